@@ -0,0 +1,143 @@
+/*-------------------------------------------------------------------------
+ *
+ * gp_ash.c
+ *    Functions to read the active session history sampled by the
+ *    ash sampler process
+ *
+ * Copyright (c) 2017-Present VMware, Inc. or its affiliates.
+ *
+ *-------------------------------------------------------------------------
+*/
+#include "postgres.h"
+#include "funcapi.h"
+#include "pgstat.h"
+#include "cdb/cdbvars.h"
+#include "postmaster/ash_sampler.h"
+#include "utils/builtins.h"
+#include "utils/timestamp.h"
+
+PG_MODULE_MAGIC;
+
+Datum		gp_ash_samples(PG_FUNCTION_ARGS);
+
+PG_FUNCTION_INFO_V1(gp_ash_samples);
+
+/* Cross-call state of gp_ash_samples */
+typedef struct AshContext
+{
+	AshSample  *samples;		/* copy of the ring buffer, oldest first */
+	int			nsamples;
+	int			crtIndex;		/* next sample to return */
+} AshContext;
+
+/*
+ * Get the active session history samples of this segment
+ *
+ * ---------------------------------------------------------------------
+ * Interface to gp_ash_samples function.
+ *
+ * The gp_ash_samples function returns the samples the ash sampler process
+ * took of the backends running a query on this segment, oldest first.
+ * slice_id and plan_node_id are -1 when the backend was not executing a
+ * plan node, e.g. while parsing or planning; wait_event_type and
+ * wait_event are NULL when it was running on CPU.
+ *
+ * Samples are only taken when gp_ash_buffer_size is non-zero. The
+ * gp_internal_tools extension wraps this in the cluster-wide
+ * session_state.active_session_history view.
+ * It can also be invoked by creating a function via psql that references it.
+ * For example,
+ *
+ * CREATE FUNCTION gp_ash_samples()
+ *   RETURNS TABLE ( segid int2
+ *   				,sample_time timestamptz
+ *   				,pid int4
+ *   				,sess_id int4
+ *   				,command_cnt int4
+ *   				,slice_id int2
+ *   				,plan_node_id int2
+ *   				,datid oid
+ *   				,wait_event_type text
+ *   				,wait_event text
+ *                 )
+ *   AS '$libdir/gp_ash', 'gp_ash_samples' LANGUAGE C VOLATILE;
+ */
+Datum
+gp_ash_samples(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	AshContext *ash;
+#define GP_ASH_SAMPLES_NATTR 10
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		/* create a function context for cross-call persistence */
+		funcctx = SRF_FIRSTCALL_INIT();
+
+		/* Switch to memory context appropriate for multiple function calls */
+		MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		TupleDesc	tupdesc = CreateTemplateTupleDesc(GP_ASH_SAMPLES_NATTR);
+
+		TupleDescInitEntry(tupdesc, (AttrNumber) 1, "segid", INT2OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 2, "sample_time", TIMESTAMPTZOID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 3, "pid", INT4OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 4, "sess_id", INT4OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 5, "command_cnt", INT4OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 6, "slice_id", INT2OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 7, "plan_node_id", INT2OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 8, "datid", OIDOID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 9, "wait_event_type", TEXTOID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 10, "wait_event", TEXTOID, -1, 0);
+
+		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+		/* Copy the samples out, so that we don't hold the lock across calls */
+		ash = (AshContext *) palloc0(sizeof(AshContext));
+		ash->nsamples = AshCopySamples(&ash->samples);
+		funcctx->user_fctx = ash;
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	ash = (AshContext *) funcctx->user_fctx;
+
+	if (ash->crtIndex < ash->nsamples)
+	{
+		AshSample  *sample = &ash->samples[ash->crtIndex++];
+		const char *wait_event_type;
+		const char *wait_event;
+
+		Datum		values[GP_ASH_SAMPLES_NATTR];
+		bool		nulls[GP_ASH_SAMPLES_NATTR];
+
+		memset(nulls, 0, sizeof(nulls));
+
+		values[0] = Int16GetDatum(GpIdentity.segindex);
+		values[1] = TimestampTzGetDatum(sample->sample_time);
+		values[2] = Int32GetDatum(sample->pid);
+		values[3] = Int32GetDatum(sample->sess_id);
+		values[4] = Int32GetDatum(sample->command_cnt);
+		values[5] = Int16GetDatum(sample->slice_id);
+		values[6] = Int16GetDatum(sample->plan_node_id);
+		values[7] = ObjectIdGetDatum(sample->databaseid);
+
+		wait_event_type = pgstat_get_wait_event_type(sample->wait_event_info);
+		wait_event = pgstat_get_wait_event(sample->wait_event_info);
+		if (wait_event_type)
+			values[8] = CStringGetTextDatum(wait_event_type);
+		else
+			nulls[8] = true;
+		if (wait_event)
+			values[9] = CStringGetTextDatum(wait_event);
+		else
+			nulls[9] = true;
+
+		HeapTuple	tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+		Datum		result = HeapTupleGetDatum(tuple);
+
+		SRF_RETURN_NEXT(funcctx, result);
+	}
+
+	SRF_RETURN_DONE(funcctx);
+}
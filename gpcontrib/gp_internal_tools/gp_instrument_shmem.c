@@ -11,18 +11,30 @@
 #include "funcapi.h"
 #include "cdb/cdbvars.h"
 #include "utils/builtins.h"
+#include "utils/timestamp.h"
+#include "utils/workfile_mgr.h"
 #include "executor/instrument.h"
 
 PG_MODULE_MAGIC;
 
 Datum		gp_instrument_shmem_summary(PG_FUNCTION_ARGS);
 Datum		gp_instrument_shmem_detail(PG_FUNCTION_ARGS);
+Datum		gp_instrument_shmem_progress(PG_FUNCTION_ARGS);
 
 /* Helper functions */
 static InstrumentationSlot *next_used_slot(int32 *);
 
 PG_FUNCTION_INFO_V1(gp_instrument_shmem_summary);
 PG_FUNCTION_INFO_V1(gp_instrument_shmem_detail);
+PG_FUNCTION_INFO_V1(gp_instrument_shmem_progress);
+
+/* Cross-call state of gp_instrument_shmem_progress */
+typedef struct ProgressContext
+{
+	int32		crtIndex;		/* next slot to look at */
+	workfile_set *workfiles;	/* snapshot of the active workfile sets */
+	int			numWorkfiles;
+} ProgressContext;
 
 #define GET_SLOT_BY_INDEX(index) ((InstrumentationSlot*)(InstrumentGlobal + 1) + (index))
 
@@ -179,3 +191,141 @@ gp_instrument_shmem_detail(PG_FUNCTION_ARGS)
 		SRF_RETURN_NEXT(funcctx, result);
 	}
 }
+
+/*
+ * Get live progress of the plan nodes of running queries
+ *
+ * ---------------------------------------------------------------------
+ * Interface to gp_instrument_shmem_progress function.
+ *
+ * The gp_instrument_shmem_progress function returns one row per plan node
+ * of every query currently running on this segment, read from the
+ * instrumentation slots in shared memory while the query runs. Rows are
+ * counted as they are produced; slice_spill_bytes is the size of the
+ * workfiles of the slice the node belongs to, as workfiles are not tracked
+ * per node; motion_bytes is only set for Motion nodes, and
+ * motion_max_target_rows, the most rows sent to any one segment, only for
+ * Redistribute Motion senders. Comparing it with rows_out shows skew while
+ * the query is still running.
+ *
+ * Slots are only used when gp_enable_query_metrics is on and
+ * gp_instrument_shmem_size is non-zero. The gp_internal_tools extension
+ * wraps this in the cluster-wide session_state.query_progress view.
+ * It can also be invoked by creating a function via psql that references it.
+ * For example,
+ *
+ * CREATE FUNCTION gp_instrument_shmem_progress()
+ *   RETURNS TABLE ( segid int2
+ *   				,pid int4
+ *   				,ssid int4
+ *   				,ccnt int4
+ *   				,sliceid int2
+ *   				,nid int2
+ *   				,tuplecount int8
+ *   				,nloops int8
+ *   				,elapsed_seconds float8
+ *   				,slice_spill_bytes int8
+ *   				,motion_bytes int8
+ *   				,motion_max_target_rows int8
+ *                 )
+ *   AS '$libdir/gp_instrument_shmem', 'gp_instrument_shmem_progress' LANGUAGE C VOLATILE;
+ */
+Datum
+gp_instrument_shmem_progress(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	ProgressContext *progress;
+#define GP_INSTRUMENT_SHMEM_PROGRESS_NATTR 12
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		/* create a function context for cross-call persistence */
+		funcctx = SRF_FIRSTCALL_INIT();
+
+		/* Switch to memory context appropriate for multiple function calls */
+		MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		TupleDesc	tupdesc = CreateTemplateTupleDesc(GP_INSTRUMENT_SHMEM_PROGRESS_NATTR);
+
+		TupleDescInitEntry(tupdesc, (AttrNumber) 1, "segid", INT2OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 2, "pid", INT4OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 3, "ssid", INT4OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 4, "ccnt", INT4OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 5, "sliceid", INT2OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 6, "nid", INT2OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 7, "tuplecount", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 8, "nloops", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 9, "elapsed_seconds", FLOAT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 10, "slice_spill_bytes", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 11, "motion_bytes", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 12, "motion_max_target_rows", INT8OID, -1, 0);
+
+		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+		progress = (ProgressContext *) palloc0(sizeof(ProgressContext));
+		progress->workfiles = workfile_mgr_cache_entries_get_copy(&progress->numWorkfiles);
+		funcctx->user_fctx = progress;
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	progress = (ProgressContext *) funcctx->user_fctx;
+	while (true)
+	{
+		InstrumentationSlot *slot = next_used_slot(&progress->crtIndex);
+		InstrumentationSlot copy;
+		int64		spill_bytes = 0;
+		long		secs;
+		int			usecs;
+
+		if (slot == NULL)
+		{
+			/* Reached the end of the entry array, we're done */
+			SRF_RETURN_DONE(funcctx);
+		}
+
+		/*
+		 * The owning query keeps updating the slot, and may even recycle it
+		 * under us; work on a copy, and skip it if it was recycled.
+		 */
+		memcpy(&copy, slot, sizeof(InstrumentationSlot));
+		if (SlotIsEmpty(&copy))
+			continue;
+
+		for (int i = 0; i < progress->numWorkfiles; i++)
+		{
+			workfile_set *work_set = &progress->workfiles[i];
+
+			if (work_set->session_id == copy.ssid &&
+				work_set->command_count == copy.ccnt &&
+				work_set->slice_id == copy.sliceid)
+				spill_bytes += work_set->total_bytes;
+		}
+
+		TimestampDifference(copy.starttime, GetCurrentTimestamp(), &secs, &usecs);
+
+		Datum		values[GP_INSTRUMENT_SHMEM_PROGRESS_NATTR];
+		bool		nulls[GP_INSTRUMENT_SHMEM_PROGRESS_NATTR];
+
+		memset(nulls, 0, sizeof(nulls));
+
+		values[0] = Int16GetDatum(copy.segid);
+		values[1] = Int32GetDatum(copy.pid);
+		values[2] = Int32GetDatum(copy.ssid);
+		values[3] = Int32GetDatum(copy.ccnt);
+		values[4] = Int16GetDatum(copy.sliceid);
+		values[5] = Int16GetDatum(copy.nid);
+		/* ntuples only accumulates at the end of each loop */
+		values[6] = Int64GetDatum((int64) (copy.data.ntuples + copy.data.tuplecount));
+		values[7] = Int64GetDatum((int64) copy.data.nloops);
+		values[8] = Float8GetDatum(secs + usecs / 1000000.0);
+		values[9] = Int64GetDatum(spill_bytes);
+		values[10] = Int64GetDatum((int64) copy.motionbytes);
+		values[11] = Int64GetDatum((int64) copy.maxtargetrows);
+
+		HeapTuple	tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+		Datum		result = HeapTupleGetDatum(tuple);
+
+		SRF_RETURN_NEXT(funcctx, result);
+	}
+}
@@ -0,0 +1,242 @@
+/* gpcontrib/gp_internal_tools/gp_internal_tools--1.0.0--1.0.1.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "ALTER EXTENSION gp_internal_tools UPDATE TO '1.0.1'" to load this file. \quit
+
+SET search_path = session_state;
+
+--------------------------------------------------------------------------------
+--  Query progress functions and views                                        --
+--------------------------------------------------------------------------------
+
+--------------------------------------------------------------------------------
+-- @function:
+--        query_progress_f
+--
+-- @in:
+--
+-- @out:
+--        smallint - segment id,
+--        int - process id,
+--        int - session id,
+--        int - command count,
+--        smallint - slice id,
+--        smallint - plan node id,
+--        bigint - rows produced so far,
+--        bigint - number of loops started,
+--        float8 - seconds since the node was initialized,
+--        bigint - bytes spilled to workfiles by the node's slice,
+--        bigint - bytes sent and received by a Motion node,
+--        bigint - most rows a Redistribute Motion sent to one segment
+--
+-- @doc:
+--        UDF to retrieve live per-node progress of running queries from the
+--        instrumentation slots in shared memory. Only available when
+--        gp_enable_query_metrics is on and gp_instrument_shmem_size > 0.
+--
+--------------------------------------------------------------------------------
+
+CREATE FUNCTION query_progress_f_on_master()
+RETURNS SETOF record
+AS '$libdir/gp_instrument_shmem', 'gp_instrument_shmem_progress'
+LANGUAGE C VOLATILE EXECUTE ON COORDINATOR;
+
+GRANT EXECUTE ON FUNCTION query_progress_f_on_master() TO public;
+
+CREATE FUNCTION query_progress_f_on_segments()
+RETURNS SETOF record
+AS '$libdir/gp_instrument_shmem', 'gp_instrument_shmem_progress'
+LANGUAGE C VOLATILE EXECUTE ON ALL SEGMENTS;
+
+GRANT EXECUTE ON FUNCTION query_progress_f_on_segments() TO public;
+
+--------------------------------------------------------------------------------
+-- @view:
+--        query_progress
+--
+-- @doc:
+--        Live per-node, per-segment progress of running queries, to spot
+--        lagging slices and skewed segments
+--
+--------------------------------------------------------------------------------
+
+CREATE VIEW query_progress AS
+WITH all_entries AS (
+   SELECT C.*
+          FROM query_progress_f_on_master() AS C (
+            segid smallint,
+            pid int,
+            sessionid int,
+            command_cnt int,
+            slice_id smallint,
+            node_id smallint,
+            rows_out bigint,
+            nloops bigint,
+            elapsed_seconds float8,
+            slice_spill_bytes bigint,
+            motion_bytes bigint,
+            motion_max_target_rows bigint
+          )
+    UNION ALL
+    SELECT C.*
+          FROM query_progress_f_on_segments() AS C (
+            segid smallint,
+            pid int,
+            sessionid int,
+            command_cnt int,
+            slice_id smallint,
+            node_id smallint,
+            rows_out bigint,
+            nloops bigint,
+            elapsed_seconds float8,
+            slice_spill_bytes bigint,
+            motion_bytes bigint,
+            motion_max_target_rows bigint
+          ))
+SELECT S.datname,
+       M.sessionid as sess_id,
+       S.usename,
+       S.query as query,
+       M.command_cnt,
+       M.segid,
+       M.pid,
+       M.slice_id,
+       M.node_id,
+       M.rows_out,
+       M.nloops,
+       M.elapsed_seconds,
+       M.slice_spill_bytes,
+       M.motion_bytes,
+       M.motion_max_target_rows
+FROM all_entries M LEFT OUTER JOIN
+pg_stat_activity as S
+ON M.sessionid = S.sess_id;
+
+GRANT SELECT ON query_progress TO public;
+
+--------------------------------------------------------------------------------
+--  Active session history functions and views                                --
+--------------------------------------------------------------------------------
+
+--------------------------------------------------------------------------------
+-- @function:
+--        ash_samples_f
+--
+-- @in:
+--
+-- @out:
+--        smallint - segment id,
+--        timestamptz - time the sample was taken,
+--        int - process id,
+--        int - session id,
+--        int - command count,
+--        smallint - slice id,
+--        smallint - plan node id,
+--        oid - database oid,
+--        text - wait event type,
+--        text - wait event
+--
+-- @doc:
+--        UDF to retrieve the samples of running queries taken by the ash
+--        sampler process. Only available when gp_ash_buffer_size > 0.
+--
+--------------------------------------------------------------------------------
+
+CREATE FUNCTION ash_samples_f_on_master()
+RETURNS SETOF record
+AS '$libdir/gp_ash', 'gp_ash_samples'
+LANGUAGE C VOLATILE EXECUTE ON COORDINATOR;
+
+GRANT EXECUTE ON FUNCTION ash_samples_f_on_master() TO public;
+
+CREATE FUNCTION ash_samples_f_on_segments()
+RETURNS SETOF record
+AS '$libdir/gp_ash', 'gp_ash_samples'
+LANGUAGE C VOLATILE EXECUTE ON ALL SEGMENTS;
+
+GRANT EXECUTE ON FUNCTION ash_samples_f_on_segments() TO public;
+
+--------------------------------------------------------------------------------
+-- @view:
+--        active_session_history
+--
+-- @doc:
+--        Samples of running queries from the coordinator and all segments
+--
+--------------------------------------------------------------------------------
+
+CREATE VIEW active_session_history AS
+WITH all_entries AS (
+   SELECT C.*
+          FROM ash_samples_f_on_master() AS C (
+            segid smallint,
+            sample_time timestamptz,
+            pid int,
+            sess_id int,
+            command_cnt int,
+            slice_id smallint,
+            plan_node_id smallint,
+            datid oid,
+            wait_event_type text,
+            wait_event text
+          )
+    UNION ALL
+    SELECT C.*
+          FROM ash_samples_f_on_segments() AS C (
+            segid smallint,
+            sample_time timestamptz,
+            pid int,
+            sess_id int,
+            command_cnt int,
+            slice_id smallint,
+            plan_node_id smallint,
+            datid oid,
+            wait_event_type text,
+            wait_event text
+          ))
+SELECT D.datname,
+       M.sess_id,
+       M.command_cnt,
+       M.segid,
+       M.pid,
+       M.sample_time,
+       M.slice_id,
+       M.plan_node_id,
+       coalesce(M.wait_event_type, 'CPU') as wait_event_type,
+       coalesce(M.wait_event, 'CPU') as wait_event
+FROM all_entries M LEFT OUTER JOIN
+pg_database as D
+ON M.datid = D.oid;
+
+GRANT SELECT ON active_session_history TO public;
+
+--------------------------------------------------------------------------------
+-- @view:
+--        active_session_history_summary
+--
+-- @doc:
+--        Number of samples per query, slice, plan node and wait event across
+--        the cluster. With gp_ash_sample_interval in milliseconds, samples
+--        times the interval approximates the time spent in each.
+--
+--------------------------------------------------------------------------------
+
+CREATE VIEW active_session_history_summary AS
+SELECT datname,
+       sess_id,
+       command_cnt,
+       slice_id,
+       plan_node_id,
+       wait_event_type,
+       wait_event,
+       count(*) as samples,
+       count(DISTINCT segid) as segments,
+       min(sample_time) as first_sample,
+       max(sample_time) as last_sample
+FROM active_session_history
+GROUP BY datname, sess_id, command_cnt, slice_id, plan_node_id,
+         wait_event_type, wait_event;
+
+GRANT SELECT ON active_session_history_summary TO public;
+
+SET search_path TO DEFAULT;
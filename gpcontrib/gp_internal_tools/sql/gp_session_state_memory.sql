@@ -5,6 +5,10 @@ CREATE EXTENSION gp_internal_tools;
 
 select * from session_state.session_level_memory_consumption limit 0;
 
+select * from session_state.query_progress limit 0;
+
+select * from session_state.active_session_history_summary limit 0;
+
 -- Verify that we have 1 entry per segment, as we are only considering our current session.
 select 1 as session_entry_count from session_state.session_level_memory_consumption, pg_stat_activity where pid = pg_backend_pid() 
 and session_state.session_level_memory_consumption.sess_id = pg_stat_activity.sess_id 
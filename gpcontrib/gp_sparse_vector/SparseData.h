@@ -143,6 +143,12 @@ SparseData arr_to_sdata(char *array, size_t width, Oid type_of_data, int count);
 double *sdata_to_float8arr(SparseData sdata);
 StringInfo copyStringInfo(StringInfo source_sinfo);
 StringInfo makeStringInfoFromData(char *data,int len);
+/* Vectorized kernels for FLOAT8 data, see SparseData.c */
+SparseData op_sdata_by_sdata_float8(int operation, SparseData left, SparseData right);
+double dot_sdata_float8(SparseData left, SparseData right);
+double sum_sdata_float8(SparseData sdata);
+double l2norm_sdata_float8(SparseData sdata);
+double l1norm_sdata_float8(SparseData sdata);
 static inline void int8_to_compword(int64 num, char entry[9]);
 
 static inline size_t
@@ -0,0 +1,102 @@
+-- Microbenchmark of the vectorized svec operators
+--
+-- Compares dot, l2norm, vec_sum, + and * and the sum(svec) aggregate with
+-- the reference versions built on the generic SparseData code, and checks
+-- that both produce identical results.  Run with psql in a database where
+-- the gp_sparse_vector extension is installed:
+--
+--   psql -f gp_svec_bench.sql
+--
+-- Vary the dimension, density and number of rows below to match the data at
+-- hand; sparse term frequency vectors have many short runs of zeroes,
+-- dense vectors have one run per element.
+
+\set nrows 2000
+\set dimension 10000
+
+DROP SCHEMA IF EXISTS svec_bench CASCADE;
+CREATE SCHEMA svec_bench;
+
+CREATE FUNCTION svec_bench.dot_reference(svec,svec) RETURNS float8 AS 'gp_svec.so', 'svec_dot_reference' STRICT LANGUAGE C IMMUTABLE;
+CREATE FUNCTION svec_bench.l2norm_reference(svec) RETURNS float8 AS 'gp_svec.so', 'svec_l2norm_reference' STRICT LANGUAGE C IMMUTABLE;
+CREATE FUNCTION svec_bench.vec_sum_reference(svec) RETURNS float8 AS 'gp_svec.so', 'svec_summate_reference' STRICT LANGUAGE C IMMUTABLE;
+CREATE FUNCTION svec_bench.plus_reference(svec,svec) RETURNS svec AS 'gp_svec.so', 'svec_plus_reference' STRICT LANGUAGE C IMMUTABLE;
+CREATE FUNCTION svec_bench.mult_reference(svec,svec) RETURNS svec AS 'gp_svec.so', 'svec_mult_reference' STRICT LANGUAGE C IMMUTABLE;
+CREATE AGGREGATE svec_bench.sum_reference (svec) (
+	SFUNC = svec_bench.plus_reference,
+	PREFUNC = svec_bench.plus_reference,
+	INITCOND = '{1}:{0.}',
+	STYPE = svec
+);
+
+-- About 5% non-zero term frequencies
+CREATE TABLE svec_bench.sparse AS
+SELECT r, ARRAY(SELECT CASE WHEN random() < 0.05 THEN floor(random() * 5) + 1 ELSE 0 END
+                FROM generate_series(1, :dimension) g WHERE g > r * 0)::svec AS a,
+          ARRAY(SELECT CASE WHEN random() < 0.05 THEN floor(random() * 5) + 1 ELSE 0 END
+                FROM generate_series(1, :dimension) g WHERE g > r * 0)::svec AS b
+FROM generate_series(1, :nrows) r DISTRIBUTED BY (r);
+
+-- All elements different
+CREATE TABLE svec_bench.dense AS
+SELECT r, ARRAY(SELECT random() FROM generate_series(1, :dimension) g WHERE g > r * 0)::svec AS a,
+          ARRAY(SELECT random() FROM generate_series(1, :dimension) g WHERE g > r * 0)::svec AS b
+FROM generate_series(1, :nrows) r DISTRIBUTED BY (r);
+
+ANALYZE svec_bench.sparse;
+ANALYZE svec_bench.dense;
+
+\qecho Results must be identical
+SELECT bool_and(dot(a, b) = svec_bench.dot_reference(a, b)) AS dot_ok,
+       bool_and(l2norm(a) = svec_bench.l2norm_reference(a)) AS l2norm_ok,
+       bool_and(vec_sum(a) = svec_bench.vec_sum_reference(a)) AS vec_sum_ok,
+       bool_and(a + b = svec_bench.plus_reference(a, b)) AS plus_ok,
+       bool_and(a * b = svec_bench.mult_reference(a, b)) AS mult_ok
+FROM svec_bench.sparse;
+SELECT bool_and(dot(a, b) = svec_bench.dot_reference(a, b)) AS dot_ok,
+       bool_and(l2norm(a) = svec_bench.l2norm_reference(a)) AS l2norm_ok,
+       bool_and(vec_sum(a) = svec_bench.vec_sum_reference(a)) AS vec_sum_ok,
+       bool_and(a + b = svec_bench.plus_reference(a, b)) AS plus_ok,
+       bool_and(a * b = svec_bench.mult_reference(a, b)) AS mult_ok
+FROM svec_bench.dense;
+SELECT sum(a) = svec_bench.sum_reference(a) AS sum_agg_ok FROM svec_bench.sparse;
+
+\timing on
+
+\qecho dot
+SELECT count(dot(a, b)) FROM svec_bench.sparse;
+SELECT count(svec_bench.dot_reference(a, b)) FROM svec_bench.sparse;
+SELECT count(dot(a, b)) FROM svec_bench.dense;
+SELECT count(svec_bench.dot_reference(a, b)) FROM svec_bench.dense;
+
+\qecho l2norm
+SELECT count(l2norm(a)) FROM svec_bench.sparse;
+SELECT count(svec_bench.l2norm_reference(a)) FROM svec_bench.sparse;
+SELECT count(l2norm(a)) FROM svec_bench.dense;
+SELECT count(svec_bench.l2norm_reference(a)) FROM svec_bench.dense;
+
+\qecho vec_sum
+SELECT count(vec_sum(a)) FROM svec_bench.sparse;
+SELECT count(svec_bench.vec_sum_reference(a)) FROM svec_bench.sparse;
+SELECT count(vec_sum(a)) FROM svec_bench.dense;
+SELECT count(svec_bench.vec_sum_reference(a)) FROM svec_bench.dense;
+
+\qecho plus
+SELECT count(a + b) FROM svec_bench.sparse;
+SELECT count(svec_bench.plus_reference(a, b)) FROM svec_bench.sparse;
+SELECT count(a + b) FROM svec_bench.dense;
+SELECT count(svec_bench.plus_reference(a, b)) FROM svec_bench.dense;
+
+\qecho mult
+SELECT count(a * b) FROM svec_bench.sparse;
+SELECT count(svec_bench.mult_reference(a, b)) FROM svec_bench.sparse;
+SELECT count(a * b) FROM svec_bench.dense;
+SELECT count(svec_bench.mult_reference(a, b)) FROM svec_bench.dense;
+
+\qecho sum aggregate
+SELECT dimension(sum(a)) FROM svec_bench.sparse;
+SELECT dimension(svec_bench.sum_reference(a)) FROM svec_bench.sparse;
+
+\timing off
+
+DROP SCHEMA svec_bench CASCADE;
@@ -141,8 +141,8 @@ svec_l2_cmp_internal(SvecType *svec1, SvecType *svec2)
 {
 	SparseData left  = sdata_from_svec(svec1);
 	SparseData right = sdata_from_svec(svec2);
-	double magleft  = l2norm_sdata_values_double(left);
-	double magright = l2norm_sdata_values_double(right);
+	double magleft  = l2norm_sdata_float8(left);
+	double magright = l2norm_sdata_float8(right);
 	int result;
 	if (magleft < magright)
 	{
@@ -235,7 +235,7 @@ svec_operate_on_sdata_pair(int scalar_args,int operation,SparseData left,SparseD
 
 	switch(scalar_args) {
 		case 0: 		//neither arg is scalar
-			sdata = op_sdata_by_sdata(operation,left,right);
+			sdata = op_sdata_by_sdata_float8(operation,left,right);
 			break;
 		case 1:			//left arg is scalar
 			
@@ -431,7 +431,7 @@ svec_count(PG_FUNCTION_ARGS)
 					right->unique_value_count,right->total_value_count);
 
 			/* Create the output SVEC */
-			sdata_result = op_sdata_by_sdata(1,left,right_clamped);
+			sdata_result = op_sdata_by_sdata_float8(1,left,right_clamped);
 			result = svec_from_sparsedata(sdata_result,true);
 
 			pfree(clamped_vals);
@@ -458,13 +458,10 @@ svec_dot(PG_FUNCTION_ARGS)
 	SvecType *svec2 = PG_GETARG_SVECTYPE_P(1);
 	SparseData left  = sdata_from_svec(svec1);
 	SparseData right = sdata_from_svec(svec2);
-	SparseData mult_result;
 	double accum;
 	check_dimension(svec1,svec2,"svec_dot");
 
-	mult_result = op_sdata_by_sdata(2,left,right);
-	accum = sum_sdata_values_double(mult_result);
-	freeSparseDataAndData(mult_result);
+	accum = dot_sdata_float8(left,right);
 
 	PG_RETURN_FLOAT8(accum);
 }
@@ -477,7 +474,7 @@ svec_l2norm(PG_FUNCTION_ARGS)
 	SvecType *svec = PG_GETARG_SVECTYPE_P(0);
 	SparseData sdata  = sdata_from_svec(svec);
 	double accum;
-	accum = l2norm_sdata_values_double(sdata);
+	accum = l2norm_sdata_float8(sdata);
 
 	PG_RETURN_FLOAT8(accum);
 }
@@ -491,7 +488,7 @@ svec_l1norm(PG_FUNCTION_ARGS)
 	SvecType *svec = PG_GETARG_SVECTYPE_P(0);
 	SparseData sdata  = sdata_from_svec(svec);
 	double accum;
-	accum = l1norm_sdata_values_double(sdata);
+	accum = l1norm_sdata_float8(sdata);
 
 	PG_RETURN_FLOAT8(accum);
 }
@@ -504,7 +501,7 @@ svec_summate(PG_FUNCTION_ARGS)
 	SvecType *svec = PG_GETARG_SVECTYPE_P(0);
 	SparseData sdata  = sdata_from_svec(svec);
 	double accum;
-	accum = sum_sdata_values_double(sdata);
+	accum = sum_sdata_float8(sdata);
 
 	PG_RETURN_FLOAT8(accum);
 }
@@ -774,7 +771,7 @@ Datum
 float8arr_l1norm(PG_FUNCTION_ARGS) {
 	ArrayType *array  = PG_GETARG_ARRAYTYPE_P(0);
 	SparseData sdata = sdata_uncompressed_from_float8arr_internal(array);
-	double result = l1norm_sdata_values_double(sdata);
+	double result = l1norm_sdata_float8(sdata);
 	pfree(sdata);
 	PG_RETURN_FLOAT8(result);
 }
@@ -786,7 +783,7 @@ Datum
 float8arr_summate(PG_FUNCTION_ARGS) {
 	ArrayType *array  = PG_GETARG_ARRAYTYPE_P(0);
 	SparseData sdata = sdata_uncompressed_from_float8arr_internal(array);
-	double result = sum_sdata_values_double(sdata);
+	double result = sum_sdata_float8(sdata);
 	pfree(sdata);
 	PG_RETURN_FLOAT8(result);
 }
@@ -802,7 +799,7 @@ Datum
 float8arr_l2norm(PG_FUNCTION_ARGS) {
 	ArrayType *array  = PG_GETARG_ARRAYTYPE_P(0);
 	SparseData sdata = sdata_uncompressed_from_float8arr_internal(array);
-	double result = l2norm_sdata_values_double(sdata);
+	double result = l2norm_sdata_float8(sdata);
 	pfree(sdata);
 	PG_RETURN_FLOAT8(result);
 }
@@ -820,14 +817,11 @@ float8arr_dot(PG_FUNCTION_ARGS) {
 	ArrayType *arr_right  = PG_GETARG_ARRAYTYPE_P(1);
 	SparseData left  = sdata_uncompressed_from_float8arr_internal(arr_left);
 	SparseData right = sdata_uncompressed_from_float8arr_internal(arr_right);
-	SparseData mult_result;
 	double accum;
 
-	mult_result = op_sdata_by_sdata(2,left,right);
-	accum = sum_sdata_values_double(mult_result);
+	accum = dot_sdata_float8(left,right);
 	freeSparseData(left);
 	freeSparseData(right);
-	freeSparseDataAndData(mult_result);
 
 	PG_RETURN_FLOAT8(accum);
 }
@@ -980,12 +974,9 @@ svec_dot_float8arr(PG_FUNCTION_ARGS)
 	ArrayType *arr = PG_GETARG_ARRAYTYPE_P(1);
 	SparseData right = sdata_uncompressed_from_float8arr_internal(arr);
 	SparseData left = sdata_from_svec(svec);
-	SparseData mult_result;
 	double accum;
-	mult_result = op_sdata_by_sdata(2,left,right);
-	accum = sum_sdata_values_double(mult_result);
+	accum = dot_sdata_float8(left,right);
 	freeSparseData(right);
-	freeSparseDataAndData(mult_result);
 
 	PG_RETURN_FLOAT8(accum);
 }
@@ -997,12 +988,9 @@ float8arr_dot_svec(PG_FUNCTION_ARGS)
 	SvecType *svec = PG_GETARG_SVECTYPE_P(1);
 	SparseData left = sdata_uncompressed_from_float8arr_internal(arr);
 	SparseData right = sdata_from_svec(svec);
-	SparseData mult_result;
 	double accum;
-	mult_result = op_sdata_by_sdata(2,left,right);
-	accum = sum_sdata_values_double(mult_result);
+	accum = dot_sdata_float8(left,right);
 	freeSparseData(left);
-	freeSparseDataAndData(mult_result);
 
 	PG_RETURN_FLOAT8(accum);
 }
@@ -1015,7 +1003,7 @@ static int
 float8arr_hash_internal(ArrayType *array)
 {
 	SparseData sdata = sdata_uncompressed_from_float8arr_internal(array);
-	double l1norm = l1norm_sdata_values_double(sdata);
+	double l1norm = l1norm_sdata_float8(sdata);
 	int arr_hash = DirectFunctionCall1(hashfloat8, Float8GetDatumFast(l1norm));
 	pfree(sdata);
 	return(arr_hash);
@@ -1387,3 +1375,86 @@ svec_median(PG_FUNCTION_ARGS) {
 
 	PG_RETURN_FLOAT8(((float8 *)(sdata->vals->data))[index]);
 }
+
+/*
+ * Reference versions of the vectorized operators, built on the generic
+ * SparseData code they replaced.  They are not part of the extension's SQL
+ * interface; gp_svec_bench.sql creates them to compare speed and results.
+ */
+PG_FUNCTION_INFO_V1( svec_dot_reference );
+
+Datum
+svec_dot_reference(PG_FUNCTION_ARGS)
+{
+	SvecType *svec1 = PG_GETARG_SVECTYPE_P(0);
+	SvecType *svec2 = PG_GETARG_SVECTYPE_P(1);
+	SparseData left  = sdata_from_svec(svec1);
+	SparseData right = sdata_from_svec(svec2);
+	SparseData mult_result;
+	double accum;
+	check_dimension(svec1,svec2,"svec_dot_reference");
+
+	mult_result = op_sdata_by_sdata(2,left,right);
+	accum = sum_sdata_values_double(mult_result);
+	freeSparseDataAndData(mult_result);
+
+	PG_RETURN_FLOAT8(accum);
+}
+
+PG_FUNCTION_INFO_V1( svec_l2norm_reference );
+
+Datum
+svec_l2norm_reference(PG_FUNCTION_ARGS)
+{
+	SvecType *svec = PG_GETARG_SVECTYPE_P(0);
+	SparseData sdata  = sdata_from_svec(svec);
+
+	PG_RETURN_FLOAT8(l2norm_sdata_values_double(sdata));
+}
+
+PG_FUNCTION_INFO_V1( svec_summate_reference );
+
+Datum
+svec_summate_reference(PG_FUNCTION_ARGS)
+{
+	SvecType *svec = PG_GETARG_SVECTYPE_P(0);
+	SparseData sdata  = sdata_from_svec(svec);
+
+	PG_RETURN_FLOAT8(sum_sdata_values_double(sdata));
+}
+
+static SvecType *
+op_svec_by_svec_reference(int operation, SvecType *svec1, SvecType *svec2)
+{
+	SparseData left  = sdata_from_svec(svec1);
+	SparseData right = sdata_from_svec(svec2);
+
+	if (IS_SCALAR(svec1) || IS_SCALAR(svec2))
+		return op_svec_by_svec_internal(operation,svec1,svec2);
+
+	return svec_from_sparsedata(op_sdata_by_sdata(operation,left,right),true);
+}
+
+PG_FUNCTION_INFO_V1( svec_plus_reference );
+
+Datum
+svec_plus_reference(PG_FUNCTION_ARGS)
+{
+	SvecType *svec1 = PG_GETARG_SVECTYPE_P(0);
+	SvecType *svec2 = PG_GETARG_SVECTYPE_P(1);
+
+	check_dimension(svec1,svec2,"svec_plus_reference");
+	PG_RETURN_SVECTYPE_P(op_svec_by_svec_reference(1,svec1,svec2));
+}
+
+PG_FUNCTION_INFO_V1( svec_mult_reference );
+
+Datum
+svec_mult_reference(PG_FUNCTION_ARGS)
+{
+	SvecType *svec1 = PG_GETARG_SVECTYPE_P(0);
+	SvecType *svec2 = PG_GETARG_SVECTYPE_P(1);
+
+	check_dimension(svec1,svec2,"svec_mult_reference");
+	PG_RETURN_SVECTYPE_P(op_svec_by_svec_reference(2,svec1,svec2));
+}
@@ -143,6 +143,13 @@ Datum float8arr_div_svec(PG_FUNCTION_ARGS);
 Datum svec_dot_float8arr(PG_FUNCTION_ARGS);
 Datum float8arr_dot_svec(PG_FUNCTION_ARGS);
 
+// Reference versions of the vectorized operators, for benchmarking
+Datum svec_dot_reference(PG_FUNCTION_ARGS);
+Datum svec_l2norm_reference(PG_FUNCTION_ARGS);
+Datum svec_summate_reference(PG_FUNCTION_ARGS);
+Datum svec_plus_reference(PG_FUNCTION_ARGS);
+Datum svec_mult_reference(PG_FUNCTION_ARGS);
+
 
 // Casts
 Datum svec_cast_int2(PG_FUNCTION_ARGS);
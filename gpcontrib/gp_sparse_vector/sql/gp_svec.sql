@@ -80,4 +80,8 @@ SELECT array_agg(a) FROM (SELECT trunc(7) a,generate_series(1,100000) ORDER BY a
 SELECT vec_median('{9960,9926,10053,9993,10080,10050,9938,9941,10030,10029}:{1,9,8,7,6,5,4,3,2,0}'::svec);
 SELECT vec_median('{9960,9926,10053,9993,10080,10050,9938,9941,10030,10029}:{1,9,8,7,6,5,4,3,2,0}'::svec::float8[]);
 
+-- Operators on vectors with more runs than one batch of the vectorized kernels
+SELECT dot(a, a), l1norm(a), vec_sum(a) FROM (SELECT ARRAY(SELECT g::float8 FROM generate_series(1,1000) g)::svec a) foo;
+SELECT dot(a, c) a_dot_c, vec_sum(a * c) sum_a_mult_c, vec_sum(a + c) sum_a_plus_c, dot(a, a) a_dot_a FROM (SELECT ARRAY(SELECT (g / 7)::float8 FROM generate_series(1,1000) g)::svec a, ARRAY(SELECT (g % 3)::float8 FROM generate_series(1,1000) g)::svec c) foo;
+
 DROP EXTENSION gp_sparse_vector;
\ No newline at end of file
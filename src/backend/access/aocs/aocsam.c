@@ -328,10 +328,31 @@ aocs_initscan(AOCSScanDesc scan)
 	pgstat_count_heap_scan(scan->rs_base.rs_rd);
 }
 
+/*
+ * Advance cur_seg to the next segfile to scan.  In a parallel scan, that is
+ * the next segfile that no other participant has claimed yet.
+ */
+static int
+advance_scan_seg(AOCSScanDesc scan)
+{
+	if (scan->rs_base.rs_parallel != NULL)
+	{
+		int			next;
+
+		next = appendonly_parallelscan_nextsegfile(scan->rs_base.rs_parallel,
+												   scan->total_seg);
+		scan->cur_seg = (next < 0) ? scan->total_seg : next;
+	}
+	else
+		scan->cur_seg++;
+
+	return scan->cur_seg;
+}
+
 static int
 open_next_scan_seg(AOCSScanDesc scan)
 {
-	while (++scan->cur_seg < scan->total_seg)
+	while (advance_scan_seg(scan) < scan->total_seg)
 	{
 		AOCSFileSegInfo *curSegInfo = scan->seginfo[scan->cur_seg];
 
@@ -451,6 +472,27 @@ close_cur_scan_seg(AOCSScanDesc scan)
 		AppendOnlyBlockDirectory_End_forInsert(scan->blockDirectory);
 }
 
+/*
+ * Size of the first 'nseg' segfiles of 'seginfo', summed over all columns,
+ * in BLCKSZ units.  For progress reporting, like appendonly_segfiles_nblocks().
+ */
+BlockNumber
+aocs_segfiles_nblocks(AOCSFileSegInfo **seginfo, int nseg)
+{
+	int64		nbytes = 0;
+
+	for (int i = 0; i < nseg; i++)
+	{
+		if (seginfo[i]->state == AOSEG_STATE_AWAITING_DROP)
+			continue;
+
+		for (int vp = 0; vp < seginfo[i]->vpinfo.nEntry; vp++)
+			nbytes += seginfo[i]->vpinfo.entry[vp].eof;
+	}
+
+	return (BlockNumber) ((nbytes + BLCKSZ - 1) / BLCKSZ);
+}
+
 /*
  * aocs_beginrangescan
  *
@@ -28,7 +28,9 @@
 #include "catalog/storage.h"
 #include "catalog/storage_xlog.h"
 #include "cdb/cdbaocsam.h"
+#include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbvars.h"
+#include "commands/progress.h"
 #include "commands/vacuum.h"
 #include "executor/executor.h"
 #include "nodes/nodeFuncs.h"
@@ -516,13 +518,11 @@ aoco_beginscan(Relation relation,
 {
 	AOCSScanDesc	aoscan;
 
-	/* Parallel scan not supported for AO_COLUMN tables */
-	Assert(pscan == NULL);
-
 	aoscan = aocs_beginscan(relation,
 							snapshot,
 							NULL,
 							flags);
+	aoscan->rs_base.rs_parallel = pscan;
 
 	return (TableScanDesc) aoscan;
 }
@@ -580,22 +580,27 @@ aoco_getnextslot(TableScanDesc scan, ScanDirection direction, TupleTableSlot *sl
 	return false;
 }
 
+/*
+ * Parallel scans hand out whole segfiles to the participants, the same way
+ * as for ao_row tables, so the shared state is the same too.  These are
+ * currently only used by parallel index builds.
+ */
 static Size
 aoco_parallelscan_estimate(Relation rel)
 {
-	elog(ERROR, "parallel SeqScan not implemented for AO_COLUMN tables");
+	return appendonly_parallelscan_estimate(rel);
 }
 
 static Size
 aoco_parallelscan_initialize(Relation rel, ParallelTableScanDesc pscan)
 {
-	elog(ERROR, "parallel SeqScan not implemented for AO_COLUMN tables");
+	return appendonly_parallelscan_initialize(rel, pscan);
 }
 
 static void
 aoco_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
 {
-	elog(ERROR, "parallel SeqScan not implemented for AO_COLUMN tables");
+	appendonly_parallelscan_reinitialize(rel, pscan);
 }
 
 static IndexFetchTableData *
@@ -1258,6 +1263,30 @@ aoco_scan_analyze_next_tuple(TableScanDesc scan, TransactionId OldestXmin,
 	return ret;
 }
 
+/*
+ * Number of blocks of the table the scan is done with, for progress
+ * reporting.  Like appendonly_scan_get_blocks_done(), this counts whole
+ * segfiles.
+ */
+static BlockNumber
+aoco_scan_get_blocks_done(AOCSScanDesc aocoscan)
+{
+	int			nstarted;
+
+	if (aocoscan->rs_base.rs_parallel != NULL)
+	{
+		ParallelAOScanDesc paoscan;
+
+		paoscan = (ParallelAOScanDesc) aocoscan->rs_base.rs_parallel;
+		nstarted = Min(pg_atomic_read_u32(&paoscan->pas_next_segfile),
+					   (uint32) aocoscan->total_seg);
+	}
+	else
+		nstarted = Max(aocoscan->cur_seg + 1, 0);
+
+	return aocs_segfiles_nblocks(aocoscan->seginfo, nstarted);
+}
+
 static double
 aoco_index_build_range_scan(Relation heapRelation,
                                   Relation indexRelation,
@@ -1284,6 +1313,7 @@ aoco_index_build_range_scan(Relation heapRelation,
 	Snapshot	snapshot;
 	bool		need_unregister_snapshot = false;
 	TransactionId OldestXmin;
+	BlockNumber previous_blkno = InvalidBlockNumber;
 
 	/*
 	 * sanity checks
@@ -1395,6 +1425,14 @@ aoco_index_build_range_scan(Relation heapRelation,
 	Relation blkdir = relation_open(blkdirrelid, AccessShareLock);
 	if (RelationGetNumberOfBlocks(blkdir) == 0)
 	{
+		/*
+		 * Parallel workers cannot insert into the block directory, so
+		 * index_build() must not have chosen a parallel build in this case.
+		 */
+		if (aocoscan->rs_base.rs_parallel != NULL)
+			elog(ERROR, "cannot build block directory of relation \"%s\" in a parallel index build",
+				 RelationGetRelationName(heapRelation));
+
 		/*
 		 * Allocate blockDirectory in scan descriptor to let the access method
 		 * know that it needs to also build the block directory while
@@ -1406,27 +1444,11 @@ aoco_index_build_range_scan(Relation heapRelation,
 	relation_close(blkdir, NoLock);
 
 
-	/* GPDB_12_MERGE_FIXME */
-#if 0
 	/* Publish number of blocks to scan */
 	if (progress)
-	{
-		BlockNumber nblocks;
-
-		if (aoscan->rs_base.rs_parallel != NULL)
-		{
-			ParallelBlockTableScanDesc pbscan;
-
-			pbscan = (ParallelBlockTableScanDesc) aoscan->rs_base.rs_parallel;
-			nblocks = pbscan->phs_nblocks;
-		}
-		else
-			nblocks = aoscan->rs_nblocks;
-
 		pgstat_progress_update_param(PROGRESS_SCAN_BLOCKS_TOTAL,
-									 nblocks);
-	}
-#endif
+									 aocs_segfiles_nblocks(aocoscan->seginfo,
+														   aocoscan->total_seg));
 
 	/*
 	 * Must call GetOldestXmin() with SnapshotAny.  Should never call
@@ -1470,12 +1492,10 @@ aoco_index_build_range_scan(Relation heapRelation,
 			(numblocks != InvalidBlockNumber && ItemPointerGetBlockNumber(&slot->tts_tid) >= numblocks))
 			continue;
 
-		/* GPDB_12_MERGE_FIXME */
-#if 0
 		/* Report scan progress, if asked to. */
 		if (progress)
 		{
-			BlockNumber blocks_done = appendonly_scan_get_blocks_done(aoscan);
+			BlockNumber blocks_done = aoco_scan_get_blocks_done(aocoscan);
 
 			if (blocks_done != previous_blkno)
 			{
@@ -1484,7 +1504,6 @@ aoco_index_build_range_scan(Relation heapRelation,
 				previous_blkno = blocks_done;
 			}
 		}
-#endif
 
 		/*
 		 * appendonly_getnext did the time qual check
@@ -1535,27 +1554,11 @@ aoco_index_build_range_scan(Relation heapRelation,
 
 	}
 
-	/* GPDB_12_MERGE_FIXME */
-#if 0
 	/* Report scan progress one last time. */
 	if (progress)
-	{
-		BlockNumber blks_done;
-
-		if (aoscan->rs_base.rs_parallel != NULL)
-		{
-			ParallelBlockTableScanDesc pbscan;
-
-			pbscan = (ParallelBlockTableScanDesc) aoscan->rs_base.rs_parallel;
-			blks_done = pbscan->phs_nblocks;
-		}
-		else
-			blks_done = aoscan->rs_nblocks;
-
 		pgstat_progress_update_param(PROGRESS_SCAN_BLOCKS_DONE,
-									 blks_done);
-	}
-#endif
+									 aocs_segfiles_nblocks(aocoscan->seginfo,
+														   aocoscan->total_seg));
 
 	table_endscan(scan);
 
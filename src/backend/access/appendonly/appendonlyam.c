@@ -255,8 +255,28 @@ SetNextFileSegForRead(AppendOnlyScanDesc scan)
 	 */
 	while (scan->aos_segfiles_processed < scan->aos_total_segfiles)
 	{
+		FileSegInfo *fsinfo;
+
+		/*
+		 * In a parallel scan, skip over the segfiles that other participants
+		 * have already claimed.
+		 */
+		if (scan->rs_base.rs_parallel != NULL)
+		{
+			int			next;
+
+			next = appendonly_parallelscan_nextsegfile(scan->rs_base.rs_parallel,
+													   scan->aos_total_segfiles);
+			if (next < 0)
+			{
+				scan->aos_segfiles_processed = scan->aos_total_segfiles;
+				break;
+			}
+			scan->aos_segfiles_processed = next;
+		}
+
 		/* still have more segment files to read. get info of the next one */
-		FileSegInfo *fsinfo = scan->aos_segfile_arr[scan->aos_segfiles_processed];
+		fsinfo = scan->aos_segfile_arr[scan->aos_segfiles_processed];
 
 		segno = fsinfo->segno;
 		formatversion = fsinfo->formatversion;
@@ -1752,6 +1772,80 @@ appendonly_beginrangescan(Relation relation,
 											  0);
 }
 
+/* ----------------
+ *		Parallel scan support, shared by ao_row and ao_column tables
+ *
+ * The participants of a parallel scan each read the list of segfiles
+ * themselves, with the same snapshot, so all they need to share is the
+ * index of the next segfile nobody has claimed yet.
+ * ----------------
+ */
+Size
+appendonly_parallelscan_estimate(Relation rel)
+{
+	return sizeof(ParallelAOScanDescData);
+}
+
+Size
+appendonly_parallelscan_initialize(Relation rel, ParallelTableScanDesc pscan)
+{
+	ParallelAOScanDesc paoscan = (ParallelAOScanDesc) pscan;
+
+	paoscan->base.phs_relid = RelationGetRelid(rel);
+	/* there is no syncscan support for append-optimized tables */
+	paoscan->base.phs_syncscan = false;
+	pg_atomic_init_u32(&paoscan->pas_next_segfile, 0);
+
+	return sizeof(ParallelAOScanDescData);
+}
+
+void
+appendonly_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
+{
+	ParallelAOScanDesc paoscan = (ParallelAOScanDesc) pscan;
+
+	pg_atomic_write_u32(&paoscan->pas_next_segfile, 0);
+}
+
+/*
+ * Claim the next segfile of a parallel scan.
+ *
+ * Returns its index into the scan's array of segfiles, or -1 if all
+ * 'total_segfiles' of them have been handed out already.
+ */
+int
+appendonly_parallelscan_nextsegfile(ParallelTableScanDesc pscan,
+									int total_segfiles)
+{
+	ParallelAOScanDesc paoscan = (ParallelAOScanDesc) pscan;
+	uint32		next;
+
+	next = pg_atomic_fetch_add_u32(&paoscan->pas_next_segfile, 1);
+
+	return (next < (uint32) total_segfiles) ? (int) next : -1;
+}
+
+/*
+ * Size of the first 'nsegfiles' segfiles of 'segfile_arr', in BLCKSZ units.
+ *
+ * AO segfiles are not made of BLCKSZ pages, but progress reporting of
+ * table scans counts blocks, so this is what we report as blocks.
+ */
+BlockNumber
+appendonly_segfiles_nblocks(FileSegInfo **segfile_arr, int nsegfiles)
+{
+	int64		nbytes = 0;
+	int			i;
+
+	for (i = 0; i < nsegfiles; i++)
+	{
+		if (segfile_arr[i]->state != AOSEG_STATE_AWAITING_DROP)
+			nbytes += segfile_arr[i]->eof;
+	}
+
+	return (BlockNumber) ((nbytes + BLCKSZ - 1) / BLCKSZ);
+}
+
 /* ----------------
  *		appendonly_beginscan	- begin relation scan
  * ----------------
@@ -32,6 +32,7 @@
 #include "catalog/storage_xlog.h"
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbvars.h"
+#include "commands/progress.h"
 #include "commands/vacuum.h"
 #include "executor/executor.h"
 #include "pgstat.h"
@@ -373,27 +374,12 @@ ExecFetchSlotMemTuple(TupleTableSlot *slot, bool *shouldFree, MemTupleBinding *m
 
 /* ------------------------------------------------------------------------
  * Parallel aware Seq Scan callbacks for ao_row AM
+ *
+ * These are in appendonlyam.c, and are currently only used by parallel
+ * index builds.
  * ------------------------------------------------------------------------
  */
 
-static Size
-appendonly_parallelscan_estimate(Relation rel)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_ROW tables");
-}
-
-static Size
-appendonly_parallelscan_initialize(Relation rel, ParallelTableScanDesc pscan)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_ROW tables");
-}
-
-static void
-appendonly_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_ROW tables");
-}
-
 /* ------------------------------------------------------------------------
  * Seq Scan callbacks for appendonly AM
  *
@@ -1091,6 +1077,32 @@ appendonly_scan_analyze_next_tuple(TableScanDesc scan, TransactionId OldestXmin,
 	return ret;
 }
 
+/*
+ * Number of blocks of the table the scan is done with, for progress
+ * reporting.
+ *
+ * The granularity is a whole segfile: count the segfiles that have been
+ * handed out to this scan or, in a parallel scan, to any participant.
+ */
+static BlockNumber
+appendonly_scan_get_blocks_done(AppendOnlyScanDesc aoscan)
+{
+	int			nstarted;
+
+	if (aoscan->rs_base.rs_parallel != NULL)
+	{
+		ParallelAOScanDesc paoscan;
+
+		paoscan = (ParallelAOScanDesc) aoscan->rs_base.rs_parallel;
+		nstarted = Min(pg_atomic_read_u32(&paoscan->pas_next_segfile),
+					   (uint32) aoscan->aos_total_segfiles);
+	}
+	else
+		nstarted = aoscan->aos_segfiles_processed;
+
+	return appendonly_segfiles_nblocks(aoscan->aos_segfile_arr, nstarted);
+}
+
 static double
 appendonly_index_build_range_scan(Relation heapRelation,
 							  Relation indexRelation,
@@ -1117,6 +1129,7 @@ appendonly_index_build_range_scan(Relation heapRelation,
 	Snapshot	snapshot;
 	bool		need_unregister_snapshot = false;
 	TransactionId OldestXmin;
+	BlockNumber previous_blkno = InvalidBlockNumber;
 
 	/*
 	 * sanity checks
@@ -1228,6 +1241,14 @@ appendonly_index_build_range_scan(Relation heapRelation,
 	Relation blkdir = relation_open(blkdirrelid, AccessShareLock);
 	if (RelationGetNumberOfBlocks(blkdir) == 0)
 	{
+		/*
+		 * Parallel workers cannot insert into the block directory, so
+		 * index_build() must not have chosen a parallel build in this case.
+		 */
+		if (aoscan->rs_base.rs_parallel != NULL)
+			elog(ERROR, "cannot build block directory of relation \"%s\" in a parallel index build",
+				 RelationGetRelationName(heapRelation));
+
 		/*
 		 * Allocate blockDirectory in scan descriptor to let the access method
 		 * know that it needs to also build the block directory while
@@ -1238,28 +1259,11 @@ appendonly_index_build_range_scan(Relation heapRelation,
 	}
 	relation_close(blkdir, NoLock);
 
-
-	/* GPDB_12_MERGE_FIXME */
-#if 0
 	/* Publish number of blocks to scan */
 	if (progress)
-	{
-		BlockNumber nblocks;
-
-		if (aoscan->rs_base.rs_parallel != NULL)
-		{
-			ParallelBlockTableScanDesc pbscan;
-
-			pbscan = (ParallelBlockTableScanDesc) aoscan->rs_base.rs_parallel;
-			nblocks = pbscan->phs_nblocks;
-		}
-		else
-			nblocks = aoscan->rs_nblocks;
-
 		pgstat_progress_update_param(PROGRESS_SCAN_BLOCKS_TOTAL,
-									 nblocks);
-	}
-#endif
+									 appendonly_segfiles_nblocks(aoscan->aos_segfile_arr,
+																 aoscan->aos_total_segfiles));
 
 	/*
 	 * Must call GetOldestXmin() with SnapshotAny.  Should never call
@@ -1303,8 +1307,6 @@ appendonly_index_build_range_scan(Relation heapRelation,
 			(numblocks != InvalidBlockNumber && ItemPointerGetBlockNumber(&slot->tts_tid) >= numblocks))
 			continue;
 
-	/* GPDB_12_MERGE_FIXME */
-#if 0
 		/* Report scan progress, if asked to. */
 		if (progress)
 		{
@@ -1317,7 +1319,6 @@ appendonly_index_build_range_scan(Relation heapRelation,
 				previous_blkno = blocks_done;
 			}
 		}
-#endif
 
 		/*
 		 * appendonly_getnext did the time qual check
@@ -1368,27 +1369,11 @@ appendonly_index_build_range_scan(Relation heapRelation,
 
 	}
 
-	/* GPDB_12_MERGE_FIXME */
-#if 0
 	/* Report scan progress one last time. */
 	if (progress)
-	{
-		BlockNumber blks_done;
-
-		if (aoscan->rs_base.rs_parallel != NULL)
-		{
-			ParallelBlockTableScanDesc pbscan;
-
-			pbscan = (ParallelBlockTableScanDesc) aoscan->rs_base.rs_parallel;
-			blks_done = pbscan->phs_nblocks;
-		}
-		else
-			blks_done = aoscan->rs_nblocks;
-
 		pgstat_progress_update_param(PROGRESS_SCAN_BLOCKS_DONE,
-									 blks_done);
-	}
-#endif
+									 appendonly_segfiles_nblocks(aoscan->aos_segfile_arr,
+																 aoscan->aos_total_segfiles));
 
 	table_endscan(scan);
 
@@ -71,6 +71,7 @@
 #include "pgstat.h"
 #include "storage/smgr.h"
 #include "tcop/tcopprot.h"		/* pgrminclude ignore */
+#include "utils/faultinjector.h"
 #include "utils/rel.h"
 #include "utils/sortsupport.h"
 #include "utils/tuplesort.h"
@@ -1632,6 +1633,8 @@ _bt_parallel_build_main(dsm_segment *seg, shm_toc *toc)
 	/* Report the query string from leader */
 	pgstat_report_activity(STATE_RUNNING, debug_query_string);
 
+	SIMPLE_FAULT_INJECTOR("btree_parallel_build_worker");
+
 	/* Look up nbtree shared state */
 	btshared = shm_toc_lookup(toc, PARALLEL_KEY_BTREE_SHARED, false);
 
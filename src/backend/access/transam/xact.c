@@ -3403,6 +3403,14 @@ AbortTransaction(void)
 	pgstat_report_wait_end();
 	pgstat_progress_end_command();
 
+	/*
+	 * An error thrown out of ExecProcNode() skips the restore of the plan
+	 * node being executed; don't let the active session history sampler
+	 * keep attributing samples to it.
+	 */
+	MyProc->sliceId = -1;
+	MyProc->planNodeId = -1;
+
 	/* Clean up buffer I/O and buffer context locks, too */
 	AbortBufferIO();
 	UnlockBuffers();
@@ -2715,6 +2715,35 @@ index_update_stats(Relation rel,
 }
 
 
+/*
+ * Can the rows of 'heapRelation' be scanned by parallel index build workers?
+ *
+ * An append-optimized table's block directory is built along with its first
+ * index, by the process that scans the table.  Parallel workers cannot
+ * insert into the block directory, so build serially until it exists.
+ */
+static bool
+parallel_index_build_supported(Relation heapRelation)
+{
+	Oid			blkdirrelid = InvalidOid;
+	Relation	blkdir;
+	bool		result;
+
+	if (!RelationIsAppendOptimized(heapRelation))
+		return true;
+
+	GetAppendOnlyEntryAuxOids(RelationGetRelid(heapRelation), NULL,
+							  NULL, &blkdirrelid, NULL, NULL, NULL);
+	if (!OidIsValid(blkdirrelid))
+		return false;
+
+	blkdir = relation_open(blkdirrelid, AccessShareLock);
+	result = RelationGetNumberOfBlocks(blkdir) > 0;
+	relation_close(blkdir, NoLock);
+
+	return result;
+}
+
 /*
  * index_build - invoke access-method-specific index build procedure
  *
@@ -2764,13 +2793,18 @@ index_build(Relation heapRelation,
 									  RelationGetRelid(indexRelation));
 
 	/*
-	 * GPDB_12_MERGE_FIXME: Parallel CREATE INDEX temporarily disabled.
-	 * In the 'partition_prune' regression test, the parallel worker
-	 * blocked waiting for the main process. I believe there's something
-	 * broken in the lock manager in GPDB with parallel workers. Need
-	 * figure that out first.
+	 * GPDB: parallel workers are only used for the segment-local build on
+	 * each QE (or in utility mode); the QD holds no data, and merely
+	 * dispatches the CREATE INDEX along with max_parallel_maintenance_workers.
+	 * Parallel builds are opt-in, through gp_enable_parallel_index_build,
+	 * and cover heap and append-optimized tables alike; the latter only
+	 * once their block directory exists, see parallel_index_build_supported().
 	 */
-	indexInfo->ii_ParallelWorkers = 0;
+	if (indexInfo->ii_ParallelWorkers > 0 &&
+		(!gp_enable_parallel_index_build ||
+		 Gp_role == GP_ROLE_DISPATCH ||
+		 !parallel_index_build_supported(heapRelation)))
+		indexInfo->ii_ParallelWorkers = 0;
 
 	if (indexInfo->ii_ParallelWorkers == 0)
 		ereport(DEBUG1,
@@ -472,11 +472,15 @@ AppendOnlyStorageWrite_FlushAndCloseFile(
 							   storageWrite->needsWAL);
 
 	/*
-	 * We must take care of fsynching to disk ourselves since a fsync request
-	 * is not enqueued for an AO segment file that is written to disk on
-	 * primary.  Temp tables are not crash safe, no need to fsync them.
+	 * If the writes were WAL-logged, BufferedAppendWrite() has already
+	 * enqueued a fsync request for the checkpointer, and the WAL record
+	 * protects the data until then. Otherwise, e.g. when WAL-logging is
+	 * skipped for a relation created in the same transaction, we must take
+	 * care of fsynching to disk ourselves before commit.  Temp tables are
+	 * not crash safe, no need to fsync them.
 	 */
-	if (!RelFileNodeBackendIsTemp(storageWrite->relFileNode) &&
+	if (!storageWrite->needsWAL &&
+		!RelFileNodeBackendIsTemp(storageWrite->relFileNode) &&
 		FileSync(storageWrite->file, WAIT_EVENT_DATA_FILE_SYNC) != 0)
 		ereport(ERROR,
 				(errcode_for_file_access(),
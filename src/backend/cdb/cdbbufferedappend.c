@@ -19,6 +19,7 @@
 
 #include <unistd.h>				/* for write() */
 
+#include "access/aomd.h"
 #include "cdb/cdbappendonlyxlog.h"
 #include "cdb/cdbbufferedappend.h"
 #include "pgstat.h"
@@ -193,8 +194,23 @@ BufferedAppendWrite(BufferedAppend *bufferedAppend, bool needsWAL)
 	 * record after writing to file works fine.
 	 */
 	if (needsWAL)
+	{
+		/*
+		 * A WAL-logged segment file is not fsync'd when it is closed, but by
+		 * the checkpointer at the next checkpoint, like heap relations. Any
+		 * checkpoint whose redo pointer is past our WAL record must see the
+		 * sync request, or a crash right after it would not replay the
+		 * record although the data may never have made it to disk. So send
+		 * the request before inserting the record: a checkpoint starting
+		 * after the insert absorbs it.
+		 */
+		register_dirty_segment_ao(bufferedAppend->relFileNode.node,
+								  bufferedAppend->segmentFileNum,
+								  bufferedAppend->file);
+
 		xlog_ao_insert(bufferedAppend->relFileNode.node, bufferedAppend->segmentFileNum,
 					   bufferedAppend->largeWritePosition, largeWriteMemory, bytestotal);
+	}
 
 	bufferedAppend->largeWritePosition += bufferedAppend->largeWriteLen;
 	bufferedAppend->largeWriteLen = 0;
@@ -283,16 +283,52 @@ DistributedSnapshot_Copy(DistributedSnapshot *target,
 			source->count * sizeof(DistributedTransactionId));
 }
 
+/*
+ * The in-progress distributed xids of a snapshot are close to each other, in
+ * the range from xmin to xmax.  So when the whole range fits, they are
+ * serialized as 32-bit offsets from xmin, which halves the size of the
+ * snapshot sent with every dispatched query.
+ */
+static bool
+DistributedSnapshot_UseCompactXids(DistributedSnapshot *ds)
+{
+	int			i;
+
+	if (ds->count == 0)
+		return false;
+
+	for (i = 0; i < ds->count; i++)
+	{
+		if (ds->inProgressXidArray[i] < ds->xmin ||
+			ds->inProgressXidArray[i] - ds->xmin > PG_UINT32_MAX)
+			return false;
+	}
+
+	return true;
+}
+
 int
 DistributedSnapshot_SerializeSize(DistributedSnapshot *ds)
 {
-	return sizeof(DistributedSnapshotId) +
+	int			size;
+
+	size = sizeof(DistributedSnapshotId) +
 	/* xminAllDistributedSnapshots, xmin, xmax */
 		3 * sizeof(DistributedTransactionId) +
 	/* count */
-		sizeof(int32) +
-	/* Size of inProgressXidArray */
-		sizeof(DistributedTransactionId) * ds->count;
+		sizeof(int32);
+
+	/* Size of inProgressXidArray, with a flag for its format */
+	if (ds->count > 0)
+	{
+		size += sizeof(bool);
+		if (DistributedSnapshot_UseCompactXids(ds))
+			size += sizeof(uint32) * ds->count;
+		else
+			size += sizeof(DistributedTransactionId) * ds->count;
+	}
+
+	return size;
 }
 
 int
@@ -311,8 +347,31 @@ DistributedSnapshot_Serialize(DistributedSnapshot *ds, char *buf)
 	memcpy(p, &ds->count, sizeof(int32));
 	p += sizeof(int32);
 
-	memcpy(p, ds->inProgressXidArray, sizeof(DistributedTransactionId) * ds->count);
-	p += sizeof(DistributedTransactionId) * ds->count;
+	if (ds->count > 0)
+	{
+		bool		compact = DistributedSnapshot_UseCompactXids(ds);
+
+		memcpy(p, &compact, sizeof(bool));
+		p += sizeof(bool);
+
+		if (compact)
+		{
+			int			i;
+
+			for (i = 0; i < ds->count; i++)
+			{
+				uint32		offset = (uint32) (ds->inProgressXidArray[i] - ds->xmin);
+
+				memcpy(p, &offset, sizeof(uint32));
+				p += sizeof(uint32);
+			}
+		}
+		else
+		{
+			memcpy(p, ds->inProgressXidArray, sizeof(DistributedTransactionId) * ds->count);
+			p += sizeof(DistributedTransactionId) * ds->count;
+		}
+	}
 
 	Assert((p - buf) == DistributedSnapshot_SerializeSize(ds));
 
@@ -337,7 +396,10 @@ DistributedSnapshot_Deserialize(const char *buf, DistributedSnapshot *ds)
 
 	if (ds->count > 0)
 	{
-		int xipsize = sizeof(DistributedTransactionId) * ds->count;
+		bool		compact;
+
+		memcpy(&compact, p, sizeof(bool));
+		p += sizeof(bool);
 
 		if (ds->inProgressXidArray == NULL)
 		{
@@ -349,8 +411,26 @@ DistributedSnapshot_Deserialize(const char *buf, DistributedSnapshot *ds)
 						 errmsg("out of memory")));
 		}
 
-		memcpy(ds->inProgressXidArray, p, xipsize);
-		p += xipsize;
+		if (compact)
+		{
+			int			i;
+
+			for (i = 0; i < ds->count; i++)
+			{
+				uint32		offset;
+
+				memcpy(&offset, p, sizeof(uint32));
+				p += sizeof(uint32);
+				ds->inProgressXidArray[i] = ds->xmin + offset;
+			}
+		}
+		else
+		{
+			int			xipsize = sizeof(DistributedTransactionId) * ds->count;
+
+			memcpy(ds->inProgressXidArray, p, xipsize);
+			p += xipsize;
+		}
 	}
 
 	Assert((p - buf) == DistributedSnapshot_SerializeSize(ds));
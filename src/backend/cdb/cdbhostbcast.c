@@ -0,0 +1,241 @@
+/*-------------------------------------------------------------------------
+ *
+ * cdbhostbcast.c
+ *	  Host-aware Broadcast Motions.
+ *
+ * A Broadcast Motion sends every row to every receiving segment.  When a
+ * host runs several primaries, it receives the same rows once for each of
+ * them, and the network between the hosts becomes the bottleneck.  With
+ * gp_enable_host_broadcast, the QD splits such a Broadcast in two, after
+ * planning:
+ *
+ *   Broadcast Motion (BROADCAST_HOST_LOCAL)    slice P
+ *     -> Broadcast Motion (BROADCAST_HOST_RELAY)    new slice R
+ *          -> subplan    slice S
+ *
+ * The lower Motion sends each row to only one segment of every host.  Which
+ * one depends on the sender, so that the relaying is spread over all the
+ * segments of a host.  The new slice R runs on the same segments as P, and
+ * its upper Motion passes every row it received on to all the segments of
+ * its own host, itself included.  That hop goes over the loopback interface,
+ * or through the local ic-proxy process, so each row crosses the network
+ * only once per host.
+ *
+ * The price is an extra gang of QEs, so the Motion is only split when some
+ * host runs more than one of the receiving segments.  Motions that preserve
+ * a sort order are left alone.
+ *
+ * The senders find out whom to send to in nodeMotion.c, from the host of
+ * each receiving segment, which is stored in the Motions.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/cdb/cdbhostbcast.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "cdb/cdbhostbcast.h"
+#include "cdb/cdbllize.h"
+#include "cdb/cdbutil.h"
+#include "cdb/cdbvars.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/walkers.h"
+#include "utils/guc.h"
+
+typedef struct host_bcast_context
+{
+	plan_tree_base_prefix base;
+	List	   *motions;		/* Broadcast Motions that could be split */
+	int			maxPlanNodeId;
+} host_bcast_context;
+
+static bool host_bcast_walker(Node *node, host_bcast_context *context);
+static void split_broadcast(PlannedStmt *stmt, Motion *motion,
+							int numsegments, int *segmentHosts,
+							int plan_node_id);
+static int *get_segment_hosts(int numsegments, int *numhosts);
+
+/*
+ * Split the Broadcast Motions of a plan, where it pays off.
+ */
+void
+ApplyHostBroadcast(PlannedStmt *stmt)
+{
+	host_bcast_context context;
+	ListCell   *lc;
+
+	if (!gp_enable_host_broadcast || Gp_role != GP_ROLE_DISPATCH ||
+		stmt->numSlices < 2)
+		return;
+
+	exec_init_plan_tree_base(&context.base, stmt);
+	context.motions = NIL;
+	context.maxPlanNodeId = 0;
+	(void) host_bcast_walker((Node *) stmt->planTree, &context);
+
+	foreach(lc, context.motions)
+	{
+		Motion	   *motion = (Motion *) lfirst(lc);
+		int			recvIndex = stmt->slices[motion->motionID].parentIndex;
+		PlanSlice  *recvSlice;
+		int		   *segmentHosts;
+		int			numhosts;
+
+		if (gp_max_slices > 0 && stmt->numSlices >= gp_max_slices)
+			break;
+
+		if (recvIndex < 0)
+			continue;
+		recvSlice = &stmt->slices[recvIndex];
+		if ((recvSlice->gangType != GANGTYPE_PRIMARY_READER &&
+			 recvSlice->gangType != GANGTYPE_PRIMARY_WRITER) ||
+			recvSlice->directDispatch.isDirectDispatch)
+			continue;
+
+		segmentHosts = get_segment_hosts(recvSlice->numsegments, &numhosts);
+		if (numhosts == recvSlice->numsegments)
+		{
+			pfree(segmentHosts);
+			continue;
+		}
+
+		split_broadcast(stmt, motion, recvSlice->numsegments, segmentHosts,
+						++context.maxPlanNodeId);
+	}
+
+	list_free(context.motions);
+}
+
+static bool
+host_bcast_walker(Node *node, host_bcast_context *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (is_plan_node(node))
+		context->maxPlanNodeId = Max(context->maxPlanNodeId,
+									 ((Plan *) node)->plan_node_id);
+
+	if (IsA(node, Motion))
+	{
+		Motion	   *motion = (Motion *) node;
+
+		if (motion->motionType == MOTIONTYPE_BROADCAST &&
+			motion->hostMode == BROADCAST_HOST_NONE &&
+			!motion->sendSorted &&
+			motion->plan.initPlan == NIL)
+			context->motions = list_append_unique_ptr(context->motions, motion);
+	}
+
+	return plan_tree_walker(node, host_bcast_walker, context, true);
+}
+
+/*
+ * Turn 'motion' into the local fan-out, and put a new Motion that sends to
+ * one segment per host, in a new slice, below it.
+ */
+static void
+split_broadcast(PlannedStmt *stmt, Motion *motion, int numsegments,
+				int *segmentHosts, int plan_node_id)
+{
+	Motion	   *relay = makeNode(Motion);
+	int			sendIndex = motion->motionID;
+	int			relayIndex = stmt->numSlices;
+	PlanSlice  *relaySlice;
+	List	   *tlist = NIL;
+	ListCell   *lc;
+
+	memcpy(relay, motion, sizeof(Motion));
+	relay->plan.plan_node_id = plan_node_id;
+	/* the rows the relays receive are only a part of the result */
+	relay->plan.feedbackSignature = 0;
+	relay->hostMode = BROADCAST_HOST_RELAY;
+	relay->numHostSegments = numsegments;
+	relay->segmentHosts = segmentHosts;
+
+	/* the upper Motion passes the relay's tuples through unchanged */
+	foreach(lc, relay->plan.targetlist)
+	{
+		TargetEntry *tle = (TargetEntry *) lfirst(lc);
+		TargetEntry *newtle = flatCopyTargetEntry(tle);
+
+		newtle->expr = (Expr *) makeVarFromTargetEntry(OUTER_VAR, tle);
+		tlist = lappend(tlist, newtle);
+	}
+
+	motion->plan.lefttree = (Plan *) relay;
+	motion->plan.targetlist = tlist;
+	motion->motionID = relayIndex;
+	motion->reoptRowLimit = 0;
+	motion->hostMode = BROADCAST_HOST_LOCAL;
+	motion->numHostSegments = numsegments;
+	motion->segmentHosts = segmentHosts;
+
+	stmt->slices = repalloc(stmt->slices,
+							(stmt->numSlices + 1) * sizeof(PlanSlice));
+	stmt->numSlices++;
+
+	relaySlice = &stmt->slices[relayIndex];
+	MemSet(relaySlice, 0, sizeof(PlanSlice));
+	relaySlice->sliceIndex = relayIndex;
+	relaySlice->parentIndex = stmt->slices[sendIndex].parentIndex;
+	relaySlice->gangType = GANGTYPE_PRIMARY_READER;
+	relaySlice->numsegments = numsegments;
+	relaySlice->segindex = 0;
+
+	stmt->slices[sendIndex].parentIndex = relayIndex;
+}
+
+/*
+ * Number the hosts of the first 'numsegments' segments, and return the
+ * host number of each of them.
+ */
+static int *
+get_segment_hosts(int numsegments, int *numhosts)
+{
+	int		   *segmentHosts = palloc(numsegments * sizeof(int));
+	char	  **hostnames = palloc(numsegments * sizeof(char *));
+	int			nhosts = 0;
+
+	for (int i = 0; i < numsegments; i++)
+	{
+		CdbComponentDatabaseInfo *cdbinfo = cdbcomponent_getComponentInfo(i);
+		char	   *hostname = cdbinfo->config->hostname;
+		int			host;
+
+		for (host = 0; host < nhosts; host++)
+		{
+			if (strcmp(hostnames[host], hostname) == 0)
+				break;
+		}
+		if (host == nhosts)
+			hostnames[nhosts++] = hostname;
+
+		segmentHosts[i] = host;
+	}
+
+	pfree(hostnames);
+
+	*numhosts = nhosts;
+	return segmentHosts;
+}
+
+/*
+ * Number of hosts that run primary segments, for GPORCA's cost model.
+ */
+int
+GetSegmentHostCount(void)
+{
+	int		   *segmentHosts;
+	int			numhosts;
+
+	segmentHosts = get_segment_hosts(getgpsegmentCount(), &numhosts);
+	pfree(segmentHosts);
+
+	return numhosts;
+}
@@ -0,0 +1,823 @@
+/*-------------------------------------------------------------------------
+ *
+ * cdbinitplancache.c
+ *	  Session-local cache of dispatched InitPlan results on the QD.
+ *
+ * Dashboards tend to fire the same query, with the same small uncorrelated
+ * subqueries, every few seconds.  Every execution dispatches each InitPlan
+ * to the segments again, even though nothing it reads has changed.  When
+ * gp_enable_initplan_cache is on, preprocess_initplans() first consults
+ * this cache, and only dispatches the InitPlan on a miss.
+ *
+ * A cache entry is keyed by a fingerprint of the InitPlan: the text form of
+ * its plan tree, the relations of the range table, the current user, and
+ * the values of every parameter it depends on.  Only InitPlans that contain
+ * no volatile or stable functions are considered.
+ *
+ * Deciding whether a cached result is still valid is the hard part.  We
+ * keep a small array of per-relation modification counters in shared
+ * memory, hashed by (database, relation).  A writer increments the
+ * "started" counter of every relation it modifies when its DML starts on
+ * the QD, and the matching "finished" counter after its transaction has
+ * ended, i.e. after the commit became visible to new distributed snapshots.
+ * A relation whose two counters differ therefore has a writer in flight.
+ * A committing writer also raises the slot's "last commit" mark to the
+ * latest completed gxid, which is at least its own gxid.
+ *
+ * A distributed snapshot whose xmin is above the last commit mark of a
+ * relation sees every writer that has finished on it so far: all of them
+ * had completed when the snapshot was taken.  Other transactions in
+ * progress, which don't write the relation, don't matter.  So a result is
+ * stored if all relations read had no writer in flight, and unchanged
+ * counters, across the execution of the InitPlan, and the snapshot used
+ * sees all their finished writers.  The stored result then reflects exactly
+ * the committed state of those relations.
+ *
+ * A stored result is reused by a later query if all counters still hold
+ * the values recorded at store time, and the query's snapshot sees all the
+ * finished writers as well.  Any writer touching one of the relations since
+ * then must have bumped at least its "started" counter, so it causes a
+ * miss.  A transaction that is older than the last write of a relation
+ * holds back the xmin of new snapshots, and keeps the relation's InitPlans
+ * from being cached until it ends.
+ *
+ * Lookups and hits of the current session are counted, and shown by
+ * gp_initplan_cache_stats().
+ *
+ * Changes that do not go through the executor on the QD (e.g. TRUNCATE, or
+ * ALTER TABLE rewriting a table) send relcache invalidations, which flush
+ * the whole cache.  Hash collisions between relations only cause spurious
+ * misses.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/cdb/cdbinitplancache.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/transam.h"
+#include "access/xact.h"
+#include "catalog/partition.h"
+#include "catalog/pg_proc.h"
+#include "cdb/cdbinitplancache.h"
+#include "cdb/cdbllize.h"
+#include "cdb/cdbvars.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "optimizer/walkers.h"
+#include "parser/parsetree.h"
+#include "port/atomics.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/builtins.h"
+#include "utils/datum.h"
+#include "utils/hashutils.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+
+/* Number of modification counter slots in shared memory */
+#define INITPLAN_CACHE_SLOTS		1024
+
+/* The whole cache is flushed when it grows beyond this many entries */
+#define INITPLAN_CACHE_MAX_ENTRIES	256
+
+typedef struct InitPlanCacheShared
+{
+	pg_atomic_uint64 started[INITPLAN_CACHE_SLOTS];
+	pg_atomic_uint64 finished[INITPLAN_CACHE_SLOTS];
+	pg_atomic_uint64 lastCommit[INITPLAN_CACHE_SLOTS];	/* a gxid */
+} InitPlanCacheShared;
+
+/*
+ * Counter values of a set of slots, as read at some point in time.
+ */
+typedef struct InitPlanCacheCounters
+{
+	int			nslots;
+	int		   *slots;
+	uint64	   *started;
+	uint64	   *finished;
+} InitPlanCacheCounters;
+
+typedef struct InitPlanCacheEntry
+{
+	uint32		hashkey;		/* hash of fingerprint, must be first */
+	char	   *fingerprint;	/* full key, compared on lookup */
+	InitPlanCacheCounters counters; /* counters at the time of storing */
+	int			nparams;		/* number of setParams */
+	Datum	   *values;
+	bool	   *isnulls;
+} InitPlanCacheEntry;
+
+/*
+ * What InitPlanCacheLookup() learned on a miss, to be used by the
+ * InitPlanCacheStore() call that follows the execution of the InitPlan.
+ */
+typedef struct InitPlanCacheProbe
+{
+	SubPlanState *sps;
+	uint32		hashkey;
+	char	   *fingerprint;
+	InitPlanCacheCounters counters;
+	int16	   *typlens;		/* of the setParams */
+	bool	   *typbyvals;
+} InitPlanCacheProbe;
+
+static InitPlanCacheShared *initPlanCacheShared = NULL;
+
+static MemoryContext InitPlanCacheContext = NULL;
+static HTAB *InitPlanCacheHash = NULL;
+static InitPlanCacheProbe *currentProbe = NULL;
+
+/* Slots whose "started" counter this transaction has bumped */
+static int *pendingSlots = NULL;
+static int	numPendingSlots = 0;
+static int	maxPendingSlots = 0;
+
+/* Statistics of this session, see gp_initplan_cache_stats() */
+static int64 initPlanCacheLookups = 0;
+static int64 initPlanCacheHits = 0;
+
+static bool initplan_cache_eligible(QueryDesc *queryDesc, SubPlanState *sps);
+static bool initplan_cache_mutable_checker(Oid func_id, void *context);
+static bool initplan_cache_mutable_walker(Node *node, void *context);
+static char *initplan_cache_fingerprint(QueryDesc *queryDesc, SubPlanState *sps,
+										List **relids);
+static void append_datum_image(StringInfo buf, Oid typid, Datum value, bool isnull);
+static void read_counters(InitPlanCacheCounters *counters);
+static bool counters_equal(InitPlanCacheCounters *a, InitPlanCacheCounters *b);
+static bool counters_quiescent(InitPlanCacheCounters *counters);
+static bool snapshot_sees_writers(QueryDesc *queryDesc,
+								  InitPlanCacheCounters *counters);
+static int	relation_slot(Oid relid);
+static void initplan_cache_reset(void);
+static void initplan_cache_inval_callback(Datum arg, Oid relid);
+static void initplan_cache_xact_callback(XactEvent event, void *arg);
+
+Size
+InitPlanCacheShmemSize(void)
+{
+	return sizeof(InitPlanCacheShared);
+}
+
+void
+InitPlanCacheShmemInit(void)
+{
+	bool		found;
+	int			i;
+
+	initPlanCacheShared = (InitPlanCacheShared *)
+		ShmemInitStruct("InitPlan Cache Counters", InitPlanCacheShmemSize(), &found);
+
+	if (!found)
+	{
+		for (i = 0; i < INITPLAN_CACHE_SLOTS; i++)
+		{
+			pg_atomic_init_u64(&initPlanCacheShared->started[i], 0);
+			pg_atomic_init_u64(&initPlanCacheShared->finished[i], 0);
+			pg_atomic_init_u64(&initPlanCacheShared->lastCommit[i], 0);
+		}
+	}
+}
+
+/*
+ * Record that the given statement is about to modify its result relations.
+ *
+ * Called from ExecutorStart() on the QD for every statement, whether or not
+ * the cache is enabled in this session, because other sessions may have it
+ * enabled.
+ */
+void
+InitPlanCacheNoteWrites(PlannedStmt *stmt)
+{
+	ListCell   *lc;
+
+	if (Gp_role != GP_ROLE_DISPATCH)
+		return;
+
+	/* Also covers data-modifying CTEs in a SELECT */
+
+	foreach(lc, stmt->resultRelations)
+	{
+		RangeTblEntry *rte = rt_fetch(lfirst_int(lc), stmt->rtable);
+
+		InitPlanCacheNoteRelationWrite(rte->relid);
+	}
+}
+
+/*
+ * Record that the current transaction is about to modify 'relid'.
+ *
+ * The partition ancestors are bumped as well, so that an InitPlan reading
+ * the parent notices writes that went directly into a leaf.
+ */
+void
+InitPlanCacheNoteRelationWrite(Oid relid)
+{
+	List	   *relids;
+	ListCell   *lc;
+
+	if (initPlanCacheShared == NULL || !OidIsValid(relid))
+		return;
+
+	relids = list_make1_oid(relid);
+	if (get_rel_relispartition(relid))
+		relids = list_concat(relids, get_partition_ancestors(relid));
+
+	foreach(lc, relids)
+	{
+		int			slot = relation_slot(lfirst_oid(lc));
+		int			i;
+
+		/*
+		 * A transaction that is already in flight on this slot doesn't need
+		 * to bump it again; every statement of a long transaction would
+		 * otherwise add an entry.
+		 */
+		for (i = 0; i < numPendingSlots; i++)
+		{
+			if (pendingSlots[i] == slot)
+				break;
+		}
+		if (i < numPendingSlots)
+			continue;
+
+		if (numPendingSlots >= maxPendingSlots)
+		{
+			if (pendingSlots == NULL)
+			{
+				maxPendingSlots = 16;
+				pendingSlots = MemoryContextAlloc(TopMemoryContext,
+												  maxPendingSlots * sizeof(int));
+			}
+			else
+			{
+				maxPendingSlots *= 2;
+				pendingSlots = repalloc(pendingSlots,
+										maxPendingSlots * sizeof(int));
+			}
+		}
+
+		if (numPendingSlots == 0)
+			RegisterXactCallbackOnce(initplan_cache_xact_callback, NULL);
+
+		/*
+		 * Remember the slot before bumping it, so that we never leave a
+		 * "started" bump without its matching "finished" bump.
+		 */
+		pendingSlots[numPendingSlots++] = slot;
+		pg_atomic_fetch_add_u64(&initPlanCacheShared->started[slot], 1);
+	}
+
+	list_free(relids);
+}
+
+/*
+ * At the end of the transaction, the writes are either visible to everyone
+ * or rolled back.  Either way, mark the writers as no longer in flight.
+ *
+ * On commit, our gxid has completed by now, so the latest completed gxid is
+ * at least as high as it.  Raise the last commit marks before bumping the
+ * "finished" counters, so that whoever sees the latter also sees the former.
+ */
+static void
+initplan_cache_xact_callback(XactEvent event, void *arg)
+{
+	DistributedTransactionId latestCompletedGxid;
+	int			i;
+
+	if (event == XACT_EVENT_COMMIT && numPendingSlots > 0)
+	{
+		LWLockAcquire(ProcArrayLock, LW_SHARED);
+		latestCompletedGxid = ShmemVariableCache->latestCompletedGxid;
+		LWLockRelease(ProcArrayLock);
+
+		for (i = 0; i < numPendingSlots; i++)
+		{
+			pg_atomic_uint64 *mark = &initPlanCacheShared->lastCommit[pendingSlots[i]];
+			uint64		old = pg_atomic_read_u64(mark);
+
+			while (old < latestCompletedGxid &&
+				   !pg_atomic_compare_exchange_u64(mark, &old, latestCompletedGxid))
+				;
+		}
+	}
+
+	for (i = 0; i < numPendingSlots; i++)
+		pg_atomic_fetch_add_u64(&initPlanCacheShared->finished[pendingSlots[i]], 1);
+
+	numPendingSlots = 0;
+}
+
+/*
+ * Try to satisfy an InitPlan from the cache.
+ *
+ * On a hit, the setParam values are filled in just like ExecSetParamPlan()
+ * would, and true is returned.  On a miss, remember what we know about the
+ * InitPlan for the following InitPlanCacheStore() call, and return false.
+ */
+bool
+InitPlanCacheLookup(QueryDesc *queryDesc, SubPlanState *sps)
+{
+	EState	   *estate = queryDesc->estate;
+	SubPlan    *subplan = sps->subplan;
+	MemoryContext oldcontext;
+	InitPlanCacheProbe *probe;
+	InitPlanCacheEntry *entry;
+	List	   *relids;
+	ListCell   *lc;
+	int			i;
+
+	currentProbe = NULL;
+
+	if (!initplan_cache_eligible(queryDesc, sps))
+		return false;
+
+	oldcontext = MemoryContextSwitchTo(estate->es_query_cxt);
+
+	probe = palloc0(sizeof(InitPlanCacheProbe));
+	probe->sps = sps;
+	probe->fingerprint = initplan_cache_fingerprint(queryDesc, sps, &relids);
+	probe->hashkey = DatumGetUInt32(hash_any((unsigned char *) probe->fingerprint,
+											 strlen(probe->fingerprint)));
+
+	probe->counters.nslots = list_length(relids);
+	probe->counters.slots = palloc(probe->counters.nslots * sizeof(int));
+	probe->counters.started = palloc(probe->counters.nslots * sizeof(uint64));
+	probe->counters.finished = palloc(probe->counters.nslots * sizeof(uint64));
+	i = 0;
+	foreach(lc, relids)
+		probe->counters.slots[i++] = relation_slot(lfirst_oid(lc));
+	read_counters(&probe->counters);
+
+	/*
+	 * Look up the setParam types now.  A syscache lookup may process
+	 * invalidations, which flush the cache, so none may happen while we hold
+	 * a pointer to an entry.
+	 */
+	probe->typlens = palloc(list_length(subplan->setParam) * sizeof(int16));
+	probe->typbyvals = palloc(list_length(subplan->setParam) * sizeof(bool));
+	i = 0;
+	foreach(lc, subplan->setParam)
+	{
+		Oid			typid = list_nth_oid(queryDesc->plannedstmt->paramExecTypes,
+										 lfirst_int(lc));
+
+		get_typlenbyval(typid, &probe->typlens[i], &probe->typbyvals[i]);
+		i++;
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+
+	currentProbe = probe;
+	initPlanCacheLookups++;
+
+	if (InitPlanCacheHash == NULL)
+		return false;
+
+	entry = (InitPlanCacheEntry *) hash_search(InitPlanCacheHash,
+											   &probe->hashkey,
+											   HASH_FIND, NULL);
+	if (entry == NULL || strcmp(entry->fingerprint, probe->fingerprint) != 0)
+		return false;
+
+	/*
+	 * Nothing may have been written to the relations since the result was
+	 * stored, and our snapshot must see everything that was written before.
+	 */
+	if (!counters_equal(&entry->counters, &probe->counters))
+		return false;
+	if (!snapshot_sees_writers(queryDesc, &probe->counters))
+		return false;
+
+	Assert(entry->nparams == list_length(subplan->setParam));
+	oldcontext = MemoryContextSwitchTo(estate->es_query_cxt);
+	i = 0;
+	foreach(lc, subplan->setParam)
+	{
+		ParamExecData *prm = &estate->es_param_exec_vals[lfirst_int(lc)];
+
+		prm->execPlan = NULL;
+		prm->isnull = entry->isnulls[i];
+		if (prm->isnull)
+			prm->value = (Datum) 0;
+		else
+			prm->value = datumCopy(entry->values[i],
+								   probe->typbyvals[i], probe->typlens[i]);
+		i++;
+	}
+	MemoryContextSwitchTo(oldcontext);
+
+	currentProbe = NULL;
+	initPlanCacheHits++;
+
+	elog(DEBUG1, "InitPlan %d (%s) result served from initplan cache",
+		 subplan->plan_id, subplan->plan_name);
+
+	return true;
+}
+
+/*
+ * Remember the result of an InitPlan that just ran, if it is safe to do so.
+ */
+void
+InitPlanCacheStore(QueryDesc *queryDesc, SubPlanState *sps)
+{
+	EState	   *estate = queryDesc->estate;
+	SubPlan    *subplan = sps->subplan;
+	InitPlanCacheProbe *probe = currentProbe;
+	InitPlanCacheCounters after;
+	InitPlanCacheEntry *entry;
+	MemoryContext oldcontext;
+	ListCell   *lc;
+	bool		found;
+	int			i;
+
+	currentProbe = NULL;
+
+	if (probe == NULL || probe->sps != sps)
+		return;
+
+	/*
+	 * No writer may have been in flight while the InitPlan ran, and the
+	 * snapshot must have seen all that finished before.
+	 */
+	after.nslots = probe->counters.nslots;
+	after.slots = probe->counters.slots;
+	after.started = palloc(after.nslots * sizeof(uint64));
+	after.finished = palloc(after.nslots * sizeof(uint64));
+	read_counters(&after);
+
+	if (!counters_quiescent(&probe->counters) ||
+		!counters_equal(&probe->counters, &after))
+		return;
+	if (!snapshot_sees_writers(queryDesc, &after))
+		return;
+
+	if (InitPlanCacheContext == NULL)
+	{
+		InitPlanCacheContext = AllocSetContextCreate(TopMemoryContext,
+													 "InitPlan Cache",
+													 ALLOCSET_DEFAULT_SIZES);
+		CacheRegisterRelcacheCallback(initplan_cache_inval_callback, (Datum) 0);
+	}
+
+	if (InitPlanCacheHash == NULL ||
+		hash_get_num_entries(InitPlanCacheHash) >= INITPLAN_CACHE_MAX_ENTRIES)
+	{
+		HASHCTL		ctl;
+
+		initplan_cache_reset();
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(uint32);
+		ctl.entrysize = sizeof(InitPlanCacheEntry);
+		ctl.hcxt = InitPlanCacheContext;
+		InitPlanCacheHash = hash_create("InitPlan Cache",
+										INITPLAN_CACHE_MAX_ENTRIES,
+										&ctl,
+										HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	entry = (InitPlanCacheEntry *) hash_search(InitPlanCacheHash,
+											   &probe->hashkey,
+											   HASH_ENTER, &found);
+	if (found)
+	{
+		/* Same hash but different fingerprint: replace the old entry */
+		pfree(entry->fingerprint);
+		pfree(entry->counters.slots);
+		pfree(entry->counters.started);
+		pfree(entry->counters.finished);
+		pfree(entry->values);
+		pfree(entry->isnulls);
+	}
+
+	oldcontext = MemoryContextSwitchTo(InitPlanCacheContext);
+
+	entry->fingerprint = pstrdup(probe->fingerprint);
+	entry->counters.nslots = probe->counters.nslots;
+	entry->counters.slots = palloc(after.nslots * sizeof(int));
+	entry->counters.started = palloc(after.nslots * sizeof(uint64));
+	entry->counters.finished = palloc(after.nslots * sizeof(uint64));
+	memcpy(entry->counters.slots, after.slots, after.nslots * sizeof(int));
+	memcpy(entry->counters.started, after.started, after.nslots * sizeof(uint64));
+	memcpy(entry->counters.finished, after.finished, after.nslots * sizeof(uint64));
+
+	entry->nparams = list_length(subplan->setParam);
+	entry->values = palloc0(entry->nparams * sizeof(Datum));
+	entry->isnulls = palloc0(entry->nparams * sizeof(bool));
+	i = 0;
+	foreach(lc, subplan->setParam)
+	{
+		ParamExecData *prm = &estate->es_param_exec_vals[lfirst_int(lc)];
+
+		Assert(prm->execPlan == NULL);
+		entry->isnulls[i] = prm->isnull;
+		if (!prm->isnull)
+			entry->values[i] = datumCopy(prm->value,
+										 probe->typbyvals[i], probe->typlens[i]);
+		i++;
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+}
+
+/*
+ * Can the result of this InitPlan be cached at all?
+ */
+static bool
+initplan_cache_eligible(QueryDesc *queryDesc, SubPlanState *sps)
+{
+	SubPlan    *subplan = sps->subplan;
+	plan_tree_base_prefix base;
+
+	if (!gp_enable_initplan_cache || Gp_role != GP_ROLE_DISPATCH)
+		return false;
+
+	/* EXPLAIN ANALYZE wants to see the InitPlan being executed */
+	if (queryDesc->instrument_options)
+		return false;
+
+	switch (subplan->subLinkType)
+	{
+		case EXISTS_SUBLINK:
+		case NOT_EXISTS_SUBLINK:
+		case EXPR_SUBLINK:
+		case ROWCOMPARE_SUBLINK:
+		case ARRAY_SUBLINK:
+			break;
+		default:
+			return false;
+	}
+
+	if (subplan->parParam != NIL)
+		return false;
+
+	/* Our own uncommitted changes are invisible to other sessions */
+	if (numPendingSlots > 0 || TransactionIdIsValid(GetTopTransactionIdIfAny()))
+		return false;
+
+	/* Parameters fetched through a hook cannot be fingerprinted */
+	if (queryDesc->params && queryDesc->params->paramFetch != NULL)
+		return false;
+
+	exec_init_plan_tree_base(&base, queryDesc->plannedstmt);
+	if (initplan_cache_mutable_walker((Node *) sps->planstate->plan, &base))
+		return false;
+
+	return true;
+}
+
+static bool
+initplan_cache_mutable_checker(Oid func_id, void *context)
+{
+	return (func_volatile(func_id) != PROVOLATILE_IMMUTABLE);
+}
+
+static bool
+initplan_cache_mutable_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, SQLValueFunction) || IsA(node, NextValueExpr))
+		return true;
+
+	if (check_functions_in_node(node, initplan_cache_mutable_checker, context))
+		return true;
+
+	return plan_tree_walker(node, initplan_cache_mutable_walker, context, true);
+}
+
+/*
+ * Build the fingerprint of an InitPlan, and collect the OIDs of the
+ * relations whose modification counters guard its result.
+ */
+static char *
+initplan_cache_fingerprint(QueryDesc *queryDesc, SubPlanState *sps, List **relids)
+{
+	PlannedStmt *stmt = queryDesc->plannedstmt;
+	EState	   *estate = queryDesc->estate;
+	ParamListInfo params = queryDesc->params;
+	StringInfoData buf;
+	ListCell   *lc;
+	int			paramid;
+
+	initStringInfo(&buf);
+	appendStringInfo(&buf, "%u %u %d ",
+					 MyDatabaseId, GetUserId(), sps->subplan->subLinkType);
+	appendStringInfoString(&buf, nodeToString(sps->planstate->plan));
+
+	/* The plan refers to relations by their range table index */
+	*relids = NIL;
+	appendStringInfoString(&buf, " :rtable");
+	foreach(lc, stmt->rtable)
+	{
+		RangeTblEntry *rte = (RangeTblEntry *) lfirst(lc);
+
+		if (rte->rtekind != RTE_RELATION)
+		{
+			appendStringInfoString(&buf, " -");
+			continue;
+		}
+
+		appendStringInfo(&buf, " %u", rte->relid);
+		*relids = lappend_oid(*relids, rte->relid);
+		if (get_rel_relispartition(rte->relid))
+			*relids = list_concat(*relids, get_partition_ancestors(rte->relid));
+	}
+
+	/* Values of earlier InitPlans this one depends on */
+	appendStringInfoString(&buf, " :execparams");
+	paramid = -1;
+	while ((paramid = bms_next_member(sps->planstate->plan->extParam, paramid)) >= 0)
+	{
+		ParamExecData *prm = &estate->es_param_exec_vals[paramid];
+
+		appendStringInfo(&buf, " %d", paramid);
+		append_datum_image(&buf, list_nth_oid(stmt->paramExecTypes, paramid),
+						   prm->value, prm->isnull);
+	}
+
+	/* Bound parameters of a prepared statement */
+	if (params)
+	{
+		int			i;
+
+		appendStringInfoString(&buf, " :externparams");
+		for (i = 0; i < params->numParams; i++)
+			append_datum_image(&buf, params->params[i].ptype,
+							   params->params[i].value,
+							   params->params[i].isnull);
+	}
+
+	return buf.data;
+}
+
+static void
+append_datum_image(StringInfo buf, Oid typid, Datum value, bool isnull)
+{
+	int16		typlen;
+	bool		typbyval;
+	Size		len;
+	const unsigned char *p;
+	Size		i;
+
+	appendStringInfo(buf, " %u:", typid);
+	if (isnull || !OidIsValid(typid))
+	{
+		appendStringInfoString(buf, "null");
+		return;
+	}
+
+	get_typlenbyval(typid, &typlen, &typbyval);
+	if (typbyval)
+	{
+		appendStringInfo(buf, UINT64_FORMAT, (uint64) value);
+		return;
+	}
+
+	len = datumGetSize(value, typbyval, typlen);
+	p = (const unsigned char *) DatumGetPointer(value);
+	for (i = 0; i < len; i++)
+		appendStringInfo(buf, "%02x", p[i]);
+}
+
+static int
+relation_slot(Oid relid)
+{
+	return hash_combine(murmurhash32(MyDatabaseId), murmurhash32(relid)) %
+		INITPLAN_CACHE_SLOTS;
+}
+
+static void
+read_counters(InitPlanCacheCounters *counters)
+{
+	int			i;
+
+	/*
+	 * Read "finished" before "started": a writer bumps them in the opposite
+	 * order, so a writer in flight is never mistaken for a finished one.
+	 */
+	for (i = 0; i < counters->nslots; i++)
+		counters->finished[i] =
+			pg_atomic_read_u64(&initPlanCacheShared->finished[counters->slots[i]]);
+	pg_read_barrier();
+	for (i = 0; i < counters->nslots; i++)
+		counters->started[i] =
+			pg_atomic_read_u64(&initPlanCacheShared->started[counters->slots[i]]);
+}
+
+static bool
+counters_equal(InitPlanCacheCounters *a, InitPlanCacheCounters *b)
+{
+	int			i;
+
+	if (a->nslots != b->nslots)
+		return false;
+
+	for (i = 0; i < a->nslots; i++)
+	{
+		if (a->slots[i] != b->slots[i] ||
+			a->started[i] != b->started[i] ||
+			a->finished[i] != b->finished[i])
+			return false;
+	}
+	return true;
+}
+
+static bool
+counters_quiescent(InitPlanCacheCounters *counters)
+{
+	int			i;
+
+	for (i = 0; i < counters->nslots; i++)
+	{
+		if (counters->started[i] != counters->finished[i])
+			return false;
+	}
+	return true;
+}
+
+/*
+ * Does the distributed snapshot of the query see every writer that had
+ * finished on these slots when their counters were read?
+ */
+static bool
+snapshot_sees_writers(QueryDesc *queryDesc, InitPlanCacheCounters *counters)
+{
+	Snapshot	snapshot = queryDesc->estate->es_snapshot;
+	DistributedSnapshot *ds;
+	int			i;
+
+	if (snapshot == NULL || !snapshot->haveDistribSnapshot)
+		return false;
+
+	ds = &snapshot->distribSnapshotWithLocalMapping.ds;
+
+	/* pairs with the barrier of raising the mark, then bumping "finished" */
+	pg_read_barrier();
+	for (i = 0; i < counters->nslots; i++)
+	{
+		uint64		mark;
+
+		mark = pg_atomic_read_u64(&initPlanCacheShared->lastCommit[counters->slots[i]]);
+		if (mark >= ds->xmin)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * gp_initplan_cache_stats
+ *	  Number of cacheable InitPlans looked up in the cache by this session,
+ *	  and how many of them were served from it.
+ */
+Datum
+gp_initplan_cache_stats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Datum		values[2];
+	bool		nulls[2];
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	MemSet(nulls, false, sizeof(nulls));
+	values[0] = Int64GetDatum(initPlanCacheLookups);
+	values[1] = Int64GetDatum(initPlanCacheHits);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(BlessTupleDesc(tupdesc),
+													  values, nulls)));
+}
+
+static void
+initplan_cache_reset(void)
+{
+	if (InitPlanCacheHash != NULL)
+	{
+		hash_destroy(InitPlanCacheHash);
+		InitPlanCacheHash = NULL;
+	}
+	if (InitPlanCacheContext != NULL)
+		MemoryContextReset(InitPlanCacheContext);
+}
+
+/*
+ * DDL, TRUNCATE and friends invalidate the relcache.  Rather than tracking
+ * which entries depend on which relation, simply forget everything.
+ */
+static void
+initplan_cache_inval_callback(Datum arg, Oid relid)
+{
+	initplan_cache_reset();
+}
@@ -1302,7 +1302,8 @@ build_slice_table_walker(Node *node, build_slice_table_context *context)
 		context->currentSliceIndex = sendSlice->sliceIndex;
 
 		if (sendSlice->directDispatch.isDirectDispatch &&
-			sendSlice->directDispatch.contentIds == NIL)
+			sendSlice->directDispatch.contentIds == NIL &&
+			sendSlice->directDispatch.paramKeys == NIL)
 		{
 			/*
 			 * Direct dispatch, but we've already determined that there will
@@ -1476,6 +1477,7 @@ motion_sanity_walker(Node *node, sanity_result_t *result)
 		case T_Limit:
 		case T_Sort:
 		case T_Material:
+		case T_Memoize:
 		case T_ForeignScan:
 			if (plan_tree_walker(node, motion_sanity_walker, result, true))
 				return true;
@@ -62,6 +62,8 @@ typedef struct
 static Node *pre_dispatch_function_evaluation_mutator(Node *node,
 										 pre_dispatch_function_evaluation_context *context);
 static bool replace_shareinput_targetlists_walker(Node *node, PlannerInfo *root, bool fPop);
+static bool pre_dispatch_function_evaluation_needed_walker(Node *node,
+										 plan_tree_base_prefix *context);
 
 
 Motion *
@@ -1443,6 +1445,55 @@ exec_make_plan_constant(struct PlannedStmt *stmt, EState *estate, bool is_SRI,
 	return result;
 }
 
+/*
+ * Would exec_make_plan_constant() change anything in the given plan?
+ *
+ * If not, the plan tree can be dispatched as it is, and its serialized form
+ * stays the same from one execution to the next.  This errs on the safe side:
+ * any function call with only constant arguments counts, whether or not the
+ * mutator would actually be able to evaluate it.
+ */
+bool
+exec_plan_needs_constant_folding(struct PlannedStmt *stmt)
+{
+	plan_tree_base_prefix base;
+
+	Assert(stmt);
+	exec_init_plan_tree_base(&base, stmt);
+
+	return pre_dispatch_function_evaluation_needed_walker((Node *) stmt->planTree, &base);
+}
+
+static bool
+pre_dispatch_function_evaluation_needed_walker(Node *node,
+											   plan_tree_base_prefix *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, FuncExpr))
+	{
+		ListCell   *arg;
+
+		foreach(arg, ((FuncExpr *) node)->args)
+		{
+			if (!IsA(lfirst(arg), Const))
+				break;
+		}
+
+		/* all arguments are constants, so it would be evaluated */
+		if (arg == NULL)
+			return true;
+	}
+	else if (IsA(node, CurrentOfExpr))
+		return true;
+
+	return plan_tree_walker(node,
+							pre_dispatch_function_evaluation_needed_walker,
+							(void *) context,
+							true);
+}
+
 /*
  * Remove subquery field in RTE's with subquery kind.
  */
@@ -1764,6 +1815,36 @@ pre_dispatch_function_evaluation_mutator(Node *node,
 	return new_node;
 }
 
+/*
+ * Is 'path' a scan of a multi-row VALUES list, possibly under a projection,
+ * that each writer segment can evaluate on its own?  Only short lists of
+ * immutable expressions qualify, since every target segment scans the whole
+ * list.
+ */
+static bool
+is_sri_values_path(PlannerInfo *root, Path *path)
+{
+	RangeTblEntry *rte;
+
+	if (IsA(path, ProjectionPath))
+		path = ((ProjectionPath *) path)->subpath;
+
+	if (path->pathtype != T_ValuesScan || !CdbPathLocus_IsGeneral(path->locus))
+		return false;
+
+	rte = planner_rt_fetch(path->parent->relid, root);
+	Assert(rte->rtekind == RTE_VALUES);
+
+	if (list_length(rte->values_lists) > gp_direct_dispatch_max_values)
+		return false;
+
+	if (contain_mutable_functions((Node *) rte->values_lists) ||
+		contain_subplans((Node *) rte->values_lists))
+		return false;
+
+	return true;
+}
+
 /*
  * cdbpathtoplan_create_sri_path
  *
@@ -1773,6 +1854,10 @@ pre_dispatch_function_evaluation_mutator(Node *node,
  * In addition, we don't need tuple distribution, but do filter on each writer
  * segment.
  *
+ * A short multi-row VALUES list of constants is handled the same way: every
+ * writer segment scans the VALUES list and keeps only its own rows, and the
+ * insert is dispatched only to the segments that some row hashes to.
+ *
  * Inputs:
  *
  * root		PlannerInfo passed by caller
@@ -1792,6 +1877,7 @@ cdbpathtoplan_create_sri_plan(RangeTblEntry *rte, PlannerInfo *subroot, Path *su
 {
 	CdbMotionPath *motionpath;
 	Path	   *resultpath;
+	Plan	   *subplan;
 	Result	   *resultplan;
 	Relation	rel;
 	GpPolicy   *targetPolicy;
@@ -1819,6 +1905,10 @@ cdbpathtoplan_create_sri_plan(RangeTblEntry *rte, PlannerInfo *subroot, Path *su
 	{
 		/* ProjectionPath with a GroupResultPath beneath is also ok. */
 	}
+	else if (is_sri_values_path(subroot, motionpath->subpath))
+	{
+		/* A short, constant VALUES list is also ok. */
+	}
 	else
 		return NULL;
 
@@ -1827,8 +1917,20 @@ cdbpathtoplan_create_sri_plan(RangeTblEntry *rte, PlannerInfo *subroot, Path *su
 	if (contain_mutable_functions((Node *) resultpath->pathtarget->exprs))
 		return NULL;
 
-	resultplan = (Result *) create_plan_recurse(subroot, resultpath, createplan_flags);
-	if (!IsA(resultplan, Result))
+	subplan = create_plan_recurse(subroot, resultpath, createplan_flags);
+	if (IsA(subplan, ValuesScan))
+	{
+		/* Put a Result on top of the VALUES scan, to do the filtering. */
+		resultplan = make_result(copyObject(subplan->targetlist), NULL, subplan);
+		resultplan->plan.startup_cost = subplan->startup_cost;
+		resultplan->plan.total_cost = subplan->total_cost;
+		resultplan->plan.plan_rows = subplan->plan_rows;
+		resultplan->plan.plan_width = subplan->plan_width;
+		resultplan->plan.flow = subplan->flow;
+	}
+	else if (IsA(subplan, Result))
+		resultplan = (Result *) subplan;
+	else
 	{
 		/* A GroupResultPath really should produce a Result node. */
 		Assert(false);
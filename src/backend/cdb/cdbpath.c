@@ -19,6 +19,7 @@
 #include "catalog/pg_amop.h"
 #include "catalog/pg_opclass.h"
 #include "catalog/pg_operator.h"
+#include "catalog/pg_statistic.h"
 #include "catalog/pg_trigger.h"
 #include "commands/trigger.h"
 #include "nodes/makefuncs.h"	/* makeFuncExpr() */
@@ -34,8 +35,10 @@
 #include "parser/parse_expr.h"	/* exprType() */
 #include "parser/parse_oper.h"
 #include "utils/catcache.h"
+#include "utils/datum.h"
 #include "utils/guc.h"
 #include "utils/lsyscache.h"
+#include "utils/selfuncs.h"
 #include "utils/syscache.h"
 
 #include "cdb/cdbdef.h"			/* CdbSwap() */
@@ -55,8 +58,21 @@ typedef struct
 	bool		ok_to_replicate;
 	bool		require_existing_order;
 	bool		has_wts;		/* Does the rel have WorkTableScan? */
+
+	/* Skew-resilient redistribution, see cdbpath_find_skew_values() */
+	List	   *skew_values;	/* heavy-hitter join key values */
+	bool		skew_broadcast; /* broadcast them, rather than spread */
+	double		skew_fraction;	/* estimated fraction of rows broadcast */
 } CdbpathMfjRel;
 
+/*
+ * Skew-resilient redistribution.  A join key value is a heavy hitter if its
+ * MCV frequency in the larger input is at least CDBPATH_SKEW_MIN_SHARE of a
+ * segment's fair share of the rows.
+ */
+#define CDBPATH_SKEW_MAX_VALUES		8
+#define CDBPATH_SKEW_MIN_SHARE		0.5
+
 static bool try_redistribute(PlannerInfo *root, CdbpathMfjRel *g,
 							 CdbpathMfjRel *o, List *redistribution_clauses);
 
@@ -120,6 +136,10 @@ cdbpath_cost_motion(PlannerInfo *root, CdbMotionPath *motionpath)
 		total_rows = motionpath->path.parent->rows;
 	}
 
+	/* Heavy-hitter rows broadcast by a skew-resilient Redistribute Motion */
+	if (motionpath->skewBroadcast)
+		total_rows += total_rows * motionpath->skewFraction * (recv_segments - 1);
+
 	motionpath->path.rows = clamp_row_est(total_rows / recv_segments);
 
 	cost_per_row = (gp_motion_cost_per_row > 0.0)
@@ -1231,6 +1251,199 @@ add_rowid_to_path(PlannerInfo *root, Path *path, int *rowidexpr_id)
 													  NIL, true);
 }
 
+/*
+ * Returns the expression a rel is to be redistributed on, if it is being
+ * moved to a locus hashed on a single key; else NULL.
+ */
+static Expr *
+cdbpath_skew_key_expr(CdbpathMfjRel *rel)
+{
+	List	   *exprs;
+	List	   *opfamilies;
+
+	if (!CdbPathLocus_IsHashed(rel->move_to) ||
+		list_length(rel->move_to.distkey) != 1)
+		return NULL;
+
+	cdbpathlocus_get_distkey_exprs(rel->move_to,
+								   rel->path->parent->relids,
+								   rel->path->pathtarget->exprs,
+								   &exprs, &opfamilies);
+	if (exprs == NIL)
+		return NULL;
+
+	return (Expr *) linitial(exprs);
+}
+
+/*
+ * Estimate the fraction of the rows of 'expr' that are equal to 'value':
+ * its MCV frequency if it is in the MCV list, otherwise assume the values
+ * not in the list are evenly distributed.
+ */
+static double
+cdbpath_value_frequency(PlannerInfo *root, Expr *expr, Datum value,
+						int16 typlen, bool typbyval)
+{
+	VariableStatData vardata;
+	AttStatsSlot sslot;
+	double		ndistinct;
+	double		freq;
+	bool		isdefault;
+
+	examine_variable(root, (Node *) expr, 0, &vardata);
+	ndistinct = get_variable_numdistinct(&vardata, &isdefault);
+	freq = 1.0 / Max(ndistinct, 1.0);
+
+	if (HeapTupleIsValid(vardata.statsTuple) &&
+		get_attstatsslot(&sslot, vardata.statsTuple,
+						 STATISTIC_KIND_MCV, InvalidOid,
+						 ATTSTATSSLOT_VALUES | ATTSTATSSLOT_NUMBERS))
+	{
+		Form_pg_statistic stats;
+		double		sumcommon = 0;
+		int			i;
+
+		stats = (Form_pg_statistic) GETSTRUCT(vardata.statsTuple);
+		for (i = 0; i < sslot.nvalues; i++)
+		{
+			if (datumIsEqual(sslot.values[i], value, typbyval, typlen))
+				break;
+			sumcommon += sslot.numbers[i];
+		}
+		if (i < sslot.nvalues)
+			freq = sslot.numbers[i];
+		else if (ndistinct > sslot.nvalues)
+			freq = Max(1.0 - sumcommon - stats->stanullfrac, 0.0) /
+				(ndistinct - sslot.nvalues);
+
+		free_attstatsslot(&sslot);
+	}
+	ReleaseVariableStats(vardata);
+
+	return freq;
+}
+
+/*
+ * cdbpath_find_skew_values
+ *
+ * When both inputs of a join are redistributed on a single join key, all
+ * rows with a very frequent key value land on the same segment, which then
+ * does most of the work.  Instead, the rows of the larger input with such
+ * heavy-hitter values can be spread round-robin over all segments, while
+ * the rows of the smaller input with the same values are broadcast, so that
+ * each of them still meets all of its join partners.  Rows with any other
+ * value are hashed as usual.
+ *
+ * Returns the heavy-hitter values of the larger rel's MCV list as Consts,
+ * or NIL if there are none or broadcasting their share of the smaller rel
+ * would cost more than the skew it avoids.  *small_fraction is set to the
+ * estimated fraction of the smaller rel that is broadcast.
+ */
+static List *
+cdbpath_find_skew_values(PlannerInfo *root,
+						 CdbpathMfjRel *large_rel,
+						 CdbpathMfjRel *small_rel,
+						 double *small_fraction)
+{
+	Expr	   *large_expr;
+	Expr	   *small_expr;
+	Oid			typid;
+	int16		typlen;
+	bool		typbyval;
+	int			numsegments;
+	VariableStatData vardata;
+	AttStatsSlot sslot;
+	List	   *values = NIL;
+	ListCell   *lc;
+	double		large_frac = 0;
+	double		small_frac = 0;
+
+	*small_fraction = 0;
+
+	/* Broadcasting the smaller rel's rows must not duplicate join output */
+	if (!gp_enable_skew_join || !small_rel->ok_to_replicate)
+		return NIL;
+
+	numsegments = CdbPathLocus_NumSegments(large_rel->move_to);
+	if (numsegments <= 1)
+		return NIL;
+
+	large_expr = cdbpath_skew_key_expr(large_rel);
+	small_expr = cdbpath_skew_key_expr(small_rel);
+	if (large_expr == NULL || small_expr == NULL)
+		return NIL;
+
+	/* Both Motions must hash the heavy-hitter values with the same function */
+	typid = exprType((Node *) large_expr);
+	if (exprType((Node *) small_expr) != typid)
+		return NIL;
+	get_typlenbyval(typid, &typlen, &typbyval);
+
+	examine_variable(root, (Node *) large_expr, 0, &vardata);
+	if (HeapTupleIsValid(vardata.statsTuple) &&
+		get_attstatsslot(&sslot, vardata.statsTuple,
+						 STATISTIC_KIND_MCV, InvalidOid,
+						 ATTSTATSSLOT_VALUES | ATTSTATSSLOT_NUMBERS))
+	{
+		/* MCVs are sorted by decreasing frequency */
+		for (int i = 0; sslot.valuetype == typid && i < sslot.nvalues; i++)
+		{
+			if (sslot.numbers[i] * numsegments < CDBPATH_SKEW_MIN_SHARE ||
+				list_length(values) >= CDBPATH_SKEW_MAX_VALUES)
+				break;
+
+			values = lappend(values,
+							 makeConst(typid,
+									   exprTypmod((Node *) large_expr),
+									   exprCollation((Node *) large_expr),
+									   typlen,
+									   datumCopy(sslot.values[i], typbyval, typlen),
+									   false,
+									   typbyval));
+			large_frac += sslot.numbers[i];
+		}
+		free_attstatsslot(&sslot);
+	}
+	ReleaseVariableStats(vardata);
+
+	if (values == NIL)
+		return NIL;
+
+	foreach(lc, values)
+		small_frac += cdbpath_value_frequency(root, small_expr,
+											  lfirst_node(Const, lc)->constvalue,
+											  typlen, typbyval);
+	small_frac = Min(small_frac, 1.0);
+
+	/*
+	 * Spreading moves about large_frac * (numsegments - 1) / numsegments of
+	 * the larger rel off the busiest segment, while broadcasting sends
+	 * small_frac * (numsegments - 1) more of the smaller rel.
+	 */
+	if (large_rel->bytes * large_frac <= small_rel->bytes * small_frac * numsegments)
+	{
+		list_free_deep(values);
+		return NIL;
+	}
+
+	*small_fraction = small_frac;
+	return values;
+}
+
+/*
+ * Mark a Redistribute Motion created for a skew-resilient join, and cost
+ * it again to account for the broadcast rows.
+ */
+static void
+cdbpath_set_skew(PlannerInfo *root, CdbMotionPath *motionpath, CdbpathMfjRel *rel)
+{
+	motionpath->skewValues = rel->skew_values;
+	motionpath->skewBroadcast = rel->skew_broadcast;
+	motionpath->skewFraction = rel->skew_fraction;
+
+	cdbpath_cost_motion(root, motionpath);
+}
+
 /*
  * cdbpath_motion_for_join
  *
@@ -1276,6 +1489,9 @@ cdbpath_motion_for_join(PlannerInfo *root,
 	inner.locus = inner.path->locus;
 	CdbPathLocus_MakeNull(&outer.move_to);
 	CdbPathLocus_MakeNull(&inner.move_to);
+	outer.skew_values = inner.skew_values = NIL;
+	outer.skew_broadcast = inner.skew_broadcast = false;
+	outer.skew_fraction = inner.skew_fraction = 0;
 
 	Assert(cdbpathlocus_is_valid(outer.locus));
 	Assert(cdbpathlocus_is_valid(inner.locus));
@@ -2008,7 +2224,12 @@ cdbpath_motion_for_join(PlannerInfo *root,
 											 &large_rel->move_to,
 											 &small_rel->move_to))
 		{
-			/* ok */
+			/* Spread heavy hitters of the larger rel, if it pays off */
+			large_rel->skew_values =
+				cdbpath_find_skew_values(root, large_rel, small_rel,
+										 &small_rel->skew_fraction);
+			small_rel->skew_values = copyObject(large_rel->skew_values);
+			small_rel->skew_broadcast = true;
 		}
 
 		/*
@@ -2073,6 +2294,28 @@ cdbpath_motion_for_join(PlannerInfo *root,
 			goto fail;
 	}
 
+	/*
+	 * Skew-resilient redistribution is only correct if both rels got the
+	 * Redistribute Motion it was planned for.  Rows with a heavy-hitter key
+	 * can then end up on any segment, so the join result is Strewn.
+	 */
+	if (outer.skew_values != NIL &&
+		IsA(outer.path, CdbMotionPath) &&
+		IsA(inner.path, CdbMotionPath))
+	{
+		CdbPathLocus locus;
+
+		cdbpath_set_skew(root, (CdbMotionPath *) outer.path, &outer);
+		cdbpath_set_skew(root, (CdbMotionPath *) inner.path, &inner);
+
+		*p_outer_path = outer.path;
+		*p_inner_path = inner.path;
+
+		CdbPathLocus_MakeStrewn(&locus,
+								CdbPathLocus_NumSegments(outer.path->locus));
+		return locus;
+	}
+
 	/*
 	 * Ok to join.  Give modified subpaths to caller.
 	 */
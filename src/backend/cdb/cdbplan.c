@@ -561,6 +561,20 @@ plan_tree_mutator(Node *node,
 			}
 			break;
 
+		case T_Memoize:
+			{
+				Memoize    *memoize = (Memoize *) node;
+				Memoize    *newmemoize;
+
+				FLATCOPY(newmemoize, memoize, Memoize);
+				PLANMUTATE(newmemoize, memoize);
+				MUTATE(newmemoize->param_exprs, memoize->param_exprs, List *);
+				COPYARRAY(newmemoize, memoize, numKeys, hashOperators);
+				COPYARRAY(newmemoize, memoize, numKeys, collations);
+				return (Node *) newmemoize;
+			}
+			break;
+
 		case T_Sort:
 			{
 				Sort	   *sort = (Sort *) node;
@@ -0,0 +1,292 @@
+/*-------------------------------------------------------------------------
+ *
+ * cdbqueryfeedback.c
+ *	  Row counts observed by EXPLAIN ANALYZE, to correct GPORCA estimates.
+ *
+ * GPORCA estimates the cardinality of a conjunction of predicates, or of a
+ * join, from per-column histograms, and it is often far off when columns
+ * are correlated.  A report or ETL query that runs every day makes the same
+ * mistake every day.  With gp_enable_query_feedback on, the QD keeps the
+ * row counts it has actually seen, and GPORCA uses them instead of its own
+ * estimate the next time it plans the same tables and predicates.
+ *
+ * GPORCA tags the statistics it derives for a Get, a Select or an inner
+ * join with a signature: the sum of hashes of the base tables and of the
+ * predicates it covers, where columns are identified by table and attribute
+ * number.  The signature is independent of the join order and of the query
+ * that contains it, and is carried to the executor in the
+ * Plan.feedbackSignature field of the node that produces those rows.
+ *
+ * Row counts are taken from the statistics the QEs send back to the QD for
+ * EXPLAIN ANALYZE (see cdbexplain_recordFeedback()), so that ordinary
+ * queries pay nothing for it.  auto_explain.log_analyze collects them, too.
+ * Before planning a query, GPORCA takes a snapshot of all entries, and
+ * scales the statistics of an expression with a known signature to the
+ * recorded row count.
+ *
+ * The entries live in shared memory on the QD, so that all sessions learn
+ * from each other.  Only the last observation for a signature is kept,
+ * together with the base tables it was read from.  ANALYZE, TRUNCATE and
+ * any change of relpages or reltuples of one of those tables forget it, as
+ * the data it describes is gone, or the regular statistics have caught up.
+ * When the table is full, the oldest observation makes room for a new one.
+ * The gp_query_feedback view shows the entries, and
+ * gp_query_feedback_reset() forgets all of them.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/cdb/cdbqueryfeedback.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "catalog/pg_type.h"
+#include "cdb/cdbqueryfeedback.h"
+#include "funcapi.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/hsearch.h"
+#include "utils/timestamp.h"
+
+/* Maximum number of signatures in shared memory */
+#define QUERY_FEEDBACK_MAX_ENTRIES	4096
+
+static HTAB *QueryFeedbackHash = NULL;
+
+static void QueryFeedbackEvictOldest(void);
+
+Size
+QueryFeedbackShmemSize(void)
+{
+	return hash_estimate_size(QUERY_FEEDBACK_MAX_ENTRIES,
+							  sizeof(QueryFeedbackEntry));
+}
+
+void
+QueryFeedbackShmemInit(void)
+{
+	HASHCTL		info;
+
+	MemSet(&info, 0, sizeof(info));
+	info.keysize = sizeof(uint32);
+	info.entrysize = sizeof(QueryFeedbackEntry);
+
+	QueryFeedbackHash = ShmemInitHash("Query Feedback",
+									  QUERY_FEEDBACK_MAX_ENTRIES,
+									  QUERY_FEEDBACK_MAX_ENTRIES,
+									  &info,
+									  HASH_ELEM | HASH_BLOBS);
+}
+
+/*
+ * Remember that the expression with the given signature, read from the
+ * given base tables, produced 'rows' rows across all segments.
+ */
+void
+QueryFeedbackRecord(uint32 signature, double rows, int nrels,
+					const Oid *relids)
+{
+	QueryFeedbackEntry *entry;
+	bool		found;
+
+	Assert(signature != 0);
+	Assert(nrels >= 0 && nrels <= QUERY_FEEDBACK_MAX_RELS);
+
+	LWLockAcquire(QueryFeedbackLock, LW_EXCLUSIVE);
+
+	/*
+	 * A shared hash table can grow past its nominal size into the spare
+	 * shared memory, so check for a full table before entering a new
+	 * signature.
+	 */
+	entry = (QueryFeedbackEntry *) hash_search(QueryFeedbackHash, &signature,
+											   HASH_FIND, NULL);
+	if (entry == NULL &&
+		hash_get_num_entries(QueryFeedbackHash) >= QUERY_FEEDBACK_MAX_ENTRIES)
+		QueryFeedbackEvictOldest();
+
+	entry = (QueryFeedbackEntry *) hash_search(QueryFeedbackHash, &signature,
+											   HASH_ENTER_NULL, &found);
+	if (entry != NULL)
+	{
+		entry->rows = rows;
+		entry->recorded = GetCurrentTimestamp();
+		entry->nrels = nrels;
+		memcpy(entry->relids, relids, nrels * sizeof(Oid));
+	}
+
+	LWLockRelease(QueryFeedbackLock);
+}
+
+/*
+ * Make room for a new entry, by removing the one recorded longest ago.
+ *
+ * The caller must hold QueryFeedbackLock exclusively.
+ */
+static void
+QueryFeedbackEvictOldest(void)
+{
+	QueryFeedbackEntry *entry;
+	QueryFeedbackEntry *oldest = NULL;
+	HASH_SEQ_STATUS status;
+
+	hash_seq_init(&status, QueryFeedbackHash);
+	while ((entry = (QueryFeedbackEntry *) hash_seq_search(&status)) != NULL)
+	{
+		if (oldest == NULL || entry->recorded < oldest->recorded)
+			oldest = entry;
+	}
+
+	if (oldest != NULL)
+		hash_search(QueryFeedbackHash, &oldest->signature, HASH_REMOVE, NULL);
+}
+
+/*
+ * Forget all observations that involve the given table, because its
+ * contents or its statistics have changed.
+ */
+void
+QueryFeedbackForgetRelation(Oid relid)
+{
+	QueryFeedbackEntry *entry;
+	HASH_SEQ_STATUS status;
+	int			i;
+
+	LWLockAcquire(QueryFeedbackLock, LW_EXCLUSIVE);
+
+	/* Nothing is ever recorded on the QEs */
+	if (hash_get_num_entries(QueryFeedbackHash) > 0)
+	{
+		hash_seq_init(&status, QueryFeedbackHash);
+		while ((entry = (QueryFeedbackEntry *) hash_seq_search(&status)) != NULL)
+		{
+			for (i = 0; i < entry->nrels; i++)
+			{
+				if (entry->relids[i] == relid)
+				{
+					hash_search(QueryFeedbackHash, &entry->signature,
+								HASH_REMOVE, NULL);
+					break;
+				}
+			}
+		}
+	}
+
+	LWLockRelease(QueryFeedbackLock);
+}
+
+/*
+ * Return a palloc'd copy of all entries, and their number in *nentries.
+ */
+QueryFeedbackEntry *
+QueryFeedbackSnapshot(int *nentries)
+{
+	QueryFeedbackEntry *entries;
+	QueryFeedbackEntry *entry;
+	HASH_SEQ_STATUS status;
+	int			n = 0;
+
+	LWLockAcquire(QueryFeedbackLock, LW_SHARED);
+
+	entries = (QueryFeedbackEntry *)
+		palloc(Max(hash_get_num_entries(QueryFeedbackHash), 1) *
+			   sizeof(QueryFeedbackEntry));
+
+	hash_seq_init(&status, QueryFeedbackHash);
+	while ((entry = (QueryFeedbackEntry *) hash_seq_search(&status)) != NULL)
+		entries[n++] = *entry;
+
+	LWLockRelease(QueryFeedbackLock);
+
+	*nentries = n;
+	return entries;
+}
+
+/*
+ * gp_get_query_feedback
+ *	  Show the contents of the query feedback store, for the
+ *	  gp_query_feedback view.
+ */
+Datum
+gp_get_query_feedback(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	QueryFeedbackEntry *entries;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		TupleDesc	tupdesc;
+		MemoryContext oldcontext;
+		int			nentries;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+			elog(ERROR, "return type must be a row type");
+		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+		funcctx->user_fctx = QueryFeedbackSnapshot(&nentries);
+		funcctx->max_calls = nentries;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	entries = (QueryFeedbackEntry *) funcctx->user_fctx;
+
+	if (funcctx->call_cntr < funcctx->max_calls)
+	{
+		QueryFeedbackEntry *entry = &entries[funcctx->call_cntr];
+		Datum		values[4];
+		bool		nulls[4];
+		Datum	   *relids;
+		HeapTuple	tuple;
+		int			i;
+
+		MemSet(nulls, false, sizeof(nulls));
+
+		relids = palloc(Max(entry->nrels, 1) * sizeof(Datum));
+		for (i = 0; i < entry->nrels; i++)
+			relids[i] = ObjectIdGetDatum(entry->relids[i]);
+
+		values[0] = Int64GetDatum((int64) entry->signature);
+		values[1] = Float8GetDatum(entry->rows);
+		values[2] = PointerGetDatum(construct_array(relids, entry->nrels,
+													OIDOID, sizeof(Oid),
+													true, 'i'));
+		values[3] = TimestampTzGetDatum(entry->recorded);
+
+		tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+		SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+	}
+
+	SRF_RETURN_DONE(funcctx);
+}
+
+/*
+ * gp_query_feedback_reset
+ *	  Forget all recorded row counts.
+ */
+Datum
+gp_query_feedback_reset(PG_FUNCTION_ARGS)
+{
+	QueryFeedbackEntry *entry;
+	HASH_SEQ_STATUS status;
+
+	LWLockAcquire(QueryFeedbackLock, LW_EXCLUSIVE);
+
+	hash_seq_init(&status, QueryFeedbackHash);
+	while ((entry = (QueryFeedbackEntry *) hash_seq_search(&status)) != NULL)
+		hash_search(QueryFeedbackHash, &entry->signature, HASH_REMOVE, NULL);
+
+	LWLockRelease(QueryFeedbackLock);
+
+	PG_RETURN_VOID();
+}
@@ -0,0 +1,492 @@
+/*-------------------------------------------------------------------------
+ *
+ * cdbreopt.c
+ *	  Adaptive re-optimization of SELECTs with misestimated Broadcast Motions.
+ *
+ * When GPORCA underestimates one side of a join by orders of magnitude, it
+ * happily broadcasts what it believes is a small relation, and the query
+ * then spends most of its time copying a huge one to every segment.  With
+ * gp_adaptive_reopt_ratio set, the QD gives each Broadcast Motion of a
+ * read-only SELECT a row limit derived from the estimate of its subplan.
+ * A sender that exceeds it raises ERRCODE_GP_CARDINALITY_MISESTIMATE (see
+ * nodeMotion.c), and the QD then plans the query again with broadcasts
+ * penalized regardless of their estimated size, and runs the new plan.
+ *
+ * To be able to start over, the first attempt runs in a subtransaction,
+ * and its result is held in a tuplestore until the executor has shut down
+ * cleanly, so that no row reaches the client before we know whether the
+ * query has to be run again.  Work already done by the first attempt is
+ * thrown away: intermediate results live in the QEs of the failed slices
+ * and cannot be handed over to a different plan.
+ *
+ * That is only worth it when a misestimate is possible at all.  A Broadcast
+ * Motion that scans a table with fewer rows than its limit, as of the last
+ * ANALYZE, gets no limit, and a query with no limits runs as usual.  So does
+ * a query whose result is expected to be larger than
+ * gp_adaptive_reopt_max_result_size.  If the held back result outgrows it
+ * anyway, the first attempt is stopped, and the query runs again without
+ * row limits, sending its result as it is produced.
+ *
+ * Only the simple query protocol uses this.  Statements with volatile
+ * functions are not retried, as they could have side effects that a
+ * rollback does not undo.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/cdb/cdbreopt.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/printtup.h"
+#include "access/xact.h"
+#include "catalog/pg_class.h"
+#include "cdb/cdbreopt.h"
+#include "cdb/cdbvars.h"
+#include "executor/executor.h"
+#include "executor/tstoreReceiver.h"
+#include "miscadmin.h"
+#include "nodes/plannodes.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/walkers.h"
+#include "parser/parsetree.h"
+#include "tcop/pquery.h"
+#include "tcop/tcopprot.h"
+#include "utils/guc.h"
+#include "utils/memutils.h"
+#include "utils/portal.h"
+#include "utils/resowner.h"
+#include "utils/snapmgr.h"
+#include "utils/syscache.h"
+#include "utils/tuplestore.h"
+
+typedef struct reopt_limit_context
+{
+	plan_tree_base_prefix base;
+	PlannedStmt *stmt;
+	bool		clear;			/* remove the limits instead */
+	bool		found;
+} reopt_limit_context;
+
+/*
+ * DestReceiver that holds back the result of the first attempt in a
+ * tuplestore, and stops the executor if it doesn't fit in memory.
+ */
+typedef struct ReoptHoldReceiver
+{
+	DestReceiver pub;
+	DestReceiver *tstore;
+	Tuplestorestate *store;
+	bool		overflowed;
+} ReoptHoldReceiver;
+
+static bool reopt_limit_walker(Node *node, reopt_limit_context *context);
+static double reopt_max_rows(Plan *plan, PlannedStmt *stmt);
+static bool reopt_run_portal(const char *query_string, NodeTag sourceTag,
+							 const char *commandTag, List *plantree_list,
+							 CommandDest dest, bool hold_result,
+							 char *completionTag);
+
+/*
+ * Can this statement be planned again if it turns out to be misestimated?
+ *
+ * Called with the rewritten query, before planning.
+ */
+bool
+AdaptiveReoptCandidate(List *querytree_list)
+{
+	Query	   *query;
+
+	if (Gp_role != GP_ROLE_DISPATCH || gp_adaptive_reopt_ratio <= 0 ||
+		!optimizer)
+		return false;
+
+	if (list_length(querytree_list) != 1)
+		return false;
+
+	query = linitial_node(Query, querytree_list);
+	if (query->commandType != CMD_SELECT || query->utilityStmt != NULL)
+		return false;
+
+	/* SELECT FOR UPDATE locks rows, data-modifying CTEs write them */
+	if (query->rowMarks != NIL || query->hasModifyingCTE)
+		return false;
+
+	return !contain_volatile_functions((Node *) query);
+}
+
+/*
+ * Give every Broadcast Motion of a GPORCA plan that may receive many more
+ * rows than estimated a row limit, past which its senders give up.  Returns
+ * false if there are none, in which case the query runs as usual.
+ */
+bool
+AdaptiveReoptSetLimits(List *plantree_list)
+{
+	PlannedStmt *stmt = linitial_node(PlannedStmt, plantree_list);
+	reopt_limit_context context;
+
+	if (stmt->planGen != PLANGEN_OPTIMIZER)
+		return false;
+
+	/* Don't hold back a result that is not expected to fit */
+	if (stmt->planTree->plan_rows * stmt->planTree->plan_width >
+		(double) gp_adaptive_reopt_max_result_size * 1024.0)
+		return false;
+
+	exec_init_plan_tree_base(&context.base, stmt);
+	context.stmt = stmt;
+	context.clear = false;
+	context.found = false;
+	(void) reopt_limit_walker((Node *) stmt->planTree, &context);
+
+	return context.found;
+}
+
+static bool
+reopt_limit_walker(Node *node, reopt_limit_context *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, Motion))
+	{
+		Motion	   *motion = (Motion *) node;
+
+		/*
+		 * The local fan-out of a host-aware Broadcast only passes on what
+		 * the Motion below it received, see cdbhostbcast.c.
+		 */
+		if (context->clear)
+			motion->reoptRowLimit = 0;
+		else if (motion->motionType == MOTIONTYPE_BROADCAST &&
+				 motion->hostMode != BROADCAST_HOST_LOCAL)
+		{
+			/* plan_rows is the estimate for a single sender */
+			double		limit = Max(motion->plan.lefttree->plan_rows * gp_adaptive_reopt_ratio,
+									(double) gp_adaptive_reopt_min_rows);
+			double		max_rows = reopt_max_rows(motion->plan.lefttree,
+												  context->stmt);
+
+			if (max_rows < 0 || max_rows > limit)
+			{
+				motion->reoptRowLimit = limit;
+				context->found = true;
+			}
+		}
+	}
+
+	return plan_tree_walker(node, reopt_limit_walker, context, true);
+}
+
+/*
+ * An upper bound for the number of rows a sender of a Motion can get from
+ * 'plan', from the sizes of the tables it scans, or -1 if there is none.
+ *
+ * Joins and the like can return more rows than they scan, as can a table
+ * that has been loaded since its last ANALYZE.  A table that appears to be
+ * empty may just never have been analyzed.
+ */
+static double
+reopt_max_rows(Plan *plan, PlannedStmt *stmt)
+{
+	switch (nodeTag(plan))
+	{
+		case T_SeqScan:
+		case T_IndexScan:
+		case T_IndexOnlyScan:
+		case T_BitmapHeapScan:
+			{
+				RangeTblEntry *rte = rt_fetch(((Scan *) plan)->scanrelid,
+											  stmt->rtable);
+				HeapTuple	tuple;
+				double		result = -1;
+
+				tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(rte->relid));
+				if (HeapTupleIsValid(tuple))
+				{
+					Form_pg_class classForm = (Form_pg_class) GETSTRUCT(tuple);
+
+					if (classForm->relkind == RELKIND_RELATION &&
+						classForm->relpages > 0)
+						result = classForm->reltuples;
+					ReleaseSysCache(tuple);
+				}
+				return result;
+			}
+
+		case T_Result:
+			if (plan->lefttree == NULL)
+				return 1;
+			return reopt_max_rows(plan->lefttree, stmt);
+
+		case T_Agg:
+			if (((Agg *) plan)->groupingSets != NIL)
+				return -1;
+			return reopt_max_rows(plan->lefttree, stmt);
+
+		case T_Sort:
+		case T_Material:
+		case T_Limit:
+		case T_Unique:
+			return reopt_max_rows(plan->lefttree, stmt);
+
+		default:
+			return -1;
+	}
+}
+
+/*
+ * Run a SELECT whose Broadcast Motions have row limits, and if one of them
+ * is exceeded, plan it again and run the new plan instead.
+ *
+ * 'querytree_list' is a copy of the rewritten query that was planned into
+ * 'plantree_list', planning scribbles on its input.
+ */
+void
+AdaptiveReoptRunSelect(const char *query_string, NodeTag sourceTag,
+					   const char *commandTag, List *querytree_list,
+					   List *plantree_list, CommandDest dest,
+					   char *completionTag)
+{
+	MemoryContext oldcontext = CurrentMemoryContext;
+	ResourceOwner oldowner = CurrentResourceOwner;
+	ErrorData  *edata = NULL;
+	volatile bool completed = false;
+	int			save_nestlevel;
+
+	BeginInternalSubTransaction(NULL);
+	MemoryContextSwitchTo(oldcontext);
+
+	PG_TRY();
+	{
+		completed = reopt_run_portal(query_string, sourceTag, commandTag,
+									 plantree_list, dest, true, completionTag);
+
+		ReleaseCurrentSubTransaction();
+		MemoryContextSwitchTo(oldcontext);
+		CurrentResourceOwner = oldowner;
+	}
+	PG_CATCH();
+	{
+		MemoryContextSwitchTo(oldcontext);
+		edata = CopyErrorData();
+		FlushErrorState();
+
+		RollbackAndReleaseCurrentSubTransaction();
+		MemoryContextSwitchTo(oldcontext);
+		CurrentResourceOwner = oldowner;
+
+		if (edata->sqlerrcode != ERRCODE_GP_CARDINALITY_MISESTIMATE)
+			ReThrowError(edata);
+	}
+	PG_END_TRY();
+
+	if (completed)
+		return;
+
+	if (edata == NULL)
+	{
+		reopt_limit_context context;
+
+		/*
+		 * The result did not fit.  Run the same plan again, without row
+		 * limits, and send the rows as they come.
+		 */
+		ereport(LOG,
+				(errmsg("running query again without row limits"),
+				 errdetail("The result exceeds gp_adaptive_reopt_max_result_size.")));
+
+		exec_init_plan_tree_base(&context.base,
+								 linitial_node(PlannedStmt, plantree_list));
+		context.stmt = linitial_node(PlannedStmt, plantree_list);
+		context.clear = true;
+		context.found = false;
+		(void) reopt_limit_walker((Node *) context.stmt->planTree, &context);
+
+		CHECK_FOR_INTERRUPTS();
+
+		(void) reopt_run_portal(query_string, sourceTag, commandTag,
+								plantree_list, dest, false, completionTag);
+		return;
+	}
+
+	ereport(LOG,
+			(errmsg("planning query again after a cardinality misestimate"),
+			 errdetail("%s", edata->message)));
+	FreeErrorData(edata);
+
+	/*
+	 * Plan again, penalizing every broadcast.  GPORCA still broadcasts where
+	 * it has no other choice, so the new plan gets no row limits.
+	 */
+	save_nestlevel = NewGUCNestLevel();
+	(void) set_config_option("optimizer_penalize_broadcast_threshold", "0",
+							 PGC_USERSET, PGC_S_SESSION,
+							 GUC_ACTION_SAVE, true, 0, false);
+
+	MemoryContextSwitchTo(MessageContext);
+	PushActiveSnapshot(GetTransactionSnapshot());
+	plantree_list = pg_plan_queries(querytree_list, CURSOR_OPT_PARALLEL_OK,
+									NULL);
+	PopActiveSnapshot();
+	MemoryContextSwitchTo(oldcontext);
+
+	AtEOXact_GUC(true, save_nestlevel);
+
+	CHECK_FOR_INTERRUPTS();
+
+	(void) reopt_run_portal(query_string, sourceTag, commandTag,
+							plantree_list, dest, false, completionTag);
+}
+
+static bool
+reopt_hold_receive(TupleTableSlot *slot, DestReceiver *self)
+{
+	ReoptHoldReceiver *myState = (ReoptHoldReceiver *) self;
+
+	if (!myState->tstore->receiveSlot(slot, myState->tstore))
+		return false;
+
+	/* stop the executor once the tuplestore has spilled to disk */
+	if (!tuplestore_in_memory(myState->store))
+	{
+		myState->overflowed = true;
+		return false;
+	}
+	return true;
+}
+
+static void
+reopt_hold_startup(DestReceiver *self, int operation, TupleDesc typeinfo)
+{
+	ReoptHoldReceiver *myState = (ReoptHoldReceiver *) self;
+
+	myState->tstore->rStartup(myState->tstore, operation, typeinfo);
+}
+
+static void
+reopt_hold_shutdown(DestReceiver *self)
+{
+	ReoptHoldReceiver *myState = (ReoptHoldReceiver *) self;
+
+	myState->tstore->rShutdown(myState->tstore);
+}
+
+static void
+reopt_hold_destroy(DestReceiver *self)
+{
+	ReoptHoldReceiver *myState = (ReoptHoldReceiver *) self;
+
+	myState->tstore->rDestroy(myState->tstore);
+	pfree(myState);
+}
+
+/*
+ * Run a plan in an unnamed portal, like exec_simple_query() does.
+ *
+ * With 'hold_result', the rows are stored in a tuplestore, and only sent
+ * to the destination after the executor has shut down, i.e. once every QE
+ * has reported success.  If they don't fit in
+ * gp_adaptive_reopt_max_result_size, the executor is stopped, nothing is
+ * sent, and false is returned.
+ */
+static bool
+reopt_run_portal(const char *query_string, NodeTag sourceTag,
+				 const char *commandTag, List *plantree_list,
+				 CommandDest dest, bool hold_result, char *completionTag)
+{
+	Portal		portal;
+	DestReceiver *receiver;
+	Tuplestorestate *store = NULL;
+	TupleDesc	tupdesc = NULL;
+	bool		overflowed = false;
+	int16		format = 0;		/* TEXT */
+
+	portal = CreatePortal("", true, true);
+	/* Don't display the portal in pg_cursors */
+	portal->visible = false;
+
+	PortalDefineQuery(portal,
+					  NULL,
+					  query_string,
+					  sourceTag,
+					  commandTag,
+					  plantree_list,
+					  NULL);
+
+	PortalStart(portal, NULL, 0, InvalidSnapshot, NULL);
+	PortalSetResultFormat(portal, 1, &format);
+
+	receiver = CreateDestReceiver(dest);
+	if (dest == DestRemote)
+		SetRemoteDestReceiverParams(receiver, portal);
+
+	if (!hold_result)
+	{
+		(void) PortalRun(portal, FETCH_ALL, true, true,
+						 receiver, receiver, completionTag);
+	}
+	else
+	{
+		ReoptHoldReceiver *hreceiver = palloc0(sizeof(ReoptHoldReceiver));
+		TupleTableSlot *slot;
+
+		store = tuplestore_begin_heap(false, false,
+									  gp_adaptive_reopt_max_result_size);
+		hreceiver->pub.receiveSlot = reopt_hold_receive;
+		hreceiver->pub.rStartup = reopt_hold_startup;
+		hreceiver->pub.rShutdown = reopt_hold_shutdown;
+		hreceiver->pub.rDestroy = reopt_hold_destroy;
+		hreceiver->pub.mydest = DestTuplestore;
+		hreceiver->tstore = CreateDestReceiver(DestTuplestore);
+		hreceiver->store = store;
+		SetTuplestoreDestReceiverParams(hreceiver->tstore, store,
+										CurrentMemoryContext, false);
+
+		(void) PortalRun(portal, FETCH_ALL, true, true,
+						 (DestReceiver *) hreceiver,
+						 (DestReceiver *) hreceiver, completionTag);
+		overflowed = hreceiver->overflowed;
+		hreceiver->pub.rDestroy((DestReceiver *) hreceiver);
+
+		/*
+		 * Shut down the executor now, as MarkPortalDone() would, so that
+		 * errors the QEs report at the end of the query are raised before
+		 * any row has been sent.
+		 */
+		tupdesc = CreateTupleDescCopy(portal->tupDesc);
+		if (PointerIsValid(portal->cleanup))
+		{
+			portal->cleanup(portal);
+			portal->cleanup = NULL;
+		}
+
+		if (!overflowed)
+		{
+			slot = MakeSingleTupleTableSlot(tupdesc, &TTSOpsMinimalTuple);
+			receiver->rStartup(receiver, CMD_SELECT, tupdesc);
+			while (tuplestore_gettupleslot(store, true, false, slot))
+			{
+				if (!receiver->receiveSlot(slot, receiver))
+					break;
+				ExecClearTuple(slot);
+			}
+			receiver->rShutdown(receiver);
+			ExecDropSingleTupleTableSlot(slot);
+		}
+
+		tuplestore_end(store);
+		FreeTupleDesc(tupdesc);
+	}
+
+	receiver->rDestroy(receiver);
+
+	PortalDrop(portal, false);
+
+	return !overflowed;
+}
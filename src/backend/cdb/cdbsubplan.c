@@ -20,6 +20,7 @@
 #include "cdb/cdbdisp_query.h"
 #include "cdb/cdbplan.h"
 #include "cdb/cdbllize.h"
+#include "cdb/cdbinitplancache.h"
 #include "cdb/cdbsubplan.h"
 #include "cdb/cdbvars.h"		/* currentSliceId */
 #include "utils/tuplestore.h"
@@ -135,8 +136,16 @@ preprocess_initplans(QueryDesc *queryDesc)
 				 * values on every iteration. That's important because the set
 				 * of valid PARAM_EXEC values grows on every iteration, and
 				 * later Init plans can depend on previous ones.
+				 *
+				 * If gp_enable_initplan_cache is on, an earlier execution of
+				 * the very same initplan may have left its result behind, in
+				 * which case there is nothing to dispatch.
 				 */
-				ExecSetParamPlan(sps, sps->planstate->ps_ExprContext, queryDesc);
+				if (!InitPlanCacheLookup(queryDesc, sps))
+				{
+					ExecSetParamPlan(sps, sps->planstate->ps_ExprContext, queryDesc);
+					InitPlanCacheStore(queryDesc, sps);
+				}
 			}
 		}
 
@@ -65,6 +65,9 @@ InitDirectDispatchCalculationInfo(DirectDispatchInfo *data)
 {
 	data->isDirectDispatch = false;
 	data->contentIds = NULL;
+	data->paramKeys = NIL;
+	data->paramHashFuncs = NIL;
+	data->paramNumSegments = 0;
 	data->haveProcessedAnyCalculations = false;
 }
 
@@ -76,9 +79,140 @@ DisableTargetedDispatch(DirectDispatchInfo *data)
 {
 	data->isDirectDispatch = false;
 	data->contentIds = NULL;
+	data->paramKeys = NIL;
+	data->paramHashFuncs = NIL;
+	data->paramNumSegments = 0;
 	data->haveProcessedAnyCalculations = true;
 }
 
+/**
+ * Find the expression that distribution key column 'var' is equated to in
+ * 'qual', when that is a Const or a PARAM_EXTERN Param.
+ *
+ * Only top-level AND'ed conditions count, and only with an equality operator
+ * of the column's distribution opfamily and an operand of the column's own
+ * type, so that hashing the operand's value gives the same result as hashing
+ * the column's value.
+ */
+static Expr *
+GetDistributionKeyValueExpr(Node *qual, Var *var, Oid opfamily)
+{
+	List	   *clauses;
+	ListCell   *lc;
+
+	if (qual == NULL)
+		return NULL;
+	else if (IsA(qual, List))
+		clauses = (List *) qual;
+	else if (is_andclause(qual))
+		clauses = ((BoolExpr *) qual)->args;
+	else
+		clauses = list_make1(qual);
+
+	foreach(lc, clauses)
+	{
+		Node	   *clause = (Node *) lfirst(lc);
+		OpExpr	   *opexpr;
+		Node	   *leftop;
+		Node	   *rightop;
+		Node	   *other;
+
+		if (is_andclause(clause))
+		{
+			Expr	   *result = GetDistributionKeyValueExpr(clause, var, opfamily);
+
+			if (result)
+				return result;
+			continue;
+		}
+
+		if (!is_opclause(clause) || list_length(((OpExpr *) clause)->args) != 2)
+			continue;
+		opexpr = (OpExpr *) clause;
+
+		leftop = (Node *) linitial(opexpr->args);
+		rightop = (Node *) lsecond(opexpr->args);
+		if (IsA(leftop, RelabelType))
+			leftop = (Node *) ((RelabelType *) leftop)->arg;
+		if (IsA(rightop, RelabelType))
+			rightop = (Node *) ((RelabelType *) rightop)->arg;
+
+		if (equal(leftop, var))
+			other = rightop;
+		else if (equal(rightop, var))
+			other = leftop;
+		else
+			continue;
+
+		if (!IsA(other, Const) &&
+			!(IsA(other, Param) && ((Param *) other)->paramkind == PARAM_EXTERN))
+			continue;
+
+		if (exprType(other) != var->vartype ||
+			!op_in_opfamily(opexpr->opno, opfamily))
+			continue;
+
+		return (Expr *) other;
+	}
+
+	return NULL;
+}
+
+/**
+ * For the generic plan of a prepared statement, the distribution key is
+ * typically compared to a parameter, as in "WHERE key = $1".  The target
+ * segment can't be computed while planning, but it can at executor startup,
+ * once the parameter values are known.  Set up 'result' for that, if every
+ * distribution key column is equated to a Const or a Param.
+ */
+static bool
+GetParamDirectDispatchInfo(GpPolicy *policy, PartitionKeyInfo *parts,
+						   int rangeTableIndex, List *qualification,
+						   DirectDispatchInfo *result)
+{
+	List	   *keys = NIL;
+	List	   *hashfuncs = NIL;
+	bool		anyParam = false;
+	int			i;
+
+	for (i = 0; i < policy->nattrs; i++)
+	{
+		Var		   *var;
+		Oid			opfamily;
+		Expr	   *key;
+
+		var = makeVar(rangeTableIndex,
+					  policy->attrs[i],
+					  parts[i].attr->atttypid,
+					  parts[i].attr->atttypmod,
+					  parts[i].attr->attcollation,
+					  0);
+		opfamily = get_opclass_family(policy->opclasses[i]);
+
+		key = GetDistributionKeyValueExpr((Node *) qualification, var, opfamily);
+		if (key == NULL)
+			return false;
+
+		if (IsA(key, Param))
+			anyParam = true;
+
+		keys = lappend(keys, copyObject(key));
+		hashfuncs = lappend_oid(hashfuncs,
+								cdb_hashproc_in_opfamily(opfamily, var->vartype));
+	}
+
+	/* with constants alone, the caller would have found the segment */
+	if (!anyParam)
+		return false;
+
+	result->isDirectDispatch = true;
+	result->contentIds = NIL;
+	result->paramKeys = keys;
+	result->paramHashFuncs = hashfuncs;
+	result->paramNumSegments = policy->numsegments;
+	return true;
+}
+
 /**
  * helper function for AssignContentIdsFromUpdateDeleteQualification
  */
@@ -267,12 +401,19 @@ GetContentIdsFromPlanForSingleRelation(PlannerInfo *root, Plan *plan, int rangeT
 													 * all! */
 		}
 		else if (totalCombinations > 0 &&
-			/* don't bother for ones which will likely hash to many segments */
-				 totalCombinations < policy->numsegments * 3)
+				 totalCombinations <= gp_direct_dispatch_max_values)
 		{
 			CdbHash    *h;
 			long		index;
 
+			/*
+			 * Long IN-lists and ANY(array) conditions are likely to hash to
+			 * every segment.  Hash them anyway, since key lookups often hit
+			 * only a few segments.  Give up once all segments are hit, as
+			 * the full dispatch is then just as good.
+			 */
+			bool		stopAtAllSegments = (totalCombinations >= policy->numsegments * 3);
+
 			h = makeCdbHashForRelation(relation);
 
 			result.isDirectDispatch = true;
@@ -313,8 +454,21 @@ GetContentIdsFromPlanForSingleRelation(PlannerInfo *root, Plan *plan, int rangeT
 				hashCode = cdbhashreduce(h);
 
 				result.contentIds = list_append_unique_int(result.contentIds, hashCode);
+
+				if (stopAtAllSegments &&
+					list_length(result.contentIds) >= policy->numsegments)
+				{
+					result.isDirectDispatch = false;
+					break;
+				}
 			}
 		}
+		else if (totalCombinations < 0 &&
+				 GetParamDirectDispatchInfo(policy, parts, rangeTableIndex,
+											qualification, &result))
+		{
+			/* target segment is computed at executor startup */
+		}
 		else
 		{
 			/* know nothing, can't do directed dispatch */
@@ -348,6 +502,27 @@ MergeDirectDispatchCalculationInfo(DirectDispatchInfo *to, DirectDispatchInfo *f
 	{
 		/* to cannot get better -- leave it alone */
 	}
+	else if (from->paramKeys != NIL || to->paramKeys != NIL)
+	{
+		/*
+		 * A target computed at executor startup can only be combined with
+		 * the very same target, or with one that doesn't need to run at all.
+		 */
+		if (from->paramKeys == NIL && from->contentIds == NULL)
+		{
+			/* from doesn't need to run anywhere -- keep to */
+		}
+		else if (to->paramKeys == NIL && to->contentIds == NULL)
+		{
+			*to = *from;
+		}
+		else if (!equal(from->paramKeys, to->paramKeys) ||
+				 !equal(from->paramHashFuncs, to->paramHashFuncs) ||
+				 from->paramNumSegments != to->paramNumSegments)
+		{
+			DisableTargetedDispatch(to);
+		}
+	}
 	else if (from->contentIds == NULL)
 	{
 		/* from says that it doesn't need to run anywhere -- so we accept to */
@@ -386,7 +561,12 @@ FinalizeDirectDispatchDataForSlice(PlanSlice *slice)
 	{
 		if (dd->isDirectDispatch)
 		{
-			if (dd->contentIds == NULL)
+			if (dd->paramKeys != NIL)
+			{
+				if (ShouldPrintTestMessages())
+					elog(INFO, "DDCR learned dispatch to content computed from parameters");
+			}
+			else if (dd->contentIds == NULL)
 			{
 				int			random_segno;
 
@@ -395,11 +575,16 @@ FinalizeDirectDispatchDataForSlice(PlanSlice *slice)
 				if (ShouldPrintTestMessages())
 					elog(INFO, "DDCR learned no content dispatch is required");
 			}
-			else
+			else if (list_length(dd->contentIds) == 1)
 			{
 				if (ShouldPrintTestMessages())
 					elog(INFO, "DDCR learned dispatch to content %d", linitial_int(dd->contentIds));
 			}
+			else
+			{
+				if (ShouldPrintTestMessages())
+					elog(INFO, "DDCR learned dispatch to %d contents", list_length(dd->contentIds));
+			}
 		}
 		else
 		{
@@ -520,6 +705,7 @@ DirectDispatchUpdateContentIdsFromPlan(PlannerInfo *root, Plan *plan)
 			 */
 			break;
 		case T_Material:
+		case T_Memoize:
 		case T_Sort:
 		case T_Agg:
 		case T_TupleSplit:
@@ -583,14 +769,30 @@ DirectDispatchUpdateContentIdsForInsert(PlannerInfo *root, Plan *plan,
 	DirectDispatchInfo dispatchInfo;
 	int			i;
 	ListCell   *cell = NULL;
+	ListCell   *rowcell;
 	bool		isDirectDispatch;
-	Datum	   *values;
-	bool	   *nulls;
+	Expr	  **exprs;
+	ValuesScan *valuesscan = NULL;
+	List	   *rows;
+	CdbHash    *h;
+
+	/*
+	 * A single-row insert is a Result with no input.  A multi-row insert
+	 * is a Result on top of a VALUES scan, see cdbpathtoplan_create_sri_plan().
+	 */
+	if (plan->lefttree == NULL)
+		rows = list_make1(NIL);
+	else if (IsA(plan->lefttree, ValuesScan))
+	{
+		valuesscan = (ValuesScan *) plan->lefttree;
+		rows = valuesscan->values_lists;
+	}
+	else
+		return;
 
 	InitDirectDispatchCalculationInfo(&dispatchInfo);
 
-	values = (Datum *) palloc(targetPolicy->nattrs * sizeof(Datum));
-	nulls = (bool *) palloc(targetPolicy->nattrs * sizeof(bool));
+	exprs = (Expr **) palloc(targetPolicy->nattrs * sizeof(Expr *));
 
 	/*
 	 * the nested loops here seem scary -- especially since we've already
@@ -601,58 +803,152 @@ DirectDispatchUpdateContentIdsForInsert(PlannerInfo *root, Plan *plan,
 	isDirectDispatch = true;
 	for (i = 0; i < targetPolicy->nattrs; i++)
 	{
+		exprs[i] = NULL;
 		foreach(cell, plan->targetlist)
 		{
 			TargetEntry *tle = (TargetEntry *) lfirst(cell);
-			Const	   *c;
 
 			Assert(tle->expr);
 
 			if (tle->resno != targetPolicy->attrs[i])
 				continue;
 
-			if (!IsA(tle->expr, Const))
-			{
-				/* the planner could not simplify this */
-				isDirectDispatch = false;
-				break;
-			}
-
-			c = (Const *) tle->expr;
-
-			values[i] = c->constvalue;
-			nulls[i] = c->constisnull;
+			exprs[i] = tle->expr;
 			break;
 		}
 
-		if (!isDirectDispatch)
+		if (exprs[i] == NULL)
+		{
+			isDirectDispatch = false;
 			break;
+		}
 	}
 
-	if (isDirectDispatch)
+	h = makeCdbHash(targetPolicy->numsegments, targetPolicy->nattrs, hashfuncs);
+
+	/* hash each row, picking the key values out of the VALUES list if needed */
+	foreach(rowcell, rows)
 	{
+		List	   *row = (List *) lfirst(rowcell);
 		uint32		hashcode;
-		CdbHash    *h;
 
-		h = makeCdbHash(targetPolicy->numsegments, targetPolicy->nattrs, hashfuncs);
+		if (!isDirectDispatch)
+			break;
 
 		cdbhashinit(h);
 		for (i = 0; i < targetPolicy->nattrs; i++)
 		{
-			cdbhash(h, i + 1, values[i], nulls[i]);
+			Expr	   *expr = exprs[i];
+			Const	   *c;
+
+			if (valuesscan && IsA(expr, Var) &&
+				((Var *) expr)->varno == valuesscan->scan.scanrelid)
+				expr = (Expr *) list_nth(row, ((Var *) expr)->varattno - 1);
+
+			if (!IsA(expr, Const))
+			{
+				/* the planner could not simplify this */
+				isDirectDispatch = false;
+				break;
+			}
+
+			c = (Const *) expr;
+			cdbhash(h, i + 1, c->constvalue, c->constisnull);
 		}
 
+		if (!isDirectDispatch)
+			break;
+
 		/* We now have the hash-partition that this row belong to */
 		hashcode = cdbhashreduce(h);
+		dispatchInfo.contentIds = list_append_unique_int(dispatchInfo.contentIds, hashcode);
+	}
+
+	if (isDirectDispatch)
+	{
 		dispatchInfo.isDirectDispatch = true;
-		dispatchInfo.contentIds = list_make1_int(hashcode);
 		dispatchInfo.haveProcessedAnyCalculations = true;
 
 		/* learned new info: merge it in */
 		MergeDirectDispatchCalculationInfo(&root->curSlice->directDispatch, &dispatchInfo);
 
-		elog(DEBUG1, "sending single row constant insert to content %d", hashcode);
+		if (valuesscan == NULL)
+			elog(DEBUG1, "sending single row constant insert to content %d",
+				 linitial_int(dispatchInfo.contentIds));
+		else
+			elog(DEBUG1, "sending %d row constant insert to %d contents",
+				 list_length(rows), list_length(dispatchInfo.contentIds));
 	}
-	pfree(values);
-	pfree(nulls);
+	else
+		list_free(dispatchInfo.contentIds);
+
+	pfree(exprs);
+}
+
+/*
+ * Compute the target segment of a slice whose direct dispatch depends on
+ * parameter values, see DirectDispatchInfo.paramKeys.
+ *
+ * Returns NIL if the value of a parameter isn't available, in which case the
+ * caller should dispatch to all segments.
+ */
+List *
+GetDirectDispatchContentIdsFromParams(DirectDispatchInfo *dd, ParamListInfo params)
+{
+	int			nkeys = list_length(dd->paramKeys);
+	Oid		   *hashfuncs;
+	CdbHash    *h;
+	ListCell   *lc;
+	int			i;
+
+	Assert(dd->isDirectDispatch && nkeys > 0);
+
+	hashfuncs = (Oid *) palloc(nkeys * sizeof(Oid));
+	i = 0;
+	foreach(lc, dd->paramHashFuncs)
+		hashfuncs[i++] = lfirst_oid(lc);
+
+	h = makeCdbHash(dd->paramNumSegments, nkeys, hashfuncs);
+	cdbhashinit(h);
+
+	i = 0;
+	foreach(lc, dd->paramKeys)
+	{
+		Node	   *key = (Node *) lfirst(lc);
+		Datum		value;
+		bool		isnull;
+
+		if (IsA(key, Const))
+		{
+			value = ((Const *) key)->constvalue;
+			isnull = ((Const *) key)->constisnull;
+		}
+		else
+		{
+			Param	   *param = (Param *) key;
+			ParamExternData *prm;
+			ParamExternData prmdata;
+
+			Assert(IsA(key, Param) && param->paramkind == PARAM_EXTERN);
+
+			if (params == NULL ||
+				param->paramid <= 0 || param->paramid > params->numParams)
+				return NIL;
+
+			if (params->paramFetch != NULL)
+				prm = params->paramFetch(params, param->paramid, false, &prmdata);
+			else
+				prm = &params->params[param->paramid - 1];
+
+			if (prm->ptype != param->paramtype)
+				return NIL;
+
+			value = prm->value;
+			isnull = prm->isnull;
+		}
+
+		cdbhash(h, ++i, value, isnull);
+	}
+
+	return list_make1_int(cdbhashreduce(h));
 }
@@ -87,6 +87,7 @@ slock_t *shmGxidGenLock;
 int	max_tm_gxacts = 100;
 
 int gp_gxid_prefetch_num;
+bool gp_enable_read_only_dtx_deferral = true;
 #define GXID_PRETCH_THRESHOLD (gp_gxid_prefetch_num>>1)
 
 #define TM_ERRDETAIL (errdetail("gid=" UINT64_FORMAT ", state=%s", \
@@ -124,6 +125,7 @@ static void doNotifyingAbort(void);
 static void retryAbortPrepared(void);
 static void doQEDistributedExplicitBegin();
 static void currentDtxActivate(void);
+static void rememberDtxExplicitBegin(void);
 static void setCurrentDtxState(DtxState state);
 
 static bool isDtxQueryDispatcher(void);
@@ -312,6 +314,13 @@ currentDtxActivate(void)
 	MyTmGxact->sessionId = gp_session_id;
 	setCurrentDtxState(DTX_STATE_ACTIVE_DISTRIBUTED);
 	GxactLockTableInsert(MyTmGxact->gxid);
+
+	/*
+	 * The transaction block's BEGIN was deferred (see deferDtxExplicitBegin),
+	 * so this is where the explicit distributed transaction really starts.
+	 */
+	if (MyTmGxactLocal->explicitBeginDeferred)
+		rememberDtxExplicitBegin();
 }
 
 static void
@@ -1439,6 +1448,7 @@ resetTmGxact(void)
 	MyTmGxact->sessionId = 0;
 
 	MyTmGxactLocal->explicitBeginRemembered = false;
+	MyTmGxactLocal->explicitBeginDeferred = false;
 	MyTmGxactLocal->writerGangLost = false;
 	MyTmGxactLocal->dtxSegmentsMap = NULL;
 	MyTmGxactLocal->dtxSegments = NIL;
@@ -2004,6 +2014,54 @@ sendDtxExplicitBegin(void)
 	rememberDtxExplicitBegin();
 }
 
+/*
+ * Called for the explicit BEGIN of a transaction block on the QD, instead of
+ * sendDtxExplicitBegin(), to see if starting the distributed transaction can
+ * be put off.
+ *
+ * A READ COMMITTED, read-only transaction block takes a new distributed
+ * snapshot for every statement and has nothing to commit on the segments, so
+ * its queries can run on the QEs just like auto-commit queries do.  That
+ * saves assigning a gxid, and the commit or abort broadcast at the end.
+ *
+ * Anything that does need the distributed transaction, like a write to a
+ * temporary table, a row-locking SELECT FOR UPDATE/SHARE, a cursor, a
+ * SAVEPOINT or a dispatched utility statement, starts it at that point (see currentDtxActivate and
+ * activateDeferredDtxExplicitBegin).
+ *
+ * Returns false if the distributed transaction has to be started now.
+ */
+bool
+deferDtxExplicitBegin(void)
+{
+	if (Gp_role != GP_ROLE_DISPATCH)
+		return false;
+
+	if (!gp_enable_read_only_dtx_deferral ||
+		!XactReadOnly ||
+		XactIsoLevel != XACT_READ_COMMITTED ||
+		isCurrentDtxActivated())
+		return false;
+
+	ereport(DTM_DEBUG5,
+			(errmsg("deferDtxExplicitBegin deferring explicit BEGIN of read-only transaction")));
+	MyTmGxactLocal->explicitBeginDeferred = true;
+	return true;
+}
+
+/*
+ * Start the distributed transaction of a transaction block whose explicit
+ * BEGIN was deferred, if it hasn't been started yet.
+ */
+void
+activateDeferredDtxExplicitBegin(void)
+{
+	if (Gp_role == GP_ROLE_DISPATCH &&
+		MyTmGxactLocal->explicitBeginDeferred &&
+		!isCurrentDtxActivated())
+		sendDtxExplicitBegin();
+}
+
 /**
  * On the QD, run the Prepare operation.
  */
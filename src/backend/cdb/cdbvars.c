@@ -211,6 +211,8 @@ bool		gp_interconnect_log_stats = false;	/* emit stats at log-level */
 
 bool		gp_interconnect_cache_future_packets = true;
 
+bool		gp_interconnect_bypass_loopback = false;	/* shmem within a host */
+
 /*
  * format: dbid:content:address:port,dbid:content:address:port ...
  * example: 1:-1:10.0.0.1:2000 2:0:10.0.0.2:2000 3:1:10.0.0.2:2001
@@ -302,6 +304,9 @@ bool		gp_enable_fast_sri = true;
 /* Enable single-mirror pair dispatch. */
 bool		gp_enable_direct_dispatch = true;
 
+/* Max number of distribution key values to hash for multi-segment direct dispatch. */
+int			gp_direct_dispatch_max_values = 1000;
+
 /* Force core dump on memory context error */
 bool		coredump_on_memerror = false;
 
@@ -493,6 +498,10 @@ int gp_log_fts;
  */
 int gp_log_interconnect;
 
+/* Runtime skew detection on Redistribute Motion senders */
+double		gp_motion_skew_warning_ratio = 0;
+int			gp_motion_skew_min_rows = 10000;
+
 /*
  * gpvars_check_gp_resource_manager_policy
  * gpvars_assign_gp_resource_manager_policy
@@ -579,10 +588,13 @@ increment_command_count()
 		gp_command_count = 1;
 
 	/*
-	 * No need to maintain MyProc->queryCommandId elsewhere, we guarantee
-	 * they are always synced here.
+	 * No need to maintain MyProc->queryCommandId elsewhere on the QD, we
+	 * guarantee they are always synced here.  QEs sync it when the command
+	 * count arrives with a dispatched query.
 	 */
 	MyProc->queryCommandId = gp_command_count;
+	MyProc->sliceId = -1;
+	MyProc->planNodeId = -1;
 }
 
 Datum mpp_execution_segment(PG_FUNCTION_ARGS);
@@ -47,6 +47,8 @@
 #include "cdb/cdbdispatchresult.h"
 #include "cdb/cdbcopy.h"
 #include "executor/execUtils.h"
+#include "funcapi.h"
+#include "utils/builtins.h"
 
 #define QUERY_STRING_TRUNCATE_SIZE (1024)
 
@@ -98,6 +100,35 @@ typedef struct DispatchCommandQueryParms
 	int			serializedDtxContextInfolen;
 } DispatchCommandQueryParms;
 
+/*
+ * Serialized form of a cached plan, kept with the PlannedStmt.
+ *
+ * A prepared point lookup or update by distribution key is dispatched to a
+ * single segment, but every execution still pre-evaluates functions in a
+ * copy of the plan tree, then serializes and compresses it.  When the plan
+ * contains nothing for exec_make_plan_constant() to evaluate, the result is
+ * the same every time, so from the second dispatch on we keep the serialized
+ * plan and ship it as is.
+ *
+ * The plan's operator memory is assigned at every ExecutorStart() from
+ * query_mem, so the serialized plan is only good for the same query_mem.
+ *
+ * gp_dispatch_plan_cache_stats() shows how many cacheable plans this
+ * session has dispatched, and how many of those reused the serialized plan.
+ */
+typedef struct DispatchPlanCache
+{
+	bool		cacheable;		/* can the serialized plan be reused? */
+	int			ndispatched;	/* times this plan has been dispatched */
+	uint64		query_mem;		/* query_mem the plan was serialized with */
+	char	   *splan;			/* serialized plan, or NULL */
+	int			splan_len;
+	int			splan_len_uncompressed;
+} DispatchPlanCache;
+
+static int64 dispatchPlanCacheDispatches = 0;
+static int64 dispatchPlanCacheHits = 0;
+
 static int fillSliceVector(SliceTable *sliceTable,
 				int sliceIndex,
 				SliceVec *sliceVector,
@@ -107,6 +138,8 @@ static char *buildGpQueryString(DispatchCommandQueryParms *pQueryParms,
 				   int *finalLen);
 
 static DispatchCommandQueryParms *cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc, bool planRequiresTxn);
+static DispatchPlanCache *getDispatchPlanCache(PlannedStmt *stmt, bool is_SRI);
+static bool isSingleSegmentPlan(PlannedStmt *stmt);
 static DispatchCommandQueryParms *cdbdisp_buildUtilityQueryParms(struct Node *stmt, int flags, List *oid_assignments);
 static DispatchCommandQueryParms *cdbdisp_buildCommandQueryParms(const char *strCommand, int flags);
 
@@ -185,6 +218,7 @@ CdbDispatchPlan(struct QueryDesc *queryDesc,
 	bool		is_SRI = false;
 	List	   *paramExecTypes;
 	Bitmapset  *sendParams;
+	DispatchPlanCache *dcache;
 
 	Assert(Gp_role == GP_ROLE_DISPATCH);
 	Assert(queryDesc != NULL && queryDesc->estate != NULL);
@@ -214,10 +248,25 @@ CdbDispatchPlan(struct QueryDesc *queryDesc,
 		is_SRI = IsA(stmt->planTree, Result) &&stmt->planTree->lefttree == NULL;
 	}
 
-	if (queryDesc->operation == CMD_INSERT ||
-		queryDesc->operation == CMD_SELECT ||
-		queryDesc->operation == CMD_UPDATE ||
-		queryDesc->operation == CMD_DELETE)
+	/*
+	 * If we already have this plan serialized, there is nothing to
+	 * evaluate, see DispatchPlanCache.
+	 */
+	dcache = getDispatchPlanCache(stmt, is_SRI);
+	if (dcache && dcache->splan && dcache->query_mem != stmt->query_mem)
+	{
+		pfree(dcache->splan);
+		dcache->splan = NULL;
+	}
+
+	if (dcache && dcache->splan)
+	{
+		/* cacheable plans have no cursor positions to collect */
+	}
+	else if (queryDesc->operation == CMD_INSERT ||
+			 queryDesc->operation == CMD_SELECT ||
+			 queryDesc->operation == CMD_UPDATE ||
+			 queryDesc->operation == CMD_DELETE)
 	{
 		List	   *cursors;
 
@@ -268,6 +317,88 @@ CdbDispatchPlan(struct QueryDesc *queryDesc,
 	cdbdisp_dispatchX(queryDesc, planRequiresTxn, cancelOnError);
 }
 
+/*
+ * Get the DispatchPlanCache of a plan that qualifies for it, creating it on
+ * first use, or NULL if the plan's serialized form can't be reused.
+ */
+static DispatchPlanCache *
+getDispatchPlanCache(PlannedStmt *stmt, bool is_SRI)
+{
+	DispatchPlanCache *dcache = stmt->dispatchCache;
+
+	if (!gp_enable_dispatch_plan_cache)
+		return NULL;
+
+	if (dcache == NULL)
+	{
+		/* allocate it alongside the plan, so that it goes away with it */
+		dcache = MemoryContextAllocZero(GetMemoryChunkContext(stmt),
+										sizeof(DispatchPlanCache));
+		dcache->cacheable = (!is_SRI &&
+							 !stmt->oneoffPlan &&
+							 isSingleSegmentPlan(stmt) &&
+							 !exec_plan_needs_constant_folding(stmt));
+		stmt->dispatchCache = dcache;
+	}
+
+	if (!dcache->cacheable)
+		return NULL;
+
+	dcache->ndispatched++;
+	dispatchPlanCacheDispatches++;
+	return dcache;
+}
+
+/*
+ * gp_dispatch_plan_cache_stats
+ *	  Number of cacheable plans dispatched by this session, and how many of
+ *	  them were dispatched with their cached serialized form.
+ */
+Datum
+gp_dispatch_plan_cache_stats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Datum		values[2];
+	bool		nulls[2];
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	MemSet(nulls, false, sizeof(nulls));
+	values[0] = Int64GetDatum(dispatchPlanCacheDispatches);
+	values[1] = Int64GetDatum(dispatchPlanCacheHits);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(BlessTupleDesc(tupdesc),
+													  values, nulls)));
+}
+
+/*
+ * Is every slice of the plan that runs on the segments directly dispatched
+ * to a single segment?  Those are the short OLTP statements for which the
+ * cost of serializing the plan is significant.
+ */
+static bool
+isSingleSegmentPlan(PlannedStmt *stmt)
+{
+	for (int i = 0; i < stmt->numSlices; i++)
+	{
+		PlanSlice  *slice = &stmt->slices[i];
+
+		if (slice->gangType == GANGTYPE_PRIMARY_READER ||
+			slice->gangType == GANGTYPE_PRIMARY_WRITER)
+		{
+			DirectDispatchInfo *dd = &slice->directDispatch;
+
+			if (!dd->isDirectDispatch)
+				return false;
+			if (dd->paramKeys == NIL && list_length(dd->contentIds) != 1)
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /*
  * SET command can not be dispatched to named portal (like CURSOR). On the one
  * hand, named portal might be busy and also it should not be affected by
@@ -525,6 +656,9 @@ cdbdisp_buildCommandQueryParms(const char *strCommand, int flags)
 	bool withSnapshot = flags & DF_WITH_SNAPSHOT;
 	DispatchCommandQueryParms *pQueryParms;
 
+	/* commands are always part of the transaction block on the QEs */
+	activateDeferredDtxExplicitBegin();
+
 	pQueryParms = palloc0(sizeof(*pQueryParms));
 	pQueryParms->strCommand = strCommand;
 	pQueryParms->serializedQueryDispatchDesc = NULL;
@@ -561,6 +695,9 @@ cdbdisp_buildUtilityQueryParms(struct Node *stmt,
 	Assert(stmt->type < 1000);
 	Assert(stmt->type > 0);
 
+	/* utility statements are always part of the transaction block on the QEs */
+	activateDeferredDtxExplicitBegin();
+
 	/* Wrap it in a PlannedStmt */
 	pstmt = makeNode(PlannedStmt);
 	pstmt->commandType = CMD_UTILITY;
@@ -619,6 +756,7 @@ cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
 {
 	char	   *splan,
 			   *sddesc;
+	DispatchPlanCache *dcache;
 
 	int			splan_len,
 				splan_len_uncompressed,
@@ -634,7 +772,20 @@ cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
 	 * (corresponding to an initPlan or the main plan), so the parameters are
 	 * fixed and we can include them in the prefix.
 	 */
-	splan = serializeNode((Node *) queryDesc->plannedstmt, &splan_len, &splan_len_uncompressed);
+	dcache = queryDesc->plannedstmt->dispatchCache;
+	if (!gp_enable_dispatch_plan_cache || (dcache && !dcache->cacheable))
+		dcache = NULL;
+
+	if (dcache && dcache->splan &&
+		dcache->query_mem == queryDesc->plannedstmt->query_mem)
+	{
+		splan = dcache->splan;
+		splan_len = dcache->splan_len;
+		splan_len_uncompressed = dcache->splan_len_uncompressed;
+		dispatchPlanCacheHits++;
+	}
+	else
+		splan = serializeNode((Node *) queryDesc->plannedstmt, &splan_len, &splan_len_uncompressed);
 
 	uint64		plan_size_in_kb = ((uint64) splan_len_uncompressed) / (uint64) 1024;
 
@@ -653,6 +804,16 @@ cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
 
 	Assert(splan != NULL && splan_len > 0 && splan_len_uncompressed > 0);
 
+	/* keep the serialized plan if it has been dispatched before */
+	if (dcache && dcache->splan == NULL && dcache->ndispatched > 1)
+	{
+		dcache->splan = MemoryContextAlloc(GetMemoryChunkContext(dcache), splan_len);
+		memcpy(dcache->splan, splan, splan_len);
+		dcache->splan_len = splan_len;
+		dcache->splan_len_uncompressed = splan_len_uncompressed;
+		dcache->query_mem = queryDesc->plannedstmt->query_mem;
+	}
+
 	sddesc = serializeNode((Node *) queryDesc->ddesc, &sddesc_len, NULL /* uncompressed_size */ );
 
 	pQueryParms->strCommand = queryDesc->sourceText;
@@ -661,6 +822,14 @@ cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
 	pQueryParms->serializedQueryDispatchDesc = sddesc;
 	pQueryParms->serializedQueryDispatchDesclen = sddesc_len;
 
+	/*
+	 * A cursor needs the distributed transaction to stay open on the QEs, and
+	 * so do the row locks taken by SELECT FOR UPDATE/SHARE.  (Writes to
+	 * temporary tables have already started it, see ExecCheckXactReadOnly.)
+	 */
+	if (queryDesc->extended_query || queryDesc->plannedstmt->rowMarks != NIL)
+		activateDeferredDtxExplicitBegin();
+
 	/*
 	 * Serialize a version of our snapshot, and generate our transction
 	 * isolations. We generally want Plan based dispatch to be in a global
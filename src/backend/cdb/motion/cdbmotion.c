@@ -557,6 +557,18 @@ SendEndOfStream(MotionLayerState *mlStates,
 	statSendEOS(mlStates, pMNEntry);
 }
 
+/*
+ * Return the number of bytes, including chunk headers, sent and received
+ * so far by the given motion node in this process.
+ */
+uint64
+GetMotionNodeBytes(MotionLayerState *mlStates, int16 motNodeID)
+{
+	MotionNodeEntry *pMNEntry = getMotionNodeEntry(mlStates, motNodeID);
+
+	return pMNEntry->stat_total_bytes_sent + pMNEntry->stat_total_bytes_recvd;
+}
+
 /*
  * Receive one tuple from a sender. An unordered receiver will call this with
  * srcRoute == ANY_ROUTE.
@@ -317,7 +317,20 @@ SendTupleChunkToAMS(MotionLayerState *mlStates,
 		elog(DEBUG5, "SendTupleChunkToAMS: chunk length %d", currItem->chunk_length);
 #endif
 
-		if (targetRoute == BROADCAST_SEGIDX)
+		if (targetRoute == BROADCAST_SEGIDX && pEntry->broadcastTargets != NULL)
+		{
+			for (i = 0; i < pEntry->numConns; i++)
+			{
+				conn = pEntry->conns + i;
+				if (pEntry->broadcastTargets[i] && conn->stillActive)
+				{
+					transportStates->SendChunk(transportStates, pEntry, conn, currItem, motNodeID);
+					if (!conn->stillActive)
+						recount = 1;
+				}
+			}
+		}
+		else if (targetRoute == BROADCAST_SEGIDX)
 		{
 			doBroadcast(transportStates, pEntry, currItem, &recount);
 		}
@@ -345,7 +358,8 @@ SendTupleChunkToAMS(MotionLayerState *mlStates,
 	for (i = 0; i < pEntry->numConns; i++)
 	{
 		conn = pEntry->conns + i;
-		if (conn->stillActive)
+		if (conn->stillActive &&
+			(pEntry->broadcastTargets == NULL || pEntry->broadcastTargets[i]))
 			break;
 	}
 
@@ -639,6 +653,7 @@ createChunkTransportState(ChunkTransportState *transportStates,
 	pEntry->scanStart = 0;
 	pEntry->sendSlice = sendSlice;
 	pEntry->recvSlice = recvSlice;
+	pEntry->broadcastTargets = NULL;
 
 	pEntry->conns = palloc0(pEntry->numConns * sizeof(pEntry->conns[0]));
 
@@ -0,0 +1,444 @@
+/*-------------------------------------------------------------------------
+ *
+ * ic_shmring.c
+ *
+ *    Shared memory rings for UDP interconnect connections within a host
+ *
+ * With several primaries per host, many Motion connections have both ends
+ * on the same host, and the UDP interconnect still sends their packets
+ * through the loopback interface, with all the acks, timers and copies into
+ * and out of the kernel that go with it.  When gp_interconnect_bypass_loopback
+ * is on, the data packets of such a connection go through a ring of packet
+ * slots in POSIX shared memory instead.  Each segment has its own postmaster,
+ * so the ring cannot live in the shared memory of either one, it is a
+ * segment of its own.
+ *
+ * Each ring has a single producer, the sender, and a single consumer, the
+ * receiver, so head and tail are advanced without locks.  The receiver
+ * reads a packet in place, and releases its slot when the Motion is done
+ * with it.
+ *
+ * The UDP socket is still used for everything else: the first packets of a
+ * connection, stop messages, and the wakeup of a peer that is waiting.
+ * Before going to sleep, a side sets its waiting flag, and the other side
+ * wakes it up if it finds the flag set after having put or released a
+ * packet: the sender with a header-only packet, the receiver with an ack.
+ * See ic_udpifc.c for how a connection switches over to its ring.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/cdb/motion/ic_shmring.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "common/file_perm.h"
+#include "miscadmin.h"
+#include "port/atomics.h"
+#include "storage/dsm_impl.h"
+#include "storage/fd.h"
+#include "utils/memutils.h"
+
+#include "cdb/ml_ipc.h"
+
+#include "ic_shmring.h"
+
+/*
+ * Layout of the shared memory segment: this header, followed by the slots.
+ * head and tail are free running packet counters, on cache lines of their
+ * own.
+ */
+typedef struct ICShmRingHeader
+{
+	uint32		nslots;
+	uint32		slotsize;
+
+	/* set by the sender once it has mapped the ring */
+	pg_atomic_uint32 attached;
+
+	/* set by the receiver when it is done with the ring */
+	pg_atomic_uint32 detached;
+
+	char		pad1[PG_CACHE_LINE_SIZE];
+
+	/* advanced by the sender */
+	pg_atomic_uint32 head;
+	pg_atomic_uint32 receiverWaiting;
+
+	char		pad2[PG_CACHE_LINE_SIZE];
+
+	/* advanced by the receiver */
+	pg_atomic_uint32 tail;
+	pg_atomic_uint32 senderWaiting;
+} ICShmRingHeader;
+
+#define IC_SHMRING_HEADER_SIZE \
+	TYPEALIGN(PG_CACHE_LINE_SIZE, sizeof(ICShmRingHeader))
+
+/* Process-local handle of a ring */
+struct ICShmRing
+{
+	ICShmRingHeader *hdr;
+	char	   *slots;
+	Size		mapped_size;
+	bool		isReceiver;
+	char		name[64];
+};
+
+static void ic_shmring_name(char *name, const icpkthdr *conn_info);
+
+/*
+ * Create the ring of an incoming connection, in the receiver.
+ *
+ * Returns NULL if that fails, the connection then keeps using UDP.
+ */
+ICShmRing *
+ic_shmring_create(const icpkthdr *conn_info, int nslots, int slotsize)
+{
+#ifdef USE_DSM_POSIX
+	ICShmRing  *ring;
+	ICShmRingHeader *hdr;
+	char		name[64];
+	Size		size;
+	void	   *address;
+	int			fd;
+	int			rc;
+
+	slotsize = TYPEALIGN(PG_CACHE_LINE_SIZE, slotsize);
+	size = IC_SHMRING_HEADER_SIZE + (Size) nslots * slotsize;
+
+	ic_shmring_name(name, conn_info);
+
+	fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, PG_FILE_MODE_OWNER);
+	if (fd == -1)
+	{
+		elog(DEBUG1, "could not create shared memory segment \"%s\": %m", name);
+		return NULL;
+	}
+
+	rc = ftruncate(fd, size);
+#if defined(HAVE_POSIX_FALLOCATE) && defined(__linux__)
+	/* reserve the memory now, rather than SIGBUS on a full /dev/shm later */
+	if (rc == 0)
+	{
+		do
+		{
+			rc = posix_fallocate(fd, 0, size);
+		} while (rc == EINTR && !(ProcDiePending || QueryCancelPending));
+		errno = rc;
+	}
+#endif
+
+	address = MAP_FAILED;
+	if (rc == 0)
+		address = mmap(NULL, size, PROT_READ | PROT_WRITE,
+					   MAP_SHARED, fd, 0);
+	if (address == MAP_FAILED)
+	{
+		int			save_errno = errno;
+
+		close(fd);
+		shm_unlink(name);
+		errno = save_errno;
+		elog(DEBUG1, "could not set up shared memory segment \"%s\": %m", name);
+		return NULL;
+	}
+	close(fd);
+
+	/* the segment is zero-filled, i.e. empty and nobody waiting */
+	hdr = (ICShmRingHeader *) address;
+	hdr->nslots = nslots;
+	hdr->slotsize = slotsize;
+
+	ring = MemoryContextAllocZero(InterconnectContext, sizeof(ICShmRing));
+	ring->hdr = hdr;
+	ring->slots = (char *) address + IC_SHMRING_HEADER_SIZE;
+	ring->mapped_size = size;
+	ring->isReceiver = true;
+	strlcpy(ring->name, name, sizeof(ring->name));
+
+	return ring;
+#else
+	return NULL;
+#endif
+}
+
+/*
+ * Map the ring the receiver has created for an outgoing connection.
+ *
+ * Returns NULL if the ring is gone, because the receiver has already torn
+ * down its side, or if it cannot hold packets of 'slotsize' bytes.
+ */
+ICShmRing *
+ic_shmring_attach(const icpkthdr *conn_info, int slotsize)
+{
+#ifdef USE_DSM_POSIX
+	ICShmRing  *ring;
+	ICShmRingHeader *hdr;
+	char		name[64];
+	struct stat st;
+	void	   *address;
+	int			fd;
+
+	ic_shmring_name(name, conn_info);
+
+	fd = shm_open(name, O_RDWR, 0);
+	if (fd == -1)
+	{
+		elog(DEBUG1, "could not open shared memory segment \"%s\": %m", name);
+		return NULL;
+	}
+
+	address = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size >= IC_SHMRING_HEADER_SIZE)
+		address = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE,
+					   MAP_SHARED, fd, 0);
+	close(fd);
+	if (address == MAP_FAILED)
+	{
+		elog(DEBUG1, "could not map shared memory segment \"%s\": %m", name);
+		return NULL;
+	}
+
+	hdr = (ICShmRingHeader *) address;
+	if (hdr->slotsize < slotsize ||
+		IC_SHMRING_HEADER_SIZE + (Size) hdr->nslots * hdr->slotsize > st.st_size)
+	{
+		munmap(address, st.st_size);
+		return NULL;
+	}
+
+	/* nobody else is going to look for it */
+	pg_atomic_write_u32(&hdr->attached, 1);
+	shm_unlink(name);
+
+	ring = MemoryContextAllocZero(InterconnectContext, sizeof(ICShmRing));
+	ring->hdr = hdr;
+	ring->slots = (char *) address + IC_SHMRING_HEADER_SIZE;
+	ring->mapped_size = st.st_size;
+	ring->isReceiver = false;
+	strlcpy(ring->name, name, sizeof(ring->name));
+
+	return ring;
+#else
+	return NULL;
+#endif
+}
+
+/*
+ * Unmap a ring.  When the receiver is done with it, the sender drops what
+ * it has not put into the ring yet.
+ */
+void
+ic_shmring_detach(ICShmRing *ring)
+{
+#ifdef USE_DSM_POSIX
+	ICShmRingHeader *hdr = ring->hdr;
+
+	if (ring->isReceiver)
+	{
+		pg_atomic_write_u32(&hdr->detached, 1);
+
+		/* if the sender never came, remove the segment ourselves */
+		if (pg_atomic_read_u32(&hdr->attached) == 0)
+			shm_unlink(ring->name);
+	}
+
+	if (munmap(hdr, ring->mapped_size) != 0)
+		elog(LOG, "could not unmap shared memory segment \"%s\": %m",
+			 ring->name);
+#endif
+
+	pfree(ring);
+}
+
+/*
+ * Put a packet into the ring.
+ *
+ * Returns false if the ring is full, or if the receiver has detached.  In
+ * the former case, the receiver wakes us up when it has made room.  Sets
+ * *wakeup if the receiver is waiting for the packet, and needs to be woken
+ * up.
+ */
+bool
+ic_shmring_put(ICShmRing *ring, const icpkthdr *pkt, bool *wakeup)
+{
+	ICShmRingHeader *hdr = ring->hdr;
+	uint32		head = pg_atomic_read_u32(&hdr->head);
+
+	Assert(!ring->isReceiver);
+	Assert(pkt->len <= hdr->slotsize);
+
+	*wakeup = false;
+
+	if (pg_atomic_read_u32(&hdr->detached) != 0)
+		return false;
+
+	if (head - pg_atomic_read_u32(&hdr->tail) >= hdr->nslots)
+	{
+		/* check again after raising the flag, in case the receiver just read */
+		pg_atomic_write_u32(&hdr->senderWaiting, 1);
+		pg_memory_barrier();
+		if (head - pg_atomic_read_u32(&hdr->tail) >= hdr->nslots)
+			return false;
+		pg_atomic_write_u32(&hdr->senderWaiting, 0);
+	}
+
+	/* the receiver is done with the slot once it has advanced tail */
+	pg_memory_barrier();
+	memcpy(ring->slots + (Size) (head % hdr->nslots) * hdr->slotsize,
+		   pkt, pkt->len);
+	pg_write_barrier();
+	pg_atomic_write_u32(&hdr->head, head + 1);
+
+	pg_memory_barrier();
+	if (pg_atomic_read_u32(&hdr->receiverWaiting) != 0)
+		*wakeup = (pg_atomic_exchange_u32(&hdr->receiverWaiting, 0) != 0);
+
+	return true;
+}
+
+bool
+ic_shmring_is_detached(ICShmRing *ring)
+{
+	return pg_atomic_read_u32(&ring->hdr->detached) != 0;
+}
+
+/*
+ * Return the oldest packet in the ring, or NULL if it is empty.  The packet
+ * stays in the ring until ic_shmring_release().
+ */
+icpkthdr *
+ic_shmring_peek(ICShmRing *ring)
+{
+	ICShmRingHeader *hdr = ring->hdr;
+	uint32		tail = pg_atomic_read_u32(&hdr->tail);
+
+	Assert(ring->isReceiver);
+
+	if (pg_atomic_read_u32(&hdr->head) == tail)
+		return NULL;
+
+	/* read the packet only after the sender has published it */
+	pg_read_barrier();
+
+	return (icpkthdr *) (ring->slots + (Size) (tail % hdr->nslots) * hdr->slotsize);
+}
+
+/*
+ * Release the oldest packet of the ring.
+ *
+ * Returns true if the sender is waiting for room, and needs to be woken up.
+ * To save wakeups, a waiting sender is only woken up once it can fill at
+ * least half of the ring again.
+ */
+bool
+ic_shmring_release(ICShmRing *ring)
+{
+	ICShmRingHeader *hdr = ring->hdr;
+	uint32		tail = pg_atomic_read_u32(&hdr->tail) + 1;
+
+	Assert(ring->isReceiver);
+	Assert(tail - 1 != pg_atomic_read_u32(&hdr->head));
+
+	/* we must be done reading the slot before the sender can reuse it */
+	pg_memory_barrier();
+	pg_atomic_write_u32(&hdr->tail, tail);
+
+	pg_memory_barrier();
+	if (pg_atomic_read_u32(&hdr->senderWaiting) != 0 &&
+		pg_atomic_read_u32(&hdr->head) - tail <= hdr->nslots / 2)
+		return pg_atomic_exchange_u32(&hdr->senderWaiting, 0) != 0;
+
+	return false;
+}
+
+/*
+ * Ask the sender to wake us up when it puts the next packet into the ring.
+ *
+ * Returns true if there already is a packet to read, in which case the
+ * receiver must not go to sleep.
+ */
+bool
+ic_shmring_wait(ICShmRing *ring)
+{
+	ICShmRingHeader *hdr = ring->hdr;
+
+	Assert(ring->isReceiver);
+
+	pg_atomic_write_u32(&hdr->receiverWaiting, 1);
+	pg_memory_barrier();
+
+	return pg_atomic_read_u32(&hdr->head) != pg_atomic_read_u32(&hdr->tail);
+}
+
+/*
+ * Remove the segments of the rings whose receiver is gone.
+ *
+ * A backend that crashes leaves the segments it has created behind.  Called
+ * by the postmaster at startup and before it reinitializes after a crash.
+ * The other segments on the host may be using rings of their own, so only
+ * remove a segment once the receiver that created it has exited; a receiver
+ * that is still alive removes its segments itself.
+ *
+ * POSIX has no way to list shared memory segments, this relies on them
+ * showing up in /dev/shm, like they do on Linux.
+ */
+void
+ic_shmring_remove_orphans(void)
+{
+#if defined(USE_DSM_POSIX) && defined(__linux__)
+	const char *shmdir = "/dev/shm";
+	DIR		   *dir;
+	struct dirent *de;
+
+	dir = AllocateDir(shmdir);
+	while ((de = ReadDirExtended(dir, shmdir, LOG)) != NULL)
+	{
+		char		name[MAXPGPATH];
+		int			sessionId;
+		unsigned int icId;
+		int			motNodeId;
+		int			srcPid;
+		int			dstPid;
+
+		if (sscanf(de->d_name, "gp_ic.%d.%u.%d.%d.%d",
+				   &sessionId, &icId, &motNodeId, &srcPid, &dstPid) != 5)
+			continue;
+
+		/* the receiver created the segment, see ic_shmring_name() */
+		if (dstPid <= 0 || kill(dstPid, 0) == 0 || errno != ESRCH)
+			continue;
+
+		snprintf(name, sizeof(name), "/%s", de->d_name);
+		if (shm_unlink(name) == 0)
+			elog(LOG, "removed orphaned interconnect shared memory segment \"%s\"",
+				 name);
+	}
+	FreeDir(dir);
+#endif
+}
+
+/*
+ * The name of the segment of a connection, from its header.  The pids of
+ * both ends are unique on the host, the interconnect instance id tells the
+ * statements of a session apart.
+ */
+static void
+ic_shmring_name(char *name, const icpkthdr *conn_info)
+{
+	snprintf(name, 64, "/gp_ic.%d.%u.%d.%d.%d",
+			 conn_info->sessionId, conn_info->icId, conn_info->motNodeId,
+			 conn_info->srcPid, conn_info->dstPid);
+}
@@ -0,0 +1,37 @@
+/*-------------------------------------------------------------------------
+ *
+ * ic_shmring.h
+ *
+ *    Shared memory rings for UDP interconnect connections within a host
+ *
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef IC_SHMRING_H
+#define IC_SHMRING_H
+
+#include "cdb/cdbinterconnect.h"
+
+typedef struct ICShmRing ICShmRing;
+
+extern ICShmRing *ic_shmring_create(const icpkthdr *conn_info,
+									int nslots, int slotsize);
+extern ICShmRing *ic_shmring_attach(const icpkthdr *conn_info,
+									int slotsize);
+extern void ic_shmring_detach(ICShmRing *ring);
+
+/* sender */
+extern bool ic_shmring_put(ICShmRing *ring, const icpkthdr *pkt,
+						   bool *wakeup);
+extern bool ic_shmring_is_detached(ICShmRing *ring);
+
+/* receiver */
+extern icpkthdr *ic_shmring_peek(ICShmRing *ring);
+extern bool ic_shmring_release(ICShmRing *ring);
+extern bool ic_shmring_wait(ICShmRing *ring);
+
+#endif   /* IC_SHMRING_H */
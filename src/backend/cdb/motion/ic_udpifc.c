@@ -57,6 +57,8 @@
 #include "cdb/cdbdispatchresult.h"
 #include "cdb/cdbicudpfaultinjection.h"
 
+#include "ic_shmring.h"
+
 #ifdef WIN32
 #define WIN32_LEAN_AND_MEAN
 #ifndef _WIN32_WINNT
@@ -151,6 +153,7 @@ int
 #define UDPIC_FLAGS_DISORDER    		(32)
 #define UDPIC_FLAGS_DUPLICATE   		(64)
 #define UDPIC_FLAGS_CAPACITY    		(128)
+#define UDPIC_FLAGS_SHM					(256)	/* see ic_shmring.c */
 
 /*
  * ConnHtabBin
@@ -532,6 +535,12 @@ static ICGlobalControlInfo ic_control_info;
 
 #define MAX_SEQS_IN_DISORDER_ACK (4)
 
+/*
+ * A shared memory ring stands for both the receive queue and the packets
+ * the sender has in flight, and a full ring costs a wakeup round trip.
+ */
+#define SHM_RING_MIN_SLOTS (16)
+
 /*
  * UnackQueueRing
  *
@@ -617,6 +626,10 @@ typedef struct AckSendParam
  * duplicatedPktNum          - duplicate packet number.
  * recvAckNum                - the number of Acks received.
  * statusQueryMsgNum         - the number of status query messages sent.
+ * shmConnNum                - the number of connections using a shared memory ring.
+ * shmSndPktNum              - the number of packets put into shared memory rings.
+ * shmRecvPktNum             - the number of packets read from shared memory rings.
+ * shmWakeupNum              - the number of wakeups sent for shared memory rings.
  *
  */
 typedef struct ICStatistics
@@ -638,6 +651,10 @@ typedef struct ICStatistics
 	int32		duplicatedPktNum;
 	int32		recvAckNum;
 	int32		statusQueryMsgNum;
+	int32		shmConnNum;
+	int32		shmSndPktNum;
+	int32		shmRecvPktNum;
+	int32		shmWakeupNum;
 } ICStatistics;
 
 /* Statistics for UDP interconnect. */
@@ -684,9 +701,11 @@ static inline void sendAckWithParam(AckSendParam *param);
 static void sendAck(MotionConn *conn, int32 flags, uint32 seq, uint32 extraSeq);
 static void sendDisorderAck(MotionConn *conn, uint32 seq, uint32 extraSeq, uint32 lostPktCnt);
 static void sendStatusQueryMessage(MotionConn *conn, int fd, uint32 seq);
+static void sendShmRingWakeup(MotionConn *conn, int fd);
 static inline void sendControlMessage(icpkthdr *pkt, int fd, struct sockaddr *addr, socklen_t peerLen);
 
 static void putRxBufferAndSendAck(MotionConn *conn, AckSendParam *param);
+static void putShmRingBufferAndSendAck(MotionConn *conn, AckSendParam *param);
 static inline void putRxBufferToFreeList(RxBufferPool *p, icpkthdr *buf);
 static inline icpkthdr *getRxBufferFromFreeList(RxBufferPool *p);
 static icpkthdr *getRxBuffer(RxBufferPool *p);
@@ -704,6 +723,7 @@ static inline ICBuffer *icBufferListAppend(ICBufferList *list, ICBuffer *buf);
 static void icBufferListReturn(ICBufferList *list, bool inExpirationQueue);
 
 static ChunkTransportState *SetupUDPIFCInterconnect_Internal(SliceTable *sliceTable);
+static bool isSameHostSender(ExecSlice *mySlice, CdbProcess *sender);
 static inline TupleChunkListItem RecvTupleChunkFromAnyUDPIFC_Internal(ChunkTransportState *transportStates,
 									 int16 motNodeID,
 									 int16 *srcRoute);
@@ -716,6 +736,9 @@ static void TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportSt
 static void freeDisorderedPackets(MotionConn *conn);
 
 static void prepareRxConnForRead(MotionConn *conn);
+static inline bool shmRingHasPacket(MotionConn *conn);
+static MotionConn *getShmRingConnForRead(ChunkTransportStateEntry *pEntry, MotionConn *conn);
+static bool waitForShmRings(ChunkTransportStateEntry *pEntry, MotionConn *conn);
 static TupleChunkListItem RecvTupleChunkFromAnyUDPIFC(ChunkTransportState *transportStates,
 							int16 motNodeID,
 							int16 *srcRoute);
@@ -751,6 +774,7 @@ static inline void prepareXmit(MotionConn *conn);
 static inline void addCRC(icpkthdr *pkt);
 static inline bool checkCRC(icpkthdr *pkt);
 static void sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn);
+static void sendBuffersToShmRing(ChunkTransportStateEntry *pEntry, MotionConn *conn);
 static void sendOnce(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer *buf, MotionConn *conn);
 static inline uint64 computeExpirationPeriod(MotionConn *conn, uint32 retry);
 
@@ -1925,6 +1949,27 @@ sendStatusQueryMessage(MotionConn *conn, int fd, uint32 seq)
 
 }
 
+/*
+ * sendShmRingWakeup
+ * 		Tell the receiver that there are packets in the shared memory ring.
+ *
+ * The receiver asks for it before going to sleep, see ic_shmring_wait().
+ */
+static void
+sendShmRingWakeup(MotionConn *conn, int fd)
+{
+	icpkthdr	msg;
+
+	memcpy(&msg, (char *) &conn->conn_info, sizeof(msg));
+	msg.flags = UDPIC_FLAGS_SHM;
+	msg.seq = conn->sentSeq;
+	msg.extraSeq = 0;
+	msg.len = sizeof(msg);
+
+	sendControlMessage(&msg, fd, (struct sockaddr *) &conn->peer, conn->peer_len);
+	ic_statistics.shmWakeupNum++;
+}
+
 /*
  * putRxBufferAndSendAck
  * 		Return a buffer and send an acknowledgment.
@@ -1977,6 +2022,35 @@ putRxBufferAndSendAck(MotionConn *conn, AckSendParam *param)
 	}
 }
 
+/*
+ * putShmRingBufferAndSendAck
+ * 		Release a packet read from the shared memory ring, and wake the sender
+ * 		up if it is waiting for room.
+ *
+ *  SHOULD BE CALLED WITH ic_control_info.lock *LOCKED*
+ */
+static void
+putShmRingBufferAndSendAck(MotionConn *conn, AckSendParam *param)
+{
+	uint32		seq = ((icpkthdr *) conn->pBuff)->seq;
+
+	Assert(conn->pkt_q_size == 0);
+
+	conn->pBuff = NULL;
+
+	/*
+	 * Keep the sequence numbers up to date for status queries and stop
+	 * messages, and the packet queue positioned for stray UDP packets.
+	 */
+	conn->conn_info.seq = seq + 1;
+	conn->conn_info.extraSeq = seq;
+	conn->pkt_q_head = conn->pkt_q_tail = seq % conn->pkt_q_capacity;
+	ic_statistics.shmRecvPktNum++;
+
+	if (ic_shmring_release(conn->shmRing))
+		setAckSendParam(param, conn, UDPIC_FLAGS_ACK | UDPIC_FLAGS_CAPACITY | conn->conn_info.flags, seq, seq);
+}
+
 /*
  * MlPutRxBufferIFC
  *
@@ -1989,6 +2063,7 @@ MlPutRxBufferIFC(ChunkTransportState *transportStates, int motNodeID, int route)
 	ChunkTransportStateEntry *pEntry = NULL;
 	MotionConn *conn = NULL;
 	AckSendParam param;
+	ICShmRing  *ring = NULL;
 
 	getChunkTransportState(transportStates, motNodeID, &pEntry);
 
@@ -1996,16 +2071,55 @@ MlPutRxBufferIFC(ChunkTransportState *transportStates, int motNodeID, int route)
 
 	memset(&param, 0, sizeof(AckSendParam));
 
+	if (conn->shmState == mcsShmActive)
+		SIMPLE_FAULT_INJECTOR("interconnect_shmring_recv");
+
+	/*
+	 * The sender runs on this host.  Now that its first packet has arrived,
+	 * the rx thread knows where to send acks to, offer it a shared memory
+	 * ring for the rest of the stream.  The sender switches over once all
+	 * the packets it has sent over UDP are acked, so the ring is only read
+	 * after the packet queue.
+	 */
+	if (conn->shmState == mcsShmEligible && conn->pBuff != NULL &&
+		!conn->stopRequested &&
+		(((icpkthdr *) conn->pBuff)->flags & UDPIC_FLAGS_EOS) == 0)
+		ring = ic_shmring_create(&conn->conn_info,
+								 Max(Gp_interconnect_queue_depth, SHM_RING_MIN_SLOTS),
+								 Gp_max_packet_size);
+
 	pthread_mutex_lock(&ic_control_info.lock);
 
-	if (conn->pBuff != NULL)
+	if (conn->pBuff == NULL)
+	{
+		pthread_mutex_unlock(&ic_control_info.lock);
+		elog(FATAL, "Interconnect error: tried to release a NULL buffer");
+	}
+	else if (conn->pkt_q_size > 0 && conn->pBuff == conn->pkt_q[conn->pkt_q_head])
 	{
 		putRxBufferAndSendAck(conn, &param);
 	}
 	else
 	{
-		pthread_mutex_unlock(&ic_control_info.lock);
-		elog(FATAL, "Interconnect error: tried to release a NULL buffer");
+		putShmRingBufferAndSendAck(conn, &param);
+	}
+
+	if (conn->shmState == mcsShmEligible)
+	{
+		if (ring == NULL)
+			conn->shmState = mcsShmFailed;
+		else
+		{
+			conn->shmRing = ring;
+			conn->shmState = mcsShmActive;
+			conn->conn_info.flags |= UDPIC_FLAGS_SHM;
+			ic_statistics.shmConnNum++;
+
+			/* releasing an odd packet sends no ack, tell the sender now */
+			if (param.msg.len == 0)
+				setAckSendParam(&param, conn, UDPIC_FLAGS_ACK | UDPIC_FLAGS_CAPACITY | conn->conn_info.flags,
+								conn->conn_info.seq - 1, conn->conn_info.extraSeq);
+		}
 	}
 
 	pthread_mutex_unlock(&ic_control_info.lock);
@@ -3011,6 +3125,33 @@ handleCachedPackets(void)
 	}
 }
 
+/*
+ * isSameHostSender
+ * 		Does the sending process run on the same host as we do?
+ *
+ * The interconnect addresses of both come from the segment configuration,
+ * so the same host has the same address.
+ */
+static bool
+isSameHostSender(ExecSlice *mySlice, CdbProcess *sender)
+{
+	ListCell   *cell;
+
+	if (sender->listenerAddr == NULL)
+		return false;
+
+	foreach(cell, mySlice->primaryProcesses)
+	{
+		CdbProcess *proc = (CdbProcess *) lfirst(cell);
+
+		if (proc != NULL && proc->pid == MyProcPid)
+			return proc->listenerAddr != NULL &&
+				strcmp(proc->listenerAddr, sender->listenerAddr) == 0;
+	}
+
+	return false;
+}
+
 /*
  * SetupUDPIFCInterconnect_Internal
  * 		Internal function for setting up UDP interconnect.
@@ -3178,6 +3319,10 @@ SetupUDPIFCInterconnect_Internal(SliceTable *sliceTable)
 				conn->conn_info.icId = sliceTable->ic_instance_id;
 				conn->conn_info.flags = UDPIC_FLAGS_RECEIVER_TO_SENDER;
 
+				if (gp_interconnect_bypass_loopback &&
+					isSameHostSender(mySlice, conn->cdbProc))
+					conn->shmState = mcsShmEligible;
+
 				connAddHash(&ic_control_info.connHtab, conn);
 			}
 		}
@@ -3494,6 +3639,12 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 					icBufferListReturn(&conn->sndQueue, false);
 					icBufferListReturn(&conn->unackQueue, Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_CAPACITY ? false : true);
 
+					if (conn->shmRing)
+					{
+						ic_shmring_detach(conn->shmRing);
+						conn->shmRing = NULL;
+					}
+
 					connDelHash(&ic_control_info.connHtab, conn);
 				}
 				avgRtt = avgRtt / pEntry->numConns;
@@ -3578,6 +3729,13 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 					/* we also need to clear all the out-of-order packets */
 					freeDisorderedPackets(conn);
 
+					/* packets left in the ring go away with it */
+					if (conn->shmRing)
+					{
+						ic_shmring_detach(conn->shmRing);
+						conn->shmRing = NULL;
+					}
+
 					/* free up the packet queue */
 					pfree(conn->pkt_q);
 					conn->pkt_q = NULL;
@@ -3636,7 +3794,8 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 		 " freebuf_avg %f "
 		 "mismatch_pkt_num %d disordered_pkt_num %d duplicated_pkt_num %d"
 		 " rtt/dev [" UINT64_FORMAT "/" UINT64_FORMAT ", %f/%f, " UINT64_FORMAT "/" UINT64_FORMAT "] "
-		 " cwnd %f status_query_msg_num %d",
+		 " cwnd %f status_query_msg_num %d"
+		 " shm_conn_num %d shm_snd_pkt_count %d shm_recv_pkt_count %d shm_wakeup_num %d",
 		 ic_control_info.isSender, isReceiver,
 		 Gp_interconnect_snd_queue_depth, Gp_interconnect_queue_depth, Gp_max_packet_size,
 		 UNACK_QUEUE_RING_SLOTS_NUM, TIMER_SPAN, DEFAULT_RTT,
@@ -3649,7 +3808,9 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 		 (double) ((double) ic_statistics.totalBuffers) / ((double) ic_statistics.bufferCountingTime),
 		 ic_statistics.mismatchNum, ic_statistics.disorderedPktNum, ic_statistics.duplicatedPktNum,
 		 (minRtt == ~((uint64) 0) ? 0 : minRtt), (minDev == ~((uint64) 0) ? 0 : minDev), avgRtt, avgDev, maxRtt, maxDev,
-		 snd_control_info.cwnd, ic_statistics.statusQueryMsgNum);
+		 snd_control_info.cwnd, ic_statistics.statusQueryMsgNum,
+		 ic_statistics.shmConnNum, ic_statistics.shmSndPktNum,
+		 ic_statistics.shmRecvPktNum, ic_statistics.shmWakeupNum);
 
 	ic_control_info.isSender = false;
 	memset(&ic_statistics, 0, sizeof(ICStatistics));
@@ -3713,13 +3874,82 @@ prepareRxConnForRead(MotionConn *conn)
 {
 	elog(DEBUG3, "In prepareRxConnForRead: conn %p, q_head %d q_tail %d q_size %d", conn, conn->pkt_q_head, conn->pkt_q_tail, conn->pkt_q_size);
 
-	Assert(conn->pkt_q[conn->pkt_q_head] != NULL);
-	conn->pBuff = conn->pkt_q[conn->pkt_q_head];
+	if (conn->pkt_q[conn->pkt_q_head] != NULL)
+		conn->pBuff = conn->pkt_q[conn->pkt_q_head];
+	else
+	{
+		/* the packets that came over UDP are all older than the ring's */
+		Assert(shmRingHasPacket(conn));
+		conn->pBuff = (uint8 *) ic_shmring_peek(conn->shmRing);
+	}
 	conn->msgPos = conn->pBuff;
 	conn->msgSize = ((icpkthdr *) conn->pBuff)->len;
 	conn->recvBytes = conn->msgSize;
 }
 
+/*
+ * shmRingHasPacket
+ * 		Is there a packet to read in the shared memory ring of the connection?
+ */
+static inline bool
+shmRingHasPacket(MotionConn *conn)
+{
+	return conn->shmState == mcsShmActive && ic_shmring_peek(conn->shmRing) != NULL;
+}
+
+/*
+ * getShmRingConnForRead
+ * 		Find a connection with a packet in its shared memory ring.
+ *
+ * Only 'conn' is considered for a directed receive, all the connections of
+ * the motion node otherwise.
+ */
+static MotionConn *
+getShmRingConnForRead(ChunkTransportStateEntry *pEntry, MotionConn *conn)
+{
+	int			i;
+
+	if (conn != NULL)
+		return shmRingHasPacket(conn) ? conn : NULL;
+
+	for (i = 0; i < pEntry->numConns; i++)
+	{
+		if (shmRingHasPacket(pEntry->conns + i))
+			return pEntry->conns + i;
+	}
+
+	return NULL;
+}
+
+/*
+ * waitForShmRings
+ * 		Ask the senders that use a shared memory ring to wake us up when they
+ * 		put a packet into it.
+ *
+ * Returns true if one of the rings is not empty, in which case we must not
+ * go to sleep.
+ */
+static bool
+waitForShmRings(ChunkTransportStateEntry *pEntry, MotionConn *conn)
+{
+	bool		found = false;
+	int			i;
+
+	if (conn != NULL)
+		return conn->shmState == mcsShmActive && ic_shmring_wait(conn->shmRing);
+
+	for (i = 0; i < pEntry->numConns; i++)
+	{
+		MotionConn *rxconn = pEntry->conns + i;
+
+		if (rxconn->shmState == mcsShmActive && rxconn->stillActive &&
+			ic_shmring_wait(rxconn->shmRing))
+			found = true;
+	}
+
+	return found;
+}
+
 /*
  * receiveChunksUDPIFC
  * 		Receive chunks from the senders
@@ -3769,6 +3999,11 @@ receiveChunksUDPIFC(ChunkTransportState *pTransportStates, ChunkTransportStateEn
 			elog(DEBUG2, "receiveChunksUDPIFC: non-directed rx woke on route %d", rx_control_info.mainWaitingState.reachRoute);
 			resetMainThreadWaiting(&rx_control_info.mainWaitingState);
 		}
+		else if ((rxconn = getShmRingConnForRead(pEntry, conn)) != NULL)
+		{
+			prepareRxConnForRead(rxconn);
+			resetMainThreadWaiting(&rx_control_info.mainWaitingState);
+		}
 
 		aggregateStatistics(pEntry);
 
@@ -3796,6 +4031,11 @@ receiveChunksUDPIFC(ChunkTransportState *pTransportStates, ChunkTransportStateEn
 		 * arrive. The RX thread will wake us up using the latch.
 		 */
 		ResetLatch(&ic_control_info.latch);
+
+		/* senders on this host wake us up only when asked to */
+		if (waitForShmRings(pEntry, conn))
+			continue;
+
 		pthread_mutex_unlock(&ic_control_info.lock);
 
 		/*
@@ -3911,7 +4151,7 @@ RecvTupleChunkFromAnyUDPIFC_Internal(ChunkTransportState *transportStates,
 		ic_statistics.totalRecvQueueSize += conn->pkt_q_size;
 		ic_statistics.recvQueueSizeCountingTime++;
 
-		if (conn->pkt_q_size > 0)
+		if (conn->pkt_q_size > 0 || shmRingHasPacket(conn))
 		{
 			found = true;
 			prepareRxConnForRead(conn);
@@ -4031,7 +4271,7 @@ RecvTupleChunkFromUDPIFC_Internal(ChunkTransportState *transportStates,
 	ic_statistics.totalRecvQueueSize += conn->pkt_q_size;
 	ic_statistics.recvQueueSizeCountingTime++;
 
-	if (conn->pkt_q[conn->pkt_q_head] != NULL)
+	if (conn->pkt_q[conn->pkt_q_head] != NULL || shmRingHasPacket(conn))
 	{
 		prepareRxConnForRead(conn);
 
@@ -4371,6 +4611,13 @@ handleAcks(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntr
 			if (pkt->flags & UDPIC_FLAGS_NAK)
 				continue;
 
+			/* the receiver has a shared memory ring for us */
+			if ((pkt->flags & UDPIC_FLAGS_SHM) && ackConn->shmState == mcsShmUnused)
+			{
+				ackConn->shmState = mcsShmOffered;
+				shouldSendBuffers = true;
+			}
+
 			while (true)
 			{
 				if (pkt->flags & UDPIC_FLAGS_CAPACITY)
@@ -4726,6 +4973,29 @@ handleStopMsgs(ChunkTransportState *transportStates, ChunkTransportStateEntry *p
 static void
 sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn)
 {
+	/*
+	 * Switch over to the shared memory ring the receiver has offered once
+	 * everything sent over UDP has arrived, so that packets cannot overtake
+	 * each other.
+	 */
+	if (conn->shmState == mcsShmOffered && icBufferListLength(&conn->unackQueue) == 0)
+	{
+		conn->shmRing = ic_shmring_attach(&conn->conn_info, Gp_max_packet_size);
+		if (conn->shmRing != NULL)
+		{
+			conn->shmState = mcsShmActive;
+			ic_statistics.shmConnNum++;
+		}
+		else
+			conn->shmState = mcsShmFailed;
+	}
+
+	if (conn->shmState == mcsShmActive)
+	{
+		sendBuffersToShmRing(pEntry, conn);
+		return;
+	}
+
 	while (conn->capacity > 0 && icBufferListLength(&conn->sndQueue) > 0)
 	{
 		ICBuffer   *buf = NULL;
@@ -4786,6 +5056,53 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 	}
 }
 
+/*
+ * sendBuffersToShmRing
+ * 		Move the buffers in the send queue into the shared memory ring.
+ *
+ * Nothing is lost on the way, so the buffers are free as soon as they are in
+ * the ring.  When it is full, the receiver wakes us up with an ack once it
+ * has made room.
+ */
+static void
+sendBuffersToShmRing(ChunkTransportStateEntry *pEntry, MotionConn *conn)
+{
+	bool		wakeup = false;
+
+	while (icBufferListLength(&conn->sndQueue) > 0)
+	{
+		ICBuffer   *buf = GET_ICBUFFER_FROM_PRIMARY(icBufferListFirst(&conn->sndQueue));
+		bool		wakeupReceiver;
+
+		if (!ic_shmring_put(conn->shmRing, buf->pkt, &wakeupReceiver))
+		{
+			/*
+			 * The receiver has torn down its end, it does not want any more
+			 * data: handle that like a stop message.
+			 */
+			if (ic_shmring_is_detached(conn->shmRing) && conn->stillActive)
+			{
+				icBufferListReturn(&conn->sndQueue, false);
+				conn->stopRequested = true;
+				conn->conn_info.flags |= UDPIC_FLAGS_STOP;
+			}
+			break;
+		}
+		wakeup |= wakeupReceiver;
+
+		icBufferListPop(&conn->sndQueue);
+		icBufferListAppend(&snd_buffer_pool.freeList, buf);
+
+		conn->sentSeq = buf->pkt->seq;
+		ic_statistics.shmSndPktNum++;
+
+		SIMPLE_FAULT_INJECTOR("interconnect_shmring_send");
+	}
+
+	if (wakeup)
+		sendShmRingWakeup(conn, pEntry->txfd);
+}
+
 /*
  * handleDisorderPacket
  * 		Called by rx thread to assemble and send a disorder message.
@@ -5194,6 +5511,10 @@ checkDeadlock(ChunkTransportStateEntry *pEntry, MotionConn *conn)
 {
 	uint64		deadlockCheckTime;
 
+	/* a full shared memory ring only means that the receiver is slow */
+	if (conn->shmState == mcsShmActive)
+		return;
+
 	if (icBufferListLength(&conn->unackQueue) == 0 && conn->capacity == 0 && icBufferListLength(&conn->sndQueue) > 0)
 	{
 		/* we must have received some acks before deadlock occurs. */
@@ -5335,6 +5656,10 @@ checkExceptions(ChunkTransportState *transportStates,
 				int retry,
 				int timeout)
 {
+	/* the wakeup for room in the shared memory ring may have been lost */
+	if (conn->shmState == mcsShmActive)
+		sendBuffers(transportStates, pEntry, conn);
+
 	if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_CAPACITY	/* || conn->state ==
 																		 * mcsSetupOutgoingConnection
 		  * */ )
@@ -5490,7 +5815,8 @@ SendChunkUDPIFC(ChunkTransportState *transportStates,
 
 	conn->pBuff = (uint8 *) conn->curBuff->pkt;
 
-	if (gotStops)
+	/* the receiver may also have torn down its shared memory ring */
+	if (gotStops || (conn->stopRequested && conn->stillActive))
 	{
 		/* handling stop message will make some connection not active anymore */
 		handleStopMsgs(transportStates, pEntry, motionId);
@@ -6313,7 +6639,18 @@ rxThreadFunc(void *arg)
 			pthread_mutex_lock(&ic_control_info.lock);
 			conn = findConnByHeader(&ic_control_info.connHtab, pkt);
 
-			if (conn != NULL)
+			if (conn != NULL && (pkt->flags & UDPIC_FLAGS_SHM) &&
+				(pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
+			{
+				/* the sender has put packets into the shared memory ring */
+				if (rx_control_info.mainWaitingState.waiting &&
+					rx_control_info.mainWaitingState.waitingNode == pkt->motNodeId &&
+					rx_control_info.mainWaitingState.waitingQuery == pkt->icId &&
+					(rx_control_info.mainWaitingState.waitingRoute == ANY_ROUTE ||
+					 rx_control_info.mainWaitingState.waitingRoute == conn->route))
+					wakeup_mainthread = true;
+			}
+			else if (conn != NULL)
 			{
 				/* Handling a regular packet */
 				if (handleDataPacket(conn, pkt, &peer, &peerlen, &param, &wakeup_mainthread))
@@ -6330,7 +6667,7 @@ rxThreadFunc(void *arg)
 				 *
 				 * The handling logic is to "Ack the past and Nak the future".
 				 */
-				if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
+				if ((pkt->flags & (UDPIC_FLAGS_RECEIVER_TO_SENDER | UDPIC_FLAGS_SHM)) == 0)
 				{
 					if (DEBUG1 >= log_min_messages)
 						write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
@@ -153,6 +153,69 @@ test__DistributedSnapshotWithLocalMapping_CommittedTest(void **state)
 	free(dslm.inProgressMappedLocalXids);
 }
 
+static void
+test__DistributedSnapshot_Serialize(void **state)
+{
+	DistributedSnapshot ds;
+	DistributedSnapshot result;
+	char		buf[1024];
+	int			len;
+
+	ds.inProgressXidArray =
+		(DistributedTransactionId*)malloc(SIZE_OF_IN_PROGRESS_ARRAY);
+	result.inProgressXidArray =
+		(DistributedTransactionId*)malloc(SIZE_OF_IN_PROGRESS_ARRAY);
+
+	ds.xminAllDistributedSnapshots = 90;
+	ds.distribSnapshotId = 12345;
+	ds.xmin = 100;
+	ds.xmax = 300;
+
+	/* Empty in-progress array */
+	ds.count = 0;
+	len = DistributedSnapshot_Serialize(&ds, buf);
+	assert_int_equal(len, DistributedSnapshot_SerializeSize(&ds));
+	assert_int_equal(DistributedSnapshot_Deserialize(buf, &result), len);
+	assert_true(result.xminAllDistributedSnapshots == 90);
+	assert_true(result.distribSnapshotId == 12345);
+	assert_true(result.xmin == 100);
+	assert_true(result.xmax == 300);
+	assert_int_equal(result.count, 0);
+
+	/* In-progress xids close to xmin are stored as 32-bit offsets */
+	ds.count = 3;
+	ds.inProgressXidArray[0] = 100;
+	ds.inProgressXidArray[1] = 150;
+	ds.inProgressXidArray[2] = 300;
+	len = DistributedSnapshot_Serialize(&ds, buf);
+	assert_int_equal(len, DistributedSnapshot_SerializeSize(&ds));
+	assert_int_equal(len, sizeof(DistributedSnapshotId) +
+					 3 * sizeof(DistributedTransactionId) + sizeof(int32) +
+					 sizeof(bool) + 3 * sizeof(uint32));
+	assert_int_equal(DistributedSnapshot_Deserialize(buf, &result), len);
+	assert_int_equal(result.count, 3);
+	assert_true(result.inProgressXidArray[0] == 100);
+	assert_true(result.inProgressXidArray[1] == 150);
+	assert_true(result.inProgressXidArray[2] == 300);
+
+	/* Otherwise they are stored as is */
+	ds.xmax = ds.xmin + PG_UINT32_MAX + 10;
+	ds.inProgressXidArray[2] = ds.xmin + PG_UINT32_MAX + 1;
+	len = DistributedSnapshot_Serialize(&ds, buf);
+	assert_int_equal(len, DistributedSnapshot_SerializeSize(&ds));
+	assert_int_equal(len, sizeof(DistributedSnapshotId) +
+					 3 * sizeof(DistributedTransactionId) + sizeof(int32) +
+					 sizeof(bool) + 3 * sizeof(DistributedTransactionId));
+	assert_int_equal(DistributedSnapshot_Deserialize(buf, &result), len);
+	assert_int_equal(result.count, 3);
+	assert_true(result.inProgressXidArray[0] == 100);
+	assert_true(result.inProgressXidArray[1] == 150);
+	assert_true(result.inProgressXidArray[2] == ds.xmin + PG_UINT32_MAX + 1);
+
+	free(ds.inProgressXidArray);
+	free(result.inProgressXidArray);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -160,7 +223,8 @@ main(int argc, char* argv[])
 
 	const UnitTest tests[] =
 	{
-		unit_test(test__DistributedSnapshotWithLocalMapping_CommittedTest)
+		unit_test(test__DistributedSnapshotWithLocalMapping_CommittedTest),
+		unit_test(test__DistributedSnapshot_Serialize)
 	};
 
 	MemoryContextInit();
@@ -121,6 +121,7 @@
 #include "cdb/cdbaocsam.h"
 #include "cdb/cdbdisp_query.h"
 #include "cdb/cdbdispatchresult.h"
+#include "cdb/cdbqueryfeedback.h"
 #include "cdb/cdbtm.h"
 #include "cdb/cdbutil.h"
 #include "cdb/cdbvars.h"
@@ -916,6 +917,12 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 							false /* isVacuum */);
 	}
 
+	/*
+	 * Row counts that GPORCA learned from earlier queries on this table may
+	 * be stale, and the new statistics are the better source now.
+	 */
+	QueryFeedbackForgetRelation(RelationGetRelid(onerel));
+
 	/*
 	 * Same for indexes. Vacuum always scans all indexes, so if we're part of
 	 * VACUUM ANALYZE, don't overwrite the accurate count already inserted by
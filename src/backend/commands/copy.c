@@ -74,6 +74,7 @@
 #include "cdb/cdbcopy.h"
 #include "cdb/cdbdisp_query.h"
 #include "cdb/cdbdispatchresult.h"
+#include "cdb/cdbinitplancache.h"
 #include "cdb/cdbsreh.h"
 #include "cdb/cdbvars.h"
 #include "commands/queue.h"
@@ -1255,6 +1256,10 @@ DoCopy(ParseState *pstate, const CopyStmt *stmt,
 			PreventCommandIfReadOnly("COPY FROM");
 		PreventCommandIfParallelMode("COPY FROM");
 
+		/* COPY FROM bypasses ExecutorStart(), see InitPlanCacheNoteWrites() */
+		if (Gp_role == GP_ROLE_DISPATCH)
+			InitPlanCacheNoteRelationWrite(RelationGetRelid(rel));
+
 		cstate = BeginCopyFrom(pstate, rel, stmt->filename, stmt->is_program,
 							   NULL, NULL, stmt->attlist, options);
 		cstate->whereClause = whereClause;
@@ -7637,6 +7642,21 @@ InitDistributionData(CopyState cstate, EState *estate)
 	distData = palloc(sizeof(GpDistributionData));
 	distData->policy = policy;
 	distData->cdbHash = cdbHash;
+	distData->hashExprState = NULL;
+	distData->econtext = NULL;
+
+	/*
+	 * Compile the hashing of the distribution key columns into an expression,
+	 * so that the common hash functions are evaluated inline, without a
+	 * function call per column.
+	 */
+	if (policy && policy->nattrs > 0)
+	{
+		distData->hashExprState =
+			ExecBuildCdbHashForSlot(cdbHash, RelationGetDescr(cstate->rel),
+									NULL, policy->attrs, NULL);
+		distData->econtext = GetPerTupleExprContext(estate);
+	}
 
 	return distData;
 }
@@ -7740,19 +7760,12 @@ GetTargetSeg(GpDistributionData *distData, TupleTableSlot *slot)
 	p_nattrs = policy->nattrs;
 	if (p_nattrs > 0)
 	{
-		cdbhashinit(cdbHash);
-
-		for (int i = 0; i < p_nattrs; i++)
-		{
-			/* current attno from the policy */
-			AttrNumber	h_attnum = policy->attrs[i];
-			Datum		d;
-			bool		isnull;
+		ExprContext *econtext = distData->econtext;
+		bool		isnull;
 
-			d = slot_getattr(slot, h_attnum, &isnull);
-
-			cdbhash(cdbHash, i + 1, d, isnull);
-		}
+		econtext->ecxt_outertuple = slot;
+		cdbHash->hash = DatumGetUInt32(ExecEvalExprSwitchContext(distData->hashExprState,
+																 econtext, &isnull));
 
 		target_seg = cdbhashreduce(cdbHash); /* hash result segment */
 	}
@@ -124,6 +124,8 @@ static void show_tablesample(TableSampleClause *tsc, PlanState *planstate,
 static void show_sort_info(SortState *sortstate, ExplainState *es);
 static void show_windowagg_keys(WindowAggState *waggstate, List *ancestors, ExplainState *es);
 static void show_hash_info(HashState *hashstate, ExplainState *es);
+static void show_memoize_info(MemoizeState *mstate, List *ancestors,
+							  ExplainState *es);
 static void show_hashagg_info(AggState *hashstate, ExplainState *es);
 static void show_tidbitmap_info(BitmapHeapScanState *planstate,
 								ExplainState *es);
@@ -868,6 +870,11 @@ ExplainPrintPlan(ExplainState *es, QueryDesc *queryDesc)
                                      estate->dispatcherState->primaryResults,
                                      LocallyExecutingSliceIndex(estate),
                                      es->showstatctx);
+
+		/* Let GPORCA learn from the actual row counts */
+		if (gp_enable_query_feedback && Gp_role == GP_ROLE_DISPATCH &&
+			es->pstmt->planGen == PLANGEN_OPTIMIZER)
+			cdbexplain_recordFeedback(queryDesc->planstate, es->rtable, true);
 	}
 
 	ExplainPreScanNode(queryDesc->planstate, &rels_used);
@@ -1570,6 +1577,9 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		case T_Material:
 			pname = sname = "Materialize";
 			break;
+		case T_Memoize:
+			pname = sname = "Memoize";
+			break;
 		case T_Sort:
 			pname = sname = "Sort";
 			break;
@@ -1681,7 +1691,12 @@ ExplainNode(PlanState *planstate, List *ancestors,
 						sname = "Redistribute Motion";
 						break;
 					case MOTIONTYPE_BROADCAST:
-						sname = "Broadcast Motion";
+						if (pMotion->hostMode == BROADCAST_HOST_RELAY)
+							sname = "Host Broadcast Motion";
+						else if (pMotion->hostMode == BROADCAST_HOST_LOCAL)
+							sname = "Local Broadcast Motion";
+						else
+							sname = "Broadcast Motion";
 						break;
 					case MOTIONTYPE_EXPLICIT:
 						sname = "Explicit Redistribute Motion";
@@ -2362,6 +2377,10 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			show_sort_keys(castNode(SortState, planstate), ancestors, es);
 			show_sort_info(castNode(SortState, planstate), es);
 			break;
+		case T_Memoize:
+			show_memoize_info(castNode(MemoizeState, planstate), ancestors,
+							  es);
+			break;
 		case T_MergeAppend:
 			show_merge_append_keys(castNode(MergeAppendState, planstate),
 								   ancestors, es);
@@ -2401,6 +2420,8 @@ ExplainNode(PlanState *planstate, List *ancestors,
 									 "Hash Module: %d\n",
 									 pMotion->numHashSegments);
 				}
+				if (pMotion->skewValues != NIL)
+					show_motion_skew_values(planstate, pMotion, ancestors, es);
 			}
 			break;
 		case T_AssertOp:
@@ -3305,6 +3326,50 @@ show_sort_info(SortState *sortstate, ExplainState *es)
 	}
 }
 
+/*
+ * Show the cache key of a Memoize node.  The hit and miss counters are
+ * collected on the segments and reported with the other EXPLAIN ANALYZE
+ * extra text; see ExecMemoizeExplainEnd().
+ */
+static void
+show_memoize_info(MemoizeState *mstate, List *ancestors, ExplainState *es)
+{
+	Plan	   *plan = ((PlanState *) mstate)->plan;
+	ListCell   *lc;
+	List	   *context;
+	StringInfoData keystr;
+	char	   *separator = "";
+	bool		useprefix;
+
+	initStringInfo(&keystr);
+
+	/*
+	 * It's hard to imagine having a memoize node with fewer than 2 RTEs, but
+	 * let's just keep the same useprefix logic as elsewhere in this file.
+	 */
+	useprefix = list_length(es->rtable) > 1 || es->verbose;
+
+	/* Set up deparsing context */
+	context = set_deparse_context_planstate(es->deparse_cxt,
+											(Node *) mstate,
+											ancestors);
+
+	foreach(lc, ((Memoize *) plan)->param_exprs)
+	{
+		Node	   *expr = (Node *) lfirst(lc);
+
+		appendStringInfoString(&keystr, separator);
+
+		appendStringInfoString(&keystr, deparse_expression(expr, context,
+														   useprefix, false));
+		separator = ", ";
+	}
+
+	ExplainPropertyText("Cache Key", keystr.data, es);
+
+	pfree(keystr.data);
+}
+
 /*
  * Show information on hash buckets/batches.
  */
@@ -19,11 +19,13 @@
 
 #include "libpq-fe.h"
 #include "libpq-int.h"
+#include "catalog/gp_distribution_policy.h"
 #include "cdb/cdbconn.h"		/* SegmentDatabaseDescriptor */
 #include "cdb/cdbdisp.h"                /* CheckDispatchResult() */
 #include "cdb/cdbdispatchresult.h"	/* CdbDispatchResults */
 #include "cdb/cdbexplain.h"		/* me */
 #include "cdb/cdbpathlocus.h"
+#include "cdb/cdbqueryfeedback.h"
 #include "cdb/cdbutil.h"
 #include "cdb/cdbvars.h"		/* GpIdentity.segindex */
 #include "cdb/memquota.h"
@@ -278,10 +280,26 @@ static void cdbexplain_depositStatsToNode(PlanState *planstate,
 										  CdbExplain_RecvStatCtx *ctx);
 static int cdbexplain_collectExtraText(PlanState *planstate,
 									   StringInfo notebuf);
+static void cdbexplain_recordFeedback(PlanState *planstate, List *rtable,
+									  bool complete);
+static bool cdbexplain_feedbackRelsWalker(PlanState *planstate,
+										  void *context);
+
+/* Base tables below a plan node, see cdbexplain_recordFeedback() */
+typedef struct CdbExplain_FeedbackRels
+{
+	List	   *rtable;
+	int			nrels;
+	Oid			relids[QUERY_FEEDBACK_MAX_RELS];
+	bool		overflow;		/* more tables than fit in relids */
+	bool		allReplicated;	/* all of them are replicated tables */
+} CdbExplain_FeedbackRels;
 
 static void show_motion_keys(PlanState *planstate, List *hashExpr, int nkeys,
 							 AttrNumber *keycols, const char *qlabel,
 							 List *ancestors, ExplainState *es);
+static void show_motion_skew_values(PlanState *planstate, Motion *motion,
+									List *ancestors, ExplainState *es);
 static void
 gpexplain_formatSlicesOutput(struct CdbExplain_ShowStatCtx *showstatctx,
                              struct EState *estate,
@@ -655,6 +673,145 @@ cdbexplain_recvExecStats(struct PlanState *planstate,
 }								/* cdbexplain_recvExecStats */
 
 
+/*
+ * cdbexplain_recordFeedback
+ *	  Store the row counts of a GPORCA plan, whose stats have been gathered,
+ *	  in the query feedback store.  See cdbqueryfeedback.c.
+ *
+ * Nodes that just pass rows on, like a Motion, a Sort or a Hash, carry the
+ * signature of their input, so only the lowest node with a given signature
+ * is recorded.  Nodes that were rescanned, or may have been stopped before
+ * the end, i.e. the inner side of a Nested Loop and everything below a
+ * Limit, are skipped.  So are InitPlans and SubPlans.
+ */
+static void
+cdbexplain_recordFeedback(PlanState *planstate, List *rtable, bool complete)
+{
+	Plan	   *plan = planstate->plan;
+	Instrumentation *instr = planstate->instrument;
+	uint32		signature = plan->feedbackSignature;
+	int			i;
+
+	if (complete && signature != 0 && instr && instr->cdbNodeSummary &&
+		!(plan->lefttree && plan->lefttree->feedbackSignature == signature) &&
+		!(plan->righttree && plan->righttree->feedbackSignature == signature))
+	{
+		CdbExplain_NodeSummary *ns = instr->cdbNodeSummary;
+		CdbExplain_FeedbackRels rels;
+		double		nloops = 0;
+		bool		rescanned = false;
+
+		for (i = 0; i < ns->ninst; i++)
+		{
+			nloops += ns->insts[i].nloops;
+			if (ns->insts[i].nloops > 1)
+				rescanned = true;
+		}
+
+		/*
+		 * Remember the tables the rows came from, so that the entry can be
+		 * forgotten when one of them changes.  An entry that could not be
+		 * forgotten is not recorded at all.
+		 */
+		rels.rtable = rtable;
+		rels.nrels = 0;
+		rels.overflow = false;
+		rels.allReplicated = true;
+		(void) cdbexplain_feedbackRelsWalker(planstate, &rels);
+
+		/*
+		 * ntuples.vsum is the total over all the QEs that ran the node.  If
+		 * it only read replicated tables, each of them produced all the
+		 * rows, though.
+		 */
+		if (nloops > 0 && !rescanned && !rels.overflow)
+			QueryFeedbackRecord(signature,
+								rels.allReplicated ? ns->ntuples.vmax
+												   : ns->ntuples.vsum,
+								rels.nrels, rels.relids);
+	}
+
+	if (IsA(planstate, LimitState))
+		complete = false;
+
+	if (outerPlanState(planstate))
+		cdbexplain_recordFeedback(outerPlanState(planstate), rtable, complete);
+	if (innerPlanState(planstate))
+		cdbexplain_recordFeedback(innerPlanState(planstate), rtable,
+								  complete && !IsA(planstate, NestLoopState));
+
+	if (IsA(planstate, AppendState))
+	{
+		AppendState *as = (AppendState *) planstate;
+
+		for (i = 0; i < as->as_nplans; i++)
+			cdbexplain_recordFeedback(as->appendplans[i], rtable, complete);
+	}
+	else if (IsA(planstate, SequenceState))
+	{
+		SequenceState *ss = (SequenceState *) planstate;
+
+		for (i = 0; i < ss->numSubplans; i++)
+			cdbexplain_recordFeedback(ss->subplans[i], rtable, complete);
+	}
+}								/* cdbexplain_recordFeedback */
+
+/*
+ * cdbexplain_feedbackRelsWalker
+ *	  Collect the base tables scanned below a plan node.
+ */
+static bool
+cdbexplain_feedbackRelsWalker(PlanState *planstate, void *context)
+{
+	CdbExplain_FeedbackRels *rels = (CdbExplain_FeedbackRels *) context;
+	Plan	   *plan = planstate->plan;
+
+	switch (nodeTag(plan))
+	{
+		case T_SeqScan:
+		case T_SampleScan:
+		case T_IndexScan:
+		case T_IndexOnlyScan:
+		case T_BitmapHeapScan:
+		case T_TidScan:
+		case T_ForeignScan:
+			{
+				RangeTblEntry *rte = rt_fetch(((Scan *) plan)->scanrelid,
+											  rels->rtable);
+				GpPolicy   *policy;
+				int			i;
+
+				if (rte->rtekind != RTE_RELATION)
+					break;
+
+				policy = GpPolicyFetch(rte->relid);
+				if (!GpPolicyIsReplicated(policy))
+					rels->allReplicated = false;
+
+				for (i = 0; i < rels->nrels; i++)
+				{
+					if (rels->relids[i] == rte->relid)
+						break;
+				}
+				if (i < rels->nrels)
+					break;
+				if (rels->nrels == QUERY_FEEDBACK_MAX_RELS)
+				{
+					rels->overflow = true;
+					return true;
+				}
+				rels->relids[rels->nrels++] = rte->relid;
+			}
+			break;
+		default:
+			break;
+	}
+
+	return planstate_tree_walker(planstate, cdbexplain_feedbackRelsWalker,
+								 context);
+}
+
+
 /*
  * cdbexplain_recvStatWalker
  *	  Update the given PlanState node's Instrument node with statistics
@@ -2093,3 +2250,23 @@ show_motion_keys(PlanState *planstate, List *hashExpr, int nkeys, AttrNumber *ke
 		ExplainPropertyText("Hash Key", exprstr, es);
     }
 }
+
+/*
+ * Show the heavy-hitter key values of a skew-resilient Redistribute Motion.
+ */
+static void
+show_motion_skew_values(PlanState *planstate, Motion *motion,
+						List *ancestors, ExplainState *es)
+{
+	List	   *context;
+	char	   *exprstr;
+
+	context = set_deparse_context_planstate(es->deparse_cxt,
+											(Node *) planstate,
+											ancestors);
+	exprstr = deparse_expression((Node *) motion->skewValues, context,
+								 false, false);
+	ExplainPropertyText(motion->skewBroadcast ?
+						"Broadcast Skewed Keys" : "Spread Skewed Keys",
+						exprstr, es);
+}
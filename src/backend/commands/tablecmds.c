@@ -130,6 +130,7 @@
 #include "cdb/cdbvars.h"
 #include "cdb/cdbrelsize.h"
 #include "cdb/cdboidsync.h"
+#include "cdb/cdbqueryfeedback.h"
 #include "postmaster/autostats.h"
 
 const char *synthetic_sql = "(internally generated SQL command)";
@@ -2160,6 +2161,9 @@ ExecuteTruncateGuts(List *explicit_rels, List *relids, List *relids_logged,
 	{
 		Relation	rel = (Relation) lfirst(cell);
 
+		/* GPORCA must not use row counts observed before the truncation */
+		QueryFeedbackForgetRelation(RelationGetRelid(rel));
+
 		/* Skip partitioned tables as there is nothing to do */
 		if (rel->rd_rel->relkind == RELKIND_PARTITIONED_TABLE)
 			continue;
@@ -64,6 +64,7 @@
 #include "catalog/oid_dispatch.h"
 #include "cdb/cdbdispatchresult.h"
 #include "cdb/cdbdisp_query.h"
+#include "cdb/cdbqueryfeedback.h"
 #include "cdb/cdbvars.h"
 #include "commands/analyzeutils.h"
 #include "libpq-int.h"
@@ -1470,6 +1471,10 @@ vac_update_relstats(Relation relation,
 		pgcform->reltuples = (float4) num_tuples;
 		dirty = true;
 	}
+
+	/* Row counts observed by earlier queries may no longer hold */
+	if (dirty)
+		QueryFeedbackForgetRelation(relid);
 	if (pgcform->relallvisible != (int32) num_all_visible_pages)
 	{
 		pgcform->relallvisible = (int32) num_all_visible_pages;
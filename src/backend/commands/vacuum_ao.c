@@ -30,7 +30,11 @@
  *   to risk "snapshot too old" errors), this can truncate the old segments left
  *   behind in the compaction phase.
  *
- *   Vacuum indexes.
+ *   Vacuum indexes. Dead index entries are only removed once compaction
+ *   has emptied segments; until then, index scans skip the hidden rows
+ *   using the visibility map. With gp_appendonly_vacuum_parallel_workers
+ *   set, the btree indexes are divided among parallel workers on each
+ *   segment.
  *
  *   Vacuum auxiliary heap tables.
  *
@@ -119,25 +123,32 @@
 #include "access/appendonly_compaction.h"
 #include "access/genam.h"
 #include "access/multixact.h"
+#include "access/parallel.h"
+#include "access/table.h"
 #include "access/visibilitymap.h"
 #include "access/xact.h"
+#include "catalog/pg_am.h"
 #include "catalog/pg_appendonly.h"
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbtm.h"
 #include "cdb/cdbvars.h"
 #include "commands/vacuum.h"
+#include "lib/integerset.h"
 #include "pgstat.h"
 #include "postmaster/autovacuum.h"
 #include "storage/freespace.h"
 #include "storage/proc.h"
 #include "storage/procarray.h"
+#include "tcop/tcopprot.h"
 #include "miscadmin.h"
 #include "nodes/makefuncs.h"
+#include "optimizer/paths.h"
 #include "utils/faultinjector.h"
 #include "utils/guc.h"
 #include "utils/rel.h"
 #include "utils/relcache.h"
 #include "utils/lsyscache.h"
+#include "utils/memutils.h"
 #include "utils/pg_rusage.h"
 #include "cdb/cdbappendonlyblockdirectory.h"
 
@@ -149,14 +160,76 @@ typedef struct AppendOnlyIndexVacuumState
 	AppendOnlyVisimap visiMap;
 	AppendOnlyBlockDirectory blockDirectory;
 	AppendOnlyBlockDirectoryEntry blockDirectoryEntry;
+
+	/*
+	 * Segment files that cannot contain any live tuples: not visible to our
+	 * snapshot, compacted and awaiting drop, or empty.
+	 */
+	bool		deadSegfile[AOTupleId_MaxSegmentFileNum + 1];
+
+	/* Has compaction emptied any segment file, leaving dead index entries? */
+	bool		hasCompactedSegfiles;
+
+	/*
+	 * The rows hidden in the visibility map, see
+	 * appendonly_index_vacuum_collect_hidden_rows().  NULL if we haven't
+	 * collected them, or they didn't fit in maintenance_work_mem.
+	 */
+	IntegerSet *hiddenRows;
+	MemoryContext hiddenRowsContext;
 } AppendOnlyIndexVacuumState;
 
-static void vacuum_appendonly_index(Relation indexRelation,
-									AppendOnlyIndexVacuumState *vacuumIndexState,
-									double rel_tuple_count,
-									int elevel,
-									BufferAccessStrategy bstrategy);
+/*
+ * Shared state of a parallel vacuum of the indexes of an append-only table
+ */
+typedef struct AOVacuumIndexSlot
+{
+	bool		parallel_safe;	/* can a worker vacuum this index? */
+	bool		has_stats;		/* result of vacuuming it, if any */
+	IndexBulkDeleteResult stats;
+} AOVacuumIndexSlot;
+
+typedef struct AOVacuumShared
+{
+	Oid			relid;
+	int			options;
+	bool		bulkdelete;
+	double		rel_tuple_count;
+	int			elevel;
+	int			nindexes;
 
+	/* next index to claim, an index into the indexes array */
+	pg_atomic_uint32 nextindex;
+
+	AOVacuumIndexSlot indexes[FLEXIBLE_ARRAY_MEMBER];
+} AOVacuumShared;
+
+#define PARALLEL_KEY_AO_VACUUM_SHARED	UINT64CONST(0xA000000000000001)
+#define PARALLEL_KEY_QUERY_TEXT			UINT64CONST(0xA000000000000002)
+
+static IndexBulkDeleteResult *vacuum_appendonly_index(Relation indexRelation,
+													  AppendOnlyIndexVacuumState *vacuumIndexState,
+													  bool bulkdelete,
+													  double rel_tuple_count,
+													  int elevel,
+													  BufferAccessStrategy bstrategy);
+static void vacuum_appendonly_index_update_stats(Relation indexRelation,
+												 IndexBulkDeleteResult *stats,
+												 bool bulkdelete,
+												 int elevel,
+												 PGRUsage *ru0);
+static int vacuum_appendonly_compute_workers(Relation *Irel, int nindexes,
+											 bool *parallel_safe);
+static void vacuum_appendonly_indexes_parallel(Relation aoRelation, int options,
+											   Relation *Irel, int nindexes,
+											   bool *parallel_safe, int nworkers,
+											   AppendOnlyIndexVacuumState *vacuumIndexState,
+											   bool bulkdelete, double rel_tuple_count,
+											   int elevel, BufferAccessStrategy bstrategy);
+
+static void appendonly_index_vacuum_collect_hidden_rows(Relation aoRelation,
+														Snapshot snapshot,
+														AppendOnlyIndexVacuumState *vacuumIndexState);
 static bool appendonly_tid_reaped(ItemPointer itemptr, void *state);
 
 static void vacuum_appendonly_fill_stats(Relation aorel, Snapshot snapshot, int elevel,
@@ -405,11 +478,234 @@ vacuum_appendonly_index_should_vacuum(Relation aoRelation,
 
 	pfree(totals);
 
-	if (hidden_tupcount > 0 || (options & VACOPT_FULL) != 0)
-	{
+	if ((options & VACOPT_FULL) != 0)
 		return true;
+
+	/*
+	 * Rows that are only hidden in the visibility map are still in their
+	 * segment file, and index scans check the visibility map anyway.  Their
+	 * index entries become dangling only once compaction has moved the live
+	 * rows out of the segment file, and all of them are removed in one pass
+	 * then, so don't scan the indexes for dead entries before that.
+	 */
+	return vacuumIndexState->hasCompactedSegfiles;
+}
+
+/*
+ * Set up the visibility map and block directory lookups used to decide
+ * which index entries point to dead tuples.
+ *
+ * Returns the segfile array that the block directory refers to; free it
+ * with appendonly_index_vacuum_state_finish().
+ */
+static FileSegInfo **
+appendonly_index_vacuum_state_init(Relation aoRelation, Snapshot snapshot,
+								   AppendOnlyIndexVacuumState *vacuumIndexState,
+								   int *totalSegfiles)
+{
+	FileSegInfo **segmentFileInfo; /* Might be a casted AOCSFileSegInfo */
+	Oid			visimaprelid;
+	Oid			visimapidxid;
+	int			i;
+
+	memset(vacuumIndexState, 0, sizeof(AppendOnlyIndexVacuumState));
+
+	if (RelationIsAoRows(aoRelation))
+	{
+		segmentFileInfo = GetAllFileSegInfo(aoRelation,
+											snapshot,
+											totalSegfiles);
+	}
+	else
+	{
+		Assert(RelationIsAoCols(aoRelation));
+		segmentFileInfo = (FileSegInfo **) GetAllAOCSFileSegInfo(aoRelation,
+																snapshot,
+																totalSegfiles);
+	}
+
+	/*
+	 * Compaction deletes the block directory and visibility map entries of
+	 * the segment files it empties, so the lookups in appendonly_tid_reaped()
+	 * would find every tuple in them dead.  Remember which ones they are, so
+	 * that it doesn't have to do the lookups.
+	 */
+	for (i = 0; i <= AOTupleId_MaxSegmentFileNum; i++)
+		vacuumIndexState->deadSegfile[i] = true;
+	for (i = 0; i < *totalSegfiles; i++)
+	{
+		int			segno;
+		FileSegInfoState state;
+		int64		tupcount;
+
+		if (RelationIsAoRows(aoRelation))
+		{
+			segno = segmentFileInfo[i]->segno;
+			state = segmentFileInfo[i]->state;
+			tupcount = segmentFileInfo[i]->total_tupcount;
+		}
+		else
+		{
+			AOCSFileSegInfo *seginfo = (AOCSFileSegInfo *) segmentFileInfo[i];
+
+			segno = seginfo->segno;
+			state = seginfo->state;
+			tupcount = seginfo->total_tupcount;
+		}
+
+		/*
+		 * An empty segment file has been recycled after compaction, unless
+		 * nothing was ever inserted to it; either way it has no live tuples.
+		 */
+		if (state == AOSEG_STATE_AWAITING_DROP || tupcount == 0)
+			vacuumIndexState->hasCompactedSegfiles = true;
+		else
+			vacuumIndexState->deadSegfile[segno] = false;
+	}
+
+	GetAppendOnlyEntryAuxOids(aoRelation->rd_id,
+							  snapshot, 
+							  NULL, NULL, NULL,
+							  &visimaprelid, &visimapidxid);
+
+	AppendOnlyVisimap_Init(
+			&vacuumIndexState->visiMap,
+			visimaprelid,
+			visimapidxid,
+			AccessShareLock,
+			snapshot);
+
+	AppendOnlyBlockDirectory_Init_forSearch(&vacuumIndexState->blockDirectory,
+			snapshot,
+			segmentFileInfo,
+			*totalSegfiles,
+			aoRelation,
+			1,
+			RelationIsAoCols(aoRelation),
+			NULL);
+
+	return segmentFileInfo;
+}
+
+static void
+appendonly_index_vacuum_state_finish(Relation aoRelation,
+									 AppendOnlyIndexVacuumState *vacuumIndexState,
+									 FileSegInfo **segmentFileInfo,
+									 int totalSegfiles)
+{
+	AppendOnlyVisimap_Finish(&vacuumIndexState->visiMap, AccessShareLock);
+	AppendOnlyBlockDirectory_End_forSearch(&vacuumIndexState->blockDirectory);
+
+	if (vacuumIndexState->hiddenRowsContext)
+		MemoryContextDelete(vacuumIndexState->hiddenRowsContext);
+
+	if (segmentFileInfo)
+	{
+		if (RelationIsAoRows(aoRelation))
+		{
+			FreeAllSegFileInfo(segmentFileInfo, totalSegfiles);
+		}
+		else
+		{
+			FreeAllAOCSSegFileInfo((AOCSFileSegInfo **)segmentFileInfo, totalSegfiles);
+		}
+		pfree(segmentFileInfo);
+	}
+}
+
+/*
+ * The key of an append-only tuple in the hidden rows set.  Row numbers have
+ * at most 40 bits, see AOTupleId_MaxRowNum, so the keys sort by segment
+ * file number first, like the visibility map.
+ */
+static inline uint64
+appendonly_hidden_row_key(AOTupleId *aoTupleId)
+{
+	return ((uint64) AOTupleIdGet_segmentFileNum(aoTupleId) << 40) |
+		(uint64) AOTupleIdGet_rowNum(aoTupleId);
+}
+
+/*
+ * Collect all rows hidden in the visibility map into an integer set.
+ *
+ * The bulk delete visits index entries in index order, so checking each of
+ * them against the visibility map jumps back and forth between visibility
+ * map entries, with an index lookup on the visibility map relation every
+ * time.  Instead, read the visibility map once, in order.  Deleted rows tend
+ * to come in runs, which integerset.c encodes compactly.
+ *
+ * If the set grows beyond maintenance_work_mem, give up, and let
+ * appendonly_tid_reaped() fall back to the visibility map lookups.
+ */
+static void
+appendonly_index_vacuum_collect_hidden_rows(Relation aoRelation,
+											Snapshot snapshot,
+											AppendOnlyIndexVacuumState *vacuumIndexState)
+{
+	AppendOnlyVisimapScan visiMapScan;
+	AOTupleId	aoTupleId;
+	Oid			visimaprelid;
+	Oid			visimapidxid;
+	MemoryContext oldcontext;
+	uint64		lastkey = 0;
+	uint64		nhidden = 0;
+	bool		complete = true;
+
+	Assert(vacuumIndexState->hiddenRows == NULL);
+
+	GetAppendOnlyEntryAuxOids(aoRelation->rd_id,
+							  snapshot,
+							  NULL, NULL, NULL,
+							  &visimaprelid, &visimapidxid);
+
+	vacuumIndexState->hiddenRowsContext =
+		AllocSetContextCreate(CurrentMemoryContext,
+							  "AO vacuum hidden rows",
+							  ALLOCSET_DEFAULT_SIZES);
+	oldcontext = MemoryContextSwitchTo(vacuumIndexState->hiddenRowsContext);
+	vacuumIndexState->hiddenRows = intset_create();
+	MemoryContextSwitchTo(oldcontext);
+
+	AppendOnlyVisimapScan_Init(&visiMapScan,
+							   visimaprelid,
+							   visimapidxid,
+							   AccessShareLock,
+							   snapshot);
+	AOTupleIdSetInvalid(&aoTupleId);
+	while (AppendOnlyVisimapScan_GetNextInvisible(&visiMapScan, &aoTupleId))
+	{
+		uint64		key = appendonly_hidden_row_key(&aoTupleId);
+
+		/* integerset.c requires the members to be added in order */
+		if (nhidden > 0 && key <= lastkey)
+		{
+			complete = false;
+			break;
+		}
+		intset_add_member(vacuumIndexState->hiddenRows, key);
+		lastkey = key;
+		nhidden++;
+
+		if (nhidden % 1024 == 0 &&
+			intset_memory_usage(vacuumIndexState->hiddenRows) > maintenance_work_mem * 1024L)
+		{
+			complete = false;
+			break;
+		}
+	}
+	AppendOnlyVisimapScan_Finish(&visiMapScan, AccessShareLock);
+
+	if (Debug_appendonly_print_compaction)
+		elog(LOG, "collected " UINT64_FORMAT " hidden rows of %s%s",
+			 nhidden, RelationGetRelationName(aoRelation),
+			 complete ? "" : ", falling back to visibility map lookups");
+
+	if (!complete)
+	{
+		MemoryContextDelete(vacuumIndexState->hiddenRowsContext);
+		vacuumIndexState->hiddenRowsContext = NULL;
+		vacuumIndexState->hiddenRows = NULL;
 	}
-	return false;
 }
 
 /*
@@ -434,13 +730,9 @@ vacuum_appendonly_indexes(Relation aoRelation, int options,
 	FileSegInfo **segmentFileInfo = NULL; /* Might be a casted AOCSFileSegInfo */
 	int			totalSegfiles;
 	Snapshot	appendOnlyMetaDataSnapshot;
-	Oid			visimaprelid;
-	Oid			visimapidxid;
 
 	Assert(RelationIsAppendOptimized(aoRelation));
 
-	memset(&vacuumIndexState, 0, sizeof(vacuumIndexState));
-
 	if (Debug_appendonly_print_compaction)
 		elog(LOG, "Vacuum indexes for append-only relation %s",
 			 RelationGetRelationName(aoRelation));
@@ -453,46 +745,19 @@ vacuum_appendonly_indexes(Relation aoRelation, int options,
 
 	appendOnlyMetaDataSnapshot = GetActiveSnapshot();
 
-	if (RelationIsAoRows(aoRelation))
-	{
-		segmentFileInfo = GetAllFileSegInfo(aoRelation,
-											appendOnlyMetaDataSnapshot,
-											&totalSegfiles);
-	}
-	else
-	{
-		Assert(RelationIsAoCols(aoRelation));
-		segmentFileInfo = (FileSegInfo **) GetAllAOCSFileSegInfo(aoRelation,
-																appendOnlyMetaDataSnapshot,
-																&totalSegfiles);
-	}
-
-	GetAppendOnlyEntryAuxOids(aoRelation->rd_id,
-							  appendOnlyMetaDataSnapshot, 
-							  NULL, NULL, NULL,
-							  &visimaprelid, &visimapidxid);
-
-	AppendOnlyVisimap_Init(
-			&vacuumIndexState.visiMap,
-			visimaprelid,
-			visimapidxid,
-			AccessShareLock,
-			appendOnlyMetaDataSnapshot);
-
-	AppendOnlyBlockDirectory_Init_forSearch(&vacuumIndexState.blockDirectory,
-			appendOnlyMetaDataSnapshot,
-			segmentFileInfo,
-			totalSegfiles,
-			aoRelation,
-			1,
-			RelationIsAoCols(aoRelation),
-			NULL);
+	segmentFileInfo = appendonly_index_vacuum_state_init(aoRelation,
+														 appendOnlyMetaDataSnapshot,
+														 &vacuumIndexState,
+														 &totalSegfiles);
 
 	/* Clean/scan index relation(s) */
 	if (Irel != NULL)
 	{
 		double rel_tuple_count = 0.0;
 		int			elevel;
+		bool		bulkdelete;
+		bool	   *parallel_safe;
+		int			nworkers;
 
 		/* just scan indexes to update statistic */
 		if (options & VACOPT_VERBOSE)
@@ -500,45 +765,50 @@ vacuum_appendonly_indexes(Relation aoRelation, int options,
 		else
 			elevel = DEBUG2;
 
-		if (vacuum_appendonly_index_should_vacuum(aoRelation, options,
-												  appendOnlyMetaDataSnapshot,
-												  &vacuumIndexState,
-												  &rel_tuple_count))
+		bulkdelete = vacuum_appendonly_index_should_vacuum(aoRelation, options,
+														   appendOnlyMetaDataSnapshot,
+														   &vacuumIndexState,
+														   &rel_tuple_count);
+		if (bulkdelete)
 		{
 			Assert(rel_tuple_count > -1.0);
-
-			for (i = 0; i < nindexes; i++)
-			{
-				vacuum_appendonly_index(Irel[i], &vacuumIndexState,
-										rel_tuple_count,
-										elevel,
-										bstrategy);
-			}
 			reindex_count++;
+			appendonly_index_vacuum_collect_hidden_rows(aoRelation,
+														appendOnlyMetaDataSnapshot,
+														&vacuumIndexState);
 		}
-		else
-		{
-			for (i = 0; i < nindexes; i++)
-				scan_index(Irel[i], rel_tuple_count, elevel, bstrategy);
-		}
-	}
 
-	AppendOnlyVisimap_Finish(&vacuumIndexState.visiMap, AccessShareLock);
-	AppendOnlyBlockDirectory_End_forSearch(&vacuumIndexState.blockDirectory);
+		parallel_safe = palloc(nindexes * sizeof(bool));
+		nworkers = vacuum_appendonly_compute_workers(Irel, nindexes, parallel_safe);
 
-	if (segmentFileInfo)
-	{
-		if (RelationIsAoRows(aoRelation))
-		{
-			FreeAllSegFileInfo(segmentFileInfo, totalSegfiles);
-		}
+		if (nworkers > 0)
+			vacuum_appendonly_indexes_parallel(aoRelation, options, Irel, nindexes,
+											   parallel_safe, nworkers,
+											   &vacuumIndexState, bulkdelete,
+											   rel_tuple_count, elevel, bstrategy);
 		else
 		{
-			FreeAllAOCSSegFileInfo((AOCSFileSegInfo **)segmentFileInfo, totalSegfiles);
+			for (i = 0; i < nindexes; i++)
+			{
+				IndexBulkDeleteResult *stats;
+				PGRUsage	ru0;
+
+				pg_rusage_init(&ru0);
+				stats = vacuum_appendonly_index(Irel[i], &vacuumIndexState,
+												bulkdelete,
+												rel_tuple_count,
+												elevel,
+												bstrategy);
+				vacuum_appendonly_index_update_stats(Irel[i], stats, bulkdelete,
+													 elevel, &ru0);
+			}
 		}
-		pfree(segmentFileInfo);
+		pfree(parallel_safe);
 	}
 
+	appendonly_index_vacuum_state_finish(aoRelation, &vacuumIndexState,
+										 segmentFileInfo, totalSegfiles);
+
 	vac_close_indexes(nindexes, Irel, NoLock);
 	return nindexes;
 }
@@ -547,12 +817,17 @@ vacuum_appendonly_indexes(Relation aoRelation, int options,
  * Vacuums an index on an append-only table.
  *
  * This is called after an append-only segment file compaction to move
- * all tuples from the compacted segment files.
- * The segmentFileList is an
+ * all tuples from the compacted segment files.  If 'bulkdelete' is false,
+ * there is nothing to delete, and the index is only scanned to collect
+ * statistics.
+ *
+ * This doesn't update pg_class, so that it can also be used in parallel
+ * workers; pass the result to vacuum_appendonly_index_update_stats().
  */
-static void
+static IndexBulkDeleteResult *
 vacuum_appendonly_index(Relation indexRelation,
 						AppendOnlyIndexVacuumState *vacuumIndexState,
+						bool bulkdelete,
 						double rel_tuple_count,
 						int elevel,
 						BufferAccessStrategy bstrategy)
@@ -560,24 +835,39 @@ vacuum_appendonly_index(Relation indexRelation,
 	Assert(RelationIsValid(indexRelation));
 	Assert(vacuumIndexState);
 
-	IndexBulkDeleteResult *stats;
+	IndexBulkDeleteResult *stats = NULL;
 	IndexVacuumInfo ivinfo;
-	PGRUsage	ru0;
-
-	pg_rusage_init(&ru0);
 
 	ivinfo.index = indexRelation;
+	ivinfo.analyze_only = false;
+	ivinfo.report_progress = false;
+	ivinfo.estimated_count = false;
 	ivinfo.message_level = elevel;
 	ivinfo.num_heap_tuples = rel_tuple_count;
 	ivinfo.strategy = bstrategy;
 
 	/* Do bulk deletion */
-	stats = index_bulk_delete(&ivinfo, NULL, appendonly_tid_reaped,
-			(void *) vacuumIndexState);
+	if (bulkdelete)
+		stats = index_bulk_delete(&ivinfo, NULL, appendonly_tid_reaped,
+				(void *) vacuumIndexState);
 
 	/* Do post-VACUUM cleanup */
 	stats = index_vacuum_cleanup(&ivinfo, stats);
 
+	return stats;
+}
+
+/*
+ * Update the statistics of an index in pg_class after
+ * vacuum_appendonly_index(), and report them.  Frees 'stats'.
+ */
+static void
+vacuum_appendonly_index_update_stats(Relation indexRelation,
+									 IndexBulkDeleteResult *stats,
+									 bool bulkdelete,
+									 int elevel,
+									 PGRUsage *ru0)
+{
 	if (!stats)
 		return;
 
@@ -595,21 +885,270 @@ vacuum_appendonly_index(Relation indexRelation,
 							false,
 							true /* isvacuum */);
 
-	ereport(elevel,
-			(errmsg("index \"%s\" now contains %.0f row versions in %u pages",
-					RelationGetRelationName(indexRelation),
-					stats->num_index_tuples,
-					stats->num_pages),
-			 errdetail("%.0f index row versions were removed.\n"
-			 "%u index pages have been deleted, %u are currently reusable.\n"
-					   "%s.",
-					   stats->tuples_removed,
-					   stats->pages_deleted, stats->pages_free,
-					   pg_rusage_show(&ru0))));
+	if (bulkdelete)
+		ereport(elevel,
+				(errmsg("index \"%s\" now contains %.0f row versions in %u pages",
+						RelationGetRelationName(indexRelation),
+						stats->num_index_tuples,
+						stats->num_pages),
+				 errdetail("%.0f index row versions were removed.\n"
+				 "%u index pages have been deleted, %u are currently reusable.\n"
+						   "%s.",
+						   stats->tuples_removed,
+						   stats->pages_deleted, stats->pages_free,
+						   pg_rusage_show(ru0))));
+	else
+		ereport(elevel,
+				(errmsg("index \"%s\" now contains %.0f row versions in %u pages",
+						RelationGetRelationName(indexRelation),
+						stats->num_index_tuples,
+						stats->num_pages),
+				 errdetail("%u index pages have been deleted, %u are currently reusable.\n"
+						   "%s.",
+						   stats->pages_deleted, stats->pages_free,
+						   pg_rusage_show(ru0))));
+
+	pfree(stats);
+}
+
+/*
+ * Decide how many parallel workers to use to vacuum the indexes of an
+ * append-only table, and which of the indexes they can process.
+ *
+ * Only btree indexes are processed by the workers, because their bulk
+ * delete result is a plain IndexBulkDeleteResult that can be passed back
+ * to the leader, and they are known to be safe to vacuum in parallel mode;
+ * the leader processes all others itself afterwards.  Small indexes
+ * are not worth a worker either, by the same min_parallel_index_scan_size
+ * criterion that the planner uses for parallel index scans.
+ */
+static int
+vacuum_appendonly_compute_workers(Relation *Irel, int nindexes,
+								  bool *parallel_safe)
+{
+	int			nsafe = 0;
+	int			nworkers;
+	int			i;
+
+	for (i = 0; i < nindexes; i++)
+	{
+		parallel_safe[i] =
+			Irel[i]->rd_rel->relam == BTREE_AM_OID &&
+			RelationGetNumberOfBlocks(Irel[i]) >= min_parallel_index_scan_size;
+		if (parallel_safe[i])
+			nsafe++;
+	}
+
+	/* The QD holds no data, and there's nothing to share with one index */
+	if (Gp_role == GP_ROLE_DISPATCH || nsafe < 2 ||
+		IsInParallelMode() || !IsUnderPostmaster)
+		return 0;
 
+	/* The leader processes one of the indexes, too */
+	nworkers = Min(gp_appendonly_vacuum_parallel_workers,
+				   max_parallel_maintenance_workers);
+	nworkers = Min(nworkers, nsafe - 1);
+
+	return Max(nworkers, 0);
+}
+
+/*
+ * Vacuum the parallel safe indexes, until there are none left to claim.
+ * Called by the leader and by all workers.
+ */
+static void
+vacuum_appendonly_indexes_participate(AOVacuumShared *shared,
+									  Relation *Irel,
+									  AppendOnlyIndexVacuumState *vacuumIndexState,
+									  BufferAccessStrategy bstrategy)
+{
+	for (;;)
+	{
+		uint32		idx = pg_atomic_fetch_add_u32(&shared->nextindex, 1);
+		IndexBulkDeleteResult *stats;
+
+		if (idx >= (uint32) shared->nindexes)
+			break;
+		if (!shared->indexes[idx].parallel_safe)
+			continue;
+
+		stats = vacuum_appendonly_index(Irel[idx], vacuumIndexState,
+										shared->bulkdelete,
+										shared->rel_tuple_count,
+										shared->elevel,
+										bstrategy);
+		if (stats)
+		{
+			shared->indexes[idx].stats = *stats;
+			shared->indexes[idx].has_stats = true;
+			pfree(stats);
+		}
+	}
+}
+
+/*
+ * Vacuum the indexes of an append-only table with the help of 'nworkers'
+ * parallel workers.
+ *
+ * Every participant claims whole indexes, and vacuums them with its own
+ * visibility map and block directory lookups.  The statistics are passed
+ * back to the leader, which updates pg_class once the workers are done:
+ * that's not allowed in parallel mode.
+ */
+static void
+vacuum_appendonly_indexes_parallel(Relation aoRelation, int options,
+								   Relation *Irel, int nindexes,
+								   bool *parallel_safe, int nworkers,
+								   AppendOnlyIndexVacuumState *vacuumIndexState,
+								   bool bulkdelete, double rel_tuple_count,
+								   int elevel, BufferAccessStrategy bstrategy)
+{
+	ParallelContext *pcxt;
+	AOVacuumShared *shared;
+	Size		estshared;
+	IndexBulkDeleteResult **stats;
+	char	   *sharedquery;
+	int			querylen;
+	PGRUsage	ru0;
+	int			i;
+
+	pg_rusage_init(&ru0);
+	stats = palloc0(nindexes * sizeof(IndexBulkDeleteResult *));
+
+	EnterParallelMode();
+	pcxt = CreateParallelContext("postgres", "appendonly_parallel_vacuum_main",
+								 nworkers);
+
+	estshared = add_size(offsetof(AOVacuumShared, indexes),
+						 mul_size(nindexes, sizeof(AOVacuumIndexSlot)));
+	shm_toc_estimate_chunk(&pcxt->estimator, estshared);
+	querylen = strlen(debug_query_string);
+	shm_toc_estimate_chunk(&pcxt->estimator, querylen + 1);
+	shm_toc_estimate_keys(&pcxt->estimator, 2);
+
+	InitializeParallelDSM(pcxt);
+
+	shared = (AOVacuumShared *) shm_toc_allocate(pcxt->toc, estshared);
+	memset(shared, 0, estshared);
+	shared->relid = RelationGetRelid(aoRelation);
+	shared->options = options;
+	shared->bulkdelete = bulkdelete;
+	shared->rel_tuple_count = rel_tuple_count;
+	shared->elevel = elevel;
+	shared->nindexes = nindexes;
+	for (i = 0; i < nindexes; i++)
+		shared->indexes[i].parallel_safe = parallel_safe[i];
+	pg_atomic_init_u32(&shared->nextindex, 0);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_AO_VACUUM_SHARED, shared);
+
+	sharedquery = (char *) shm_toc_allocate(pcxt->toc, querylen + 1);
+	memcpy(sharedquery, debug_query_string, querylen + 1);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_QUERY_TEXT, sharedquery);
+
+	LaunchParallelWorkers(pcxt);
+
+	if (Debug_appendonly_print_compaction)
+		elog(LOG, "launched %d parallel workers to vacuum indexes of %s",
+			 pcxt->nworkers_launched, RelationGetRelationName(aoRelation));
+
+	/*
+	 * Join the workers.  If none could be launched, this processes all of
+	 * the parallel safe indexes serially.
+	 */
+	vacuum_appendonly_indexes_participate(shared, Irel, vacuumIndexState,
+										  bstrategy);
+
+	WaitForParallelWorkersToFinish(pcxt);
+
+	for (i = 0; i < nindexes; i++)
+	{
+		if (parallel_safe[i] && shared->indexes[i].has_stats)
+		{
+			stats[i] = palloc(sizeof(IndexBulkDeleteResult));
+			*stats[i] = shared->indexes[i].stats;
+		}
+	}
+
+	DestroyParallelContext(pcxt);
+	ExitParallelMode();
+
+	/* Vacuum the indexes the workers couldn't process, outside parallel mode */
+	for (i = 0; i < nindexes; i++)
+	{
+		if (!parallel_safe[i])
+			stats[i] = vacuum_appendonly_index(Irel[i], vacuumIndexState,
+											   bulkdelete, rel_tuple_count,
+											   elevel, bstrategy);
+	}
+
+	for (i = 0; i < nindexes; i++)
+		vacuum_appendonly_index_update_stats(Irel[i], stats[i], bulkdelete,
+											 elevel, &ru0);
 	pfree(stats);
 }
 
+/*
+ * Entry point of a parallel worker vacuuming indexes of an append-only table.
+ */
+void
+appendonly_parallel_vacuum_main(dsm_segment *seg, shm_toc *toc)
+{
+	AOVacuumShared *shared;
+	char	   *sharedquery;
+	Relation	aoRelation;
+	Relation   *Irel;
+	int			nindexes;
+	LOCKMODE	lockmode;
+	AppendOnlyIndexVacuumState vacuumIndexState;
+	FileSegInfo **segmentFileInfo;
+	int			totalSegfiles;
+	BufferAccessStrategy bstrategy;
+
+	/* Set debug_query_string for individual workers first */
+	sharedquery = shm_toc_lookup(toc, PARALLEL_KEY_QUERY_TEXT, false);
+	debug_query_string = sharedquery;
+
+	/* Report the query string from leader */
+	pgstat_report_activity(STATE_RUNNING, debug_query_string);
+
+	SIMPLE_FAULT_INJECTOR("appendonly_parallel_vacuum_worker");
+
+	shared = shm_toc_lookup(toc, PARALLEL_KEY_AO_VACUUM_SHARED, false);
+
+	/* Open relations using the same lock modes as the leader */
+	lockmode = (shared->options & VACOPT_FULL) ? AccessExclusiveLock : ShareUpdateExclusiveLock;
+	aoRelation = table_open(shared->relid, lockmode);
+	if ((shared->options & VACOPT_FULL))
+		vac_open_indexes(aoRelation, AccessExclusiveLock, &nindexes, &Irel);
+	else
+		vac_open_indexes(aoRelation, RowExclusiveLock, &nindexes, &Irel);
+
+	/* The leader holds a lock that prevents indexes from coming and going */
+	if (nindexes != shared->nindexes)
+		elog(ERROR, "parallel vacuum of \"%s\" expected %d indexes, found %d",
+			 RelationGetRelationName(aoRelation), shared->nindexes, nindexes);
+
+	segmentFileInfo = appendonly_index_vacuum_state_init(aoRelation,
+														 GetActiveSnapshot(),
+														 &vacuumIndexState,
+														 &totalSegfiles);
+	if (shared->bulkdelete)
+		appendonly_index_vacuum_collect_hidden_rows(aoRelation,
+													GetActiveSnapshot(),
+													&vacuumIndexState);
+	bstrategy = GetAccessStrategy(BAS_VACUUM);
+
+	vacuum_appendonly_indexes_participate(shared, Irel, &vacuumIndexState,
+										  bstrategy);
+
+	appendonly_index_vacuum_state_finish(aoRelation, &vacuumIndexState,
+										 segmentFileInfo, totalSegfiles);
+	FreeAccessStrategy(bstrategy);
+
+	vac_close_indexes(nindexes, Irel, NoLock);
+	table_close(aoRelation, NoLock);
+}
+
 static bool
 appendonly_tid_reaped_check_block_directory(AppendOnlyIndexVacuumState *vacuumState,
 											AOTupleId *aoTupleId)
@@ -639,8 +1178,8 @@ appendonly_tid_reaped_check_block_directory(AppendOnlyIndexVacuumState *vacuumSt
  * appendonly_tid_reaped()
  *
  * Is a particular tid for an appendonly reaped?
- * state should contain an integer list of all compacted
- * segment files.
+ * state is the AppendOnlyIndexVacuumState set up by
+ * appendonly_index_vacuum_state_init().
  *
  * This has the right signature to be an IndexBulkDeleteCallback.
  */
@@ -657,13 +1196,24 @@ appendonly_tid_reaped(ItemPointer itemptr, void *state)
 	aoTupleId = (AOTupleId *)itemptr;
 	vacuumState = (AppendOnlyIndexVacuumState *)state;
 
-	reaped = !appendonly_tid_reaped_check_block_directory(vacuumState,
-														  aoTupleId);
-	if (!reaped)
+	if (vacuumState->deadSegfile[AOTupleIdGet_segmentFileNum(aoTupleId)])
+		reaped = true;
+	else if (vacuumState->hiddenRows &&
+			 intset_is_member(vacuumState->hiddenRows,
+							  appendonly_hidden_row_key(aoTupleId)))
+		reaped = true;
+	else
 	{
-		/* Also check visi map */
-		reaped = !AppendOnlyVisimap_IsVisible(&vacuumState->visiMap,
-		aoTupleId);
+		reaped = !appendonly_tid_reaped_check_block_directory(vacuumState,
+															  aoTupleId);
+
+		/*
+		 * Also check visi map, unless we know the hidden rows, and this is
+		 * not one of them.
+		 */
+		if (!reaped && vacuumState->hiddenRows == NULL)
+			reaped = !AppendOnlyVisimap_IsVisible(&vacuumState->visiMap,
+												  aoTupleId);
 	}
 
 	if (Debug_appendonly_print_compaction)
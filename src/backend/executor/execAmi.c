@@ -35,6 +35,7 @@
 #include "executor/nodeLimit.h"
 #include "executor/nodeLockRows.h"
 #include "executor/nodeMaterial.h"
+#include "executor/nodeMemoize.h"
 #include "executor/nodeMergeAppend.h"
 #include "executor/nodeMergejoin.h"
 #include "executor/nodeModifyTable.h"
@@ -286,6 +287,10 @@ ExecReScan(PlanState *node)
 			ExecReScanMaterial((MaterialState *) node);
 			break;
 
+		case T_MemoizeState:
+			ExecReScanMemoize((MemoizeState *) node);
+			break;
+
 		case T_SortState:
 			ExecReScanSort((SortState *) node);
 			break;
@@ -784,6 +789,10 @@ ExecSquelchNode(PlanState *node)
 			ExecSquelchMaterial((MaterialState*) node);
 			break;
 
+		case T_MemoizeState:
+			ExecSquelchMemoize((MemoizeState *) node);
+			break;
+
 		case T_SortState:
 			ExecSquelchSort((SortState *) node);
 			break;
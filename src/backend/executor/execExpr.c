@@ -50,6 +50,7 @@
 
 #include "access/tuptoaster.h"
 #include "catalog/pg_collation.h"
+#include "cdb/cdbhash.h"
 #include "cdb/cdbvars.h"
 #include "utils/pg_locale.h"
 
@@ -68,6 +69,9 @@ static void ExecInitFunc(ExprEvalStep *scratch, Expr *node, List *args,
 						 Oid funcid, Oid inputcollid,
 						 ExprState *state);
 static void ExecInitExprSlots(ExprState *state, Node *node);
+static FunctionCallInfo ExecInitCdbHashKey(CdbHash *h, int keyno);
+static void ExecPushCdbHashStep(ExprState *state, CdbHash *h, int keyno,
+								FunctionCallInfo fcinfo);
 static void ExecPushExprSlots(ExprState *state, LastAttnumInfo *info);
 static bool get_last_attnums_walker(Node *node, LastAttnumInfo *info);
 static void ExecComputeSlotInfo(ExprState *state, ExprEvalStep *op);
@@ -3813,6 +3817,170 @@ ExecBuildGroupingEqual(TupleDesc ldesc, TupleDesc rdesc,
 	return state;
 }
 
+/*
+ * Build an ExprState that computes the distribution hash of a row, like
+ * cdbhashinit() and a cdbhash() call for each of the distribution keys
+ * would.  Having the hash computation as expression steps lets the hash
+ * functions of the common types be inlined, and the whole computation be
+ * JIT compiled along with the key expressions.
+ *
+ * The result is the 32-bit hash value, before reduction to a segment.
+ * Store it in h->hash, and reduce it with cdbhashreduce().
+ *
+ * hashExprs: distribution key expressions, one for each hash function in h
+ * parent: parent executor node
+ */
+ExprState *
+ExecBuildCdbHash(CdbHash *h, List *hashExprs, PlanState *parent)
+{
+	ExprState  *state = makeNode(ExprState);
+	ListCell   *lc;
+	int			keyno = 0;
+
+	Assert(list_length(hashExprs) == h->natts);
+	Assert(h->natts > 0);
+
+	state->expr = (Expr *) hashExprs;
+	state->parent = parent;
+
+	/* Insert EEOP_*_FETCHSOME steps as needed */
+	ExecInitExprSlots(state, (Node *) hashExprs);
+
+	foreach(lc, hashExprs)
+	{
+		FunctionCallInfo fcinfo = ExecInitCdbHashKey(h, keyno);
+
+		/* evaluate the key directly into the hash function's argument */
+		ExecInitExprRec((Expr *) lfirst(lc), state,
+						&fcinfo->args[0].value, &fcinfo->args[0].isnull);
+
+		ExecPushCdbHashStep(state, h, keyno, fcinfo);
+		keyno++;
+	}
+
+	ExecPushCdbHashStep(state, NULL, -1, NULL);
+
+	ExecReadyExpr(state);
+
+	return state;
+}
+
+/*
+ * Like ExecBuildCdbHash(), but for distribution keys that are columns of the
+ * expression context's outer tuple.
+ *
+ * desc: tuple descriptor of the outer tuple
+ * ops: slot type of the outer tuple, if known
+ * keyColIdx: array of attribute numbers of the distribution keys
+ * parent: parent executor node, or NULL
+ */
+ExprState *
+ExecBuildCdbHashForSlot(CdbHash *h, TupleDesc desc,
+						const TupleTableSlotOps *ops,
+						const AttrNumber *keyColIdx,
+						PlanState *parent)
+{
+	ExprState  *state = makeNode(ExprState);
+	ExprEvalStep scratch = {0};
+	int			maxatt = -1;
+	int			keyno;
+
+	Assert(h->natts > 0);
+
+	state->expr = NULL;
+	state->parent = parent;
+
+	/* compute max needed attribute */
+	for (keyno = 0; keyno < h->natts; keyno++)
+	{
+		if (keyColIdx[keyno] > maxatt)
+			maxatt = keyColIdx[keyno];
+	}
+	Assert(maxatt >= 0);
+
+	/* push deform step */
+	scratch.opcode = EEOP_OUTER_FETCHSOME;
+	scratch.d.fetch.last_var = maxatt;
+	scratch.d.fetch.fixed = false;
+	scratch.d.fetch.known_desc = desc;
+	scratch.d.fetch.kind = ops;
+	ExecComputeSlotInfo(state, &scratch);
+	ExprEvalPushStep(state, &scratch);
+
+	for (keyno = 0; keyno < h->natts; keyno++)
+	{
+		AttrNumber	attno = keyColIdx[keyno];
+		FunctionCallInfo fcinfo = ExecInitCdbHashKey(h, keyno);
+
+		/* fetch the column directly into the hash function's argument */
+		scratch.opcode = EEOP_OUTER_VAR;
+		scratch.d.var.attnum = attno - 1;
+		scratch.d.var.vartype = TupleDescAttr(desc, attno - 1)->atttypid;
+		scratch.resvalue = &fcinfo->args[0].value;
+		scratch.resnull = &fcinfo->args[0].isnull;
+		ExprEvalPushStep(state, &scratch);
+
+		ExecPushCdbHashStep(state, h, keyno, fcinfo);
+	}
+
+	ExecPushCdbHashStep(state, NULL, -1, NULL);
+
+	ExecReadyExpr(state);
+
+	return state;
+}
+
+/*
+ * Set up the call of the hash function of the keyno'th distribution key.
+ */
+static FunctionCallInfo
+ExecInitCdbHashKey(CdbHash *h, int keyno)
+{
+	FunctionCallInfo fcinfo = palloc0(SizeForFunctionCallInfo(1));
+
+	/* Hash with the default collation, as cdbhash() does */
+	InitFunctionCallInfoData(*fcinfo, &h->hashfuncs[keyno], 1,
+							 DEFAULT_COLLATION_OID, NULL, NULL);
+
+	return fcinfo;
+}
+
+/*
+ * Push the step combining the hash of the keyno'th distribution key, which
+ * has been evaluated into fcinfo's argument, into the result.  With a NULL
+ * 'h', push the final step instead.
+ */
+static void
+ExecPushCdbHashStep(ExprState *state, CdbHash *h, int keyno,
+					FunctionCallInfo fcinfo)
+{
+	ExprEvalStep scratch = {0};
+
+	if (h == NULL)
+	{
+		scratch.opcode = EEOP_DONE;
+		ExprEvalPushStep(state, &scratch);
+		return;
+	}
+
+	if (h->is_legacy_hash)
+		scratch.opcode = EEOP_CDBHASH_LEGACY;
+	else if (fcinfo->flinfo->fn_oid == F_HASHINT4 ||
+			 fcinfo->flinfo->fn_oid == F_HASHOID)
+		scratch.opcode = EEOP_CDBHASH_INT4;
+	else if (fcinfo->flinfo->fn_oid == F_HASHINT8)
+		scratch.opcode = EEOP_CDBHASH_INT8;
+	else
+		scratch.opcode = EEOP_CDBHASH;
+	scratch.resvalue = &state->resvalue;
+	scratch.resnull = &state->resnull;
+	scratch.d.cdbhash.finfo = fcinfo->flinfo;
+	scratch.d.cdbhash.fcinfo_data = fcinfo;
+	scratch.d.cdbhash.fn_addr = fcinfo->flinfo->fn_addr;
+	scratch.d.cdbhash.first = (keyno == 0);
+	ExprEvalPushStep(state, &scratch);
+}
+
 /* ----------------------------------------------------------------
  *	isJoinExprNull
  *
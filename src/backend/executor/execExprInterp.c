@@ -76,8 +76,10 @@
 #include "utils/typcache.h"
 #include "utils/xml.h"
 
+#include "cdb/cdbhash.h"
 #include "cdb/cdbvars.h"
 #include "utils/fmgroids.h"
+#include "utils/hashutils.h"
 
 
 /*
@@ -163,6 +165,18 @@ static Datum ExecJustAssignOuterVar(ExprState *state, ExprContext *econtext, boo
 static Datum ExecJustAssignScanVar(ExprState *state, ExprContext *econtext, bool *isnull);
 static Datum ExecJustApplyFuncToCase(ExprState *state, ExprContext *econtext, bool *isnull);
 
+/*
+ * The distribution hash of the keys before an EEOP_CDBHASH* step, rotated
+ * left by one bit.
+ */
+static inline uint32
+cdbhash_rotate_previous(ExprEvalStep *op)
+{
+	uint32		hashkey = op->d.cdbhash.first ? 0 : DatumGetUInt32(*op->resvalue);
+
+	return (hashkey << 1) | (hashkey >> 31);
+}
+
 
 /*
  * Prepare ExprState for interpreted execution.
@@ -405,6 +419,10 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 		&&CASE_EEOP_AGG_PLAIN_TRANS,
 		&&CASE_EEOP_AGG_ORDERED_TRANS_DATUM,
 		&&CASE_EEOP_AGG_ORDERED_TRANS_TUPLE,
+		&&CASE_EEOP_CDBHASH,
+		&&CASE_EEOP_CDBHASH_INT4,
+		&&CASE_EEOP_CDBHASH_INT8,
+		&&CASE_EEOP_CDBHASH_LEGACY,
 		&&CASE_EEOP_LAST
 	};
 
@@ -1834,6 +1852,79 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 			EEO_NEXT();
 		}
 
+		/*
+		 * Add a distribution key to the distribution hash: like cdbhash(),
+		 * rotate the hash of the previous keys left by one bit, and xor in
+		 * the hash of this key unless it's NULL.
+		 */
+		EEO_CASE(EEOP_CDBHASH)
+		{
+			FunctionCallInfo fcinfo = op->d.cdbhash.fcinfo_data;
+			uint32		hashkey = cdbhash_rotate_previous(op);
+
+			if (!fcinfo->args[0].isnull)
+			{
+				Datum		d;
+
+				fcinfo->isnull = false;
+				d = op->d.cdbhash.fn_addr(fcinfo);
+				if (fcinfo->isnull)
+					elog(ERROR, "function %u returned NULL",
+						 fcinfo->flinfo->fn_oid);
+				hashkey ^= DatumGetUInt32(d);
+			}
+
+			*op->resvalue = UInt32GetDatum(hashkey);
+			*op->resnull = false;
+
+			EEO_NEXT();
+		}
+
+		/* same, with hashint4() or hashoid() inlined */
+		EEO_CASE(EEOP_CDBHASH_INT4)
+		{
+			FunctionCallInfo fcinfo = op->d.cdbhash.fcinfo_data;
+			uint32		hashkey = cdbhash_rotate_previous(op);
+
+			if (!fcinfo->args[0].isnull)
+				hashkey ^= DatumGetUInt32(hash_uint32(DatumGetUInt32(fcinfo->args[0].value)));
+
+			*op->resvalue = UInt32GetDatum(hashkey);
+			*op->resnull = false;
+
+			EEO_NEXT();
+		}
+
+		/* same, with hashint8() inlined */
+		EEO_CASE(EEOP_CDBHASH_INT8)
+		{
+			FunctionCallInfo fcinfo = op->d.cdbhash.fcinfo_data;
+			uint32		hashkey = cdbhash_rotate_previous(op);
+
+			if (!fcinfo->args[0].isnull)
+			{
+				int64		val = DatumGetInt64(fcinfo->args[0].value);
+				uint32		lohalf = (uint32) val;
+				uint32		hihalf = (uint32) (val >> 32);
+
+				lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+				hashkey ^= DatumGetUInt32(hash_uint32(lohalf));
+			}
+
+			*op->resvalue = UInt32GetDatum(hashkey);
+			*op->resnull = false;
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_CDBHASH_LEGACY)
+		{
+			/* legacy hash functions communicate through a global variable */
+			ExecEvalCdbHashLegacy(state, op);
+
+			EEO_NEXT();
+		}
+
 		EEO_CASE(EEOP_LAST)
 		{
 			/* unreachable */
@@ -3681,6 +3772,38 @@ ExecEvalScalarArrayOpFastInt(ExprState *state, ExprEvalStep *op)
 	*op->resnull = false;
 }
 
+/*
+ * Add a distribution key to a legacy distribution hash.  The legacy hash
+ * functions take the hash of the previous keys from magic_hash_stash, and
+ * replace it, see cdblegacyhash.c.
+ */
+void
+ExecEvalCdbHashLegacy(ExprState *state, ExprEvalStep *op)
+{
+	FunctionCallInfo fcinfo = op->d.cdbhash.fcinfo_data;
+	uint32		hashkey;
+
+	hashkey = op->d.cdbhash.first ? FNV1_32_INIT : DatumGetUInt32(*op->resvalue);
+
+	magic_hash_stash = hashkey;
+	if (!fcinfo->args[0].isnull)
+	{
+		Datum		d;
+
+		fcinfo->isnull = false;
+		d = op->d.cdbhash.fn_addr(fcinfo);
+		if (fcinfo->isnull)
+			elog(ERROR, "function %u returned NULL", fcinfo->flinfo->fn_oid);
+		hashkey = DatumGetUInt32(d);
+	}
+	else
+		hashkey = cdblegacyhash_null();
+	magic_hash_stash = FNV1_32_INIT;
+
+	*op->resvalue = UInt32GetDatum(hashkey);
+	*op->resnull = false;
+}
+
 /*
  * Fast-path version of "scalar op ANY/ALL (array)", texteq() variant.
  */
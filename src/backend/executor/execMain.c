@@ -95,6 +95,7 @@
 #include "cdb/cdbdisp_query.h"
 #include "cdb/cdbdispatchresult.h"
 #include "cdb/cdbexplain.h"             /* cdbexplain_sendExecStats() */
+#include "cdb/cdbinitplancache.h"
 #include "cdb/cdbplan.h"
 #include "cdb/cdbsubplan.h"
 #include "cdb/cdbvars.h"
@@ -278,6 +279,13 @@ standard_ExecutorStart(QueryDesc *queryDesc, int eflags)
 		!(eflags & EXEC_FLAG_EXPLAIN_ONLY))
 		ExecCheckXactReadOnly(queryDesc->plannedstmt);
 
+	/*
+	 * Let cached InitPlan results that depend on the relations we are about
+	 * to modify know that they are going stale.
+	 */
+	if (Gp_role == GP_ROLE_DISPATCH && !(eflags & EXEC_FLAG_EXPLAIN_ONLY))
+		InitPlanCacheNoteWrites(queryDesc->plannedstmt);
+
 	/*
 	 * Build EState, switch into per-query memory context for startup.
 	 */
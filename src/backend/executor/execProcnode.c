@@ -94,6 +94,7 @@
 #include "executor/nodeLimit.h"
 #include "executor/nodeLockRows.h"
 #include "executor/nodeMaterial.h"
+#include "executor/nodeMemoize.h"
 #include "executor/nodeMergeAppend.h"
 #include "executor/nodeMergejoin.h"
 #include "executor/nodeModifyTable.h"
@@ -128,6 +129,8 @@
 #include "executor/nodeSplitUpdate.h"
 #include "executor/nodeTableFunction.h"
 #include "pg_trace.h"
+#include "postmaster/ash_sampler.h"
+#include "storage/proc.h"
 #include "tcop/tcopprot.h"
 #include "utils/memutils.h"
 #include "utils/metrics_utils.h"
@@ -386,6 +389,11 @@ ExecInitNode(Plan *node, EState *estate, int eflags)
 													estate, eflags);
 			break;
 
+		case T_Memoize:
+			result = (PlanState *) ExecInitMemoize((Memoize *) node, estate,
+												   eflags);
+			break;
+
 		case T_Sort:
 			result = (PlanState *) ExecInitSort((Sort *) node,
 												estate, eflags);
@@ -565,6 +573,7 @@ ExecProcNodeGPDB(PlanState *node)
 {
 	TupleTableSlot *result;
 	MemoryContext oldcxt = NULL;
+	int			savedPlanNodeId;
 
 	/*
 	 * Even if we are requested to finish query, Motion has to do its work
@@ -596,7 +605,19 @@ ExecProcNodeGPDB(PlanState *node)
 	if ((node->state->es_instrument & INSTRUMENT_MEMORY_DETAIL) != 0)
 		oldcxt = MemoryContextSwitchTo(node->node_context);
 
-	result = node->ExecProcNodeReal(node);
+	/* Publish the node we're in for the active session history sampler */
+	if (gp_ash_buffer_size > 0)
+	{
+		savedPlanNodeId = MyProc->planNodeId;
+		if (node->plan)
+			MyProc->planNodeId = node->plan->plan_node_id;
+
+		result = node->ExecProcNodeReal(node);
+
+		MyProc->planNodeId = savedPlanNodeId;
+	}
+	else
+		result = node->ExecProcNodeReal(node);
 
 	if ((node->state->es_instrument & INSTRUMENT_MEMORY_DETAIL) != 0)
 	{
@@ -651,6 +672,7 @@ Node *
 MultiExecProcNode(PlanState *node)
 {
 	Node	   *result;
+	int			savedPlanNodeId;
 
 	check_stack_depth();
 
@@ -658,6 +680,10 @@ MultiExecProcNode(PlanState *node)
 
 	Assert(NULL != node->plan);
 
+	savedPlanNodeId = MyProc->planNodeId;
+	if (gp_ash_buffer_size > 0)
+		MyProc->planNodeId = node->plan->plan_node_id;
+
 	TRACE_POSTGRESQL_EXECPROCNODE_ENTER(GpIdentity.segindex, currentSliceId, nodeTag(node), node->plan->plan_node_id);
 	
 	if (!node->fHadSentNodeStart)
@@ -699,6 +725,9 @@ MultiExecProcNode(PlanState *node)
 			break;
 	}
 
+	if (gp_ash_buffer_size > 0)
+		MyProc->planNodeId = savedPlanNodeId;
+
 	TRACE_POSTGRESQL_EXECPROCNODE_EXIT(GpIdentity.segindex, currentSliceId, nodeTag(node), node->plan->plan_node_id);
 
 	return result;
@@ -895,6 +924,10 @@ ExecEndNode(PlanState *node)
 			ExecEndMaterial((MaterialState *) node);
 			break;
 
+		case T_MemoizeState:
+			ExecEndMemoize((MemoizeState *) node);
+			break;
+
 		case T_SortState:
 			ExecEndSort((SortState *) node);
 			break;
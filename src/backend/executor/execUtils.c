@@ -88,7 +88,9 @@
 #include "miscadmin.h"
 #include "nodes/makefuncs.h"
 #include "storage/ipc.h"
+#include "storage/proc.h"
 #include "cdb/cdbllize.h"
+#include "cdb/cdbtargeteddispatch.h"
 #include "utils/guc.h"
 #include "utils/workfile_mgr.h"
 #include "utils/metrics_utils.h"
@@ -1233,7 +1235,7 @@ ExecPrefetchJoinQual(JoinState *node)
 
 
 static void
-FillSliceGangInfo(ExecSlice *slice, PlanSlice *ps)
+FillSliceGangInfo(ExecSlice *slice, PlanSlice *ps, ParamListInfo params)
 {
 	int numsegments = ps->numsegments;
 	DirectDispatchInfo *dd = &ps->directDispatch;
@@ -1250,11 +1252,21 @@ FillSliceGangInfo(ExecSlice *slice, PlanSlice *ps)
 		case GANGTYPE_PRIMARY_WRITER:
 		case GANGTYPE_PRIMARY_READER:
 			slice->planNumSegments = numsegments;
-			if (dd->isDirectDispatch)
+			if (dd->isDirectDispatch && dd->paramKeys != NIL)
+			{
+				/*
+				 * The target depends on parameter values, compute it now.
+				 * If that's not possible, fall back to all segments.
+				 */
+				slice->segments = GetDirectDispatchContentIdsFromParams(dd, params);
+			}
+			else if (dd->isDirectDispatch)
 			{
 				slice->segments = list_copy(dd->contentIds);
 			}
-			else
+
+			if (!dd->isDirectDispatch ||
+				(dd->paramKeys != NIL && slice->segments == NIL))
 			{
 				int i;
 				slice->segments = NIL;
@@ -1359,7 +1371,7 @@ InitSliceTable(EState *estate, PlannedStmt *plannedstmt)
 		currExecSlice->rootIndex = rootIndex;
 		currExecSlice->gangType = currPlanSlice->gangType;
 
-		FillSliceGangInfo(currExecSlice, currPlanSlice);
+		FillSliceGangInfo(currExecSlice, currPlanSlice, estate->es_param_list_info);
 	}
 	table->numSlices = numSlices;
 
@@ -1591,7 +1603,10 @@ getGpExecIdentity(QueryDesc *queryDesc,
     {
         if (Gp_role == GP_ROLE_EXECUTE ||
             sliceRunsOnQD(currentSlice))
+        {
             currentSliceId = currentSlice->sliceIndex;
+            MyProc->sliceId = currentSliceId;
+        }
     }
 
 	/* select the strategy */
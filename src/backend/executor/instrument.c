@@ -435,6 +435,8 @@ pickInstrFromShmem(const Plan *plan, int instrument_options)
 		slot->ssid = gp_session_id;
 		slot->ccnt = gp_command_count;
 		slot->nid = (int16) plan->plan_node_id;
+		slot->sliceid = (int16) currentSliceId;
+		slot->starttime = GetCurrentTimestamp();
 
 		MemoryContext contextSave = MemoryContextSwitchTo(TopMemoryContext);
 
@@ -455,6 +457,34 @@ pickInstrFromShmem(const Plan *plan, int instrument_options)
 	return instr;
 }
 
+/*
+ * Publish the number of bytes a Motion node has sent and received so far,
+ * and for a Redistribute Motion the most rows sent to any single target
+ * segment, so that they can be observed while the query runs.  Only
+ * instrumentation living in a shmem slot has somewhere to put them;
+ * otherwise this is a no-op.
+ */
+void
+GpInstrSetMotionProgress(Instrumentation *instr, uint64 nbytes,
+						 uint64 maxtargetrows)
+{
+	InstrumentationSlot *first;
+	InstrumentationSlot *slot;
+
+	if (NULL == InstrumentGlobal || NULL == instr)
+		return;
+
+	first = (InstrumentationSlot *) (InstrumentGlobal + 1);
+	if ((InstrumentationSlot *) instr < first ||
+		(InstrumentationSlot *) instr >= first + InstrShmemNumSlots())
+		return;
+
+	/* data is the first member of the slot */
+	slot = (InstrumentationSlot *) instr;
+	slot->motionbytes = nbytes;
+	slot->maxtargetrows = maxtargetrows;
+}
+
 /*
  * Recycle instrumentation in shmem
  */
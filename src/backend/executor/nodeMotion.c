@@ -26,6 +26,9 @@
 #include "executor/execUtils.h"
 #include "executor/nodeMotion.h"
 #include "lib/binaryheap.h"
+#include "mb/pg_wchar.h"
+#include "nodes/nodeFuncs.h"
+#include "utils/lsyscache.h"
 #include "utils/tuplesort.h"
 #include "miscadmin.h"
 #include "utils/memutils.h"
@@ -45,6 +48,25 @@
 #endif
 
 
+/*
+ * Heavy-hitter tracking for skew reports on a Redistribute Motion sender.
+ * Every MOTION_SKEW_SAMPLE_INTERVAL'th row is fed, by the full (unreduced)
+ * hash of its distribution key, into a space-saving summary of
+ * MOTION_SKEW_NUM_SAMPLES counters.  The key is only rendered as text when
+ * a counter is (re)assigned to it, so the per-row cost is a few compares.
+ */
+#define MOTION_SKEW_SAMPLE_INTERVAL	16
+#define MOTION_SKEW_NUM_SAMPLES		8
+#define MOTION_SKEW_KEY_MAXLEN		64
+
+typedef struct MotionSkewSample
+{
+	uint32		hash;			/* full hash of the distribution key */
+	int			target;			/* segment the key is sent to */
+	int64		count;			/* sampled rows, possibly overestimated */
+	char	   *keytext;		/* rendered key values */
+} MotionSkewSample;
+
 /*=========================================================================
  * FUNCTIONS PROTOTYPES
  */
@@ -53,9 +75,14 @@ static TupleTableSlot *execMotionUnsortedReceiver(MotionState *node);
 static TupleTableSlot *execMotionSortedReceiver(MotionState *node);
 
 static int	CdbMergeComparator(Datum lhs, Datum rhs, void *context);
-static uint32 evalHashKey(ExprContext *econtext, List *hashkeys, CdbHash *h);
+static uint32 evalHashKey(ExprContext *econtext, ExprState *hashexpr, CdbHash *h);
 
 static void doSendEndOfStream(Motion *motion, MotionState *node);
+static void updateMotionBytes(MotionState *node);
+static void noteMotionTarget(MotionState *node, ExprContext *econtext, int target);
+static void reportMotionSkew(Motion *motion, MotionState *node);
+static void reportMisestimate(Motion *motion, MotionState *node);
+static void setHostBroadcastTargets(Motion *motion, MotionState *node);
 static void doSendTuple(Motion *motion, MotionState *node, TupleTableSlot *outerTupleSlot);
 
 
@@ -143,6 +170,8 @@ ExecMotion(PlanState *pstate)
 		else
 			tuple = execMotionUnsortedReceiver(node);
 
+		updateMotionBytes(node);
+
 		/*
 		 * We tell the upper node as if this was the end of tuple stream if
 		 * query-finish is requested.  Unlike other nodes, we skipped this
@@ -254,6 +283,12 @@ execMotionSender(MotionState *node)
 		else
 		{
 			doSendTuple(motion, node, outerTupleSlot);
+			updateMotionBytes(node);
+
+			if (motion->reoptRowLimit > 0 &&
+				node->numTuplesFromChild > motion->reoptRowLimit)
+				reportMisestimate(motion, node);
+
 			/* doSendTuple() may have set node->stopRequested as a side-effect */
 
 			if (node->stopRequested)
@@ -641,6 +676,7 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 	motionstate->mstype = MOTIONSTATE_NONE;
 	motionstate->stopRequested = false;
 	motionstate->hashExprs = NIL;
+	motionstate->hashExprState = NULL;
 	motionstate->cdbhash = NULL;
 
 	/* Look up the sending and receiving gang's slice table entries. */
@@ -761,6 +797,68 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 		motionstate->cdbhash = makeCdbHash(motionstate->numHashSegments,
 										   nkeys,
 										   node->hashFuncs);
+
+		/* Compute the hash of the keys in one expression, see evalHashKey() */
+		if (nkeys > 0)
+			motionstate->hashExprState = ExecBuildCdbHash(motionstate->cdbhash,
+														  node->hashExprs,
+														  (PlanState *) motionstate);
+
+		/*
+		 * Skew-resilient redistribution: remember the hashes of the
+		 * heavy-hitter key values, so that they are recognized without
+		 * comparing the values themselves.  Equal values of the join key
+		 * hash alike on both sides of the join, so a hash collision merely
+		 * treats another value as a heavy hitter on both sides too.
+		 */
+		if (node->skewValues != NIL)
+		{
+			ListCell   *lc;
+			int			i = 0;
+
+			Assert(nkeys == 1);
+			motionstate->skewHashes = (uint32 *)
+				palloc(list_length(node->skewValues) * sizeof(uint32));
+			foreach(lc, node->skewValues)
+			{
+				Const	   *skewValue = lfirst_node(Const, lc);
+
+				cdbhashinit(motionstate->cdbhash);
+				cdbhash(motionstate->cdbhash, 1,
+						skewValue->constvalue, skewValue->constisnull);
+				motionstate->skewHashes[i++] = motionstate->cdbhash->hash;
+			}
+			motionstate->numSkewHashes = i;
+
+			/* Let each sender start spreading at a different segment */
+			motionstate->skewNextTarget =
+				Max(GpIdentity.segindex, 0) % motionstate->numHashSegments;
+		}
+
+		/* Per-target row counts and key samples for skew detection */
+		motionstate->numTuplesPerTarget =
+			(int64 *) palloc0(motionstate->numHashSegments * sizeof(int64));
+		if (nkeys > 0)
+		{
+			ListCell   *lc;
+			int			i = 0;
+
+			motionstate->skewSamples = (MotionSkewSample *)
+				palloc0(MOTION_SKEW_NUM_SAMPLES * sizeof(MotionSkewSample));
+			motionstate->hashKeyOutFuncs = (Oid *) palloc(nkeys * sizeof(Oid));
+			foreach(lc, node->hashExprs)
+			{
+				bool		typisvarlena;
+
+				getTypeOutputInfo(exprType((Node *) lfirst(lc)),
+								  &motionstate->hashKeyOutFuncs[i++],
+								  &typisvarlena);
+			}
+		}
+
+		/* CDB: Offer extra info for EXPLAIN ANALYZE. */
+		if (estate->es_instrument && (estate->es_instrument & INSTRUMENT_CDB))
+			motionstate->ps.cdbexplainbuf = makeStringInfo();
 	}
 
 	/*
@@ -990,19 +1088,15 @@ CdbMergeComparator(Datum lhs, Datum rhs, void *context)
 }								/* CdbMergeComparator */
 
 /*
- * Experimental code that will be replaced later with new hashing mechanism
+ * Compute the target segment of the outer tuple in econtext.
  */
 uint32
-evalHashKey(ExprContext *econtext, List *hashkeys, CdbHash * h)
+evalHashKey(ExprContext *econtext, ExprState *hashexpr, CdbHash * h)
 {
-	ListCell   *hk;
-	MemoryContext oldContext;
 	unsigned int target_seg;
 
 	ResetExprContext(econtext);
 
-	oldContext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
-
 	/*
 	 * If we have 1 or more distribution keys for this relation, hash them.
 	 * However, If this happens to be a relation with an empty policy
@@ -1010,42 +1104,261 @@ evalHashKey(ExprContext *econtext, List *hashkeys, CdbHash * h)
 	 * hash key value to feed in, so use cdbhashrandomseg() to pick a segment
 	 * at random.
 	 */
-	if (list_length(hashkeys) > 0)
+	if (hashexpr != NULL)
+	{
+		bool		isNull;
+
+		/*
+		 * The expression evaluates the keys and combines their hashes, see
+		 * ExecBuildCdbHash().  Leave the hash in h, like cdbhash() would.
+		 */
+		h->hash = DatumGetUInt32(ExecEvalExprSwitchContext(hashexpr, econtext,
+															&isNull));
+		Assert(!isNull);
+		target_seg = cdbhashreduce(h);
+	}
+	else
+	{
+		target_seg = cdbhashrandomseg(h->numsegs);
+	}
+
+	return target_seg;
+}
+
+/*
+ * Publish the bytes moved through this motion node so far in its shmem
+ * instrumentation slot, so that they can be monitored while the query runs.
+ */
+static void
+updateMotionBytes(MotionState *node)
+{
+	if (node->ps.instrument == NULL || InstrumentGlobal == NULL)
+		return;
+
+	GpInstrSetMotionProgress(node->ps.instrument,
+							 GetMotionNodeBytes(node->ps.state->motionlayer_context,
+												((Motion *) node->ps.plan)->motionID),
+							 (uint64) node->maxTuplesPerTarget);
+}
+
+/*
+ * Render the distribution key of the current outer tuple as "(v1, v2)",
+ * truncated to MOTION_SKEW_KEY_MAXLEN, in the query memory context.
+ */
+static char *
+formatHashKey(MotionState *node, ExprContext *econtext)
+{
+	StringInfoData buf;
+	MemoryContext oldContext;
+	ListCell   *hk;
+	char	   *result;
+	int			i = 0;
+
+	oldContext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+	initStringInfo(&buf);
+	appendStringInfoChar(&buf, '(');
+	foreach(hk, node->hashExprs)
 	{
-		int			i;
+		ExprState  *keyexpr = (ExprState *) lfirst(hk);
+		Datum		keyval;
+		bool		isNull;
+
+		keyval = ExecEvalExpr(keyexpr, econtext, &isNull);
+		if (i > 0)
+			appendStringInfoString(&buf, ", ");
+		if (isNull)
+			appendStringInfoString(&buf, "NULL");
+		else
+			appendStringInfoString(&buf,
+								   OidOutputFunctionCall(node->hashKeyOutFuncs[i],
+														 keyval));
+		i++;
+	}
+	appendStringInfoChar(&buf, ')');
 
-		cdbhashinit(h);
+	if (buf.len > MOTION_SKEW_KEY_MAXLEN)
+	{
+		buf.len = pg_mbcliplen(buf.data, buf.len, MOTION_SKEW_KEY_MAXLEN);
+		buf.data[buf.len] = '\0';
+		appendStringInfoString(&buf, "...");
+	}
 
-		i = 0;
-		foreach(hk, hashkeys)
-		{
-			ExprState  *keyexpr = (ExprState *) lfirst(hk);
-			Datum		keyval;
-			bool		isNull;
+	MemoryContextSwitchTo(oldContext);
 
-			/*
-			 * Get the attribute value of the tuple
-			 */
-			keyval = ExecEvalExpr(keyexpr, econtext, &isNull);
+	result = MemoryContextStrdup(node->ps.state->es_query_cxt, buf.data);
+	pfree(buf.data);
 
-			/*
-			 * Compute the hash function
-			 */
-			cdbhash(h, i + 1, keyval, isNull);
-			i++;
+	return result;
+}
+
+/*
+ * Is 'hash' the hash of one of the heavy-hitter values of a skew-resilient
+ * Redistribute Motion?  There are only a handful, so just scan them.
+ */
+static inline bool
+isSkewHash(MotionState *node, uint32 hash)
+{
+	for (int i = 0; i < node->numSkewHashes; i++)
+	{
+		if (node->skewHashes[i] == hash)
+			return true;
+	}
+	return false;
+}
+
+/*
+ * Account for a row sent by a Redistribute Motion to 'target', and sample
+ * its distribution key for the heavy-hitter summary.  evalHashKey() must
+ * have just been called for the row, leaving its full hash in node->cdbhash.
+ */
+static void
+noteMotionTarget(MotionState *node, ExprContext *econtext, int target)
+{
+	MotionSkewSample *samples = node->skewSamples;
+	MotionSkewSample *victim;
+	uint32		hash;
+	int64		n;
+	int			i;
+
+	n = ++node->numTuplesPerTarget[target];
+	if (n > node->maxTuplesPerTarget)
+	{
+		node->maxTuplesPerTarget = n;
+		node->maxTarget = target;
+	}
+
+	if (samples == NULL ||
+		node->numTuplesFromChild % MOTION_SKEW_SAMPLE_INTERVAL != 0)
+		return;
+
+	hash = node->cdbhash->hash;
+	for (i = 0; i < node->numSkewSamples; i++)
+	{
+		if (samples[i].hash == hash && samples[i].target == target)
+		{
+			samples[i].count++;
+			return;
 		}
-		target_seg = cdbhashreduce(h);
+	}
+
+	/*
+	 * Not tracked yet.  Take a free counter if there is one, otherwise evict
+	 * the smallest and inherit its count, as the space-saving algorithm does.
+	 */
+	if (node->numSkewSamples < MOTION_SKEW_NUM_SAMPLES)
+	{
+		victim = &samples[node->numSkewSamples++];
+		victim->count = 0;
 	}
 	else
 	{
-		target_seg = cdbhashrandomseg(h->numsegs);
+		victim = &samples[0];
+		for (i = 1; i < MOTION_SKEW_NUM_SAMPLES; i++)
+		{
+			if (samples[i].count < victim->count)
+				victim = &samples[i];
+		}
+		pfree(victim->keytext);
 	}
 
-	MemoryContextSwitchTo(oldContext);
+	victim->hash = hash;
+	victim->target = target;
+	victim->count++;
+	victim->keytext = formatHashKey(node, econtext);
+}
 
-	return target_seg;
+static int
+skewSampleCmp(const void *a, const void *b)
+{
+	const MotionSkewSample *sa = (const MotionSkewSample *) a;
+	const MotionSkewSample *sb = (const MotionSkewSample *) b;
+
+	if (sa->count > sb->count)
+		return -1;
+	if (sa->count < sb->count)
+		return 1;
+	return 0;
+}
+
+/*
+ * At end of stream, check how evenly a Redistribute Motion spread its rows.
+ * Warn if one segment got gp_motion_skew_warning_ratio times the average or
+ * more, and leave a note for EXPLAIN ANALYZE either way.
+ */
+static void
+reportMotionSkew(Motion *motion, MotionState *node)
+{
+	int64		total = node->numTuplesFromChild;
+	double		ratio;
+	bool		warn;
+	StringInfoData keys;
+	int			i;
+
+	if (node->numTuplesPerTarget == NULL || total == 0)
+		return;
+
+	ratio = (double) node->maxTuplesPerTarget * node->numHashSegments / total;
+	warn = (gp_motion_skew_warning_ratio > 0 &&
+			total >= gp_motion_skew_min_rows &&
+			ratio >= gp_motion_skew_warning_ratio);
+
+	if (!warn && node->ps.cdbexplainbuf == NULL)
+		return;
+
+	/* Most frequent sampled keys that went to the busiest segment */
+	initStringInfo(&keys);
+	qsort(node->skewSamples, node->numSkewSamples, sizeof(MotionSkewSample),
+		  skewSampleCmp);
+	for (i = 0; i < node->numSkewSamples; i++)
+	{
+		MotionSkewSample *sample = &node->skewSamples[i];
+
+		if (sample->target != node->maxTarget)
+			continue;
+		if (keys.len > 0)
+			appendStringInfoString(&keys, ", ");
+		appendStringInfo(&keys, "%s ~" INT64_FORMAT " rows", sample->keytext,
+						 sample->count * MOTION_SKEW_SAMPLE_INTERVAL);
+	}
+
+	if (warn)
+		ereport(WARNING,
+				(errmsg("Redistribute Motion %d is skewed: segment %d was sent " INT64_FORMAT " of " INT64_FORMAT " rows, %.1f times the average",
+						motion->motionID, node->maxTarget,
+						node->maxTuplesPerTarget, total, ratio),
+				 keys.len > 0 ?
+				 errdetail("Most frequent distribution key values sent to segment %d: %s.",
+						   node->maxTarget, keys.data) : 0,
+				 errhint("Consider a distribution key with more distinct values, or raise gp_motion_skew_warning_ratio.")));
+
+	if (node->ps.cdbexplainbuf != NULL)
+	{
+		appendStringInfo(node->ps.cdbexplainbuf,
+						 "Max rows sent to one segment: " INT64_FORMAT " (seg%d), %.1f times the average.\n",
+						 node->maxTuplesPerTarget, node->maxTarget, ratio);
+		if (keys.len > 0)
+			appendStringInfo(node->ps.cdbexplainbuf,
+							 "Frequent distribution keys: %s.\n", keys.data);
+	}
+
+	pfree(keys.data);
 }
 
+/*
+ * Give up on a Broadcast Motion that got far more rows from its subplan than
+ * the plan expected.  The QD catches this error and plans the query again,
+ * see cdbreopt.c.
+ */
+static void
+reportMisestimate(Motion *motion, MotionState *node)
+{
+	ereport(ERROR,
+			(errcode(ERRCODE_GP_CARDINALITY_MISESTIMATE),
+			 errmsg("Broadcast Motion %d received more than %.0f rows, estimated %.0f",
+					motion->motionID, motion->reoptRowLimit,
+					motion->plan.lefttree->plan_rows)));
+}
 
 void
 doSendEndOfStream(Motion *motion, MotionState *node)
@@ -1058,6 +1371,72 @@ doSendEndOfStream(Motion *motion, MotionState *node)
 					node->ps.state->interconnect_context,
 					motion->motionID);
 	node->sentEndOfStream = true;
+
+	reportMotionSkew(motion, node);
+}
+
+/*
+ * Choose the receivers of a host-aware Broadcast (see cdbhostbcast.c).
+ *
+ * A relaying Broadcast sends to one segment of every host.  Each sender
+ * picks a different one, the (n mod k)th segment of a host with k segments
+ * for the sender on segment n, so that the work of passing the rows on is
+ * spread over the host.  A local Broadcast sends to all the segments on the
+ * sender's own host.
+ */
+static void
+setHostBroadcastTargets(Motion *motion, MotionState *node)
+{
+	ChunkTransportStateEntry *pEntry;
+	bool	   *targets;
+	int		   *hostSegs;
+	int		   *hostOrdinals;
+	int			sender = Max(GpIdentity.segindex, 0);
+	int			i;
+
+	Assert(motion->numHostSegments > 0);
+
+	if (sender >= motion->numHostSegments)
+		sender %= motion->numHostSegments;
+
+	getChunkTransportState(node->ps.state->interconnect_context,
+						   motion->motionID, &pEntry);
+
+	targets = MemoryContextAllocZero(node->ps.state->es_query_cxt,
+									 pEntry->numConns * sizeof(bool));
+
+	/* # of segments on each host, and the position of each on its host */
+	hostSegs = palloc0(motion->numHostSegments * sizeof(int));
+	hostOrdinals = palloc(motion->numHostSegments * sizeof(int));
+	for (i = 0; i < motion->numHostSegments; i++)
+		hostOrdinals[i] = hostSegs[motion->segmentHosts[i]]++;
+
+	for (i = 0; i < pEntry->numConns; i++)
+	{
+		MotionConn *conn = &pEntry->conns[i];
+		int			contentid;
+		int			host;
+
+		if (conn->cdbProc == NULL)
+			continue;
+
+		contentid = conn->cdbProc->contentid;
+		if (contentid < 0 || contentid >= motion->numHostSegments)
+			elog(ERROR, "unexpected receiver segment %d for host-aware broadcast motion %d",
+				 contentid, motion->motionID);
+		host = motion->segmentHosts[contentid];
+
+		if (motion->hostMode == BROADCAST_HOST_RELAY)
+			targets[i] = (hostOrdinals[contentid] == sender % hostSegs[host]);
+		else
+			targets[i] = (host == motion->segmentHosts[sender]);
+	}
+
+	pfree(hostSegs);
+	pfree(hostOrdinals);
+
+	pEntry->broadcastTargets = targets;
+	node->hostTargetsSet = true;
 }
 
 /*
@@ -1109,6 +1488,9 @@ doSendTuple(Motion *motion, MotionState *node, TupleTableSlot *outerTupleSlot)
 	}
 	else if (motion->motionType == MOTIONTYPE_BROADCAST)
 	{
+		if (motion->hostMode != BROADCAST_HOST_NONE && !node->hostTargetsSet)
+			setHostBroadcastTargets(motion, node);
+
 		targetRoute = BROADCAST_SEGIDX;
 	}
 	else if (motion->motionType == MOTIONTYPE_HASH) /* Redistribute */
@@ -1117,7 +1499,7 @@ doSendTuple(Motion *motion, MotionState *node, TupleTableSlot *outerTupleSlot)
 
 		econtext->ecxt_outertuple = outerTupleSlot;
 
-		hval = evalHashKey(econtext, node->hashExprs, node->cdbhash);
+		hval = evalHashKey(econtext, node->hashExprState, node->cdbhash);
 
 #ifdef USE_ASSERT_CHECKING
 		Assert(hval < node->numHashSegments &&
@@ -1140,6 +1522,24 @@ doSendTuple(Motion *motion, MotionState *node, TupleTableSlot *outerTupleSlot)
 		 * is passed around our system a fair amount!).
 		 */
 		Assert(targetRoute != BROADCAST_SEGIDX);
+
+		/*
+		 * Heavy-hitter key of a skew-resilient join: send the row to all
+		 * segments, or to the next segment in turn.
+		 */
+		if (node->numSkewHashes > 0 && isSkewHash(node, node->cdbhash->hash))
+		{
+			if (motion->skewBroadcast)
+				targetRoute = BROADCAST_SEGIDX;
+			else
+			{
+				targetRoute = node->skewNextTarget;
+				node->skewNextTarget = (targetRoute + 1) % node->numHashSegments;
+			}
+		}
+
+		if (targetRoute != BROADCAST_SEGIDX)
+			noteMotionTarget(node, econtext, targetRoute);
 	}
 	else if (motion->motionType == MOTIONTYPE_EXPLICIT)
 	{
@@ -176,27 +176,22 @@ ExecResult(PlanState *pstate)
 static bool
 TupleMatchesHashFilter(ResultState *node, TupleTableSlot *resultSlot)
 {
-	Result	   *resultNode = (Result *)node->ps.plan;
 	bool		res = true;
 
-	Assert(resultNode);
 	Assert(!TupIsNull(resultSlot));
 
 	if (node->hashFilter)
 	{
-		int			i;
+		ExprContext *econtext = node->ps.ps_ExprContext;
+		TupleTableSlot *saveOuterTuple = econtext->ecxt_outertuple;
+		bool		isnull;
 
-		cdbhashinit(node->hashFilter);
-		for (i = 0; i < resultNode->numHashFilterCols; i++)
-		{
-			int			attnum = resultNode->hashFilterColIdx[i];
-			Datum		hAttr;
-			bool		isnull;
-
-			hAttr = slot_getattr(resultSlot, attnum, &isnull);
-
-			cdbhash(node->hashFilter, i + 1, hAttr, isnull);
-		}
+		/* the hash expression reads the columns from the outer tuple */
+		econtext->ecxt_outertuple = resultSlot;
+		node->hashFilter->hash =
+			DatumGetUInt32(ExecEvalExprSwitchContext(node->hashFilterExpr,
+													 econtext, &isnull));
+		econtext->ecxt_outertuple = saveOuterTuple;
 
 		int targetSeg = cdbhashreduce(node->hashFilter);
 
@@ -306,6 +301,12 @@ ExecInitResult(Result *node, EState *estate, int eflags)
 		resstate->hashFilter = makeCdbHash(currentSlice->planNumSegments,
 										   node->numHashFilterCols,
 										   node->hashFilterFuncs);
+		resstate->hashFilterExpr =
+			ExecBuildCdbHashForSlot(resstate->hashFilter,
+									resstate->ps.ps_ResultTupleDesc,
+									NULL,
+									node->hashFilterColIdx,
+									(PlanState *) resstate);
 	}
 
 	if (!IsResManagerMemoryPolicyNone()
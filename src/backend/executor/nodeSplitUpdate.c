@@ -37,34 +37,20 @@ static void SplitTupleTableSlot(TupleTableSlot *slot,
  * Evaluate the hash keys, and compute the target segment ID for the new row.
  */
 static uint32
-evalHashKey(SplitUpdateState *node, Datum *values, bool *isnulls)
+evalHashKey(SplitUpdateState *node)
 {
-	SplitUpdate *plannode = (SplitUpdate *) node->ps.plan;
 	ExprContext *econtext = node->ps.ps_ExprContext;
-	MemoryContext oldContext;
-	unsigned int target_seg;
 	CdbHash	   *h = node->cdbhash;
+	bool		isnull;
 
 	ResetExprContext(econtext);
 
-	oldContext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
-
-	cdbhashinit(h);
-
-	for (int i = 0; i < plannode->numHashAttrs; i++)
-	{
-		AttrNumber	keyattno = plannode->hashAttnos[i];
-
-		/*
-		 * Compute the hash function
-		 */
-		cdbhash(h, i + 1, values[keyattno - 1], isnulls[keyattno - 1]);
-	}
-	target_seg = cdbhashreduce(h);
-
-	MemoryContextSwitchTo(oldContext);
+	/* the hash expression reads the keys from the new row */
+	econtext->ecxt_outertuple = node->insertTuple;
+	h->hash = DatumGetUInt32(ExecEvalExprSwitchContext(node->hashExprState,
+													   econtext, &isnull));
 
-	return target_seg;
+	return cdbhashreduce(h);
 }
 
 /* Split TupleTableSlot into a DELETE and INSERT TupleTableSlot */
@@ -155,7 +141,7 @@ SplitTupleTableSlot(TupleTableSlot *slot,
 	{
 		int32		target_seg;
 
-		target_seg = evalHashKey(node, insert_values, insert_nulls);
+		target_seg = evalHashKey(node);
 
 		insert_values[node->output_segid_attno - 1] = Int32GetDatum(target_seg);
 		insert_nulls[node->output_segid_attno - 1] = false;
@@ -268,6 +254,12 @@ ExecInitSplitUpdate(SplitUpdate *node, EState *estate, int eflags)
 		splitupdatestate->cdbhash = makeCdbHash(node->numHashSegments,
 												node->numHashAttrs,
 												node->hashFuncs);
+		splitupdatestate->hashExprState =
+			ExecBuildCdbHashForSlot(splitupdatestate->cdbhash,
+									tupDesc,
+									&TTSOpsVirtual,
+									node->hashAttnos,
+									(PlanState *) splitupdatestate);
 	}
 
 	if (estate->es_instrument && (estate->es_instrument & INSTRUMENT_CDB))
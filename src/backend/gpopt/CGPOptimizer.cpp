@@ -23,6 +23,7 @@
 #include "gpos/_api.h"
 #include "gpos/memory/CMemoryPoolManager.h"
 
+#include "gpdbcost/CCostModelParamsGPDB.h"
 #include "gpopt/gpdbwrappers.h"
 #include "gpopt/init.h"
 #include "naucrates/exception.h"
@@ -53,6 +54,11 @@ CGPOptimizer::GPOPTOptimizedPlan(
 
 	*had_unexpected_failure = false;
 
+	if (optimizer_print_wrapper_calls)
+	{
+		gpdb::ResetWrapperCalls();
+	}
+
 	GPOS_TRY
 	{
 		plStmt = COptTasks::GPOPTOptimizedPlan(query, &gpopt_context);
@@ -144,6 +150,12 @@ CGPOptimizer::GPOPTOptimizedPlan(
 			pfree(serialized_error_msg);
 	}
 	GPOS_CATCH_END;
+
+	if (optimizer_print_wrapper_calls)
+	{
+		gpdb::ReportWrapperCalls();
+	}
+
 	return plStmt;
 }
 
@@ -176,6 +188,22 @@ CGPOptimizer::SerializeDXLPlan(Query *query)
 	return nullptr;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		GPOPTIsCostModelParam
+//
+//	@doc:
+//		Check cost model parameter names from C files
+//
+//---------------------------------------------------------------------------
+extern "C" {
+bool
+GPOPTIsCostModelParam(const char *name)
+{
+	return CGPOptimizer::IsCostModelParam(name);
+}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		InitGPOPT()
@@ -215,6 +243,21 @@ CGPOptimizer::TerminateGPOPT()
 	gpos_terminate();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CGPOptimizer::IsCostModelParam
+//
+//	@doc:
+//		Is the given name the name of a parameter of the GPDB cost model
+//
+//---------------------------------------------------------------------------
+bool
+CGPOptimizer::IsCostModelParam(const char *name)
+{
+	return CCostModelParamsGPDB::EcpSentinel !=
+		   CCostModelParamsGPDB::EcpLookup(name);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		GPOPTOptimizedPlan
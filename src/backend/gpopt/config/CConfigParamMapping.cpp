@@ -278,7 +278,19 @@ CConfigParamMapping::SConfigMappingElem CConfigParamMapping::m_elements[] = {
 	{EopttraceAllowGeneralPredicatesforDPE,
 	 &optimizer_enable_range_predicate_dpe,
 	 false,	 // m_negate_param
-	 GPOS_WSZ_LIT("Enable range predicates for dynamic partition elimination.")}
+	 GPOS_WSZ_LIT("Enable range predicates for dynamic partition elimination.")},
+	{EopttraceDisableForeignKeyStats, &optimizer_enable_foreign_key_stats,
+	 true,	// m_negate_param
+	 GPOS_WSZ_LIT("Use foreign keys to estimate the cardinality of joins.")},
+	{EopttraceEnableForeignKeyJoinElimination,
+	 &optimizer_enable_foreign_key_join_elimination,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Eliminate inner joins to unused relations referenced by a foreign key.")},
+	{EopttraceDisableExtendedStats, &optimizer_enable_extended_stats,
+	 true,	// m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Use extended statistics to estimate the cardinality of filters and group by.")}
 
 };
 
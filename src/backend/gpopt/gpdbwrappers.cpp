@@ -32,19 +32,32 @@
 #include "catalog/pg_collation.h"
 extern "C" {
 #include "access/external.h"
+#include "access/htup_details.h"
+#include "catalog/pg_index.h"
 #include "catalog/pg_inherits.h"
+#include "catalog/pg_statistic.h"
+#include "catalog/pg_statistic_ext.h"
 #include "nodes/nodeFuncs.h"
 #include "optimizer/clauses.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/plancat.h"
 #include "parser/parse_agg.h"
 #include "partitioning/partdesc.h"
+#include "partitioning/partprune.h"
+#include "statistics/statistics.h"
 #include "storage/lmgr.h"
 #include "utils/fmgroids.h"
+#include "utils/guc.h"
 #include "utils/memutils.h"
 #include "utils/partcache.h"
+#include "utils/relcache.h"
 }
+
+static void CountWrapperCall(const char *func_name);
+
 #define GP_WRAP_START                                            \
+	if (unlikely(optimizer_print_wrapper_calls))                 \
+		CountWrapperCall(__func__);                              \
 	sigjmp_buf local_sigjmp_buf;                                 \
 	{                                                            \
 		CAutoExceptionStack aes((void **) &PG_exception_stack,   \
@@ -749,6 +762,83 @@ gpdb::GetAttStats(Oid relid, AttrNumber attnum)
 	return nullptr;
 }
 
+HeapTuple
+gpdb::GetAttStatsWithSlots(Oid relid, AttrNumber attnum,
+						   AttStatsSlot *mcv_slot, AttStatsSlot *hist_slot)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_statistic */
+		HeapTuple statstuple = get_att_stats(relid, attnum);
+
+		if (HeapTupleIsValid(statstuple))
+		{
+			(void) get_attstatsslot(mcv_slot, statstuple, STATISTIC_KIND_MCV,
+									InvalidOid,
+									ATTSTATSSLOT_VALUES | ATTSTATSSLOT_NUMBERS);
+			(void) get_attstatsslot(hist_slot, statstuple,
+									STATISTIC_KIND_HISTOGRAM, InvalidOid,
+									ATTSTATSSLOT_VALUES);
+		}
+		else
+		{
+			memset(mcv_slot, 0, sizeof(AttStatsSlot));
+			memset(hist_slot, 0, sizeof(AttStatsSlot));
+		}
+		return statstuple;
+	}
+	GP_WRAP_END;
+	return nullptr;
+}
+
+void
+gpdb::FreeAttStatsWithSlots(HeapTuple statstuple, AttStatsSlot *mcv_slot,
+							AttStatsSlot *hist_slot)
+{
+	GP_WRAP_START;
+	{
+		free_attstatsslot(mcv_slot);
+		free_attstatsslot(hist_slot);
+		if (HeapTupleIsValid(statstuple))
+			heap_freetuple(statstuple);
+		return;
+	}
+	GP_WRAP_END;
+}
+
+void
+gpdb::GetAttStatsWidths(Oid relid, int natts, int32 *widths)
+{
+	GP_WRAP_START;
+	{
+		for (int i = 0; i < natts; i++)
+		{
+			/*
+			 * catalog tables: pg_statistic; same lookup as get_att_stats(),
+			 * but without copying the whole tuple just to read stawidth
+			 */
+			HeapTuple statstuple = SearchSysCache3(
+				STATRELATTINH, ObjectIdGetDatum(relid),
+				Int16GetDatum(i + 1), BoolGetDatum(true));
+			if (!HeapTupleIsValid(statstuple))
+				statstuple = SearchSysCache3(
+					STATRELATTINH, ObjectIdGetDatum(relid),
+					Int16GetDatum(i + 1), BoolGetDatum(false));
+
+			if (HeapTupleIsValid(statstuple))
+			{
+				widths[i] =
+					((Form_pg_statistic) GETSTRUCT(statstuple))->stawidth;
+				ReleaseSysCache(statstuple);
+			}
+			else
+				widths[i] = -1;
+		}
+		return;
+	}
+	GP_WRAP_END;
+}
+
 Oid
 gpdb::GetCommutatorOp(Oid opno)
 {
@@ -837,6 +927,28 @@ gpdb::GetRelationPartConstraints(Relation rel)
 	return nullptr;
 }
 
+List *
+gpdb::GetPartitionsMatchingQuals(Relation rel, Index varno, Node *quals)
+{
+	GP_WRAP_START;
+	{
+		Bitmapset *matching = prune_partitions_for_quals(
+			rel, varno, make_ands_implicit((Expr *) quals));
+		PartitionDesc partdesc = RelationGetPartitionDesc(rel);
+		List *result = NIL;
+
+		for (int i = -1; (i = bms_next_member(matching, i)) >= 0;)
+		{
+			result = lappend_oid(result, partdesc->oids[i]);
+		}
+		bms_free(matching);
+
+		return result;
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
 #if 0
 bool
 gpdb::HasExternalPartition
@@ -1124,6 +1236,78 @@ gpdb::GetRelationKeys(Oid relid)
 	return NIL;
 }
 
+List *
+gpdb::GetRelationForeignKeys(Relation rel)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: relcache */
+		return RelationGetFKeyList(rel);
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
+List *
+gpdb::GetRelationExtStatistics(Relation rel)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: relcache */
+		return RelationGetStatExtList(rel);
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
+// check if the given kind of statistics has been built for an extended
+// statistics object
+static bool
+IsExtStatsKindBuilt(Oid stat_oid, char kind)
+{
+	HeapTuple htup =
+		SearchSysCache1(STATEXTDATASTXOID, ObjectIdGetDatum(stat_oid));
+	if (!HeapTupleIsValid(htup))
+	{
+		return false;
+	}
+
+	bool is_built = statext_is_kind_built(htup, kind);
+	ReleaseSysCache(htup);
+
+	return is_built;
+}
+
+MVDependencies *
+gpdb::GetMVDependencies(Oid stat_oid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_statistic_ext_data */
+		if (IsExtStatsKindBuilt(stat_oid, STATS_EXT_DEPENDENCIES))
+		{
+			return statext_dependencies_load(stat_oid);
+		}
+	}
+	GP_WRAP_END;
+	return nullptr;
+}
+
+MVNDistinct *
+gpdb::GetMVNDistinct(Oid stat_oid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_statistic_ext_data */
+		if (IsExtStatsKindBuilt(stat_oid, STATS_EXT_NDISTINCT))
+		{
+			return statext_ndistinct_load(stat_oid);
+		}
+	}
+	GP_WRAP_END;
+	return nullptr;
+}
+
 Oid
 gpdb::GetTypeRelid(Oid typid)
 {
@@ -1159,6 +1343,28 @@ gpdb::GetGPSegmentCount(void)
 	return 0;
 }
 
+int
+gpdb::GetGPSegmentHostCount(void)
+{
+	GP_WRAP_START;
+	{
+		return GetSegmentHostCount();
+	}
+	GP_WRAP_END;
+	return 0;
+}
+
+QueryFeedbackEntry *
+gpdb::GetQueryFeedback(int *nentries)
+{
+	GP_WRAP_START;
+	{
+		return QueryFeedbackSnapshot(nentries);
+	}
+	GP_WRAP_END;
+	return nullptr;
+}
+
 bool
 gpdb::HeapAttIsNull(HeapTuple tup, int attno)
 {
@@ -1700,6 +1906,44 @@ gpdb::GetTypeDefault(Oid typid)
 	return nullptr;
 }
 
+void
+gpdb::GetColumnDefaults(TupleDesc tupdesc, Node **defaults)
+{
+	GP_WRAP_START;
+	{
+		TupleConstr *constr = tupdesc->constr;
+
+		for (int i = 0; i < tupdesc->natts; i++)
+		{
+			Form_pg_attribute att = TupleDescAttr(tupdesc, i);
+
+			defaults[i] = nullptr;
+			if (att->attisdropped)
+				continue;
+
+			/* the relation's own default for the column, if any */
+			if (nullptr != constr)
+			{
+				for (int j = 0; j < constr->num_defval; j++)
+				{
+					if (constr->defval[j].adnum == att->attnum)
+					{
+						defaults[i] =
+							(Node *) stringToNode(constr->defval[j].adbin);
+						break;
+					}
+				}
+			}
+
+			/* catalog tables: pg_type */
+			if (nullptr == defaults[i])
+				defaults[i] = get_typdefault(att->atttypid);
+		}
+		return;
+	}
+	GP_WRAP_END;
+}
+
 
 double
 gpdb::NumericToDoubleNoOverflow(Numeric num)
@@ -2033,6 +2277,76 @@ gpdb::GetRelationIndexes(Relation relation)
 	return NIL;
 }
 
+static void
+FillIndexProps(Relation index_rel, gpdb::IndexProps *props)
+{
+	props->oid = RelationGetRelid(index_rel);
+	props->found = true;
+	props->relam = index_rel->rd_rel->relam;
+	props->is_valid = index_rel->rd_index->indisvalid;
+	props->has_include_cols =
+		index_rel->rd_index->indnatts > index_rel->rd_index->indnkeyatts;
+	props->has_exprs =
+		!heap_attisnull(index_rel->rd_indextuple, Anum_pg_index_indexprs,
+						nullptr);
+	props->has_pred = !heap_attisnull(index_rel->rd_indextuple,
+									  Anum_pg_index_indpred, nullptr);
+}
+
+void
+gpdb::GetIndexProps(Relation index_rel, IndexProps *props)
+{
+	GP_WRAP_START;
+	{
+		FillIndexProps(index_rel, props);
+		return;
+	}
+	GP_WRAP_END;
+}
+
+int
+gpdb::GetRelationIndexProps(Relation relation, IndexProps **props)
+{
+	GP_WRAP_START;
+	{
+		List *index_oids = NIL;
+		IndexProps *result = nullptr;
+		int nindexes = 0;
+		ListCell *lc;
+
+		/* catalog tables: from relcache */
+		if (relation->rd_rel->relhasindex)
+			index_oids = RelationGetIndexList(relation);
+
+		if (index_oids != NIL)
+			result = (IndexProps *) palloc0(list_length(index_oids) *
+											sizeof(IndexProps));
+
+		foreach (lc, index_oids)
+		{
+			Oid index_oid = lfirst_oid(lc);
+			Relation index_rel = RelationIdGetRelation(index_oid);
+			IndexProps *index_props = &result[nindexes++];
+
+			if (nullptr == index_rel)
+			{
+				index_props->oid = index_oid;
+				index_props->found = false;
+				continue;
+			}
+
+			FillIndexProps(index_rel, index_props);
+			RelationClose(index_rel);
+		}
+		list_free(index_oids);
+
+		*props = result;
+		return nindexes;
+	}
+	GP_WRAP_END;
+	return 0;
+}
+
 gpdb::RelationWrapper
 gpdb::GetRelation(Oid rel_oid)
 {
@@ -2834,4 +3148,88 @@ gpdb::GPDBLockRelationOid(Oid reloid, LOCKMODE lockmode)
 	GP_WRAP_END;
 }
 
+/*
+ * Counts of calls through the wrappers above, to see which catalog lookups
+ * dominate the optimization of a query when optimizer_print_wrapper_calls
+ * is on.  Each wrapper counts itself in GP_WRAP_START under its __func__,
+ * which is a distinct static string per function, so the table is keyed by
+ * the pointer and needs no string comparisons.  It only lives in the QD
+ * backend, and is reset at the start of each optimization.
+ */
+#define WRAPPER_CALLS_SIZE 512
+
+struct WrapperCallCount
+{
+	const char *func_name;
+	uint64 count;
+};
+
+static WrapperCallCount wrapper_calls[WRAPPER_CALLS_SIZE];
+static uint64 wrapper_calls_total = 0;
+
+static void
+CountWrapperCall(const char *func_name)
+{
+	uint32 i = (uint32) (((uintptr_t) func_name) >> 3) % WRAPPER_CALLS_SIZE;
+
+	wrapper_calls_total++;
+	for (int probes = 0; probes < WRAPPER_CALLS_SIZE; probes++)
+	{
+		WrapperCallCount *entry = &wrapper_calls[i];
+
+		if (entry->func_name == func_name)
+		{
+			entry->count++;
+			return;
+		}
+		if (nullptr == entry->func_name)
+		{
+			entry->func_name = func_name;
+			entry->count = 1;
+			return;
+		}
+		i = (i + 1) % WRAPPER_CALLS_SIZE;
+	}
+	/* table full: only the total is counted */
+}
+
+static int
+CompareWrapperCallCounts(const void *a, const void *b)
+{
+	const WrapperCallCount *ca = (const WrapperCallCount *) a;
+	const WrapperCallCount *cb = (const WrapperCallCount *) b;
+
+	if (ca->count != cb->count)
+		return (ca->count > cb->count) ? -1 : 1;
+	return 0;
+}
+
+void
+gpdb::ResetWrapperCalls()
+{
+	memset(wrapper_calls, 0, sizeof(wrapper_calls));
+	wrapper_calls_total = 0;
+}
+
+void
+gpdb::ReportWrapperCalls()
+{
+	WrapperCallCount sorted[WRAPPER_CALLS_SIZE];
+	int nentries = 0;
+
+	for (int i = 0; i < WRAPPER_CALLS_SIZE; i++)
+	{
+		if (nullptr != wrapper_calls[i].func_name)
+			sorted[nentries++] = wrapper_calls[i];
+	}
+	qsort(sorted, nentries, sizeof(WrapperCallCount),
+		  CompareWrapperCallCounts);
+
+	elog(LOG, "optimizer made " UINT64_FORMAT " calls through %d wrappers",
+		 wrapper_calls_total, nentries);
+	for (int i = 0; i < nentries; i++)
+		elog(LOG, "  %s: " UINT64_FORMAT, sorted[i].func_name,
+			 sorted[i].count);
+}
+
 // EOF
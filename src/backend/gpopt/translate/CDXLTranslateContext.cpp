@@ -49,8 +49,11 @@ CDXLTranslateContext::CDXLTranslateContext(CMemoryPool *mp,
 	: m_mp(mp), m_is_child_agg_node(is_child_agg_node)
 {
 	m_colid_to_target_entry_map = GPOS_NEW(m_mp) ULongToTargetEntryMap(m_mp);
-	m_colid_to_paramid_map = GPOS_NEW(m_mp) ULongToColParamMap(m_mp);
-	CopyParamHashmap(original);
+
+	// share the params hashmap of the parent context; it is only copied if
+	// this context adds a mapping of its own, see FInsertParamMapping
+	original->AddRef();
+	m_colid_to_paramid_map = original;
 }
 
 //---------------------------------------------------------------------------
@@ -92,6 +95,8 @@ CDXLTranslateContext::IsParentAggNode() const
 void
 CDXLTranslateContext::CopyParamHashmap(ULongToColParamMap *original)
 {
+	m_colid_to_paramid_map = GPOS_NEW(m_mp) ULongToColParamMap(m_mp);
+
 	// iterate over full map
 	ULongToColParamMapIter hashmapiter(original);
 	while (hashmapiter.Advance())
@@ -169,6 +174,15 @@ BOOL
 CDXLTranslateContext::FInsertParamMapping(
 	ULONG colid, CMappingElementColIdParamId *colidparamid)
 {
+	// the hashmap may still be shared with the parent context or with
+	// sibling contexts; copy it before changing it
+	if (1 < m_colid_to_paramid_map->RefCount())
+	{
+		ULongToColParamMap *shared_map = m_colid_to_paramid_map;
+		CopyParamHashmap(shared_map);
+		shared_map->Release();
+	}
+
 	// copy key
 	ULONG *key = GPOS_NEW(m_mp) ULONG(colid);
 
@@ -44,6 +44,7 @@ extern "C" {
 #include <tuple>
 
 #include "gpos/base.h"
+#include "gpos/common/CAutoTimer.h"
 
 #include "gpopt/base/CUtils.h"
 #include "gpopt/gpdbwrappers.h"
@@ -160,6 +161,9 @@ CTranslatorDXLToPlStmt::GetPlannedStmtFromDXL(const CDXLNode *dxlnode,
 {
 	GPOS_ASSERT(nullptr != dxlnode);
 
+	CAutoTimer at("\n[OPT]: DXL To PlStmt Translation Time",
+				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
+
 	CDXLTranslateContext dxl_translate_ctxt(m_mp, false);
 
 	PlanSlice *topslice;
@@ -4591,6 +4595,11 @@ CTranslatorDXLToPlStmt::TranslateDXLProjList(
 
 	List *target_list = NIL;
 
+	// the column mapping is the same for all project elements
+	CMappingColIdVarPlStmt colid_var_mapping =
+		CMappingColIdVarPlStmt(m_mp, base_table_context, child_contexts,
+							   output_context, m_dxl_to_plstmt_context);
+
 	// translate each DXL project element into a target entry
 	const ULONG arity = project_list_dxlnode->Arity();
 	for (ULONG ul = 0; ul < arity; ++ul)
@@ -4605,10 +4614,6 @@ CTranslatorDXLToPlStmt::TranslateDXLProjList(
 		// translate proj element expression
 		CDXLNode *expr_dxlnode = (*proj_elem_dxlnode)[0];
 
-		CMappingColIdVarPlStmt colid_var_mapping =
-			CMappingColIdVarPlStmt(m_mp, base_table_context, child_contexts,
-								   output_context, m_dxl_to_plstmt_context);
-
 		Expr *expr = m_translator_dxl_to_scalar->TranslateDXLToScalar(
 			expr_dxlnode, &colid_var_mapping);
 
@@ -4697,7 +4702,7 @@ CTranslatorDXLToPlStmt::CreateTargetListWithNullsForDroppedCols(
 	GPOS_ASSERT(gpdb::ListLength(target_list) <= md_rel->ColumnCount());
 
 	List *result_list = NIL;
-	ULONG last_tgt_elem = 0;
+	ListCell *lc_target_entry = gpdb::ListHead(target_list);
 	ULONG resno = 1;
 
 	const ULONG num_of_rel_cols = md_rel->ColumnCount();
@@ -4723,10 +4728,12 @@ CTranslatorDXLToPlStmt::CreateTargetListWithNullsForDroppedCols(
 		}
 		else
 		{
-			TargetEntry *target_entry =
-				(TargetEntry *) gpdb::ListNth(target_list, last_tgt_elem);
-			expr = (Expr *) gpdb::CopyObject(target_entry->expr);
-			last_tgt_elem++;
+			// the input target list is discarded by the caller, so its
+			// expressions can be reused without copying them
+			GPOS_ASSERT(nullptr != lc_target_entry);
+			TargetEntry *target_entry = (TargetEntry *) lfirst(lc_target_entry);
+			expr = target_entry->expr;
+			lc_target_entry = lnext(lc_target_entry);
 		}
 
 		CHAR *name_str =
@@ -4893,9 +4900,9 @@ CTranslatorDXLToPlStmt::TranslateDXLScCondToQual(
 void
 CTranslatorDXLToPlStmt::TranslatePlanCosts(const CDXLNode *dxlnode, Plan *plan)
 {
-	CDXLOperatorCost *costs =
-		CDXLPhysicalProperties::PdxlpropConvert(dxlnode->GetProperties())
-			->GetDXLOperatorCost();
+	CDXLPhysicalProperties *properties =
+		CDXLPhysicalProperties::PdxlpropConvert(dxlnode->GetProperties());
+	CDXLOperatorCost *costs = properties->GetDXLOperatorCost();
 
 	plan->startup_cost = CostFromStr(costs->GetStartUpCostStr());
 	plan->total_cost = CostFromStr(costs->GetTotalCostStr());
@@ -4908,6 +4915,8 @@ CTranslatorDXLToPlStmt::TranslatePlanCosts(const CDXLNode *dxlnode, Plan *plan)
 	plan->plan_rows =
 		ceil(CostFromStr(costs->GetRowsOutStr()) /
 			 m_dxl_to_plstmt_context->GetCurrentSlice()->numsegments);
+
+	plan->feedbackSignature = properties->GetFeedbackSignature();
 }
 
 //---------------------------------------------------------------------------
@@ -1874,21 +1874,20 @@ CTranslatorDXLToScalar::TranslateDXLScalarIdentToScalar(
 	CDXLScalarIdent *dxlop =
 		CDXLScalarIdent::Cast(scalar_id_node->GetOperator());
 	Expr *result_expr = nullptr;
-	if (nullptr == colid_var_plstmt_map ||
-		nullptr ==
-			colid_var_plstmt_map->GetOutputContext()->GetParamIdMappingElement(
-				dxlop->GetDXLColRef()->Id()))
+	if (nullptr != colid_var_plstmt_map)
 	{
-		// not an outer ref -> Translate var node
-		result_expr = (Expr *) colid_var->VarFromDXLNodeScId(dxlop);
-	}
-	else
-	{
-		// outer ref -> Translate param node
+		// outer ref -> Translate param node; this is NULL if the column
+		// has no param mapping
 		result_expr =
 			(Expr *) colid_var_plstmt_map->ParamFromDXLNodeScId(dxlop);
 	}
 
+	if (nullptr == result_expr)
+	{
+		// not an outer ref -> Translate var node
+		result_expr = (Expr *) colid_var->VarFromDXLNodeScId(dxlop);
+	}
+
 	if (nullptr == result_expr)
 	{
 		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXL2PlStmtAttributeNotFound,
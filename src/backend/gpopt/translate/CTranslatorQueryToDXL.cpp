@@ -87,6 +87,7 @@ extern bool optimizer_enable_ctas;
 extern bool optimizer_enable_dml;
 extern bool optimizer_enable_dml_constraints;
 extern bool optimizer_enable_multiple_distinct_aggs;
+extern bool optimizer_enable_static_partition_prefilter;
 
 // OIDs of variants of LEAD window function
 static const OID lead_func_oids[] = {
@@ -3143,6 +3144,21 @@ CTranslatorQueryToDXL::TranslateRTEToDXLLogicalGet(const RangeTblEntry *rte,
 	CDXLLogicalGet *dxl_op = nullptr;
 	const IMDRelation *md_rel =
 		m_md_accessor->RetrieveRel(dxl_table_descr->MDId());
+
+	// restrict the partitions to those that can satisfy the WHERE clause,
+	// before the metadata of every partition gets retrieved below
+	IMdIdArray *partition_mdids = md_rel->ChildPartitionMdids();
+	if (nullptr != partition_mdids)
+	{
+		IMdIdArray *pruned_partition_mdids =
+			GetStaticallyPrunedPartitions(rte, rt_index, partition_mdids);
+		if (nullptr != pruned_partition_mdids)
+		{
+			dxl_table_descr->SetPartitionMdids(pruned_partition_mdids);
+			partition_mdids = pruned_partition_mdids;
+		}
+	}
+
 	if (IMDRelation::ErelstorageExternal == md_rel->RetrieveRelStorageType())
 	{
 		dxl_op = GPOS_NEW(m_mp) CDXLLogicalExternalGet(m_mp, dxl_table_descr);
@@ -3161,7 +3177,6 @@ CTranslatorQueryToDXL::TranslateRTEToDXLLogicalGet(const RangeTblEntry *rte,
 	// make note of the operator classes used in the distribution key
 	NoteDistributionPolicyOpclasses(rte);
 
-	IMdIdArray *partition_mdids = md_rel->ChildPartitionMdids();
 	IMDRelation::Erelstoragetype rel_storage_type =
 		IMDRelation::ErelstorageSentinel;
 	for (ULONG ul = 0; partition_mdids && ul < partition_mdids->Size(); ++ul)
@@ -3194,6 +3209,73 @@ CTranslatorQueryToDXL::TranslateRTEToDXLLogicalGet(const RangeTblEntry *rte,
 	return dxl_node;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorQueryToDXL::GetStaticallyPrunedPartitions
+//
+//	@doc:
+//		Return the partitions of the given partitioned table that can satisfy
+//		the restrictions on the partition key in the WHERE clause, found by a
+//		binary search over the partition bounds in the relcache. Returns NULL
+//		if nothing could be pruned. Only relations listed directly in the
+//		top-level FROM list are considered, so that the WHERE clause is known
+//		to apply to every row of the scan.
+//
+//---------------------------------------------------------------------------
+IMdIdArray *
+CTranslatorQueryToDXL::GetStaticallyPrunedPartitions(
+	const RangeTblEntry *rte, ULONG rt_index, IMdIdArray *partition_mdids)
+{
+	FromExpr *jointree = m_query->jointree;
+
+	if (!optimizer_enable_static_partition_prefilter || nullptr == jointree ||
+		nullptr == jointree->quals)
+	{
+		return nullptr;
+	}
+
+	BOOL in_from_list = false;
+	ListCell *lc = nullptr;
+	ForEach(lc, jointree->fromlist)
+	{
+		Node *node = (Node *) lfirst(lc);
+		if (IsA(node, RangeTblRef) &&
+			((RangeTblRef *) node)->rtindex == (int) rt_index)
+		{
+			in_from_list = true;
+			break;
+		}
+	}
+
+	if (!in_from_list)
+	{
+		return nullptr;
+	}
+
+	gpdb::RelationWrapper rel = gpdb::GetRelation(rte->relid);
+	List *part_oids =
+		gpdb::GetPartitionsMatchingQuals(rel.get(), rt_index, jointree->quals);
+	const ULONG num_selected = gpdb::ListLength(part_oids);
+
+	// if nothing survives, leave it to ORCA's own pruning to produce an
+	// empty result
+	if (0 == num_selected || partition_mdids->Size() == num_selected)
+	{
+		gpdb::ListFree(part_oids);
+		return nullptr;
+	}
+
+	IMdIdArray *pruned_partition_mdids = GPOS_NEW(m_mp) IMdIdArray(m_mp);
+	ForEach(lc, part_oids)
+	{
+		pruned_partition_mdids->Append(GPOS_NEW(m_mp)
+										   CMDIdGPDB(lfirst_oid(lc)));
+	}
+	gpdb::ListFree(part_oids);
+
+	return pruned_partition_mdids;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorQueryToDXL::NoteDistributionPolicyOpclasses
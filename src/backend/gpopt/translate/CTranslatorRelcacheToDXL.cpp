@@ -24,6 +24,7 @@ extern "C" {
 #include "catalog/pg_statistic.h"
 #include "cdb/cdbhash.h"
 #include "partitioning/partdesc.h"
+#include "statistics/statistics.h"
 #include "utils/array.h"
 #include "utils/datum.h"
 #include "utils/elog.h"
@@ -52,11 +53,13 @@ extern "C" {
 #include "naucrates/dxl/xml/dxltokens.h"
 #include "naucrates/exception.h"
 #include "naucrates/md/CDXLColStats.h"
+#include "naucrates/md/CDXLExtStats.h"
 #include "naucrates/md/CDXLRelStats.h"
 #include "naucrates/md/CMDArrayCoerceCastGPDB.h"
 #include "naucrates/md/CMDCastGPDB.h"
 #include "naucrates/md/CMDIdCast.h"
 #include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdExtStats.h"
 #include "naucrates/md/CMDIdRelStats.h"
 #include "naucrates/md/CMDIdScCmp.h"
 #include "naucrates/md/CMDIndexGPDB.h"
@@ -107,6 +110,10 @@ CTranslatorRelcacheToDXL::RetrieveObject(CMemoryPool *mp,
 			md_obj = RetrieveRelStats(mp, mdid);
 			break;
 
+		case IMDId::EmdidExtStats:
+			md_obj = RetrieveExtStats(mp, mdid);
+			break;
+
 		case IMDId::EmdidColStats:
 			md_obj = RetrieveColStats(mp, md_accessor, mdid);
 			break;
@@ -227,19 +234,16 @@ CTranslatorRelcacheToDXL::RetrieveRelIndexInfo(CMemoryPool *mp, Relation rel)
 	GPOS_ASSERT(nullptr != rel);
 	CMDIndexInfoArray *md_index_info_array = GPOS_NEW(mp) CMDIndexInfoArray(mp);
 
-	// not a partitioned table: obtain indexes directly from the catalog
-	List *index_oids = gpdb::GetRelationIndexes(rel);
-
-	ListCell *lc = nullptr;
+	// not a partitioned table: obtain indexes directly from the catalog,
+	// with the properties we check for all of them fetched in one call
+	gpdb::IndexProps *index_props = nullptr;
+	int num_indexes = gpdb::GetRelationIndexProps(rel, &index_props);
 
-	ForEach(lc, index_oids)
+	for (int i = 0; i < num_indexes; i++)
 	{
-		OID index_oid = lfirst_oid(lc);
+		OID index_oid = index_props[i].oid;
 
-		// only add supported indexes
-		gpdb::RelationWrapper index_rel = gpdb::GetRelation(index_oid);
-
-		if (!index_rel)
+		if (!index_props[i].found)
 		{
 			WCHAR wstr[1024];
 			CWStringStatic str(wstr, 1024);
@@ -249,9 +253,8 @@ CTranslatorRelcacheToDXL::RetrieveRelIndexInfo(CMemoryPool *mp, Relation rel)
 					   str.GetBuffer());
 		}
 
-		GPOS_ASSERT(nullptr != index_rel->rd_indextuple);
-
-		if (IsIndexSupported(index_rel.get()))
+		// only add supported indexes
+		if (IsIndexSupported(&index_props[i]))
 		{
 			CMDIdGPDB *mdid_index = GPOS_NEW(mp) CMDIdGPDB(index_oid);
 			// for a regular table, external table or leaf partition, an index is always complete
@@ -261,6 +264,11 @@ CTranslatorRelcacheToDXL::RetrieveRelIndexInfo(CMemoryPool *mp, Relation rel)
 		}
 	}
 
+	if (nullptr != index_props)
+	{
+		gpdb::GPDBFree(index_props);
+	}
+
 	return md_index_info_array;
 }
 
@@ -384,6 +392,9 @@ CTranslatorRelcacheToDXL::RetrieveRel(CMemoryPool *mp, CMDAccessor *md_accessor,
 	ULONG num_leaf_partitions = 0;
 	BOOL convert_hash_to_random = false;
 	ULongPtr2dArray *keyset_array = nullptr;
+	IMdIdArray *fk_rel_mdids = nullptr;
+	ULongPtr2dArray *fk_cols = nullptr;
+	ULongPtr2dArray *fk_ref_cols = nullptr;
 	IMdIdArray *check_constraint_mdids = nullptr;
 	BOOL is_temporary = false;
 	BOOL has_oids = false;
@@ -457,6 +468,13 @@ CTranslatorRelcacheToDXL::RetrieveRel(CMemoryPool *mp, CMDAccessor *md_accessor,
 	keyset_array = RetrieveRelKeysets(mp, oid, should_add_default_keys,
 									  is_partitioned, attno_mapping);
 
+	// get foreign keys
+	if (IMDRelation::ErelstorageExternal != rel_storage_type)
+	{
+		RetrieveRelForeignKeys(mp, rel.get(), attno_mapping, &fk_rel_mdids,
+							   &fk_cols, &fk_ref_cols);
+	}
+
 	// collect all check constraints
 	check_constraint_mdids = RetrieveRelCheckConstraints(mp, oid);
 
@@ -502,7 +520,8 @@ CTranslatorRelcacheToDXL::RetrieveRel(CMemoryPool *mp, CMDAccessor *md_accessor,
 			distr_cols, distr_op_families, part_keys, part_types,
 			num_leaf_partitions, partition_oids, convert_hash_to_random,
 			keyset_array, md_index_info_array, mdid_triggers_array,
-			check_constraint_mdids, mdpart_constraint, has_oids);
+			check_constraint_mdids, mdpart_constraint, has_oids, fk_rel_mdids,
+			fk_cols, fk_ref_cols);
 	}
 
 	return md_rel;
@@ -533,7 +552,15 @@ CTranslatorRelcacheToDXL::RetrieveRelColumns(
 					   GPOS_WSZ_LIT("column has GENERATED default value"));
 	}
 
-	for (ULONG ul = 0; ul < (ULONG) rel->rd_att->natts; ul++)
+	// fetch the default values and the widths from the stats of all columns
+	// at once, rather than with a few catalog calls per column
+	const ULONG num_atts = (ULONG) rel->rd_att->natts;
+	Node **default_exprs = GPOS_NEW_ARRAY(mp, Node *, num_atts);
+	int32 *stats_widths = GPOS_NEW_ARRAY(mp, int32, num_atts);
+	gpdb::GetColumnDefaults(rel->rd_att, default_exprs);
+	gpdb::GetAttStatsWidths(rel->rd_id, (int) num_atts, stats_widths);
+
+	for (ULONG ul = 0; ul < num_atts; ul++)
 	{
 		Form_pg_attribute att = &rel->rd_att->attrs[ul];
 		CMDName *md_colname =
@@ -544,13 +571,12 @@ CTranslatorRelcacheToDXL::RetrieveRelColumns(
 
 		if (!att->attisdropped)
 		{
-			dxl_default_col_val = GetDefaultColumnValue(
-				mp, md_accessor, rel->rd_att, att->attnum);
+			dxl_default_col_val =
+				GetDefaultColumnValue(mp, md_accessor, default_exprs[ul]);
 		}
 
 		ULONG col_len = gpos::ulong_max;
 		CMDIdGPDB *mdid_col = GPOS_NEW(mp) CMDIdGPDB(att->atttypid);
-		HeapTuple stats_tup = gpdb::GetAttStats(rel->rd_id, ul + 1);
 
 		// Column width priority:
 		// 1. If there is average width kept in the stats for that column, pick that value.
@@ -559,14 +585,10 @@ CTranslatorRelcacheToDXL::RetrieveRelColumns(
 		// 3. Else if it not dropped and a fixed length type such as int4, assign the fixed
 		//    length.
 		// 4. Otherwise, assign it to default column width which is 8.
-		if (HeapTupleIsValid(stats_tup))
+		if (0 <= stats_widths[ul])
 		{
-			Form_pg_statistic form_pg_stats =
-				(Form_pg_statistic) GETSTRUCT(stats_tup);
-
 			// column width
-			col_len = form_pg_stats->stawidth;
-			gpdb::FreeHeapTuple(stats_tup);
+			col_len = stats_widths[ul];
 		}
 		else if ((mdid_col->Equals(&CMDIdGPDB::m_mdid_bpchar) ||
 				  mdid_col->Equals(&CMDIdGPDB::m_mdid_varchar)) &&
@@ -599,6 +621,9 @@ CTranslatorRelcacheToDXL::RetrieveRelColumns(
 		mdcol_array->Append(md_col);
 	}
 
+	GPOS_DELETE_ARRAY(default_exprs);
+	GPOS_DELETE_ARRAY(stats_widths);
+
 	// add system columns
 	if (RelHasSystemColumns(rel->rd_rel->relkind))
 	{
@@ -622,39 +647,9 @@ CTranslatorRelcacheToDXL::RetrieveRelColumns(
 CDXLNode *
 CTranslatorRelcacheToDXL::GetDefaultColumnValue(CMemoryPool *mp,
 												CMDAccessor *md_accessor,
-												TupleDesc rd_att,
-												AttrNumber attno)
+												Node *default_expr)
 {
-	GPOS_ASSERT(attno > 0);
-
-	Node *node = nullptr;
-
-	// Scan to see if relation has a default for this column
-	if (nullptr != rd_att->constr && 0 < rd_att->constr->num_defval)
-	{
-		AttrDefault *defval = rd_att->constr->defval;
-		INT num_def = rd_att->constr->num_defval;
-
-		GPOS_ASSERT(nullptr != defval);
-		for (ULONG ul = 0; ul < (ULONG) num_def; ul++)
-		{
-			if (attno == defval[ul].adnum)
-			{
-				// found it, convert string representation to node tree.
-				node = gpdb::StringToNode(defval[ul].adbin);
-				break;
-			}
-		}
-	}
-
-	if (nullptr == node)
-	{
-		// get the default value for the type
-		Form_pg_attribute att_tup = &rd_att->attrs[attno - 1];
-		node = gpdb::GetTypeDefault(att_tup->atttypid);
-	}
-
-	if (nullptr == node)
+	if (nullptr == default_expr)
 	{
 		return nullptr;
 	}
@@ -663,7 +658,7 @@ CTranslatorRelcacheToDXL::GetDefaultColumnValue(CMemoryPool *mp,
 	return CTranslatorScalarToDXL::TranslateStandaloneExprToDXL(
 		mp, md_accessor,
 		nullptr, /* var_colid_mapping --- subquery or external variable are not supported in default expression */
-		(Expr *) node);
+		(Expr *) default_expr);
 }
 
 //---------------------------------------------------------------------------
@@ -1737,6 +1732,100 @@ CTranslatorRelcacheToDXL::RetrieveRelStats(CMemoryPool *mp, IMDId *mdid)
 	return dxl_rel_stats;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::RetrieveExtStats
+//
+//	@doc:
+//		Retrieve the functional dependencies and multi-column ndistinct
+//		coefficients of the extended statistics objects of a relation.
+//		Statistics objects that have not been analyzed yet are skipped.
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CTranslatorRelcacheToDXL::RetrieveExtStats(CMemoryPool *mp, IMDId *mdid)
+{
+	CMDIdExtStats *ext_stats_mdid = CMDIdExtStats::CastMdid(mdid);
+	IMDId *mdid_rel = ext_stats_mdid->GetRelMdId();
+	OID rel_oid = CMDIdGPDB::CastMdid(mdid_rel)->Oid();
+
+	gpdb::RelationWrapper rel = gpdb::GetRelation(rel_oid);
+	if (!rel)
+	{
+		GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound,
+				   mdid->GetBuffer());
+	}
+
+	// get rel name
+	CHAR *relname = NameStr(rel->rd_rel->relname);
+	CWStringDynamic *relname_str =
+		CDXLUtils::CreateDynamicStringFromCharArray(mp, relname);
+	CMDName *mdname = GPOS_NEW(mp) CMDName(mp, relname_str);
+	// CMDName ctor created a copy of the string
+	GPOS_DELETE(relname_str);
+
+	ULongPtr2dArray *dep_from_attnos = GPOS_NEW(mp) ULongPtr2dArray(mp);
+	ULongPtrArray *dep_to_attnos = GPOS_NEW(mp) ULongPtrArray(mp);
+	CDoubleArray *dep_degrees = GPOS_NEW(mp) CDoubleArray(mp);
+	ULongPtr2dArray *ndistinct_attnos = GPOS_NEW(mp) ULongPtr2dArray(mp);
+	CDoubleArray *ndistinct_values = GPOS_NEW(mp) CDoubleArray(mp);
+
+	List *stat_oids = gpdb::GetRelationExtStatistics(rel.get());
+	ListCell *lc = nullptr;
+	ForEach(lc, stat_oids)
+	{
+		OID stat_oid = lfirst_oid(lc);
+
+		MVDependencies *dependencies = gpdb::GetMVDependencies(stat_oid);
+		if (nullptr != dependencies)
+		{
+			for (ULONG ul = 0; ul < dependencies->ndeps; ul++)
+			{
+				// the last attribute is implied by the others
+				MVDependency *dependency = dependencies->deps[ul];
+				ULongPtrArray *from_attnos = GPOS_NEW(mp) ULongPtrArray(mp);
+				for (AttrNumber att = 0; att < dependency->nattributes - 1;
+					 att++)
+				{
+					from_attnos->Append(
+						GPOS_NEW(mp) ULONG(dependency->attributes[att]));
+				}
+				dep_from_attnos->Append(from_attnos);
+				dep_to_attnos->Append(GPOS_NEW(mp) ULONG(
+					dependency->attributes[dependency->nattributes - 1]));
+				dep_degrees->Append(
+					GPOS_NEW(mp) CDouble(dependency->degree));
+			}
+		}
+
+		MVNDistinct *ndistinct = gpdb::GetMVNDistinct(stat_oid);
+		if (nullptr != ndistinct)
+		{
+			for (ULONG ul = 0; ul < ndistinct->nitems; ul++)
+			{
+				MVNDistinctItem *item = &ndistinct->items[ul];
+				ULongPtrArray *attnos = GPOS_NEW(mp) ULongPtrArray(mp);
+				INT attno = -1;
+				while (0 <= (attno = bms_next_member(item->attrs, attno)))
+				{
+					attnos->Append(GPOS_NEW(mp) ULONG(attno));
+				}
+				ndistinct_attnos->Append(attnos);
+				ndistinct_values->Append(
+					GPOS_NEW(mp) CDouble(item->ndistinct));
+			}
+		}
+	}
+	gpdb::ListFree(stat_oids);
+
+	ext_stats_mdid->AddRef();
+
+	return GPOS_NEW(mp) CDXLExtStats(mp, ext_stats_mdid, mdname,
+									 dep_from_attnos, dep_to_attnos,
+									 dep_degrees, ndistinct_attnos,
+									 ndistinct_values);
+}
+
 // Retrieve column statistics from relcache
 // If all statistics are missing, create dummy statistics
 // Also, if the statistics are broken, create dummy statistics
@@ -1777,8 +1866,12 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 										  dxl_stats_bucket_array, num_rows);
 	}
 
-	// extract out histogram and mcv information from pg_statistic
-	HeapTuple stats_tup = gpdb::GetAttStats(rel_oid, attno);
+	// extract out histogram and mcv information from pg_statistic, together
+	// with the stats tuple in one call
+	AttStatsSlot mcv_slot;
+	AttStatsSlot hist_slot;
+	HeapTuple stats_tup =
+		gpdb::GetAttStatsWithSlots(rel_oid, attno, &mcv_slot, &hist_slot);
 
 	// if there is no colstats
 	if (!HeapTupleIsValid(stats_tup))
@@ -1828,13 +1921,6 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	num_distinct = num_distinct.Ceil();
 
 	BOOL is_dummy_stats = false;
-	// most common values and their frequencies extracted from the pg_statistic
-	// tuple for a given column
-	AttStatsSlot mcv_slot;
-
-	(void) gpdb::GetAttrStatsSlot(&mcv_slot, stats_tup, STATISTIC_KIND_MCV,
-								  InvalidOid,
-								  ATTSTATSSLOT_VALUES | ATTSTATSSLOT_NUMBERS);
 	if (InvalidOid != mcv_slot.valuetype && mcv_slot.valuetype != att_type)
 	{
 		char msgbuf[NAMEDATALEN * 2 + 100];
@@ -1846,7 +1932,6 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 			mcv_slot.valuetype);
 		GpdbEreport(ERRCODE_SUCCESSFUL_COMPLETION, NOTICE, msgbuf, nullptr);
 
-		gpdb::FreeAttrStatsSlot(&mcv_slot);
 		is_dummy_stats = true;
 	}
 
@@ -1861,7 +1946,6 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 		GpdbEreport(ERRCODE_SUCCESSFUL_COMPLETION, NOTICE, msgbuf, nullptr);
 
 		// if the number of MCVs(nvalues) and number of MCFs(nnumbers) do not match, we discard the MCVs and MCFs
-		gpdb::FreeAttrStatsSlot(&mcv_slot);
 		is_dummy_stats = true;
 	}
 	else
@@ -1878,14 +1962,6 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 		}
 	}
 
-	// histogram values extracted from the pg_statistic tuple for a given column
-	AttStatsSlot hist_slot;
-
-	// get histogram datums from pg_statistic entry
-	(void) gpdb::GetAttrStatsSlot(&hist_slot, stats_tup,
-								  STATISTIC_KIND_HISTOGRAM, InvalidOid,
-								  ATTSTATSSLOT_VALUES);
-
 	if (InvalidOid != hist_slot.valuetype && hist_slot.valuetype != att_type)
 	{
 		char msgbuf[NAMEDATALEN * 2 + 100];
@@ -1897,7 +1973,6 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 			hist_slot.valuetype);
 		GpdbEreport(ERRCODE_SUCCESSFUL_COMPLETION, NOTICE, msgbuf, nullptr);
 
-		gpdb::FreeAttrStatsSlot(&hist_slot);
 		is_dummy_stats = true;
 	}
 
@@ -1907,7 +1982,7 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 		mdid_col_stats->AddRef();
 
 		CDouble col_width = CStatistics::DefaultColumnWidth;
-		gpdb::FreeHeapTuple(stats_tup);
+		gpdb::FreeAttStatsWithSlots(stats_tup, &mcv_slot, &hist_slot);
 		return CDXLColStats::CreateDXLDummyColStats(mp, mdid_col_stats,
 													md_colname, col_width);
 	}
@@ -1950,11 +2025,8 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 			std::max(CDouble(0.0), (1 - num_freq_buckets - null_freq));
 	}
 
-	// free up allocated datum and float4 arrays
-	gpdb::FreeAttrStatsSlot(&mcv_slot);
-	gpdb::FreeAttrStatsSlot(&hist_slot);
-
-	gpdb::FreeHeapTuple(stats_tup);
+	// free up allocated datum and float4 arrays, and the stats tuple
+	gpdb::FreeAttStatsWithSlots(stats_tup, &mcv_slot, &hist_slot);
 
 	// create col stats object
 	mdid_col_stats->AddRef();
@@ -2672,6 +2744,61 @@ CTranslatorRelcacheToDXL::RetrieveRelKeysets(CMemoryPool *mp, OID oid,
 	return key_sets;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::RetrieveRelForeignKeys
+//
+//	@doc:
+//		Get the foreign keys of the relation, as the referenced relations and
+//		the positions of the referencing and referenced columns. The output
+//		arrays are left NULL if the relation has no foreign keys.
+//
+//		Foreign keys are not enforced in GPDB, so the optimizer must only
+//		rely on them where a violated constraint cannot produce wrong
+//		results, or where the user opted in
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorRelcacheToDXL::RetrieveRelForeignKeys(
+	CMemoryPool *mp, Relation rel, ULONG *attno_mapping,
+	IMdIdArray **fk_rel_mdids, ULongPtr2dArray **fk_cols,
+	ULongPtr2dArray **fk_ref_cols)
+{
+	List *fkeys = gpdb::GetRelationForeignKeys(rel);
+	if (NIL == fkeys)
+	{
+		return;
+	}
+
+	*fk_rel_mdids = GPOS_NEW(mp) IMdIdArray(mp);
+	*fk_cols = GPOS_NEW(mp) ULongPtr2dArray(mp);
+	*fk_ref_cols = GPOS_NEW(mp) ULongPtr2dArray(mp);
+
+	ListCell *lc = nullptr;
+	ForEach(lc, fkeys)
+	{
+		ForeignKeyCacheInfo *fkey = (ForeignKeyCacheInfo *) lfirst(lc);
+
+		ULongPtrArray *cols = GPOS_NEW(mp) ULongPtrArray(mp);
+		ULongPtrArray *ref_cols = GPOS_NEW(mp) ULongPtrArray(mp);
+		for (int i = 0; i < fkey->nkeys; i++)
+		{
+			GPOS_ASSERT(0 < fkey->conkey[i] && 0 < fkey->confkey[i]);
+
+			cols->Append(GPOS_NEW(mp) ULONG(
+				GetAttributePosition(fkey->conkey[i], attno_mapping)));
+
+			// user columns of a relation come first in its metadata object,
+			// in attribute number order, see RetrieveRelColumns
+			ref_cols->Append(GPOS_NEW(mp) ULONG(fkey->confkey[i] - 1));
+		}
+
+		(*fk_rel_mdids)->Append(GPOS_NEW(mp) CMDIdGPDB(fkey->confrelid));
+		(*fk_cols)->Append(cols);
+		(*fk_ref_cols)->Append(ref_cols);
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorRelcacheToDXL::NormalizeFrequencies
@@ -2730,21 +2857,35 @@ CTranslatorRelcacheToDXL::NormalizeFrequencies(float4 *freqs, ULONG length,
 BOOL
 CTranslatorRelcacheToDXL::IsIndexSupported(Relation index_rel)
 {
-	HeapTupleData *tup = index_rel->rd_indextuple;
+	gpdb::IndexProps index_props;
+	gpdb::GetIndexProps(index_rel, &index_props);
 
+	return IsIndexSupported(&index_props);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::IsIndexSupported
+//
+//	@doc:
+//		Check if index type is supported, given the index properties
+//
+//---------------------------------------------------------------------------
+BOOL
+CTranslatorRelcacheToDXL::IsIndexSupported(const gpdb::IndexProps *index_props)
+{
 	// covering index -- it has INCLUDE (...) columns
-	if (index_rel->rd_index->indnatts > index_rel->rd_index->indnkeyatts)
+	if (index_props->has_include_cols)
 		return false;
 
 	// index expressions and index constraints not supported
-	return gpdb::HeapAttIsNull(tup, Anum_pg_index_indexprs) &&
-		   gpdb::HeapAttIsNull(tup, Anum_pg_index_indpred) &&
-		   index_rel->rd_index->indisvalid &&
-		   (BTREE_AM_OID == index_rel->rd_rel->relam ||
-			BITMAP_AM_OID == index_rel->rd_rel->relam ||
-			GIST_AM_OID == index_rel->rd_rel->relam ||
-			GIN_AM_OID == index_rel->rd_rel->relam ||
-			BRIN_AM_OID == index_rel->rd_rel->relam);
+	return !index_props->has_exprs && !index_props->has_pred &&
+		   index_props->is_valid &&
+		   (BTREE_AM_OID == index_props->relam ||
+			BITMAP_AM_OID == index_props->relam ||
+			GIST_AM_OID == index_props->relam ||
+			GIN_AM_OID == index_props->relam ||
+			BRIN_AM_OID == index_props->relam);
 }
 
 //---------------------------------------------------------------------------
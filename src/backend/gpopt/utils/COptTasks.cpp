@@ -374,13 +374,18 @@ COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model)
 	ULONG push_group_by_below_setop_threshold =
 		(ULONG) optimizer_push_group_by_below_setop_threshold;
 
+	CStatisticsConfig *stats_config = GPOS_NEW(mp)
+		CStatisticsConfig(mp, damping_factor_filter, damping_factor_join,
+						  damping_factor_groupby, MAX_STATS_BUCKETS);
+	if (gp_enable_query_feedback)
+	{
+		stats_config->SetFeedbackRows(GetFeedbackRows(mp));
+	}
+
 	return GPOS_NEW(mp) COptimizerConfig(
 		GPOS_NEW(mp)
 			CEnumeratorConfig(mp, plan_id, num_samples, cost_threshold),
-		GPOS_NEW(mp)
-			CStatisticsConfig(mp, damping_factor_filter, damping_factor_join,
-							  damping_factor_groupby, MAX_STATS_BUCKETS),
-		GPOS_NEW(mp) CCTEConfig(cte_inlining_cutoff), cost_model,
+		stats_config, GPOS_NEW(mp) CCTEConfig(cte_inlining_cutoff), cost_model,
 		GPOS_NEW(mp)
 			CHint(gpos::int_max /* optimizer_parts_to_force_sort_on_insert */,
 				  join_arity_for_associativity_commutativity,
@@ -392,6 +397,33 @@ COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model)
 		GPOS_NEW(mp) CWindowOids(OID(F_WINDOW_ROW_NUMBER), OID(F_WINDOW_RANK)));
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::GetFeedbackRows
+//
+//	@doc:
+//		Map from cardinality feedback signatures to the row counts recorded
+//		by EXPLAIN ANALYZE, see cdbqueryfeedback.c
+//
+//---------------------------------------------------------------------------
+gpnaucrates::UlongToDoubleMap *
+COptTasks::GetFeedbackRows(CMemoryPool *mp)
+{
+	gpnaucrates::UlongToDoubleMap *feedback_rows =
+		GPOS_NEW(mp) gpnaucrates::UlongToDoubleMap(mp);
+
+	int nentries = 0;
+	QueryFeedbackEntry *entries = gpdb::GetQueryFeedback(&nentries);
+	for (int i = 0; i < nentries; i++)
+	{
+		feedback_rows->Insert(GPOS_NEW(mp) ULONG(entries[i].signature),
+							  GPOS_NEW(mp) CDouble(entries[i].rows));
+	}
+	gpdb::GPDBFree(entries);
+
+	return feedback_rows;
+}
+
 //---------------------------------------------------------------------------
 //		@function:
 //			COptTasks::SetCostModelParams
@@ -405,6 +437,14 @@ COptTasks::SetCostModelParams(ICostModel *cost_model)
 {
 	GPOS_ASSERT(nullptr != cost_model);
 
+	// apply the cost model profile first, so that the factors below are
+	// relative to the calibrated values
+	if (nullptr != optimizer_cost_model_params &&
+		'\0' != optimizer_cost_model_params[0])
+	{
+		SetCostModelParamsFromProfile(cost_model, optimizer_cost_model_params);
+	}
+
 	if (optimizer_nestloop_factor > 1.0)
 	{
 		// change NLJ cost factor
@@ -432,6 +472,77 @@ COptTasks::SetCostModelParams(ICostModel *cost_model)
 }
 
 
+//---------------------------------------------------------------------------
+//      @function:
+//			COptTasks::SetCostModelParamsFromProfile
+//
+//      @doc:
+//			Set the cost model parameters listed in a profile of the form
+//			"Name=Value,Name=Value", as in optimizer_cost_model_params; the
+//			syntax has already been validated by the GUC check hook
+//
+//---------------------------------------------------------------------------
+void
+COptTasks::SetCostModelParamsFromProfile(ICostModel *cost_model,
+										 const CHAR *profile)
+{
+	ICostModelParams *params = cost_model->GetCostModelParams();
+	const CHAR *p = profile;
+
+	while ('\0' != *p)
+	{
+		CHAR name[NAMEDATALEN];
+		ULONG len = 0;
+		CHAR *end;
+
+		while (isspace((unsigned char) *p))
+		{
+			p++;
+		}
+		while (isalnum((unsigned char) *p))
+		{
+			if (len < NAMEDATALEN - 1)
+			{
+				name[len++] = *p;
+			}
+			p++;
+		}
+		name[len] = '\0';
+		while (isspace((unsigned char) *p) || '=' == *p)
+		{
+			p++;
+		}
+		CDouble value(strtod(p, &end));
+		p = end;
+		while (isspace((unsigned char) *p) || ',' == *p)
+		{
+			p++;
+		}
+
+		ICostModelParams::SCostParam *cost_param = params->PcpLookup(name);
+		if (nullptr == cost_param)
+		{
+			char msgbuf[NAMEDATALEN + 100];
+			snprintf(msgbuf, sizeof(msgbuf),
+					 "unrecognized cost model parameter \"%s\" in "
+					 "optimizer_cost_model_params",
+					 name);
+			GpdbEreport(ERRCODE_INVALID_PARAMETER_VALUE, WARNING, msgbuf,
+						nullptr);
+			continue;
+		}
+
+		// keep the width of the parameter's range around the new value
+		CDouble lower_delta =
+			cost_param->Get() - cost_param->GetLowerBoundVal();
+		CDouble upper_delta =
+			cost_param->GetUpperBoundVal() - cost_param->Get();
+		params->SetParam(cost_param->Id(), value, value - lower_delta,
+						 value + upper_delta);
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //      @function:
 //			COptTasks::GetCostModel
@@ -441,9 +552,15 @@ COptTasks::SetCostModelParams(ICostModel *cost_model)
 //
 //---------------------------------------------------------------------------
 ICostModel *
-COptTasks::GetCostModel(CMemoryPool *mp, ULONG num_segments)
+COptTasks::GetCostModel(CMemoryPool *mp, ULONG num_segments,
+						ULONG num_broadcast_hosts)
 {
-	ICostModel *cost_model = GPOS_NEW(mp) CCostModelGPDB(mp, num_segments);
+	CCostModelGPDB *cost_model = GPOS_NEW(mp) CCostModelGPDB(mp, num_segments);
+
+	if (0 < num_broadcast_hosts)
+	{
+		cost_model->SetBroadcastHosts(num_broadcast_hosts);
+	}
 
 	SetCostModelParams(cost_model);
 
@@ -537,7 +654,25 @@ COptTasks::OptimizeTask(void *ptr)
 			query_to_dxl_translator = CTranslatorQueryToDXL::QueryToDXLInstance(
 				mp, &mda, (Query *) opt_ctxt->m_query);
 
-			ICostModel *cost_model = GetCostModel(mp, num_segments_for_costing);
+			// with host-aware broadcasts, keep the number of segments per
+			// host when costing for a different number of segments
+			ULONG num_broadcast_hosts = 0;
+			if (gp_enable_host_broadcast)
+			{
+				ULONG num_hosts = gpdb::GetGPSegmentHostCount();
+				if (num_hosts < num_segments)
+				{
+					num_broadcast_hosts =
+						num_segments_for_costing * num_hosts / num_segments;
+					if (0 == num_broadcast_hosts)
+					{
+						num_broadcast_hosts = 1;
+					}
+				}
+			}
+
+			ICostModel *cost_model = GetCostModel(mp, num_segments_for_costing,
+												  num_broadcast_hosts);
 			COptimizerConfig *optimizer_config =
 				CreateOptimizerConfig(mp, cost_model);
 			CConstExprEvaluatorProxy expr_eval_proxy(mp, &mda);
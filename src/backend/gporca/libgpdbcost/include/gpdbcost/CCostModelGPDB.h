@@ -45,6 +45,10 @@ private:
 	// number of segments
 	ULONG m_num_of_segments;
 
+	// number of hosts a host-aware broadcast sends to, 0 if broadcasts
+	// send to every segment
+	ULONG m_num_of_broadcast_hosts;
+
 	// cost model parameters
 	CCostModelParamsGPDB *m_cost_model_params;
 
@@ -210,6 +214,21 @@ public:
 		return m_num_of_segments;
 	}
 
+	// number of hosts a host-aware broadcast sends to
+	ULONG
+	UlBroadcastHosts() const
+	{
+		return m_num_of_broadcast_hosts;
+	}
+
+	// make broadcasts send to one segment per host
+	void
+	SetBroadcastHosts(ULONG ulHosts)
+	{
+		GPOS_ASSERT(ulHosts <= m_num_of_segments);
+		m_num_of_broadcast_hosts = ulHosts;
+	}
+
 	// return number of rows per host
 	CDouble DRowsPerHost(CDouble dRowsTotal) const override;
 
@@ -61,6 +61,7 @@ public:
 		EcpRedistributeRecvCostUnit,  // receiving cost per tuple in redistribute motion
 		EcpBroadcastSendCostUnit,  // sending cost per tuple in broadcast motion
 		EcpBroadcastRecvCostUnit,  // receiving cost per tuple in broadcast motion
+		EcpBroadcastLocalCostUnit,	// cost per tuple of copying a host-aware broadcast to the segments of a host
 		EcpNoOpCostUnit,		   // cost per tuple in No-Op motion
 		// general join params
 		EcpJoinFeedingTupColumnCostUnit,  // feeding cost per tuple per column in join operator
@@ -172,6 +173,9 @@ private:
 	// default value of receiving tuple cost unit for broadcast motion
 	static const CDouble DBroadcastRecvCostUnitVal;
 
+	// default value of local copying tuple cost unit for host-aware broadcast motion
+	static const CDouble DBroadcastLocalCostUnitVal;
+
 	// default value of tuple cost unit for No-Op motion
 	static const CDouble DNoOpCostUnitVal;
 
@@ -289,6 +293,9 @@ public:
 	// lookup param by name
 	SCostParam *PcpLookup(const CHAR *szName) const override;
 
+	// lookup param id by name
+	static ECostParam EcpLookup(const CHAR *szName);
+
 	// set param by id
 	void SetParam(ULONG id, CDouble dVal, CDouble dLowerBound,
 				  CDouble dUpperBound) override;
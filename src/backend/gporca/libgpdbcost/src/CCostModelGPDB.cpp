@@ -50,7 +50,7 @@ using namespace gpdbcost;
 //---------------------------------------------------------------------------
 CCostModelGPDB::CCostModelGPDB(CMemoryPool *mp, ULONG ulSegments,
 							   CCostModelParamsGPDB *pcp)
-	: m_mp(mp), m_num_of_segments(ulSegments)
+	: m_mp(mp), m_num_of_segments(ulSegments), m_num_of_broadcast_hosts(0)
 {
 	GPOS_ASSERT(0 < ulSegments);
 
@@ -1325,8 +1325,26 @@ CCostModelGPDB::CostMotion(CMemoryPool *mp, CExpressionHandle &exprhdl,
 				->PcpLookup(CCostModelParamsGPDB::EcpBroadcastRecvCostUnit)
 				->Get();
 
-		recvCost =
-			num_rows_outer * dWidthOuter * pcmgpdb->UlHosts() * dRecvCostUnit;
+		const ULONG ulBroadcastHosts = pcmgpdb->UlBroadcastHosts();
+		if (0 < ulBroadcastHosts)
+		{
+			// host-aware broadcast: rows cross the network once per host,
+			// and are copied to the segments of each host locally
+			const DOUBLE dLocalCostUnit =
+				pcmgpdb->GetCostModelParams()
+					->PcpLookup(CCostModelParamsGPDB::EcpBroadcastLocalCostUnit)
+					->Get()
+					.Get();
+
+			recvCost = num_rows_outer * dWidthOuter *
+					   (ulBroadcastHosts * dRecvCostUnit +
+						pcmgpdb->UlHosts() * dLocalCostUnit);
+		}
+		else
+		{
+			recvCost = num_rows_outer * dWidthOuter * pcmgpdb->UlHosts() *
+					   dRecvCostUnit;
+		}
 	}
 	else if (COperator::EopPhysicalMotionHashDistribute == op_id ||
 			 COperator::EopPhysicalMotionRandom == op_id ||
@@ -75,6 +75,10 @@ const CDouble CCostModelParamsGPDB::DBroadcastSendCostUnitVal = 4.965e-05;
 // receiving tuple cost unit in broadcast motion
 const CDouble CCostModelParamsGPDB::DBroadcastRecvCostUnitVal = 1.35e-06;
 
+// local copying tuple cost unit in host-aware broadcast motion, a loopback
+// copy is taken to cost a quarter of one over the network
+const CDouble CCostModelParamsGPDB::DBroadcastLocalCostUnitVal = 3.375e-07;
+
 // tuple cost unit in No-Op motion
 const CDouble CCostModelParamsGPDB::DNoOpCostUnitVal = 0;
 
@@ -207,6 +211,7 @@ const CHAR rgszCostParamNames[CCostModelParamsGPDB::EcpSentinel]
 								 "RedistributeRecvCostUnit",
 								 "BroadcastSendCostUnit",
 								 "BroadcastRecvCostUnit",
+								 "BroadcastLocalCostUnit",
 								 "NoOpCostUnit",
 								 "JoinFeedingTupColumnCostUnit",
 								 "JoinFeedingTupWidthCostUnit",
@@ -315,6 +320,9 @@ CCostModelParamsGPDB::CCostModelParamsGPDB(CMemoryPool *mp) : m_mp(mp)
 	m_rgpcp[EcpBroadcastRecvCostUnit] = GPOS_NEW(mp) SCostParam(
 		EcpBroadcastRecvCostUnit, DBroadcastRecvCostUnitVal,
 		DBroadcastRecvCostUnitVal - 0.0, DBroadcastRecvCostUnitVal + 0.0);
+	m_rgpcp[EcpBroadcastLocalCostUnit] = GPOS_NEW(mp) SCostParam(
+		EcpBroadcastLocalCostUnit, DBroadcastLocalCostUnitVal,
+		DBroadcastLocalCostUnitVal - 0.0, DBroadcastLocalCostUnitVal + 0.0);
 	m_rgpcp[EcpNoOpCostUnit] =
 		GPOS_NEW(mp) SCostParam(EcpNoOpCostUnit, DNoOpCostUnitVal,
 								DNoOpCostUnitVal - 0.0, DNoOpCostUnitVal + 0.0);
@@ -479,6 +487,28 @@ CCostModelParamsGPDB::PcpLookup(ULONG id) const
 //---------------------------------------------------------------------------
 CCostModelParamsGPDB::SCostParam *
 CCostModelParamsGPDB::PcpLookup(const CHAR *szName) const
+{
+	ECostParam ecp = EcpLookup(szName);
+	if (EcpSentinel == ecp)
+	{
+		return nullptr;
+	}
+
+	return PcpLookup(ecp);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelParamsGPDB::EcpLookup
+//
+//	@doc:
+//		Lookup param id by name, return EcpSentinel if there is no param
+//		of that name
+//
+//---------------------------------------------------------------------------
+CCostModelParamsGPDB::ECostParam
+CCostModelParamsGPDB::EcpLookup(const CHAR *szName)
 {
 	GPOS_ASSERT(nullptr != szName);
 
@@ -486,11 +516,11 @@ CCostModelParamsGPDB::PcpLookup(const CHAR *szName) const
 	{
 		if (0 == clib::Strcmp(szName, rgszCostParamNames[ul]))
 		{
-			return PcpLookup((ECostParam) ul);
+			return (ECostParam) ul;
 		}
 	}
 
-	return nullptr;
+	return EcpSentinel;
 }
 
 
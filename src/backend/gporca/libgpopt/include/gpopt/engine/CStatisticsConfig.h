@@ -18,6 +18,7 @@
 
 #include "naucrates/md/CMDIdColStats.h"
 #include "naucrates/md/IMDId.h"
+#include "naucrates/statistics/IStatistics.h"
 
 #define MAX_STATS_BUCKETS ULONG(100)
 
@@ -56,6 +57,10 @@ private:
 	// hash set of md ids for columns with missing statistics
 	MdidHashSet *m_phsmdidcolinfo;
 
+	// row counts observed in earlier executions, by feedback signature;
+	// nullptr if cardinality feedback is disabled
+	gpnaucrates::UlongToDoubleMap *m_feedback_rows;
+
 public:
 	// ctor
 	CStatisticsConfig(CMemoryPool *mp, CDouble damping_factor_filter,
@@ -99,6 +104,25 @@ public:
 	// collect the missing statistics columns
 	void CollectMissingStatsColumns(IMdIdArray *pdrgmdid);
 
+	// enable cardinality feedback with the given observed row counts
+	void SetFeedbackRows(gpnaucrates::UlongToDoubleMap *feedback_rows);
+
+	// is cardinality feedback enabled
+	BOOL
+	FFeedback() const
+	{
+		return nullptr != m_feedback_rows;
+	}
+
+	// observed row count for the given feedback signature, if any
+	const CDouble *
+	PdFeedbackRows(ULONG signature) const
+	{
+		GPOS_ASSERT(FFeedback());
+
+		return m_feedback_rows->Find(&signature);
+	}
+
 	// generate default optimizer configurations
 	static CStatisticsConfig *
 	PstatsconfDefault(CMemoryPool *mp)
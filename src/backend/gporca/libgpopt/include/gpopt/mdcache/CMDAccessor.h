@@ -47,6 +47,7 @@ class IMDProvider;
 class CMDProviderGeneric;
 class IMDColStats;
 class IMDRelStats;
+class IMDExtStats;
 class CDXLBucket;
 class IMDCast;
 class IMDScCmp;
@@ -347,6 +348,9 @@ public:
 	// retrieve a relation stats object from the cache
 	const IMDRelStats *Pmdrelstats(IMDId *mdid);
 
+	// retrieve an extended stats object from the cache
+	const IMDExtStats *Pmdextstats(IMDId *mdid);
+
 	// retrieve a cast object from the cache
 	const IMDCast *Pmdcast(IMDId *mdid_src, IMDId *mdid_dest);
 
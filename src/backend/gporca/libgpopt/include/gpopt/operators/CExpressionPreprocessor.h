@@ -127,6 +127,28 @@ private:
 		ULongPtrArray *lojChildPredIndexes,
 		CExpressionArray *innerJoinPredicates, CExpressionArray *lojPredicates);
 
+	// eliminate inner joins to unused relations referenced by a foreign key
+	static CExpression *PexprEliminateForeignKeyJoins(
+		CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsOutputAndOrderCols);
+
+	// collect the columns used outside of the predicates of inner NAry joins
+	static void CollectUsedColsOutsideInnerJoinPreds(CMemoryPool *mp,
+													 CExpression *pexpr,
+													 CColRefSet *pcrsUsed);
+
+	// workhorse for eliminating foreign key joins
+	static CExpression *PexprEliminateForeignKeyJoinsRecursive(
+		CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsUsed);
+
+	// check if the given child of an inner NAry join only joins on a foreign
+	// key referencing it, and none of its columns are used
+	static BOOL FForeignKeyJoinChild(CExpressionArray *pdrgpexprChildren,
+									 ULONG child_index,
+									 CExpressionArray *pdrgpexprConjuncts,
+									 CColRefSet *pcrsUsed,
+									 ULongPtrArray *pdrgpulFkConjuncts,
+									 CColRefArray *pdrgpcrFk);
+
 	// collapse cascaded logical project operators
 	static CExpression *PexprCollapseProjects(CMemoryPool *mp,
 											  CExpression *pexpr);
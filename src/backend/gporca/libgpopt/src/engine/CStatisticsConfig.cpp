@@ -39,7 +39,8 @@ CStatisticsConfig::CStatisticsConfig(CMemoryPool *mp,
 	  m_damping_factor_join(damping_factor_join),
 	  m_damping_factor_groupby(damping_factor_groupby),
 	  m_max_stats_buckets(max_stats_buckets),
-	  m_phsmdidcolinfo(nullptr)
+	  m_phsmdidcolinfo(nullptr),
+	  m_feedback_rows(nullptr)
 {
 	GPOS_ASSERT(CDouble(0.0) < damping_factor_filter);
 	GPOS_ASSERT(CDouble(0.0) <= damping_factor_join);
@@ -63,6 +64,7 @@ CStatisticsConfig::CStatisticsConfig(CMemoryPool *mp,
 CStatisticsConfig::~CStatisticsConfig()
 {
 	m_phsmdidcolinfo->Release();
+	CRefCount::SafeRelease(m_feedback_rows);
 }
 
 //---------------------------------------------------------------------------
@@ -109,5 +111,24 @@ CStatisticsConfig::CollectMissingStatsColumns(IMdIdArray *pdrgmdid)
 	}
 }
 
+//---------------------------------------------------------------------------
+//      @function:
+//              CStatisticsConfig::SetFeedbackRows
+//
+//      @doc:
+//              Enable cardinality feedback; takes ownership of the map from
+//              feedback signatures to observed row counts
+//
+//---------------------------------------------------------------------------
+void
+CStatisticsConfig::SetFeedbackRows(
+	gpnaucrates::UlongToDoubleMap *feedback_rows)
+{
+	GPOS_ASSERT(nullptr != feedback_rows);
+
+	CRefCount::SafeRelease(m_feedback_rows);
+	m_feedback_rows = feedback_rows;
+}
+
 
 // EOF
@@ -35,6 +35,7 @@
 #include "naucrates/md/IMDCast.h"
 #include "naucrates/md/IMDCheckConstraint.h"
 #include "naucrates/md/IMDColStats.h"
+#include "naucrates/md/IMDExtStats.h"
 #include "naucrates/md/IMDFunction.h"
 #include "naucrates/md/IMDIndex.h"
 #include "naucrates/md/IMDProvider.h"
@@ -914,6 +915,29 @@ CMDAccessor::Pmdrelstats(IMDId *mdid)
 	return dynamic_cast<const IMDRelStats *>(pmdobj);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::Pmdextstats
+//
+//	@doc:
+//		Retrieves the extended statistics of a relation from the md cache,
+//		possibly retrieving them from the external metadata provider and
+//		storing them in the cache first.
+//
+//---------------------------------------------------------------------------
+const IMDExtStats *
+CMDAccessor::Pmdextstats(IMDId *mdid)
+{
+	const IMDCacheObject *pmdobj = GetImdObj(mdid);
+	if (IMDCacheObject::EmdtExtStats != pmdobj->MDType())
+	{
+		GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound,
+				   mdid->GetBuffer());
+	}
+
+	return dynamic_cast<const IMDExtStats *>(pmdobj);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessor::Pmdcast
@@ -398,6 +398,10 @@ CExpressionHandle::DeriveRootStats(IStatisticsArray *stats_ctxt)
 	{
 		// otherwise, derive stats using root operator
 		pstatsRoot = popLogical->PstatsDerive(m_mp, *this, stats_ctxt);
+
+		// correct them with the row count of earlier executions, if known
+		pstatsRoot = CStatisticsUtils::ApplyCardinalityFeedback(m_mp, *this,
+															   pstatsRoot);
 	}
 	GPOS_ASSERT(nullptr != pstatsRoot);
 
@@ -31,6 +31,7 @@
 #include "gpopt/operators/CLogicalConstTableGet.h"
 #include "gpopt/operators/CLogicalDynamicGet.h"
 #include "gpopt/operators/CLogicalGbAgg.h"
+#include "gpopt/operators/CLogicalGet.h"
 #include "gpopt/operators/CLogicalInnerJoin.h"
 #include "gpopt/operators/CLogicalLimit.h"
 #include "gpopt/operators/CLogicalNAryJoin.h"
@@ -1074,6 +1075,367 @@ CExpressionPreprocessor::CollectJoinChildrenRecursively(
 	}
 }
 
+// Eliminate inner joins to relations referenced by a foreign key, when none
+// of the columns of the referenced relation are used other than in the
+// foreign key join predicates. Every row of the referencing relation with a
+// non-NULL foreign key matches exactly one row of the referenced relation, so
+// the join is replaced by IS NOT NULL predicates on the foreign key columns.
+//
+// Foreign keys are not enforced in GPDB, so the result is only correct if the
+// constraint holds, which is why this is controlled by a trace flag that is
+// off by default.
+//
+// Example (fact.d_id references dim.id):
+//
+//		select fact.* from fact, dim where fact.d_id = dim.id
+//	=>
+//		select fact.* from fact where fact.d_id is not null
+CExpression *
+CExpressionPreprocessor::PexprEliminateForeignKeyJoins(
+	CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsOutputAndOrderCols)
+{
+	GPOS_ASSERT(nullptr != pexpr);
+
+	if (nullptr == pcrsOutputAndOrderCols ||
+		!GPOS_FTRACE(EopttraceEnableForeignKeyJoinElimination))
+	{
+		pexpr->AddRef();
+		return pexpr;
+	}
+
+	CColRefSet *pcrsUsed = GPOS_NEW(mp) CColRefSet(mp);
+	pcrsUsed->Include(pcrsOutputAndOrderCols);
+	CollectUsedColsOutsideInnerJoinPreds(mp, pexpr, pcrsUsed);
+
+	CExpression *pexprNew =
+		PexprEliminateForeignKeyJoinsRecursive(mp, pexpr, pcrsUsed);
+	pcrsUsed->Release();
+
+	return pexprNew;
+}
+
+// collect the columns used by all logical operators in the expression,
+// except for the predicates of inner NAry joins, which are examined
+// conjunct by conjunct when eliminating foreign key joins
+void
+CExpressionPreprocessor::CollectUsedColsOutsideInnerJoinPreds(
+	CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsUsed)
+{
+	// protect against stack overflow during recursion
+	GPOS_CHECK_STACK_SIZE;
+
+	COperator *pop = pexpr->Pop();
+	if (pop->FLogical())
+	{
+		if (COperator::EopLogicalNAryJoin == pop->Eopid() &&
+			!CLogicalNAryJoin::PopConvert(pop)->HasOuterJoinChildren())
+		{
+			pcrsUsed->Include(CLogical::PopConvert(pop)->PcrsLocalUsed());
+		}
+		else
+		{
+			CExpressionHandle exprhdl(mp);
+			exprhdl.Attach(pexpr);
+			CColRefSet *pcrsLogicalUsed = exprhdl.PcrsUsedColumns(mp);
+			pcrsUsed->Include(pcrsLogicalUsed);
+			pcrsLogicalUsed->Release();
+		}
+	}
+
+	// scalar children may contain subqueries
+	const ULONG arity = pexpr->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		CollectUsedColsOutsideInnerJoinPreds(mp, (*pexpr)[ul], pcrsUsed);
+	}
+}
+
+// check if the given child of an inner NAry join is a table that is only
+// joined on a foreign key referencing it, and none of its columns are used
+// elsewhere; if so, return the indexes of the foreign key join conjuncts and
+// the foreign key columns that may be NULL
+BOOL
+CExpressionPreprocessor::FForeignKeyJoinChild(
+	CExpressionArray *pdrgpexprChildren, ULONG child_index,
+	CExpressionArray *pdrgpexprConjuncts, CColRefSet *pcrsUsed,
+	ULongPtrArray *pdrgpulFkConjuncts, CColRefArray *pdrgpcrFk)
+{
+	CMemoryPool *mp = COptCtxt::PoctxtFromTLS()->Pmp();
+	CExpression *pexprChild = (*pdrgpexprChildren)[child_index];
+	if (COperator::EopLogicalGet != pexprChild->Pop()->Eopid())
+	{
+		return false;
+	}
+
+	CColRefSet *pcrsChild = pexprChild->DeriveOutputColumns();
+	if (!pcrsChild->IsDisjoint(pcrsUsed))
+	{
+		return false;
+	}
+
+	// collect the join conjuncts on the columns of the child, which must all
+	// be equalities with columns of the same table in another child
+	CColRefArray *pdrgpcrRef = GPOS_NEW(mp) CColRefArray(mp);
+	CColRefArray *pdrgpcrAllFk = GPOS_NEW(mp) CColRefArray(mp);
+	IMDId *fk_table = nullptr;
+	BOOL fCandidate = true;
+	const ULONG ulConjuncts = pdrgpexprConjuncts->Size();
+	for (ULONG ul = 0; fCandidate && ul < ulConjuncts; ul++)
+	{
+		CExpression *pexprConj = (*pdrgpexprConjuncts)[ul];
+		if (pcrsChild->IsDisjoint(pexprConj->DeriveUsedColumns()))
+		{
+			continue;
+		}
+
+		fCandidate = CPredicateUtils::FPlainEquality(pexprConj);
+		if (!fCandidate)
+		{
+			break;
+		}
+
+		CColRef *pcrRef = const_cast<CColRef *>(
+			CScalarIdent::PopConvert((*pexprConj)[0]->Pop())->Pcr());
+		CColRef *pcrFk = const_cast<CColRef *>(
+			CScalarIdent::PopConvert((*pexprConj)[1]->Pop())->Pcr());
+		if (!pcrsChild->FMember(pcrRef))
+		{
+			CColRef *pcrTemp = pcrRef;
+			pcrRef = pcrFk;
+			pcrFk = pcrTemp;
+		}
+
+		fCandidate = pcrsChild->FMember(pcrRef) &&
+					 !pcrsChild->FMember(pcrFk) &&
+					 CColRef::EcrtTable == pcrFk->Ecrt() &&
+					 nullptr != pcrFk->GetMdidTable() &&
+					 (nullptr == fk_table || fk_table == pcrFk->GetMdidTable());
+		if (fCandidate)
+		{
+			fk_table = pcrFk->GetMdidTable();
+			pdrgpulFkConjuncts->Append(GPOS_NEW(mp) ULONG(ul));
+			pdrgpcrRef->Append(pcrRef);
+			pdrgpcrAllFk->Append(pcrFk);
+		}
+	}
+
+	// the foreign key columns must be produced by another child
+	ULONG ulFkChild = gpos::ulong_max;
+	CColRefSet *pcrsAllFk = GPOS_NEW(mp) CColRefSet(mp, pdrgpcrAllFk);
+	for (ULONG ul = 0; fCandidate && nullptr != fk_table &&
+					   ul < pdrgpexprChildren->Size();
+		 ul++)
+	{
+		if (ul != child_index &&
+			(*pdrgpexprChildren)[ul]->DeriveOutputColumns()->ContainsAll(
+				pcrsAllFk))
+		{
+			ulFkChild = ul;
+		}
+	}
+	pcrsAllFk->Release();
+
+	// the conjuncts must match exactly the columns of a foreign key of the
+	// other table that references this one
+	BOOL fFkJoin = false;
+	if (fCandidate && gpos::ulong_max != ulFkChild)
+	{
+		CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+		IMDId *ref_mdid =
+			CLogicalGet::PopConvert(pexprChild->Pop())->Ptabdesc()->MDId();
+		const IMDRelation *fk_rel = md_accessor->RetrieveRel(fk_table);
+		const IMDRelation *ref_rel = md_accessor->RetrieveRel(ref_mdid);
+
+		const ULONG num_fks = fk_rel->ForeignKeyCount();
+		for (ULONG fk_pos = 0; !fFkJoin && fk_pos < num_fks; fk_pos++)
+		{
+			const ULongPtrArray *fk_cols = fk_rel->ForeignKeyColsAt(fk_pos);
+			const ULongPtrArray *ref_cols = fk_rel->ForeignKeyRefColsAt(fk_pos);
+			if (!fk_rel->ForeignKeyRelMdidAt(fk_pos)->Equals(ref_mdid) ||
+				fk_cols->Size() != pdrgpcrAllFk->Size())
+			{
+				continue;
+			}
+
+			fFkJoin = true;
+			for (ULONG col = 0; fFkJoin && col < fk_cols->Size(); col++)
+			{
+				BOOL fFound = false;
+				for (ULONG ul = 0; !fFound && ul < pdrgpcrAllFk->Size(); ul++)
+				{
+					CColRefTable *pcrFk =
+						CColRefTable::PcrConvert((*pdrgpcrAllFk)[ul]);
+					CColRefTable *pcrRef =
+						CColRefTable::PcrConvert((*pdrgpcrRef)[ul]);
+					fFound =
+						*(*fk_cols)[col] ==
+							fk_rel->GetPosFromAttno(pcrFk->AttrNum()) &&
+						*(*ref_cols)[col] ==
+							ref_rel->GetPosFromAttno(pcrRef->AttrNum());
+				}
+				fFkJoin = fFound;
+			}
+		}
+	}
+
+	if (fFkJoin)
+	{
+		// rows with a NULL foreign key do not join with the referenced table
+		CColRefSet *pcrsNotNull =
+			(*pdrgpexprChildren)[ulFkChild]->DeriveNotNullColumns();
+		for (ULONG ul = 0; ul < pdrgpcrAllFk->Size(); ul++)
+		{
+			CColRef *pcrFk = (*pdrgpcrAllFk)[ul];
+			if (!pcrsNotNull->FMember(pcrFk))
+			{
+				pdrgpcrFk->Append(pcrFk);
+			}
+		}
+	}
+	else
+	{
+		pdrgpulFkConjuncts->Clear();
+	}
+
+	pdrgpcrRef->Release();
+	pdrgpcrAllFk->Release();
+
+	return fFkJoin;
+}
+
+// workhorse for eliminating foreign key joins, pcrsUsed holds the columns
+// used outside of the predicates of the current join
+CExpression *
+CExpressionPreprocessor::PexprEliminateForeignKeyJoinsRecursive(
+	CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsUsed)
+{
+	// protect against stack overflow during recursion
+	GPOS_CHECK_STACK_SIZE;
+
+	COperator *pop = pexpr->Pop();
+
+	// joins in subqueries are left alone
+	if (pop->FScalar())
+	{
+		pexpr->AddRef();
+		return pexpr;
+	}
+
+	const ULONG arity = pexpr->Arity();
+	if (COperator::EopLogicalNAryJoin != pop->Eopid() ||
+		CLogicalNAryJoin::PopConvert(pop)->HasOuterJoinChildren())
+	{
+		CExpressionArray *pdrgpexprChildren = GPOS_NEW(mp) CExpressionArray(mp);
+		for (ULONG ul = 0; ul < arity; ul++)
+		{
+			pdrgpexprChildren->Append(PexprEliminateForeignKeyJoinsRecursive(
+				mp, (*pexpr)[ul], pcrsUsed));
+		}
+
+		pop->AddRef();
+		return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	}
+
+	CExpressionArray *pdrgpexprChildren = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < arity - 1; ul++)
+	{
+		(*pexpr)[ul]->AddRef();
+		pdrgpexprChildren->Append((*pexpr)[ul]);
+	}
+	CExpressionArray *pdrgpexprConjuncts =
+		CPredicateUtils::PdrgpexprConjuncts(mp, (*pexpr)[arity - 1]);
+
+	// eliminating a join may make the columns of another child unused, as
+	// in snowflake schemas, so repeat until there is nothing to eliminate
+	BOOL fEliminated = true;
+	while (fEliminated && 1 < pdrgpexprChildren->Size())
+	{
+		fEliminated = false;
+		for (ULONG ulChild = 0;
+			 !fEliminated && ulChild < pdrgpexprChildren->Size(); ulChild++)
+		{
+			ULongPtrArray *pdrgpulFkConjuncts = GPOS_NEW(mp) ULongPtrArray(mp);
+			CColRefArray *pdrgpcrFk = GPOS_NEW(mp) CColRefArray(mp);
+			fEliminated = FForeignKeyJoinChild(
+				pdrgpexprChildren, ulChild, pdrgpexprConjuncts, pcrsUsed,
+				pdrgpulFkConjuncts, pdrgpcrFk);
+			if (fEliminated)
+			{
+				CExpressionArray *pdrgpexprChildrenNew =
+					GPOS_NEW(mp) CExpressionArray(mp);
+				for (ULONG ul = 0; ul < pdrgpexprChildren->Size(); ul++)
+				{
+					if (ul != ulChild)
+					{
+						(*pdrgpexprChildren)[ul]->AddRef();
+						pdrgpexprChildrenNew->Append((*pdrgpexprChildren)[ul]);
+					}
+				}
+				pdrgpexprChildren->Release();
+				pdrgpexprChildren = pdrgpexprChildrenNew;
+
+				CExpressionArray *pdrgpexprConjunctsNew =
+					GPOS_NEW(mp) CExpressionArray(mp);
+				for (ULONG ul = 0; ul < pdrgpexprConjuncts->Size(); ul++)
+				{
+					BOOL fFkConjunct = false;
+					for (ULONG ulFk = 0; ulFk < pdrgpulFkConjuncts->Size();
+						 ulFk++)
+					{
+						fFkConjunct =
+							fFkConjunct || ul == *(*pdrgpulFkConjuncts)[ulFk];
+					}
+					if (!fFkConjunct)
+					{
+						(*pdrgpexprConjuncts)[ul]->AddRef();
+						pdrgpexprConjunctsNew->Append(
+							(*pdrgpexprConjuncts)[ul]);
+					}
+				}
+				for (ULONG ul = 0; ul < pdrgpcrFk->Size(); ul++)
+				{
+					pdrgpexprConjunctsNew->Append(CUtils::PexprIsNotNull(
+						mp, CUtils::PexprScalarIdent(mp, (*pdrgpcrFk)[ul])));
+				}
+				pdrgpexprConjuncts->Release();
+				pdrgpexprConjuncts = pdrgpexprConjunctsNew;
+			}
+			pdrgpulFkConjuncts->Release();
+			pdrgpcrFk->Release();
+		}
+	}
+
+	CExpression *pexprPred =
+		CPredicateUtils::PexprConjunction(mp, pdrgpexprConjuncts);
+
+	// the remaining predicates are used by the joins below
+	CColRefSet *pcrsUsedChildren = GPOS_NEW(mp) CColRefSet(mp);
+	pcrsUsedChildren->Include(pcrsUsed);
+	pcrsUsedChildren->Include(pexprPred->DeriveUsedColumns());
+
+	CExpressionArray *pdrgpexprChildrenNew = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < pdrgpexprChildren->Size(); ul++)
+	{
+		pdrgpexprChildrenNew->Append(PexprEliminateForeignKeyJoinsRecursive(
+			mp, (*pdrgpexprChildren)[ul], pcrsUsedChildren));
+	}
+	pdrgpexprChildren->Release();
+	pcrsUsedChildren->Release();
+
+	if (1 == pdrgpexprChildrenNew->Size())
+	{
+		CExpression *pexprChild = (*pdrgpexprChildrenNew)[0];
+		pexprChild->AddRef();
+		pdrgpexprChildrenNew->Release();
+
+		return CUtils::PexprSafeSelect(mp, pexprChild, pexprPred);
+	}
+
+	pdrgpexprChildrenNew->Append(pexprPred);
+	pop->AddRef();
+
+	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildrenNew);
+}
 
 // collapse cascaded logical project operators
 CExpression *
@@ -2828,11 +3190,18 @@ CExpressionPreprocessor::PexprPreprocess(
 	GPOS_CHECK_ABORT;
 	pexprNormalized1->Release();
 
-	// (19) collapse cascaded inner and left outer joins
-	CExpression *pexprCollapsed = PexprCollapseJoins(mp, pexprLOJToIJ);
+	// (19.a) collapse cascaded inner and left outer joins
+	CExpression *pexprCollapsedJoins = PexprCollapseJoins(mp, pexprLOJToIJ);
 	GPOS_CHECK_ABORT;
 	pexprLOJToIJ->Release();
 
+	// (19.b) eliminate unused joins on foreign keys, before more join
+	// predicates are inferred from equivalence classes
+	CExpression *pexprCollapsed = PexprEliminateForeignKeyJoins(
+		mp, pexprCollapsedJoins, pcrsOutputAndOrderCols);
+	GPOS_CHECK_ABORT;
+	pexprCollapsedJoins->Release();
+
 	// (20) after transforming outer joins to inner joins, we may be able to generate more predicates from constraints
 	CExpression *pexprWithPreds =
 		PexprAddPredicatesFromConstraints(mp, pexprCollapsed);
@@ -336,6 +336,7 @@ CLogicalGet::PstatsDerive(CMemoryPool *mp, CExpressionHandle &exprhdl,
 	CUpperBoundNDVs *upper_bound_NDVs =
 		GPOS_NEW(mp) CUpperBoundNDVs(pcrs, pstatsTable->Rows());
 	CStatistics::CastStats(pstatsTable)->AddCardUpperBound(upper_bound_NDVs);
+	pstatsTable->SetBaseScanId(UlOpId());
 
 	return pstatsTable;
 }
@@ -590,7 +590,13 @@ CTranslatorDXLToExpr::PexprLogicalGet(const CDXLNode *dxlnode)
 	{
 		GPOS_ASSERT(EdxlopLogicalGet == edxlopid);
 
-		IMdIdArray *partition_mdids = pmdrel->ChildPartitionMdids();
+		// only look at the partitions that survived static pruning in the
+		// query translator, if any; their metadata is not fetched otherwise
+		IMdIdArray *partition_mdids = table_descr->GetPartitionMdids();
+		if (nullptr == partition_mdids)
+		{
+			partition_mdids = pmdrel->ChildPartitionMdids();
+		}
 		for (ULONG ul = 0; ul < partition_mdids->Size(); ++ul)
 		{
 			IMDId *part_mdid = (*partition_mdids)[ul];
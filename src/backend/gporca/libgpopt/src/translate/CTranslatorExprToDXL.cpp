@@ -7635,10 +7635,11 @@ CTranslatorExprToDXL::GetProperties(const CExpression *pexpr)
 		rows = stats->Rows();
 	}
 
-	if (CDistributionSpec::EdtStrictReplicated ==
-			pexpr->GetDrvdPropPlan()->Pds()->Edt() ||
-		CDistributionSpec::EdtTaintedReplicated ==
-			pexpr->GetDrvdPropPlan()->Pds()->Edt())
+	CDistributionSpec::EDistributionType edt =
+		pexpr->GetDrvdPropPlan()->Pds()->Edt();
+	BOOL is_replicated = CDistributionSpec::EdtStrictReplicated == edt ||
+						 CDistributionSpec::EdtTaintedReplicated == edt;
+	if (is_replicated)
 	{
 		// if distribution is replicated, multiply number of rows by number of segments
 		ULONG ulSegments = COptCtxt::PoctxtFromTLS()->GetCostModel()->UlHosts();
@@ -7677,6 +7678,20 @@ CTranslatorExprToDXL::GetProperties(const CExpression *pexpr)
 	CDXLPhysicalProperties *dxl_properties =
 		GPOS_NEW(m_mp) CDXLPhysicalProperties(cost);
 
+	// pass on the feedback signature of the rows computed, for the executor
+	// to record their actual number. Rows computed on every segment would
+	// be counted several times, and a scan without a filter has nothing to
+	// correct.
+	COperator::EOperatorId op_id = pexpr->Pop()->Eopid();
+	if (nullptr != stats && !is_replicated &&
+		CDistributionSpec::EdtUniversal != edt &&
+		COperator::EopPhysicalTableScan != op_id &&
+		COperator::EopPhysicalDynamicTableScan != op_id &&
+		COperator::EopPhysicalExternalScan != op_id)
+	{
+		dxl_properties->SetFeedbackSignature(stats->FeedbackSignature());
+	}
+
 	return dxl_properties;
 }
 
@@ -35,6 +35,10 @@ private:
 	// cost estimate
 	CDXLOperatorCost *m_operator_cost_dxl;
 
+	// cardinality feedback signature of the rows the operator produces,
+	// 0 if none; not serialized, it is only passed on to the plan
+	ULONG m_feedback_signature;
+
 public:
 	CDXLPhysicalProperties(const CDXLPhysicalProperties &) = delete;
 
@@ -52,6 +56,20 @@ public:
 	// the cost estimates for the operator node
 	CDXLOperatorCost *GetDXLOperatorCost() const;
 
+	// cardinality feedback signature
+	ULONG
+	GetFeedbackSignature() const
+	{
+		return m_feedback_signature;
+	}
+
+	// set cardinality feedback signature
+	void
+	SetFeedbackSignature(ULONG signature)
+	{
+		m_feedback_signature = signature;
+	}
+
 	Edxlproperty
 	GetDXLPropertyType() const override
 	{
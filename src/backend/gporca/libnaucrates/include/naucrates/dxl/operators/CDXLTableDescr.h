@@ -50,6 +50,11 @@ private:
 	// lock mode from the parser
 	INT m_lockmode;
 
+	// partitions of a partitioned table that survived static pruning in the
+	// query translator, or NULL if all partitions are to be considered; not
+	// serialized, since it is only an upper bound for ORCA's own pruning
+	IMdIdArray *m_partition_mdids;
+
 	void SerializeMDId(CXMLSerializer *xml_serializer) const;
 
 public:
@@ -66,6 +71,8 @@ public:
 
 	void AddColumnDescr(CDXLColDescr *pdxlcd);
 
+	void SetPartitionMdids(IMdIdArray *partition_mdids);
+
 	// table name
 	const CMDName *MdName() const;
 
@@ -81,6 +88,9 @@ public:
 	// lock mode
 	INT LockMode() const;
 
+	// statically pruned partitions, NULL if not pruned
+	IMdIdArray *GetPartitionMdids() const;
+
 	// get the column descriptor at the given position
 	const CDXLColDescr *GetColumnDescrAt(ULONG idx) const;
 
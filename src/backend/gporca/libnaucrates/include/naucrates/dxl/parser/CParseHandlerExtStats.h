@@ -0,0 +1,88 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2023 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CParseHandlerExtStats.h
+//
+//	@doc:
+//		SAX parse handler class for parsing extended stats objects
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CParseHandlerExtStats_H
+#define GPDXL_CParseHandlerExtStats_H
+
+#include "gpos/base.h"
+
+#include "naucrates/dxl/parser/CParseHandlerMetadataObject.h"
+#include "naucrates/statistics/CHistogram.h"
+
+namespace gpdxl
+{
+using namespace gpos;
+using namespace gpmd;
+using namespace gpnaucrates;
+
+XERCES_CPP_NAMESPACE_USE
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CParseHandlerExtStats
+//
+//	@doc:
+//		Parse handler class for the extended stats of a relation, including
+//		its functional dependency and ndistinct elements
+//
+//---------------------------------------------------------------------------
+class CParseHandlerExtStats : public CParseHandlerMetadataObject
+{
+private:
+	// metadata id of the object
+	IMDId *m_mdid;
+
+	// table name
+	CMDName *m_mdname;
+
+	// determining columns of the functional dependencies
+	ULongPtr2dArray *m_dep_from_attnos;
+
+	// dependent column of the functional dependencies
+	ULongPtrArray *m_dep_to_attnos;
+
+	// degrees of the functional dependencies
+	CDoubleArray *m_dep_degrees;
+
+	// columns of the ndistinct coefficients
+	ULongPtr2dArray *m_ndistinct_attnos;
+
+	// values of the ndistinct coefficients
+	CDoubleArray *m_ndistinct_values;
+
+	// process the start of an element
+	void StartElement(
+		const XMLCh *const element_uri,			// URI of element's namespace
+		const XMLCh *const element_local_name,	// local part of element's name
+		const XMLCh *const element_qname,		// element's qname
+		const Attributes &attr					// element's attributes
+		) override;
+
+	// process the end of an element
+	void EndElement(
+		const XMLCh *const element_uri,			// URI of element's namespace
+		const XMLCh *const element_local_name,	// local part of element's name
+		const XMLCh *const element_qname		// element's qname
+		) override;
+
+public:
+	CParseHandlerExtStats(const CParseHandlerExtStats &) = delete;
+
+	// ctor
+	CParseHandlerExtStats(CMemoryPool *mp,
+						  CParseHandlerManager *parse_handler_mgr,
+						  CParseHandlerBase *parse_handler_root);
+};
+}  // namespace gpdxl
+
+#endif	// !GPDXL_CParseHandlerExtStats_H
+
+// EOF
@@ -76,6 +76,13 @@ protected:
 	// key sets
 	ULongPtr2dArray *m_key_sets_arrays;
 
+	// relations referenced by foreign keys
+	IMdIdArray *m_fk_rel_mdid_array;
+
+	// referencing and referenced columns of the foreign keys
+	ULongPtr2dArray *m_fk_cols_array;
+	ULongPtr2dArray *m_fk_ref_cols_array;
+
 	// part constraint
 	CDXLNode *m_part_constraint;
 
@@ -33,6 +33,7 @@
 #include "naucrates/dxl/parser/CParseHandlerDirectDispatchInfo.h"
 #include "naucrates/dxl/parser/CParseHandlerDistinctComp.h"
 #include "naucrates/dxl/parser/CParseHandlerEnumeratorConfig.h"
+#include "naucrates/dxl/parser/CParseHandlerExtStats.h"
 #include "naucrates/dxl/parser/CParseHandlerExternalScan.h"
 #include "naucrates/dxl/parser/CParseHandlerFactory.h"
 #include "naucrates/dxl/parser/CParseHandlerFilter.h"
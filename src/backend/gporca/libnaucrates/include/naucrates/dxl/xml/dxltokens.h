@@ -447,6 +447,12 @@ enum Edxltoken
 	EdxltokenRelationStats,
 	EdxltokenColumnStats,
 	EdxltokenColumnStatsBucket,
+	EdxltokenExtendedStats,
+	EdxltokenExtStatsDependency,
+	EdxltokenExtStatsNDistinct,
+	EdxltokenExtStatsFromAttnos,
+	EdxltokenExtStatsToAttno,
+	EdxltokenExtStatsDegree,
 	EdxltokenEmptyRelation,
 	EdxltokenIsNull,
 	EdxltokenLintValue,
@@ -490,6 +496,9 @@ enum Edxltoken
 	EdxltokenColumnDefaultValue,
 
 	EdxltokenKeys,
+	EdxltokenForeignKeyRels,
+	EdxltokenForeignKeyCols,
+	EdxltokenForeignKeyRefCols,
 	EdxltokenDistrColumns,
 
 	EdxltokenIndexKeyCols,
@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2023 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLExtStats.h
+//
+//	@doc:
+//		Class representing the extended statistics of a relation
+//---------------------------------------------------------------------------
+
+
+
+#ifndef GPMD_CDXLExtStats_H
+#define GPMD_CDXLExtStats_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/md/CMDIdExtStats.h"
+#include "naucrates/md/IMDExtStats.h"
+#include "naucrates/statistics/CHistogram.h"
+
+namespace gpdxl
+{
+class CXMLSerializer;
+}
+
+namespace gpmd
+{
+using namespace gpos;
+using namespace gpdxl;
+using namespace gpnaucrates;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLExtStats
+//
+//	@doc:
+//		Class representing the functional dependencies and multi-column
+//		ndistinct coefficients of a relation. The i-th elements of the
+//		dependency arrays (resp. ndistinct arrays) describe the i-th
+//		dependency (resp. ndistinct coefficient).
+//
+//---------------------------------------------------------------------------
+class CDXLExtStats : public IMDExtStats
+{
+private:
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// metadata id of the object
+	CMDIdExtStats *m_ext_stats_mdid;
+
+	// table name
+	CMDName *m_mdname;
+
+	// determining columns of the functional dependencies
+	ULongPtr2dArray *m_dep_from_attnos;
+
+	// dependent column of the functional dependencies
+	ULongPtrArray *m_dep_to_attnos;
+
+	// degrees of the functional dependencies
+	CDoubleArray *m_dep_degrees;
+
+	// columns of the ndistinct coefficients
+	ULongPtr2dArray *m_ndistinct_attnos;
+
+	// values of the ndistinct coefficients
+	CDoubleArray *m_ndistinct_values;
+
+	// DXL string for object
+	CWStringDynamic *m_dxl_str;
+
+public:
+	CDXLExtStats(const CDXLExtStats &) = delete;
+
+	CDXLExtStats(CMemoryPool *mp, CMDIdExtStats *ext_stats_mdid,
+				 CMDName *mdname, ULongPtr2dArray *dep_from_attnos,
+				 ULongPtrArray *dep_to_attnos, CDoubleArray *dep_degrees,
+				 ULongPtr2dArray *ndistinct_attnos,
+				 CDoubleArray *ndistinct_values);
+
+	~CDXLExtStats() override;
+
+	// the metadata id
+	IMDId *MDId() const override;
+
+	// relation name
+	CMDName Mdname() const override;
+
+	// DXL string representation of cache object
+	const CWStringDynamic *GetStrRepr() const override;
+
+	// number of functional dependencies
+	ULONG DependencyCount() const override;
+
+	// attnos of the determining columns of the given dependency
+	const ULongPtrArray *DependencyFromAttnos(ULONG pos) const override;
+
+	// attno of the dependent column of the given dependency
+	ULONG DependencyToAttno(ULONG pos) const override;
+
+	// fraction of the rows for which the given dependency holds
+	CDouble DependencyDegree(ULONG pos) const override;
+
+	// number of multi-column ndistinct coefficients
+	ULONG NDistinctCount() const override;
+
+	// attnos of the columns of the given ndistinct coefficient
+	const ULongPtrArray *NDistinctAttnos(ULONG pos) const override;
+
+	// number of distinct combinations of values of the given columns
+	CDouble NDistinct(ULONG pos) const override;
+
+	// serialize extended stats in DXL format given a serializer object
+	void Serialize(gpdxl::CXMLSerializer *) const override;
+
+#ifdef GPOS_DEBUG
+	// debug print of the extended stats
+	void DebugPrint(IOstream &os) const override;
+#endif
+
+	// dummy extended stats, for relations without statistics objects
+	static CDXLExtStats *CreateDXLDummyExtStats(CMemoryPool *mp, IMDId *mdid);
+};
+
+}  // namespace gpmd
+
+
+
+#endif	// !GPMD_CDXLExtStats_H
+
+// EOF
@@ -94,6 +94,15 @@ private:
 	// array of key sets
 	ULongPtr2dArray *m_keyset_array;
 
+	// relations referenced by foreign keys
+	IMdIdArray *m_fk_rel_mdid_array;
+
+	// referencing column positions of each foreign key
+	ULongPtr2dArray *m_fk_cols_array;
+
+	// referenced column positions of each foreign key
+	ULongPtr2dArray *m_fk_ref_cols_array;
+
 	// array of index info
 	CMDIndexInfoArray *m_mdindex_info_array;
 
@@ -141,7 +150,10 @@ public:
 					CMDIndexInfoArray *md_index_info_array,
 					IMdIdArray *mdid_triggers_array,
 					IMdIdArray *mdid_check_constraint_array,
-					CDXLNode *mdpart_constraint, BOOL has_oids);
+					CDXLNode *mdpart_constraint, BOOL has_oids,
+					IMdIdArray *fk_rel_mdid_array,
+					ULongPtr2dArray *fk_cols_array,
+					ULongPtr2dArray *fk_ref_cols_array);
 
 	// dtor
 	~CMDRelationGPDB() override;
@@ -260,6 +272,18 @@ public:
 	// child partition oids
 	IMdIdArray *ChildPartitionMdids() const override;
 
+	// number of foreign keys referencing other relations
+	ULONG ForeignKeyCount() const override;
+
+	// relation referenced by the foreign key at the given position
+	IMDId *ForeignKeyRelMdidAt(ULONG pos) const override;
+
+	// referencing column positions of the foreign key at the given position
+	const ULongPtrArray *ForeignKeyColsAt(ULONG pos) const override;
+
+	// referenced column positions of the foreign key at the given position
+	const ULongPtrArray *ForeignKeyRefColsAt(ULONG pos) const override;
+
 #ifdef GPOS_DEBUG
 	// debug print of the metadata relation
 	void DebugPrint(IOstream &os) const override;
@@ -72,7 +72,8 @@ public:
 		EmdtRelStats,
 		EmdtColStats,
 		EmdtCastFunc,
-		EmdtScCmp
+		EmdtScCmp,
+		EmdtExtStats
 	};
 
 	// md id of cache object
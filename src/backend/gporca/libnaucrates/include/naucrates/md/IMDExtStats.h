@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2023 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		IMDExtStats.h
+//
+//	@doc:
+//		Interface for the extended (multi-column) statistics of a relation
+//---------------------------------------------------------------------------
+
+
+
+#ifndef GPMD_IMDExtStats_H
+#define GPMD_IMDExtStats_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CDynamicPtrArray.h"
+
+#include "naucrates/md/IMDCacheObject.h"
+
+namespace gpmd
+{
+using namespace gpos;
+using namespace gpdxl;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		IMDExtStats
+//
+//	@doc:
+//		Interface for the extended statistics built by ANALYZE for the
+//		statistics objects defined with CREATE STATISTICS on a relation.
+//		Columns are identified by their attribute numbers.
+//
+//---------------------------------------------------------------------------
+class IMDExtStats : public IMDCacheObject
+{
+public:
+	// object type
+	Emdtype
+	MDType() const override
+	{
+		return EmdtExtStats;
+	}
+
+	// number of functional dependencies
+	virtual ULONG DependencyCount() const = 0;
+
+	// attnos of the determining columns of the given dependency
+	virtual const ULongPtrArray *DependencyFromAttnos(ULONG pos) const = 0;
+
+	// attno of the dependent column of the given dependency
+	virtual ULONG DependencyToAttno(ULONG pos) const = 0;
+
+	// fraction of the rows for which the given dependency holds
+	virtual CDouble DependencyDegree(ULONG pos) const = 0;
+
+	// number of multi-column ndistinct coefficients
+	virtual ULONG NDistinctCount() const = 0;
+
+	// attnos of the columns of the given ndistinct coefficient
+	virtual const ULongPtrArray *NDistinctAttnos(ULONG pos) const = 0;
+
+	// number of distinct combinations of values of the given columns
+	virtual CDouble NDistinct(ULONG pos) const = 0;
+
+	// are there any extended statistics
+	BOOL
+	IsEmpty() const
+	{
+		return 0 == DependencyCount() && 0 == NDistinctCount();
+	}
+};
+}  // namespace gpmd
+
+#endif	// !GPMD_IMDExtStats_H
+
+// EOF
@@ -73,6 +73,7 @@ public:
 		EmdidCastFunc = 3,
 		EmdidScCmp = 4,
 		EmdidGPDBCtas = 5,
+		EmdidExtStats = 6,
 		EmdidSentinel
 	};
 
@@ -191,6 +191,39 @@ public:
 		return nullptr;
 	}
 
+	// number of foreign keys referencing other relations
+	virtual ULONG
+	ForeignKeyCount() const
+	{
+		return 0;
+	}
+
+	// relation referenced by the foreign key at the given position
+	virtual IMDId *
+	ForeignKeyRelMdidAt(ULONG) const
+	{
+		GPOS_ASSERT(!"Relation has no foreign keys");
+		return nullptr;
+	}
+
+	// positions of the referencing columns of the foreign key at the given
+	// position
+	virtual const ULongPtrArray *
+	ForeignKeyColsAt(ULONG) const
+	{
+		GPOS_ASSERT(!"Relation has no foreign keys");
+		return nullptr;
+	}
+
+	// positions of the referenced columns, in the referenced relation, of
+	// the foreign key at the given position
+	virtual const ULongPtrArray *
+	ForeignKeyRefColsAt(ULONG) const
+	{
+		GPOS_ASSERT(!"Relation has no foreign keys");
+		return nullptr;
+	}
+
 	// relation distribution policy as a string value
 	static const CWStringConst *GetDistrPolicyStr(
 		Ereldistrpolicy rel_distr_policy);
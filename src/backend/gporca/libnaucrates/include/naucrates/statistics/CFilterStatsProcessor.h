@@ -81,6 +81,19 @@ private:
 	// check if the column is a new column for statistic calculation
 	static BOOL IsNewStatsColumn(ULONG colid, ULONG last_colid);
 
+	// adjust the scaling factors of equality predicates using the
+	// functional dependencies between the filtered columns
+	static void ApplyFunctionalDependencies(
+		CMemoryPool *mp, const ULongPtrArray *scale_factor_colids,
+		CDoubleArray *scale_factors);
+
+	// can the column take part in a functional dependency
+	static BOOL IsDependencyCandidate(CColRef *colref);
+
+	// position of the given attno among the columns not implied yet
+	static ULONG FindAttnoPos(const ULongPtrArray *attnos,
+							  const CBitSet *implied, ULONG attno);
+
 public:
 	// filter
 	static CStatistics *MakeStatsFilter(CMemoryPool *mp,
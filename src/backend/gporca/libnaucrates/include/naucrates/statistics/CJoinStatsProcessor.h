@@ -53,6 +53,13 @@ protected:
 		IStatistics::EStatsJoinType join_type,
 		BOOL DoIgnoreLASJHistComputation);
 
+	// scale factor of the foreign keys covered by the join conditions
+	static CDouble ForeignKeyJoinScaleFactor(
+		CMemoryPool *mp, CColRefArray *outer_colrefs,
+		CColRefArray *inner_colrefs, const IStatistics *outer_stats,
+		const IStatistics *inner_stats,
+		CScaleFactorUtils::SJoinConditionArray *join_conds_scale_factors);
+
 public:
 	// main driver to generate join stats
 	static CStatistics *SetResultingJoinStats(
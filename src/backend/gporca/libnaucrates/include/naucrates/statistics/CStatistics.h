@@ -91,6 +91,14 @@ private:
 	// plan, operators that generate joins, selections and groups increment the risk
 	ULONG m_stats_estimation_risk;
 
+	// signature of the tables and predicates covered, see
+	// CStatisticsUtils::ApplyCardinalityFeedback
+	ULONG m_feedback_signature;
+
+	// id of the table scan these stats are derived from, see
+	// CJoinStatsProcessor::ForeignKeyJoinScaleFactor
+	ULONG m_base_scan_id;
+
 	// flag to indicate if input relation is empty
 	BOOL m_empty;
 
@@ -225,6 +233,34 @@ public:
 		m_stats_estimation_risk = risk;
 	}
 
+	// signature of the tables and predicates covered
+	ULONG
+	FeedbackSignature() const override
+	{
+		return m_feedback_signature;
+	}
+
+	// set the signature of the tables and predicates covered
+	void
+	SetFeedbackSignature(ULONG signature) override
+	{
+		m_feedback_signature = signature;
+	}
+
+	// id of the table scan these stats are derived from
+	ULONG
+	BaseScanId() const override
+	{
+		return m_base_scan_id;
+	}
+
+	// set the id of the table scan these stats are derived from
+	void
+	SetBaseScanId(ULONG scan_id) override
+	{
+		m_base_scan_id = scan_id;
+	}
+
 	// inner join with another stats structure
 	IStatistics *CalcInnerJoinStats(
 		CMemoryPool *mp, const IStatistics *other_stats,
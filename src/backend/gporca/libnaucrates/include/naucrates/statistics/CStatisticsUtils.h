@@ -30,6 +30,11 @@ namespace gpopt
 class CTableDescriptor;
 }
 
+namespace gpmd
+{
+class IMDExtStats;
+}
+
 namespace gpnaucrates
 {
 using namespace gpos;
@@ -117,6 +122,21 @@ private:
 		CMemoryPool *mp, const CStatisticsConfig *stats_config,
 		CStatistics *input_stats, const ULongPtrArray *src_grouping_cols);
 
+	// replace the NDVs of grouping columns covered by a multi-column
+	// ndistinct coefficient
+	static CDoubleArray *ApplyMultiColumnNDistinct(
+		CMemoryPool *mp, const ULongPtrArray *grouping_columns,
+		CDoubleArray *ndvs);
+
+	// signature of the tables and predicates of the expression the handle
+	// is attached to, 0 if it has none
+	static ULONG FeedbackSignature(CMemoryPool *mp,
+								   CExpressionHandle &exprhdl);
+
+	// hash of a predicate for feedback signatures, 0 if it references
+	// columns other than those of base tables
+	static ULONG FeedbackPredicateHash(CExpression *pexpr);
+
 	// check to see if any one of the grouping columns has been capped
 	static BOOL CappedGrpColExists(const CStatistics *stats,
 								   const ULongPtrArray *grouping_columns);
@@ -178,6 +198,10 @@ public:
 	static CBitSet *GetColsNonUpdatableHistForDisj(CMemoryPool *mp,
 												   CStatsPredDisj *pred_stats);
 
+	// extended statistics of the given relation, NULL if there are none
+	// or their use is disabled
+	static const IMDExtStats *GetExtStats(CMemoryPool *mp, IMDId *rel_mdid);
+
 	// helper method to add a histogram to a map
 	static void AddHistogram(CMemoryPool *mp, ULONG colid,
 							 const CHistogram *histogram,
@@ -283,6 +307,13 @@ public:
 	// true if the given operator increases risk of cardinality misestimation
 	static BOOL IncreasesRisk(CLogical *logical_op);
 
+	// tag the stats derived for the expression the handle is attached to
+	// with its feedback signature, and scale them to the row count observed
+	// in earlier executions, if there is one
+	static IStatistics *ApplyCardinalityFeedback(CMemoryPool *mp,
+												 CExpressionHandle &exprhdl,
+												 IStatistics *stats);
+
 	// return the default column width
 	static CDouble DefaultColumnWidth(const IMDType *mdtype);
 
@@ -134,6 +134,20 @@ public:
 	// update the risk of errors in cardinality estimation
 	virtual void SetStatsEstimationRisk(ULONG risk) = 0;
 
+	// signature of the tables and predicates these stats were derived
+	// from, used to look up cardinality feedback, 0 if none
+	virtual ULONG FeedbackSignature() const = 0;
+
+	// set the cardinality feedback signature
+	virtual void SetFeedbackSignature(ULONG signature) = 0;
+
+	// id of the table scan whose rows these stats describe, possibly after
+	// filters, gpos::ulong_max if they are not derived from a single scan
+	virtual ULONG BaseScanId() const = 0;
+
+	// set the id of the table scan these stats are derived from
+	virtual void SetBaseScanId(ULONG scan_id) = 0;
+
 	// look up the number of distinct values of a particular column
 	virtual CDouble GetNDVs(const CColRef *colref) = 0;
 
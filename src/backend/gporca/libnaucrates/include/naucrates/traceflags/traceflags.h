@@ -213,6 +213,9 @@ enum EOptTraceFlag
 	// Use legacy (cdbhash) opfamilies for compatibility
 	EopttraceUseLegacyOpfamilies = 103039,
 
+	// eliminate inner joins to unused relations referenced by a foreign key
+	EopttraceEnableForeignKeyJoinElimination = 103040,
+
 	///////////////////////////////////////////////////////
 	///////////////////// statistics flags ////////////////
 	//////////////////////////////////////////////////////
@@ -243,6 +246,12 @@ enum EOptTraceFlag
 
 	// Use experimental cost model
 	EopttraceExperimentalCostModel = 104009,
+
+	// do not use foreign keys in join cardinality estimation
+	EopttraceDisableForeignKeyStats = 104010,
+
+	// do not use extended statistics in cardinality estimation
+	EopttraceDisableExtendedStats = 104011,
 	///////////////////////////////////////////////////////
 	/////////// constant expression evaluator flags ///////
 	///////////////////////////////////////////////////////
@@ -0,0 +1,359 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2023 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLExtStats.cpp
+//
+//	@doc:
+//		Implementation of the class for representing extended stats in DXL
+//---------------------------------------------------------------------------
+
+
+#include "naucrates/md/CDXLExtStats.h"
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRef.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::CDXLExtStats
+//
+//	@doc:
+//		Constructs the extended stats of a relation
+//
+//---------------------------------------------------------------------------
+CDXLExtStats::CDXLExtStats(CMemoryPool *mp, CMDIdExtStats *ext_stats_mdid,
+						   CMDName *mdname, ULongPtr2dArray *dep_from_attnos,
+						   ULongPtrArray *dep_to_attnos,
+						   CDoubleArray *dep_degrees,
+						   ULongPtr2dArray *ndistinct_attnos,
+						   CDoubleArray *ndistinct_values)
+	: m_mp(mp),
+	  m_ext_stats_mdid(ext_stats_mdid),
+	  m_mdname(mdname),
+	  m_dep_from_attnos(dep_from_attnos),
+	  m_dep_to_attnos(dep_to_attnos),
+	  m_dep_degrees(dep_degrees),
+	  m_ndistinct_attnos(ndistinct_attnos),
+	  m_ndistinct_values(ndistinct_values)
+{
+	GPOS_ASSERT(ext_stats_mdid->IsValid());
+	GPOS_ASSERT(dep_from_attnos->Size() == dep_to_attnos->Size());
+	GPOS_ASSERT(dep_from_attnos->Size() == dep_degrees->Size());
+	GPOS_ASSERT(ndistinct_attnos->Size() == ndistinct_values->Size());
+
+	m_dxl_str = CDXLUtils::SerializeMDObj(
+		m_mp, this, false /*fSerializeHeader*/, false /*indentation*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::~CDXLExtStats
+//
+//	@doc:
+//		Destructor
+//
+//---------------------------------------------------------------------------
+CDXLExtStats::~CDXLExtStats()
+{
+	GPOS_DELETE(m_mdname);
+	GPOS_DELETE(m_dxl_str);
+	m_ext_stats_mdid->Release();
+	m_dep_from_attnos->Release();
+	m_dep_to_attnos->Release();
+	m_dep_degrees->Release();
+	m_ndistinct_attnos->Release();
+	m_ndistinct_values->Release();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::MDId
+//
+//	@doc:
+//		Returns the metadata id of this extended stats object
+//
+//---------------------------------------------------------------------------
+IMDId *
+CDXLExtStats::MDId() const
+{
+	return m_ext_stats_mdid;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::Mdname
+//
+//	@doc:
+//		Returns the name of this relation
+//
+//---------------------------------------------------------------------------
+CMDName
+CDXLExtStats::Mdname() const
+{
+	return *m_mdname;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::GetStrRepr
+//
+//	@doc:
+//		Returns the DXL string for this object
+//
+//---------------------------------------------------------------------------
+const CWStringDynamic *
+CDXLExtStats::GetStrRepr() const
+{
+	return m_dxl_str;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::DependencyCount
+//
+//	@doc:
+//		Returns the number of functional dependencies
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLExtStats::DependencyCount() const
+{
+	return m_dep_to_attnos->Size();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::DependencyFromAttnos
+//
+//	@doc:
+//		Returns the determining columns of the given dependency
+//
+//---------------------------------------------------------------------------
+const ULongPtrArray *
+CDXLExtStats::DependencyFromAttnos(ULONG pos) const
+{
+	return (*m_dep_from_attnos)[pos];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::DependencyToAttno
+//
+//	@doc:
+//		Returns the dependent column of the given dependency
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLExtStats::DependencyToAttno(ULONG pos) const
+{
+	return *(*m_dep_to_attnos)[pos];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::DependencyDegree
+//
+//	@doc:
+//		Returns the degree of the given dependency
+//
+//---------------------------------------------------------------------------
+CDouble
+CDXLExtStats::DependencyDegree(ULONG pos) const
+{
+	return *(*m_dep_degrees)[pos];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::NDistinctCount
+//
+//	@doc:
+//		Returns the number of ndistinct coefficients
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLExtStats::NDistinctCount() const
+{
+	return m_ndistinct_values->Size();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::NDistinctAttnos
+//
+//	@doc:
+//		Returns the columns of the given ndistinct coefficient
+//
+//---------------------------------------------------------------------------
+const ULongPtrArray *
+CDXLExtStats::NDistinctAttnos(ULONG pos) const
+{
+	return (*m_ndistinct_attnos)[pos];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::NDistinct
+//
+//	@doc:
+//		Returns the value of the given ndistinct coefficient
+//
+//---------------------------------------------------------------------------
+CDouble
+CDXLExtStats::NDistinct(ULONG pos) const
+{
+	return *(*m_ndistinct_values)[pos];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::Serialize
+//
+//	@doc:
+//		Serialize extended stats in DXL format
+//
+//---------------------------------------------------------------------------
+void
+CDXLExtStats::Serialize(CXMLSerializer *xml_serializer) const
+{
+	xml_serializer->OpenElement(
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+		CDXLTokens::GetDXLTokenStr(EdxltokenExtendedStats));
+
+	m_ext_stats_mdid->Serialize(xml_serializer,
+								CDXLTokens::GetDXLTokenStr(EdxltokenMdid));
+	xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenName),
+								 m_mdname->GetMDName());
+
+	for (ULONG ul = 0; ul < DependencyCount(); ul++)
+	{
+		xml_serializer->OpenElement(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+			CDXLTokens::GetDXLTokenStr(EdxltokenExtStatsDependency));
+
+		CWStringDynamic *from_attnos_str =
+			CDXLUtils::Serialize(m_mp, DependencyFromAttnos(ul));
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenExtStatsFromAttnos),
+			from_attnos_str);
+		GPOS_DELETE(from_attnos_str);
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenExtStatsToAttno),
+			DependencyToAttno(ul));
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenExtStatsDegree),
+			DependencyDegree(ul));
+
+		xml_serializer->CloseElement(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+			CDXLTokens::GetDXLTokenStr(EdxltokenExtStatsDependency));
+	}
+
+	for (ULONG ul = 0; ul < NDistinctCount(); ul++)
+	{
+		xml_serializer->OpenElement(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+			CDXLTokens::GetDXLTokenStr(EdxltokenExtStatsNDistinct));
+
+		CWStringDynamic *attnos_str =
+			CDXLUtils::Serialize(m_mp, NDistinctAttnos(ul));
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenColumns), attnos_str);
+		GPOS_DELETE(attnos_str);
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenValue), NDistinct(ul));
+
+		xml_serializer->CloseElement(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+			CDXLTokens::GetDXLTokenStr(EdxltokenExtStatsNDistinct));
+	}
+
+	xml_serializer->CloseElement(
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+		CDXLTokens::GetDXLTokenStr(EdxltokenExtendedStats));
+
+	GPOS_CHECK_ABORT;
+}
+
+
+
+#ifdef GPOS_DEBUG
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::DebugPrint
+//
+//	@doc:
+//		Prints the extended stats to the provided output
+//
+//---------------------------------------------------------------------------
+void
+CDXLExtStats::DebugPrint(IOstream &os) const
+{
+	os << "Extended stats id: ";
+	MDId()->OsPrint(os);
+	os << std::endl;
+
+	os << "Relation name: " << (Mdname()).GetMDName()->GetBuffer() << std::endl;
+
+	for (ULONG ul = 0; ul < DependencyCount(); ul++)
+	{
+		const ULongPtrArray *from_attnos = DependencyFromAttnos(ul);
+		os << "Dependency: (";
+		for (ULONG col = 0; col < from_attnos->Size(); col++)
+		{
+			os << (0 == col ? "" : ", ") << *(*from_attnos)[col];
+		}
+		os << ") => " << DependencyToAttno(ul)
+		   << ", degree: " << DependencyDegree(ul) << std::endl;
+	}
+
+	for (ULONG ul = 0; ul < NDistinctCount(); ul++)
+	{
+		const ULongPtrArray *attnos = NDistinctAttnos(ul);
+		os << "NDistinct: (";
+		for (ULONG col = 0; col < attnos->Size(); col++)
+		{
+			os << (0 == col ? "" : ", ") << *(*attnos)[col];
+		}
+		os << "): " << NDistinct(ul) << std::endl;
+	}
+}
+
+#endif	// GPOS_DEBUG
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtStats::CreateDXLDummyExtStats
+//
+//	@doc:
+//		Dummy extended stats, without any dependencies or ndistinct
+//		coefficients
+//
+//---------------------------------------------------------------------------
+CDXLExtStats *
+CDXLExtStats::CreateDXLDummyExtStats(CMemoryPool *mp, IMDId *mdid)
+{
+	CMDIdExtStats *ext_stats_mdid = CMDIdExtStats::CastMdid(mdid);
+	CAutoP<CWStringDynamic> str;
+	str = GPOS_NEW(mp) CWStringDynamic(mp, ext_stats_mdid->GetBuffer());
+	CAutoP<CMDName> mdname;
+	mdname = GPOS_NEW(mp) CMDName(mp, str.Value());
+	CAutoRef<CDXLExtStats> ext_stats_dxl;
+	ext_stats_dxl = GPOS_NEW(mp) CDXLExtStats(
+		mp, ext_stats_mdid, mdname.Value(), GPOS_NEW(mp) ULongPtr2dArray(mp),
+		GPOS_NEW(mp) ULongPtrArray(mp), GPOS_NEW(mp) CDoubleArray(mp),
+		GPOS_NEW(mp) ULongPtr2dArray(mp), GPOS_NEW(mp) CDoubleArray(mp));
+	mdname.Reset();
+	return ext_stats_dxl.Reset();
+}
+
+// EOF
@@ -23,6 +23,7 @@
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/exception.h"
 #include "naucrates/md/CDXLColStats.h"
+#include "naucrates/md/CDXLExtStats.h"
 #include "naucrates/md/CDXLRelStats.h"
 #include "naucrates/md/CMDTypeBoolGPDB.h"
 #include "naucrates/md/CMDTypeInt4GPDB.h"
@@ -159,8 +160,8 @@ CMDProviderMemory::GetMDObjDXLStr(CMemoryPool *mp,
 
 	if (nullptr == pstrObj)
 	{
-		// Relstats and colstats are special as they may not
-		// exist in the metadata file. Provider must return dummy objects
+		// Relstats, colstats and extended stats are special as they may
+		// not exist in the metadata file. Provider must return dummy objects
 		// in this case.
 		switch (mdid->MdidType())
 		{
@@ -174,6 +175,16 @@ CMDProviderMemory::GetMDObjDXLStr(CMemoryPool *mp,
 					false /*findent*/);
 				break;
 			}
+			case IMDId::EmdidExtStats:
+			{
+				mdid->AddRef();
+				CAutoRef<CDXLExtStats> a_pdxlextstats;
+				a_pdxlextstats = CDXLExtStats::CreateDXLDummyExtStats(mp, mdid);
+				a_pstrResult = CDXLUtils::SerializeMDObj(
+					mp, a_pdxlextstats.Value(), true /*fSerializeHeaders*/,
+					false /*findent*/);
+				break;
+			}
 			case IMDId::EmdidColStats:
 			{
 				CAutoP<CWStringDynamic> a_pstr;
@@ -38,7 +38,8 @@ CMDRelationGPDB::CMDRelationGPDB(
 	IMdIdArray *partition_oids, BOOL convert_hash_to_random,
 	ULongPtr2dArray *keyset_array, CMDIndexInfoArray *md_index_info_array,
 	IMdIdArray *mdid_triggers_array, IMdIdArray *mdid_check_constraint_array,
-	CDXLNode *mdpart_constraint, BOOL has_oids)
+	CDXLNode *mdpart_constraint, BOOL has_oids, IMdIdArray *fk_rel_mdid_array,
+	ULongPtr2dArray *fk_cols_array, ULongPtr2dArray *fk_ref_cols_array)
 	: m_mp(mp),
 	  m_mdid(mdid),
 	  m_mdname(mdname),
@@ -55,6 +56,9 @@ CMDRelationGPDB::CMDRelationGPDB(
 	  m_num_of_partitions(num_of_partitions),
 	  m_partition_oids(partition_oids),
 	  m_keyset_array(keyset_array),
+	  m_fk_rel_mdid_array(fk_rel_mdid_array),
+	  m_fk_cols_array(fk_cols_array),
+	  m_fk_ref_cols_array(fk_ref_cols_array),
 	  m_mdindex_info_array(md_index_info_array),
 	  m_mdid_trigger_array(mdid_triggers_array),
 	  m_mdid_check_constraint_array(mdid_check_constraint_array),
@@ -76,6 +80,10 @@ CMDRelationGPDB::CMDRelationGPDB(
 			"Converting hash distributed table to random only possible for hash distributed tables");
 	GPOS_ASSERT(nullptr == distr_opfamilies ||
 				distr_opfamilies->Size() == m_distr_col_array->Size());
+	GPOS_ASSERT_IMP(nullptr != fk_rel_mdid_array,
+					nullptr != fk_cols_array && nullptr != fk_ref_cols_array &&
+						fk_rel_mdid_array->Size() == fk_cols_array->Size() &&
+						fk_rel_mdid_array->Size() == fk_ref_cols_array->Size());
 
 	m_colpos_nondrop_colpos_map = GPOS_NEW(m_mp) UlongToUlongMap(m_mp);
 	m_attrno_nondrop_col_pos_map = GPOS_NEW(m_mp) IntToUlongMap(m_mp);
@@ -138,6 +146,9 @@ CMDRelationGPDB::~CMDRelationGPDB()
 	CRefCount::SafeRelease(m_partition_cols_array);
 	CRefCount::SafeRelease(m_str_part_types_array);
 	CRefCount::SafeRelease(m_keyset_array);
+	CRefCount::SafeRelease(m_fk_rel_mdid_array);
+	CRefCount::SafeRelease(m_fk_cols_array);
+	CRefCount::SafeRelease(m_fk_ref_cols_array);
 	m_mdindex_info_array->Release();
 	m_mdid_trigger_array->Release();
 	m_mdid_check_constraint_array->Release();
@@ -685,6 +696,39 @@ CMDRelationGPDB::Serialize(CXMLSerializer *xml_serializer) const
 		GPOS_DELETE(keyset_str_array);
 	}
 
+	// serialize foreign keys
+	if (0 < ForeignKeyCount())
+	{
+		CWStringDynamic *fk_rels_str = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
+		const ULONG num_fks = m_fk_rel_mdid_array->Size();
+		for (ULONG ul = 0; ul < num_fks; ul++)
+		{
+			if (0 < ul)
+			{
+				fk_rels_str->Append(
+					CDXLTokens::GetDXLTokenStr(EdxltokenComma));
+			}
+			fk_rels_str->AppendFormat(GPOS_WSZ_LIT("%ls"),
+									  (*m_fk_rel_mdid_array)[ul]->GetBuffer());
+		}
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenForeignKeyRels), fk_rels_str);
+		GPOS_DELETE(fk_rels_str);
+
+		CWStringDynamic *fk_cols_str =
+			CDXLUtils::Serialize(m_mp, m_fk_cols_array);
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenForeignKeyCols), fk_cols_str);
+		GPOS_DELETE(fk_cols_str);
+
+		CWStringDynamic *fk_ref_cols_str =
+			CDXLUtils::Serialize(m_mp, m_fk_ref_cols_array);
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenForeignKeyRefCols),
+			fk_ref_cols_str);
+		GPOS_DELETE(fk_ref_cols_str);
+	}
+
 	if (IsPartitioned())
 	{
 		// Fall back, instead of segfaulting when m_partition_oids is NULL
@@ -813,6 +857,71 @@ CMDRelationGPDB::ChildPartitionMdids() const
 	return m_partition_oids;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDRelationGPDB::ForeignKeyCount
+//
+//	@doc:
+//		Returns the number of foreign keys of this relation
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDRelationGPDB::ForeignKeyCount() const
+{
+	return (nullptr == m_fk_rel_mdid_array) ? 0 : m_fk_rel_mdid_array->Size();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDRelationGPDB::ForeignKeyRelMdidAt
+//
+//	@doc:
+//		Returns the id of the relation referenced by the foreign key at the
+//		specified position
+//
+//---------------------------------------------------------------------------
+IMDId *
+CMDRelationGPDB::ForeignKeyRelMdidAt(ULONG pos) const
+{
+	GPOS_ASSERT(pos < ForeignKeyCount());
+
+	return (*m_fk_rel_mdid_array)[pos];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDRelationGPDB::ForeignKeyColsAt
+//
+//	@doc:
+//		Returns the positions of the referencing columns of the foreign key
+//		at the specified position
+//
+//---------------------------------------------------------------------------
+const ULongPtrArray *
+CMDRelationGPDB::ForeignKeyColsAt(ULONG pos) const
+{
+	GPOS_ASSERT(pos < ForeignKeyCount());
+
+	return (*m_fk_cols_array)[pos];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDRelationGPDB::ForeignKeyRefColsAt
+//
+//	@doc:
+//		Returns the positions of the referenced columns of the foreign key at
+//		the specified position
+//
+//---------------------------------------------------------------------------
+const ULongPtrArray *
+CMDRelationGPDB::ForeignKeyRefColsAt(ULONG pos) const
+{
+	GPOS_ASSERT(pos < ForeignKeyCount());
+
+	return (*m_fk_ref_cols_array)[pos];
+}
+
 #ifdef GPOS_DEBUG
 //---------------------------------------------------------------------------
 //	@function:
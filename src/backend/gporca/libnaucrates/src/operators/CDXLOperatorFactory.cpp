@@ -66,6 +66,7 @@
 #include "naucrates/exception.h"
 #include "naucrates/md/CMDIdCast.h"
 #include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdExtStats.h"
 #include "naucrates/md/CMDIdGPDB.h"
 #include "naucrates/md/CMDIdGPDBCtas.h"
 #include "naucrates/md/CMDIdRelStats.h"
@@ -2248,6 +2249,11 @@ CDXLOperatorFactory::MakeMdIdFromStr(CDXLMemoryManager *dxl_memory_manager,
 								   target_attr, target_elem);
 			break;
 
+		case IMDId::EmdidExtStats:
+			mdid = GetExtStatsMdId(dxl_memory_manager, remaining_tokens,
+								   target_attr, target_elem);
+			break;
+
 		case IMDId::EmdidCastFunc:
 			mdid = GetCastFuncMdId(dxl_memory_manager, remaining_tokens,
 								   target_attr, target_elem);
@@ -2374,6 +2380,30 @@ CDXLOperatorFactory::GetRelStatsMdId(CDXLMemoryManager *dxl_memory_manager,
 	return GPOS_NEW(dxl_memory_manager->Pmp()) CMDIdRelStats(rel_mdid);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLOperatorFactory::GetExtStatsMdId
+//
+//	@doc:
+//		Construct an extended stats mdid from an array of XML string
+//		components.
+//
+//---------------------------------------------------------------------------
+CMDIdExtStats *
+CDXLOperatorFactory::GetExtStatsMdId(CDXLMemoryManager *dxl_memory_manager,
+									 XMLChArray *remaining_tokens,
+									 Edxltoken target_attr,
+									 Edxltoken target_elem)
+{
+	GPOS_ASSERT(GPDXL_GPDB_MDID_COMPONENTS == remaining_tokens->Size());
+
+	CMDIdGPDB *rel_mdid = GetGPDBMdId(dxl_memory_manager, remaining_tokens,
+									  target_attr, target_elem);
+
+	// construct metadata id object
+	return GPOS_NEW(dxl_memory_manager->Pmp()) CMDIdExtStats(rel_mdid);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLOperatorFactory::GetCastFuncMdId
@@ -36,7 +36,8 @@ CDXLTableDescr::CDXLTableDescr(CMemoryPool *mp, IMDId *mdid, CMDName *mdname,
 	  m_mdname(mdname),
 	  m_dxl_column_descr_array(nullptr),
 	  m_execute_as_user_id(ulExecuteAsUser),
-	  m_lockmode(lockmode)
+	  m_lockmode(lockmode),
+	  m_partition_mdids(nullptr)
 {
 	GPOS_ASSERT(nullptr != m_mdname);
 	m_dxl_column_descr_array = GPOS_NEW(mp) CDXLColDescrArray(mp);
@@ -56,6 +57,7 @@ CDXLTableDescr::~CDXLTableDescr()
 	m_mdid->Release();
 	GPOS_DELETE(m_mdname);
 	CRefCount::SafeRelease(m_dxl_column_descr_array);
+	CRefCount::SafeRelease(m_partition_mdids);
 }
 
 
@@ -123,6 +125,35 @@ CDXLTableDescr::LockMode() const
 	return m_lockmode;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLTableDescr::GetPartitionMdids
+//
+//	@doc:
+//		Partitions left after static pruning, NULL if no pruning was done
+//
+//---------------------------------------------------------------------------
+IMdIdArray *
+CDXLTableDescr::GetPartitionMdids() const
+{
+	return m_partition_mdids;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLTableDescr::SetPartitionMdids
+//
+//	@doc:
+//		Restrict the partitions to be considered to the given list
+//
+//---------------------------------------------------------------------------
+void
+CDXLTableDescr::SetPartitionMdids(IMdIdArray *partition_mdids)
+{
+	CRefCount::SafeRelease(m_partition_mdids);
+	m_partition_mdids = partition_mdids;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLTableDescr::SetColumnDescriptors
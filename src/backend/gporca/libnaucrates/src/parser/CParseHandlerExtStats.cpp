@@ -0,0 +1,173 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2023 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CParseHandlerExtStats.cpp
+//
+//	@doc:
+//		Implementation of the SAX parse handler class for parsing extended
+//		statistics.
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/parser/CParseHandlerExtStats.h"
+
+#include "naucrates/dxl/operators/CDXLOperatorFactory.h"
+#include "naucrates/dxl/parser/CParseHandlerFactory.h"
+#include "naucrates/dxl/parser/CParseHandlerManager.h"
+#include "naucrates/md/CDXLExtStats.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+using namespace gpnaucrates;
+
+XERCES_CPP_NAMESPACE_USE
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerExtStats::CParseHandlerExtStats
+//
+//	@doc:
+//		Constructor
+//
+//---------------------------------------------------------------------------
+CParseHandlerExtStats::CParseHandlerExtStats(
+	CMemoryPool *mp, CParseHandlerManager *parse_handler_mgr,
+	CParseHandlerBase *parse_handler_root)
+	: CParseHandlerMetadataObject(mp, parse_handler_mgr, parse_handler_root),
+	  m_mdid(nullptr),
+	  m_mdname(nullptr),
+	  m_dep_from_attnos(nullptr),
+	  m_dep_to_attnos(nullptr),
+	  m_dep_degrees(nullptr),
+	  m_ndistinct_attnos(nullptr),
+	  m_ndistinct_values(nullptr)
+{
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerExtStats::StartElement
+//
+//	@doc:
+//		Invoked by Xerces to process an opening tag
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerExtStats::StartElement(const XMLCh *const,	 // element_uri,
+									const XMLCh *const element_local_name,
+									const XMLCh *const,	 // element_qname,
+									const Attributes &attrs)
+{
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenExtendedStats),
+				 element_local_name))
+	{
+		// parse table name
+		const XMLCh *xml_str_table_name = CDXLOperatorFactory::ExtractAttrValue(
+			attrs, EdxltokenName, EdxltokenExtendedStats);
+
+		CWStringDynamic *str_table_name =
+			CDXLUtils::CreateDynamicStringFromXMLChArray(
+				m_parse_handler_mgr->GetDXLMemoryManager(), xml_str_table_name);
+
+		// create a copy of the string in the CMDName constructor
+		m_mdname = GPOS_NEW(m_mp) CMDName(m_mp, str_table_name);
+
+		GPOS_DELETE(str_table_name);
+
+		// parse metadata id info
+		m_mdid = CDXLOperatorFactory::ExtractConvertAttrValueToMdId(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs, EdxltokenMdid,
+			EdxltokenExtendedStats);
+
+		m_dep_from_attnos = GPOS_NEW(m_mp) ULongPtr2dArray(m_mp);
+		m_dep_to_attnos = GPOS_NEW(m_mp) ULongPtrArray(m_mp);
+		m_dep_degrees = GPOS_NEW(m_mp) CDoubleArray(m_mp);
+		m_ndistinct_attnos = GPOS_NEW(m_mp) ULongPtr2dArray(m_mp);
+		m_ndistinct_values = GPOS_NEW(m_mp) CDoubleArray(m_mp);
+	}
+	else if (0 == XMLString::compareString(
+					  CDXLTokens::XmlstrToken(EdxltokenExtStatsDependency),
+					  element_local_name))
+	{
+		GPOS_ASSERT(nullptr != m_dep_from_attnos);
+
+		m_dep_from_attnos->Append(
+			CDXLOperatorFactory::ExtractConvertValuesToArray(
+				m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+				EdxltokenExtStatsFromAttnos, EdxltokenExtStatsDependency));
+		m_dep_to_attnos->Append(GPOS_NEW(m_mp) ULONG(
+			CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
+				m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+				EdxltokenExtStatsToAttno, EdxltokenExtStatsDependency)));
+		m_dep_degrees->Append(GPOS_NEW(m_mp) CDouble(
+			CDXLOperatorFactory::ExtractConvertAttrValueToDouble(
+				m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+				EdxltokenExtStatsDegree, EdxltokenExtStatsDependency)));
+	}
+	else if (0 == XMLString::compareString(
+					  CDXLTokens::XmlstrToken(EdxltokenExtStatsNDistinct),
+					  element_local_name))
+	{
+		GPOS_ASSERT(nullptr != m_ndistinct_attnos);
+
+		m_ndistinct_attnos->Append(
+			CDXLOperatorFactory::ExtractConvertValuesToArray(
+				m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+				EdxltokenColumns, EdxltokenExtStatsNDistinct));
+		m_ndistinct_values->Append(GPOS_NEW(m_mp) CDouble(
+			CDXLOperatorFactory::ExtractConvertAttrValueToDouble(
+				m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+				EdxltokenValue, EdxltokenExtStatsNDistinct)));
+	}
+	else
+	{
+		CWStringDynamic *str = CDXLUtils::CreateDynamicStringFromXMLChArray(
+			m_parse_handler_mgr->GetDXLMemoryManager(), element_local_name);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag,
+				   str->GetBuffer());
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerExtStats::EndElement
+//
+//	@doc:
+//		Invoked by Xerces to process a closing tag
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerExtStats::EndElement(const XMLCh *const,  // element_uri,
+								  const XMLCh *const element_local_name,
+								  const XMLCh *const  // element_qname
+)
+{
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenExtendedStats),
+				 element_local_name))
+	{
+		m_imd_obj = GPOS_NEW(m_mp) CDXLExtStats(
+			m_mp, CMDIdExtStats::CastMdid(m_mdid), m_mdname, m_dep_from_attnos,
+			m_dep_to_attnos, m_dep_degrees, m_ndistinct_attnos,
+			m_ndistinct_values);
+
+		// deactivate handler
+		m_parse_handler_mgr->DeactivateHandler();
+	}
+	else if (0 != XMLString::compareString(
+					  CDXLTokens::XmlstrToken(EdxltokenExtStatsDependency),
+					  element_local_name) &&
+			 0 != XMLString::compareString(
+					  CDXLTokens::XmlstrToken(EdxltokenExtStatsNDistinct),
+					  element_local_name))
+	{
+		CWStringDynamic *str = CDXLUtils::CreateDynamicStringFromXMLChArray(
+			m_parse_handler_mgr->GetDXLMemoryManager(), element_local_name);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag,
+				   str->GetBuffer());
+	}
+}
+
+// EOF
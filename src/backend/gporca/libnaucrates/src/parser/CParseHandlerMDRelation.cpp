@@ -49,6 +49,9 @@ CParseHandlerMDRelation::CParseHandlerMDRelation(
 	  m_str_part_types_array(nullptr),
 	  m_num_of_partitions(0),
 	  m_key_sets_arrays(nullptr),
+	  m_fk_rel_mdid_array(nullptr),
+	  m_fk_cols_array(nullptr),
+	  m_fk_ref_cols_array(nullptr),
 	  m_part_constraint(nullptr),
 	  m_opfamilies_parse_handler(nullptr),
 	  m_child_partitions_parse_handler(nullptr)
@@ -197,6 +200,28 @@ CParseHandlerMDRelation::StartElement(const XMLCh *const element_uri,
 			EdxltokenRelation);
 	}
 
+	// parse foreign keys
+	const XMLCh *xmlszFkRels =
+		attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenForeignKeyRels));
+	if (nullptr != xmlszFkRels)
+	{
+		CDXLMemoryManager *dxl_memory_manager =
+			m_parse_handler_mgr->GetDXLMemoryManager();
+		m_fk_rel_mdid_array = CDXLOperatorFactory::ExtractConvertMdIdsToArray(
+			dxl_memory_manager, xmlszFkRels, EdxltokenForeignKeyRels,
+			EdxltokenRelation);
+		m_fk_cols_array = CDXLOperatorFactory::ExtractConvertUlongTo2DArray(
+			dxl_memory_manager,
+			CDXLOperatorFactory::ExtractAttrValue(
+				attrs, EdxltokenForeignKeyCols, EdxltokenRelation),
+			EdxltokenForeignKeyCols, EdxltokenRelation);
+		m_fk_ref_cols_array = CDXLOperatorFactory::ExtractConvertUlongTo2DArray(
+			dxl_memory_manager,
+			CDXLOperatorFactory::ExtractAttrValue(
+				attrs, EdxltokenForeignKeyRefCols, EdxltokenRelation),
+			EdxltokenForeignKeyRefCols, EdxltokenRelation);
+	}
+
 	// parse children
 	ParseChildNodes();
 }
@@ -288,7 +313,8 @@ CParseHandlerMDRelation::EndElement(const XMLCh *const,	 // element_uri,
 		m_partition_cols_array, m_str_part_types_array, m_num_of_partitions,
 		child_partitions, m_convert_hash_to_random, m_key_sets_arrays,
 		md_index_info_array, mdid_triggers_array, mdid_check_constraint_array,
-		m_part_constraint, m_has_oids);
+		m_part_constraint, m_has_oids, m_fk_rel_mdid_array, m_fk_cols_array,
+		m_fk_ref_cols_array);
 
 	// deactivate handler
 	m_parse_handler_mgr->DeactivateHandler();
@@ -11,11 +11,13 @@
 
 #include "naucrates/statistics/CFilterStatsProcessor.h"
 
+#include "gpopt/base/CColRefTable.h"
 #include "gpopt/base/COptCtxt.h"
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/operators/CScalarCmp.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
+#include "naucrates/md/IMDExtStats.h"
 #include "naucrates/statistics/CBucket.h"
 #include "naucrates/statistics/CJoinStatsProcessor.h"
 #include "naucrates/statistics/CScaleFactorUtils.h"
@@ -251,6 +253,8 @@ CFilterStatsProcessor::MakeStatsFilter(CMemoryPool *mp,
 		CStatistics(mp, histograms_new, input_stats->CopyWidths(mp),
 					rows_filter, input_stats->IsEmpty(),
 					input_stats->GetNumberOfPredicates() + num_predicates);
+	// filtering keeps the rows a subset of the scan they came from
+	filter_stats->SetBaseScanId(input_stats->BaseScanId());
 
 	// since the filter operation is reductive, we choose the bounding method that takes
 	// the minimum of the cardinality upper bound of the source column (in the input hash map)
@@ -312,6 +316,10 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 	CBitSet *filter_colids = GPOS_NEW(mp) CBitSet(mp);
 	CDoubleArray *scale_factors = GPOS_NEW(mp) CDoubleArray(mp);
 
+	// column of each scaling factor, if the factor comes only from equality
+	// predicates on that column, gpos::ulong_max otherwise
+	ULongPtrArray *scale_factor_colids = GPOS_NEW(mp) ULongPtrArray(mp);
+
 	// create copy of the original hash map of colid -> histogram
 	UlongToHistogramMap *result_histograms =
 		CStatisticsUtils::CopyHistHashMap(mp, input_histograms);
@@ -319,6 +327,7 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 	// properties of last seen column
 	CDouble last_scale_factor(1.0);
 	ULONG last_colid = gpos::ulong_max;
+	BOOL last_col_is_eq = true;
 
 	// iterate over filters and update corresponding histograms
 	const ULONG filters = conjunctive_pred_stats->GetNumPreds();
@@ -339,6 +348,7 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 				CStatsPredUnsupported::ConvertPredStats(child_pred_stats);
 			scale_factors->Append(
 				GPOS_NEW(mp) CDouble(unsupported_pred_stats->ScaleFactor()));
+			scale_factor_colids->Append(GPOS_NEW(mp) ULONG(gpos::ulong_max));
 
 			continue;
 		}
@@ -348,7 +358,10 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 		if (IsNewStatsColumn(colid, last_colid))
 		{
 			scale_factors->Append(GPOS_NEW(mp) CDouble(last_scale_factor));
+			scale_factor_colids->Append(GPOS_NEW(mp) ULONG(
+				last_col_is_eq ? last_colid : gpos::ulong_max));
 			last_scale_factor = CDouble(1.0);
+			last_col_is_eq = true;
 		}
 
 		if (CStatsPred::EsptDisj != child_pred_stats->GetPredStatsType())
@@ -365,6 +378,13 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 
 			GPOS_ASSERT(nullptr != result_histogram);
 
+			last_col_is_eq =
+				last_col_is_eq &&
+				CStatsPred::EsptPoint == child_pred_stats->GetPredStatsType() &&
+				CStatsPred::EstatscmptEq ==
+					CStatsPredPoint::ConvertPredStats(child_pred_stats)
+						->GetCmpType();
+
 			CHistogram *input_histogram = input_histograms->Find(&colid);
 			GPOS_ASSERT(nullptr != input_histogram);
 			if (input_histogram->IsEmpty())
@@ -432,14 +452,18 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 			}
 
 			last_colid = colid;
+			last_col_is_eq = false;
 			disjunctive_input_histograms->Release();
 		}
 	}
 
 	// scaling factor of the last predicate
 	scale_factors->Append(GPOS_NEW(mp) CDouble(last_scale_factor));
+	scale_factor_colids->Append(
+		GPOS_NEW(mp) ULONG(last_col_is_eq ? last_colid : gpos::ulong_max));
 
 	GPOS_ASSERT(nullptr != scale_factors);
+	ApplyFunctionalDependencies(mp, scale_factor_colids, scale_factors);
 	CScaleFactorUtils::SortScalingFactor(scale_factors, true /* fDescending */);
 
 	*scale_factor = CScaleFactorUtils::CalcScaleFactorCumulativeConj(
@@ -447,11 +471,175 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 
 	// clean up
 	scale_factors->Release();
+	scale_factor_colids->Release();
 	filter_colids->Release();
 
 	return result_histograms;
 }
 
+// adjust the scaling factors of equality predicates on columns of the same
+// table using the functional dependencies of that table. As in the Postgres
+// planner, the selectivity of the dependent column becomes
+// (degree + (1 - degree) * selectivity). The adjusted factors are folded
+// into a single factor so that they are not damped as independent columns.
+void
+CFilterStatsProcessor::ApplyFunctionalDependencies(
+	CMemoryPool *mp, const ULongPtrArray *scale_factor_colids,
+	CDoubleArray *scale_factors)
+{
+	GPOS_ASSERT(scale_factor_colids->Size() == scale_factors->Size());
+
+	CColumnFactory *col_factory = COptCtxt::PoctxtFromTLS()->Pcf();
+	const ULONG size = scale_factor_colids->Size();
+	CBitSet *processed = GPOS_NEW(mp) CBitSet(mp);
+
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		ULONG colid = *(*scale_factor_colids)[ul];
+		if (gpos::ulong_max == colid || processed->Get(ul))
+		{
+			continue;
+		}
+
+		CColRef *colref = col_factory->LookupColRef(colid);
+		if (!IsDependencyCandidate(colref))
+		{
+			continue;
+		}
+		IMDId *rel_mdid = colref->GetMdidTable();
+
+		// positions and attnos of the equality columns of this table
+		ULongPtrArray *positions = GPOS_NEW(mp) ULongPtrArray(mp);
+		ULongPtrArray *attnos = GPOS_NEW(mp) ULongPtrArray(mp);
+		for (ULONG ulPos = ul; ulPos < size; ulPos++)
+		{
+			ULONG other_colid = *(*scale_factor_colids)[ulPos];
+			if (gpos::ulong_max == other_colid || processed->Get(ulPos))
+			{
+				continue;
+			}
+			CColRef *other_colref = col_factory->LookupColRef(other_colid);
+			if (!IsDependencyCandidate(other_colref) ||
+				other_colref->GetMdidTable() != rel_mdid)
+			{
+				continue;
+			}
+			processed->ExchangeSet(ulPos);
+			positions->Append(GPOS_NEW(mp) ULONG(ulPos));
+			attnos->Append(GPOS_NEW(mp) ULONG(
+				CColRefTable::PcrConvert(other_colref)->AttrNum()));
+		}
+
+		const IMDExtStats *ext_stats =
+			(1 < positions->Size())
+				? CStatisticsUtils::GetExtStats(mp, rel_mdid)
+				: nullptr;
+		if (nullptr != ext_stats)
+		{
+			// positions whose column has been implied by a dependency
+			CBitSet *implied = GPOS_NEW(mp) CBitSet(mp);
+			CDouble combined_scale_factor(1.0);
+			while (true)
+			{
+				// strongest dependency among the remaining columns
+				ULONG best_dep = gpos::ulong_max;
+				ULONG best_to_pos = gpos::ulong_max;
+				CDouble best_degree(0.0);
+				for (ULONG ulDep = 0; ulDep < ext_stats->DependencyCount();
+					 ulDep++)
+				{
+					ULONG to_pos = FindAttnoPos(
+						attnos, implied, ext_stats->DependencyToAttno(ulDep));
+					if (gpos::ulong_max == to_pos ||
+						ext_stats->DependencyDegree(ulDep) <= best_degree)
+					{
+						continue;
+					}
+
+					const ULongPtrArray *from_attnos =
+						ext_stats->DependencyFromAttnos(ulDep);
+					BOOL applicable = true;
+					for (ULONG ulFrom = 0;
+						 applicable && ulFrom < from_attnos->Size(); ulFrom++)
+					{
+						applicable = gpos::ulong_max !=
+									 FindAttnoPos(attnos, implied,
+												  *(*from_attnos)[ulFrom]);
+					}
+
+					if (applicable)
+					{
+						best_dep = ulDep;
+						best_to_pos = to_pos;
+						best_degree = ext_stats->DependencyDegree(ulDep);
+					}
+				}
+
+				if (gpos::ulong_max == best_dep)
+				{
+					break;
+				}
+
+				CDouble *to_scale_factor =
+					(*scale_factors)[*(*positions)[best_to_pos]];
+				CDouble selectivity =
+					best_degree +
+					(CDouble(1.0) - best_degree) / *to_scale_factor;
+				combined_scale_factor =
+					combined_scale_factor / std::max(selectivity.Get(),
+													 CStatistics::Epsilon.Get());
+				*to_scale_factor = CDouble(1.0);
+				implied->ExchangeSet(best_to_pos);
+			}
+
+			// fold the dependent columns into one of the determining columns
+			for (ULONG ulPos = 0; ulPos < positions->Size(); ulPos++)
+			{
+				if (!implied->Get(ulPos))
+				{
+					CDouble *from_scale_factor =
+						(*scale_factors)[*(*positions)[ulPos]];
+					*from_scale_factor =
+						*from_scale_factor * combined_scale_factor;
+					break;
+				}
+			}
+			implied->Release();
+		}
+
+		positions->Release();
+		attnos->Release();
+	}
+
+	processed->Release();
+}
+
+// is the column a user column of a base table, whose table can have
+// functional dependencies
+BOOL
+CFilterStatsProcessor::IsDependencyCandidate(CColRef *colref)
+{
+	return nullptr != colref && CColRef::EcrtTable == colref->Ecrt() &&
+		   !colref->IsSystemCol() && nullptr != colref->GetMdidTable();
+}
+
+// position of the given attno among the columns not implied yet, or
+// gpos::ulong_max if there is none
+ULONG
+CFilterStatsProcessor::FindAttnoPos(const ULongPtrArray *attnos,
+									const CBitSet *implied, ULONG attno)
+{
+	for (ULONG ul = 0; ul < attnos->Size(); ul++)
+	{
+		if (attno == *(*attnos)[ul] && !implied->Get(ul))
+		{
+			return ul;
+		}
+	}
+
+	return gpos::ulong_max;
+}
+
 // create new hash map of histograms after applying disjunctive predicates
 UlongToHistogramMap *
 CFilterStatsProcessor::MakeHistHashMapDisjFilter(
@@ -11,16 +11,20 @@
 
 #include "naucrates/statistics/CJoinStatsProcessor.h"
 
+#include "gpopt/base/CColRefTable.h"
 #include "gpopt/base/COptCtxt.h"
 #include "gpopt/operators/CLogicalIndexApply.h"
 #include "gpopt/operators/CLogicalNAryJoin.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/operators/CScalarNAryJoinPredList.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDRelStats.h"
 #include "naucrates/statistics/CFilterStatsProcessor.h"
 #include "naucrates/statistics/CLeftAntiSemiJoinStatsProcessor.h"
 #include "naucrates/statistics/CScaleFactorUtils.h"
 #include "naucrates/statistics/CStatisticsUtils.h"
+#include "naucrates/traceflags/traceflags.h"
 
 using namespace gpopt;
 
@@ -252,6 +256,213 @@ CJoinStatsProcessor::CalcAllJoinStats(CMemoryPool *mp,
 }
 
 
+// return the join conditions that equate all columns of the given foreign key
+// of the referencing table with the referenced columns, or NULL if the join
+// conditions do not cover the foreign key. All the columns must come from the
+// same scans of the two tables: in a self join, the instances of a table share
+// the table mdid, but each is produced by a different Get operator
+static CBitSet *
+ForeignKeyJoinConds(CMemoryPool *mp, const IMDRelation *fk_rel,
+					const IMDRelation *ref_rel, ULONG fk_pos, ULONG fk_scan_id,
+					ULONG ref_scan_id, CColRefArray *fk_colrefs,
+					CColRefArray *ref_colrefs, CBitSet *covered_conds)
+{
+	const ULongPtrArray *fk_cols = fk_rel->ForeignKeyColsAt(fk_pos);
+	const ULongPtrArray *ref_cols = fk_rel->ForeignKeyRefColsAt(fk_pos);
+	CBitSet *fk_conds = GPOS_NEW(mp) CBitSet(mp);
+
+	for (ULONG col = 0; col < fk_cols->Size(); col++)
+	{
+		BOOL found = false;
+		for (ULONG ul = 0; !found && ul < fk_colrefs->Size(); ul++)
+		{
+			if (nullptr == (*fk_colrefs)[ul] || covered_conds->Get(ul))
+			{
+				continue;
+			}
+
+			CColRefTable *fk_colref =
+				CColRefTable::PcrConvert((*fk_colrefs)[ul]);
+			CColRefTable *ref_colref =
+				CColRefTable::PcrConvert((*ref_colrefs)[ul]);
+			if (fk_colref->UlSourceOpId() != fk_scan_id ||
+				ref_colref->UlSourceOpId() != ref_scan_id)
+			{
+				continue;
+			}
+
+			ULONG fk_col_pos = fk_rel->GetPosFromAttno(fk_colref->AttrNum());
+			ULONG ref_col_pos =
+				ref_rel->GetPosFromAttno(ref_colref->AttrNum());
+			if (*(*fk_cols)[col] == fk_col_pos &&
+				*(*ref_cols)[col] == ref_col_pos)
+			{
+				(void) fk_conds->ExchangeSet(ul);
+				found = true;
+			}
+		}
+
+		if (!found)
+		{
+			fk_conds->Release();
+			return nullptr;
+		}
+	}
+
+	return fk_conds;
+}
+
+// does the given set of column positions include one of the keys of the
+// relation, so that a combination of values identifies at most one row
+static BOOL
+ColumnsIncludeKey(const IMDRelation *rel, const ULongPtrArray *cols)
+{
+	const ULONG num_keys = rel->KeySetCount();
+	for (ULONG key_pos = 0; key_pos < num_keys; key_pos++)
+	{
+		const ULongPtrArray *key = rel->KeySetAt(key_pos);
+		BOOL included = true;
+		for (ULONG ul = 0; included && ul < key->Size(); ul++)
+		{
+			included = false;
+			for (ULONG col = 0; !included && col < cols->Size(); col++)
+			{
+				included = (*(*key)[ul] == *(*cols)[col]);
+			}
+		}
+
+		if (included)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Find the foreign keys between the joined tables that are covered by the
+// equality join conditions. Every row of the referencing table matches exactly
+// one row of the referenced table, so such a join preserves the cardinality of
+// the referencing side, reduced by the fraction of the referenced table that
+// qualifies below the join. This holds regardless of the histograms of the
+// join columns, which cannot capture the correlation of filters on the
+// referenced table.
+//
+// The referenced side must be a scan of the referenced table, possibly
+// filtered, so that its rows are a subset of the table, and the referenced
+// columns must include a key of the table, so that they match at most one row.
+// Otherwise, e.g. if the referenced side is an aggregate or a join that
+// duplicates rows, fall back to the histograms.
+//
+// Return the product of the row counts of the referenced tables, and set the
+// scale factors of the covered conditions to 1 so that they are not counted
+// twice. Conditions that are not equalities between columns of two base tables
+// have NULL entries in the colref arrays.
+CDouble
+CJoinStatsProcessor::ForeignKeyJoinScaleFactor(
+	CMemoryPool *mp, CColRefArray *outer_colrefs, CColRefArray *inner_colrefs,
+	const IStatistics *outer_stats, const IStatistics *inner_stats,
+	CScaleFactorUtils::SJoinConditionArray *join_conds_scale_factors)
+{
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+	const ULONG num_join_conds = join_conds_scale_factors->Size();
+	CBitSet *covered_conds = GPOS_NEW(mp) CBitSet(mp);
+	CDouble fk_scale_factor(1.0);
+
+	for (ULONG ul = 0; ul < num_join_conds; ul++)
+	{
+		if (nullptr == (*outer_colrefs)[ul] || covered_conds->Get(ul))
+		{
+			continue;
+		}
+
+		// the referencing table can be on either side of the join
+		BOOL found = false;
+		for (ULONG side = 0; !found && side < 2; side++)
+		{
+			BOOL fk_on_outer = (0 == side);
+			CColRefArray *fk_colrefs =
+				fk_on_outer ? outer_colrefs : inner_colrefs;
+			CColRefArray *ref_colrefs =
+				fk_on_outer ? inner_colrefs : outer_colrefs;
+			const IStatistics *ref_stats =
+				fk_on_outer ? inner_stats : outer_stats;
+			CColRefTable *fk_colref =
+				CColRefTable::PcrConvert((*fk_colrefs)[ul]);
+			CColRefTable *ref_colref =
+				CColRefTable::PcrConvert((*ref_colrefs)[ul]);
+			if (ref_stats->BaseScanId() != ref_colref->UlSourceOpId())
+			{
+				continue;
+			}
+
+			IMDId *ref_mdid = ref_colref->GetMdidTable();
+			const IMDRelation *fk_rel =
+				md_accessor->RetrieveRel(fk_colref->GetMdidTable());
+			const ULONG num_fks = fk_rel->ForeignKeyCount();
+			for (ULONG fk_pos = 0; !found && fk_pos < num_fks; fk_pos++)
+			{
+				if (!fk_rel->ForeignKeyRelMdidAt(fk_pos)->Equals(ref_mdid))
+				{
+					continue;
+				}
+
+				const IMDRelation *ref_rel =
+					md_accessor->RetrieveRel(ref_mdid);
+				if (!ColumnsIncludeKey(ref_rel,
+									   fk_rel->ForeignKeyRefColsAt(fk_pos)))
+				{
+					continue;
+				}
+
+				CBitSet *fk_conds = ForeignKeyJoinConds(
+					mp, fk_rel, ref_rel, fk_pos, fk_colref->UlSourceOpId(),
+					ref_colref->UlSourceOpId(), fk_colrefs, ref_colrefs,
+					covered_conds);
+				if (nullptr == fk_conds)
+				{
+					continue;
+				}
+
+				ref_mdid->AddRef();
+				CMDIdRelStats *rel_stats_mdid = GPOS_NEW(mp)
+					CMDIdRelStats(CMDIdGPDB::CastMdid(ref_mdid));
+				const IMDRelStats *rel_stats =
+					md_accessor->Pmdrelstats(rel_stats_mdid);
+				rel_stats_mdid->Release();
+
+				// without statistics on the referenced table, fall back to
+				// the histograms
+				if (!rel_stats->IsEmpty())
+				{
+					for (ULONG cond = 0; cond < num_join_conds; cond++)
+					{
+						if (fk_conds->Get(cond))
+						{
+							(*join_conds_scale_factors)[cond]->m_scale_factor =
+								CDouble(1.0);
+						}
+					}
+					(void) covered_conds->Union(fk_conds);
+
+					// the scan of the referenced table estimates at least one
+					// row, see CMDAccessor::Pstats
+					fk_scale_factor =
+						fk_scale_factor *
+						std::max(DOUBLE(1.0), rel_stats->Rows().Get());
+					found = true;
+				}
+				fk_conds->Release();
+			}
+		}
+	}
+
+	covered_conds->Release();
+
+	return fk_scale_factor;
+}
+
+
 // main driver to generate join stats
 CStatistics *
 CJoinStatsProcessor::SetResultingJoinStats(
@@ -313,6 +524,11 @@ CJoinStatsProcessor::SetResultingJoinStats(
 		GPOS_NEW(mp) CScaleFactorUtils::SJoinConditionArray(mp);
 	const ULONG num_join_conds = join_pred_stats_info->Size();
 
+	// columns of the equality conditions between two base tables, used to
+	// find the foreign keys covered by the join
+	CColRefArray *outer_colrefs = GPOS_NEW(mp) CColRefArray(mp);
+	CColRefArray *inner_colrefs = GPOS_NEW(mp) CColRefArray(mp);
+
 	BOOL output_is_empty = false;
 	CDouble num_join_rows = 0;
 	// iterate over join's predicate(s)
@@ -415,11 +631,33 @@ CJoinStatsProcessor::SetResultingJoinStats(
 			}
 		}
 
+		BOOL is_fk_candidate =
+			nullptr != mdid_pair &&
+			CStatsPred::EstatscmptEq == pred_info->GetCmpType() &&
+			pred_info->HasValidColIdOuter() &&
+			pred_info->HasValidColIdInner() &&
+			CColRef::EcrtTable == colref_outer->Ecrt() &&
+			CColRef::EcrtTable == colref_inner->Ecrt() &&
+			!colref_outer->IsSystemCol() && !colref_inner->IsSystemCol();
+		outer_colrefs->Append(is_fk_candidate ? colref_outer : nullptr);
+		inner_colrefs->Append(is_fk_candidate ? colref_inner : nullptr);
+
 		join_conds_scale_factors->Append(
 			GPOS_NEW(mp) CScaleFactorUtils::SJoinCondition(
 				local_scale_factor, mdid_pair, both_dist_keys));
 	}
 
+	CDouble fk_scale_factor(1.0);
+	if (IStatistics::EsjtInnerJoin == join_type &&
+		!GPOS_FTRACE(EopttraceDisableForeignKeyStats))
+	{
+		fk_scale_factor = ForeignKeyJoinScaleFactor(
+			mp, outer_colrefs, inner_colrefs, outer_stats, inner_side_stats,
+			join_conds_scale_factors);
+	}
+	outer_colrefs->Release();
+	inner_colrefs->Release();
+
 
 	num_join_rows = CStatistics::MinRows;
 	if (!output_is_empty)
@@ -427,6 +665,8 @@ CJoinStatsProcessor::SetResultingJoinStats(
 		num_join_rows = CalcJoinCardinality(
 			mp, stats_config, outer_stats->Rows(), inner_side_stats->Rows(),
 			join_conds_scale_factors, join_type);
+		num_join_rows = std::max(CStatistics::MinRows.Get(),
+								 (num_join_rows / fk_scale_factor).Get());
 	}
 
 	// clean up
@@ -65,6 +65,8 @@ CStatistics::CStatistics(CMemoryPool *mp,
 	  m_colid_width_mapping(colid_width_mapping),
 	  m_rows(rows),
 	  m_stats_estimation_risk(no_card_est_risk_default_val),
+	  m_feedback_signature(0),
+	  m_base_scan_id(gpos::ulong_max),
 	  m_empty(is_empty),
 	  m_relpages(0),
 	  m_relallvisible(0),
@@ -92,6 +94,8 @@ CStatistics::CStatistics(CMemoryPool *mp,
 	  m_colid_width_mapping(colid_width_mapping),
 	  m_rows(rows),
 	  m_stats_estimation_risk(no_card_est_risk_default_val),
+	  m_feedback_signature(0),
+	  m_base_scan_id(gpos::ulong_max),
 	  m_empty(is_empty),
 	  m_relpages(relpages),
 	  m_relallvisible(relallvisible),
@@ -551,7 +555,11 @@ CStatistics::AppendStats(CMemoryPool *mp, IStatistics *input_stats)
 IStatistics *
 CStatistics::CopyStats(CMemoryPool *mp) const
 {
-	return ScaleStats(mp, CDouble(1.0) /*factor*/);
+	IStatistics *stats_copy = ScaleStats(mp, CDouble(1.0) /*factor*/);
+	stats_copy->SetFeedbackSignature(m_feedback_signature);
+	stats_copy->SetBaseScanId(m_base_scan_id);
+
+	return stats_copy;
 }
 
 // return a copy of this statistics object scaled by a given factor
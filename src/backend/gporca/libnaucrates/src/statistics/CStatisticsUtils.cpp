@@ -23,15 +23,21 @@
 #include "gpopt/mdcache/CMDAccessor.h"
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CExpressionUtils.h"
+#include "gpopt/operators/CLogicalDynamicGet.h"
 #include "gpopt/operators/CLogicalDynamicIndexGet.h"
+#include "gpopt/operators/CLogicalGet.h"
 #include "gpopt/operators/CLogicalIndexGet.h"
+#include "gpopt/operators/CLogicalNAryJoin.h"
 #include "gpopt/operators/CPredicateUtils.h"
+#include "gpopt/operators/CScalarIdent.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "naucrates/base/IDatumInt2.h"
 #include "naucrates/base/IDatumInt4.h"
 #include "naucrates/base/IDatumInt8.h"
 #include "naucrates/base/IDatumOid.h"
 #include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdExtStats.h"
+#include "naucrates/md/IMDExtStats.h"
 #include "naucrates/md/IMDScalarOp.h"
 #include "naucrates/md/IMDType.h"
 #include "naucrates/md/IMDTypeInt2.h"
@@ -47,6 +53,7 @@
 #include "naucrates/statistics/CStatsPredDisj.h"
 #include "naucrates/statistics/CStatsPredLike.h"
 #include "naucrates/statistics/CStatsPredUtils.h"
+#include "naucrates/traceflags/traceflags.h"
 
 using namespace gpopt;
 using namespace gpmd;
@@ -1488,6 +1495,7 @@ CStatisticsUtils::MaxNumGroupsForGivenSrcGprCols(
 
 	CDoubleArray *ndvs = GPOS_NEW(mp) CDoubleArray(mp);
 	AddNdvForAllGrpCols(mp, input_stats, src_grouping_cols, ndvs);
+	ndvs = ApplyMultiColumnNDistinct(mp, src_grouping_cols, ndvs);
 
 	// take the minimum of (a) the estimated number of groups from the columns of this source,
 	// (b) input rows, and (c) cardinality upper bound for the given source in the
@@ -1506,6 +1514,142 @@ CStatisticsUtils::MaxNumGroupsForGivenSrcGprCols(
 	return groups;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::ApplyMultiColumnNDistinct
+//
+//	@doc:
+//		Replace the NDVs of the grouping columns covered by the largest
+//		multi-column ndistinct coefficient of their table with that
+//		coefficient. The coefficient is computed on the whole table, so it
+//		is capped by the product of the NDVs it replaces. Takes ownership of
+//		the given array and returns the array to use instead.
+//---------------------------------------------------------------------------
+CDoubleArray *
+CStatisticsUtils::ApplyMultiColumnNDistinct(
+	CMemoryPool *mp, const ULongPtrArray *grouping_columns, CDoubleArray *ndvs)
+{
+	GPOS_ASSERT(grouping_columns->Size() == ndvs->Size());
+
+	const ULONG num_cols = grouping_columns->Size();
+	if (2 > num_cols)
+	{
+		return ndvs;
+	}
+
+	// collect the attnos of the grouping columns, all from the same table
+	CColumnFactory *col_factory = COptCtxt::PoctxtFromTLS()->Pcf();
+	IMDId *rel_mdid = nullptr;
+	ULongPtrArray *attnos = GPOS_NEW(mp) ULongPtrArray(mp);
+	for (ULONG ul = 0; ul < num_cols; ul++)
+	{
+		CColRef *colref = col_factory->LookupColRef(*(*grouping_columns)[ul]);
+		if (CColRef::EcrtTable != colref->Ecrt() || colref->IsSystemCol() ||
+			nullptr == colref->GetMdidTable() ||
+			(nullptr != rel_mdid && rel_mdid != colref->GetMdidTable()))
+		{
+			attnos->Release();
+			return ndvs;
+		}
+		rel_mdid = colref->GetMdidTable();
+		attnos->Append(
+			GPOS_NEW(mp) ULONG(CColRefTable::PcrConvert(colref)->AttrNum()));
+	}
+
+	const IMDExtStats *ext_stats = GetExtStats(mp, rel_mdid);
+	if (nullptr == ext_stats)
+	{
+		attnos->Release();
+		return ndvs;
+	}
+
+	// find the coefficient covering the most grouping columns
+	ULONG best_pos = gpos::ulong_max;
+	ULONG best_size = 1;
+	for (ULONG ul = 0; ul < ext_stats->NDistinctCount(); ul++)
+	{
+		const ULongPtrArray *item_attnos = ext_stats->NDistinctAttnos(ul);
+		if (item_attnos->Size() <= best_size)
+		{
+			continue;
+		}
+
+		BOOL is_covered = true;
+		for (ULONG ulItem = 0; is_covered && ulItem < item_attnos->Size();
+			 ulItem++)
+		{
+			is_covered = nullptr != attnos->Find((*item_attnos)[ulItem]);
+		}
+
+		if (is_covered)
+		{
+			best_pos = ul;
+			best_size = item_attnos->Size();
+		}
+	}
+
+	if (gpos::ulong_max == best_pos)
+	{
+		attnos->Release();
+		return ndvs;
+	}
+
+	const ULongPtrArray *item_attnos = ext_stats->NDistinctAttnos(best_pos);
+	CDoubleArray *result_ndvs = GPOS_NEW(mp) CDoubleArray(mp);
+	CDouble covered_ndvs(1.0);
+	for (ULONG ul = 0; ul < num_cols; ul++)
+	{
+		if (nullptr != item_attnos->Find((*attnos)[ul]))
+		{
+			covered_ndvs = covered_ndvs * *(*ndvs)[ul];
+		}
+		else
+		{
+			result_ndvs->Append(GPOS_NEW(mp) CDouble(*(*ndvs)[ul]));
+		}
+	}
+	result_ndvs->Append(GPOS_NEW(mp) CDouble(
+		std::min(ext_stats->NDistinct(best_pos).Get(), covered_ndvs.Get())));
+
+	attnos->Release();
+	ndvs->Release();
+
+	return result_ndvs;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::GetExtStats
+//
+//	@doc:
+//		Return the extended statistics of the given relation, or NULL if
+//		there are none or their use is disabled
+//---------------------------------------------------------------------------
+const IMDExtStats *
+CStatisticsUtils::GetExtStats(CMemoryPool *mp, IMDId *rel_mdid)
+{
+	GPOS_ASSERT(nullptr != rel_mdid);
+
+	if (GPOS_FTRACE(EopttraceDisableExtendedStats))
+	{
+		return nullptr;
+	}
+
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+	rel_mdid->AddRef();
+	CMDIdExtStats *ext_stats_mdid =
+		GPOS_NEW(mp) CMDIdExtStats(CMDIdGPDB::CastMdid(rel_mdid));
+	const IMDExtStats *ext_stats = md_accessor->Pmdextstats(ext_stats_mdid);
+	ext_stats_mdid->Release();
+
+	if (ext_stats->IsEmpty())
+	{
+		return nullptr;
+	}
+
+	return ext_stats;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CStatisticsUtils::Groups
@@ -1776,6 +1920,193 @@ CStatisticsUtils::IncreasesRisk(CLogical *logical_op)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::ApplyCardinalityFeedback
+//
+//	@doc:
+//		Tag the stats of a Get, Select or inner join with the signature of
+//		the tables and predicates it covers. The translator passes it on to
+//		the plan, and EXPLAIN ANALYZE records the actual row count under it
+//		(see gp_enable_query_feedback). If a row count was recorded for the
+//		signature, use it instead of the estimate.
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CStatisticsUtils::ApplyCardinalityFeedback(CMemoryPool *mp,
+										   CExpressionHandle &exprhdl,
+										   IStatistics *stats)
+{
+	GPOS_ASSERT(nullptr != stats);
+
+	const CStatisticsConfig *stats_config =
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetStatsConf();
+	if (!stats_config->FFeedback())
+	{
+		return stats;
+	}
+
+	// stats shared with a child, e.g. of a Select with a subquery, must
+	// keep the signature of the child
+	ULONG signature = FeedbackSignature(mp, exprhdl);
+	if (0 == signature || 1 < stats->RefCount())
+	{
+		return stats;
+	}
+
+	// a Get has no predicates to correct, its signature only serves to
+	// build those of the expressions above it
+	COperator::EOperatorId op_id = exprhdl.Pop()->Eopid();
+	const CDouble *feedback_rows = stats_config->PdFeedbackRows(signature);
+	if (nullptr != feedback_rows && COperator::EopLogicalGet != op_id &&
+		COperator::EopLogicalDynamicGet != op_id && !stats->IsEmpty() &&
+		CDouble(0.0) < stats->Rows())
+	{
+		CDouble rows =
+			std::max(CStatistics::MinRows.Get(), feedback_rows->Get());
+		IStatistics *corrected_stats =
+			stats->ScaleStats(mp, rows / stats->Rows());
+		corrected_stats->SetStatsEstimationRisk(stats->StatsEstimationRisk());
+		stats->Release();
+		stats = corrected_stats;
+	}
+
+	stats->SetFeedbackSignature(signature);
+
+	return stats;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::FeedbackSignature
+//
+//	@doc:
+//		Sum of the hashes of the base tables and of the conjuncts of the
+//		predicates an expression covers. Sums do not depend on the order of
+//		joins, nor on where a conjunct was placed. Expressions other than
+//		Gets, Selects and inner joins, and those with subqueries or outer
+//		references, whose cardinality depends on the context, get none.
+//
+//---------------------------------------------------------------------------
+ULONG
+CStatisticsUtils::FeedbackSignature(CMemoryPool *mp, CExpressionHandle &exprhdl)
+{
+	COperator *pop = exprhdl.Pop();
+	switch (pop->Eopid())
+	{
+		case COperator::EopLogicalGet:
+			return CLogicalGet::PopConvert(pop)->Ptabdesc()->MDId()->HashValue();
+
+		case COperator::EopLogicalDynamicGet:
+			return CLogicalDynamicGet::PopConvert(pop)
+				->Ptabdesc()
+				->MDId()
+				->HashValue();
+
+		case COperator::EopLogicalNAryJoin:
+			if (CLogicalNAryJoin::PopConvert(pop)->HasOuterJoinChildren())
+			{
+				return 0;
+			}
+			break;
+
+		case COperator::EopLogicalSelect:
+		case COperator::EopLogicalInnerJoin:
+			break;
+
+		default:
+			return 0;
+	}
+
+	if (exprhdl.HasOuterRefs())
+	{
+		return 0;
+	}
+
+	const ULONG arity = exprhdl.Arity();
+	const ULONG scalar_child = arity - 1;
+	ULONG signature = 0;
+	for (ULONG ul = 0; ul < scalar_child; ul++)
+	{
+		ULONG child_signature = exprhdl.Pstats(ul)->FeedbackSignature();
+		if (0 == child_signature)
+		{
+			return 0;
+		}
+		signature += child_signature;
+	}
+
+	if (exprhdl.DeriveHasSubquery(scalar_child))
+	{
+		return 0;
+	}
+
+	CExpressionArray *conjuncts = CPredicateUtils::PdrgpexprConjuncts(
+		mp, exprhdl.PexprScalarRepChild(scalar_child));
+	const ULONG size = conjuncts->Size();
+	for (ULONG ul = 0; ul < size && 0 != signature; ul++)
+	{
+		CExpression *conjunct = (*conjuncts)[ul];
+		if (CUtils::FScalarConstTrue(conjunct))
+		{
+			continue;
+		}
+
+		ULONG hash = FeedbackPredicateHash(conjunct);
+		signature = (0 == hash) ? 0 : signature + hash;
+	}
+	conjuncts->Release();
+
+	return signature;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::FeedbackPredicateHash
+//
+//	@doc:
+//		Hash of a scalar expression that is stable across queries: column
+//		references are hashed by table and attribute number rather than by
+//		column id
+//
+//---------------------------------------------------------------------------
+ULONG
+CStatisticsUtils::FeedbackPredicateHash(CExpression *pexpr)
+{
+	COperator *pop = pexpr->Pop();
+	if (COperator::EopScalarIdent == pop->Eopid())
+	{
+		const CColRef *colref = CScalarIdent::PopConvert(pop)->Pcr();
+		if (CColRef::EcrtTable != colref->Ecrt() ||
+			nullptr == colref->GetMdidTable())
+		{
+			return 0;
+		}
+
+		INT attno = CColRefTable::PcrConvert(const_cast<CColRef *>(colref))
+						->AttrNum();
+		return gpos::CombineHashes(colref->GetMdidTable()->HashValue(),
+								   gpos::HashValue<INT>(&attno));
+	}
+
+	ULONG hash = pop->HashValue();
+	const ULONG arity = pexpr->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		ULONG child_hash = FeedbackPredicateHash((*pexpr)[ul]);
+		if (0 == child_hash)
+		{
+			return 0;
+		}
+		hash = gpos::CombineHashes(hash, child_hash);
+	}
+
+	return hash;
+}
+
+
 //---------------------------------------------------------------------------
 //     @function:
 //             CStatisticsUtils::DefaultColumnWidth
@@ -494,6 +494,12 @@ CDXLTokens::Init(CMemoryPool *mp)
 		{EdxltokenRelationStats, GPOS_WSZ_LIT("RelationStatistics")},
 		{EdxltokenColumnStats, GPOS_WSZ_LIT("ColumnStatistics")},
 		{EdxltokenColumnStatsBucket, GPOS_WSZ_LIT("StatsBucket")},
+		{EdxltokenExtendedStats, GPOS_WSZ_LIT("ExtendedStatistics")},
+		{EdxltokenExtStatsDependency, GPOS_WSZ_LIT("FunctionalDependency")},
+		{EdxltokenExtStatsNDistinct, GPOS_WSZ_LIT("NDistinct")},
+		{EdxltokenExtStatsFromAttnos, GPOS_WSZ_LIT("FromAttnos")},
+		{EdxltokenExtStatsToAttno, GPOS_WSZ_LIT("ToAttno")},
+		{EdxltokenExtStatsDegree, GPOS_WSZ_LIT("Degree")},
 		{EdxltokenEmptyRelation, GPOS_WSZ_LIT("EmptyRelation")},
 
 		{EdxltokenIsNull, GPOS_WSZ_LIT("IsNull")},
@@ -534,6 +540,10 @@ CDXLTokens::Init(CMemoryPool *mp)
 		{EdxltokenExtRelFmtErrRel, GPOS_WSZ_LIT("FormatErrorRelId")},
 
 		{EdxltokenKeys, GPOS_WSZ_LIT("Keys")},
+		{EdxltokenForeignKeyRels, GPOS_WSZ_LIT("ForeignKeyRelations")},
+		{EdxltokenForeignKeyCols, GPOS_WSZ_LIT("ForeignKeyColumns")},
+		{EdxltokenForeignKeyRefCols,
+		 GPOS_WSZ_LIT("ForeignKeyReferencedColumns")},
 		{EdxltokenDistrColumns, GPOS_WSZ_LIT("DistributionColumns")},
 
 		{EdxltokenPartKeys, GPOS_WSZ_LIT("PartitionColumns")},
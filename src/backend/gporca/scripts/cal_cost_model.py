@@ -0,0 +1,488 @@
+#!/usr/bin/env python3
+
+# Optimizer cost model calibration
+#
+# The unit costs of the GPDB cost model (libgpdbcost/src/CCostModelParamsGPDB.cpp)
+# were measured on one particular hardware setup. This program measures them on
+# the cluster it connects to, and prints a profile that can be loaded with the
+# optimizer_cost_model_params GUC.
+#
+# It runs a suite of micro-queries, each of which exercises one operator: hash
+# join, hash aggregate, sort, and redistribute, broadcast and gather motions.
+# Each query is run at two input sizes with EXPLAIN ANALYZE, and the difference
+# in the operator's own time (excluding its children) is compared to the
+# difference in the operator's own estimated cost. The same is done for a
+# sequential scan, which serves as the reference: the unit costs of each
+# operator are scaled so that the ratio of its cost to the cost of the scan
+# matches the ratio of the measured times. The table scan cost unit itself is
+# left unchanged, which keeps the absolute cost values comparable to the
+# defaults, e.g. for optimizer_cost_threshold.
+#
+# Since the estimated cost of an operator may depend on more than the unit
+# costs that are being fitted, the fit is repeated with the new profile in
+# effect until it converges.
+#
+# The cluster should be otherwise idle while this runs. The resulting profile
+# can be installed with, for example:
+#
+#   gpconfig -c optimizer_cost_model_params -v "'<profile>'" --masteronly
+#
+# or written to a file with --output, and included in postgresql.conf.
+#
+# Run this program with the -h or --help option to see argument syntax
+
+import argparse
+import json
+import sys
+
+try:
+    from gppylib.db import dbconn
+except ImportError as e:
+    sys.exit('ERROR: Cannot import modules.  Please check that you have sourced greenplum_path.sh.  Detail: ' + str(e))
+
+# constants
+# -----------------------------------------------------------------------------
+
+_help = """
+Calibrate the optimizer cost model on this cluster. Optionally create the tables
+before running, and drop them afterwards. Prints a value for the
+optimizer_cost_model_params GUC.
+"""
+
+# default values of the fitted parameters, as in CCostModelParamsGPDB.cpp. The
+# calibration starts from these, and a profile only lists the parameters that
+# differ from them. tests/test_cal_cost_model.py checks that they are in sync.
+DEFAULT_PARAMS = {
+    "TableScanCostUnit": 5.50e-07,
+    "GatherSendCostUnit": 4.58e-06,
+    "GatherRecvCostUnit": 2.20e-06,
+    "RedistributeSendCostUnit": 2.33e-06,
+    "RedistributeRecvCostUnit": 8.0e-07,
+    "BroadcastSendCostUnit": 4.965e-05,
+    "BroadcastRecvCostUnit": 1.35e-06,
+    "JoinFeedingTupColumnCostUnit": 8.69e-05,
+    "JoinFeedingTupWidthCostUnit": 6.09e-07,
+    "JoinOutputTupCostUnit": 3.50e-06,
+    "HJHashTableColumnCostUnit": 5.0e-05,
+    "HJHashTableWidthCostUnit": 3.0e-06,
+    "HJHashingTupWidthCostUnit": 1.97e-05,
+    "HashAggInputTupColumnCostUnit": 1.20e-04,
+    "HashAggInputTupWidthCostUnit": 1.12e-07,
+    "HashAggOutputTupWidthCostUnit": 5.61e-07,
+    "SortTupWidthCostUnit": 5.67e-06,
+}
+
+# the reference probe, whose parameters are not changed
+REFERENCE_PROBE = "scan"
+
+# fit is done when all scale factors are within this distance of 1. Repeated
+# runs of the same probe typically vary by a few percent, so refining the fit
+# below that only chases noise.
+DEFAULT_TOLERANCE = 0.05
+
+# global variables that may be modified
+# -----------------------------------------------------------------------------
+
+glob_verbose = False
+glob_log_file = None
+
+# SQL statements, DDL and DML
+# -----------------------------------------------------------------------------
+
+_drop_tables = """
+DROP TABLE IF EXISTS cal_costtest, cal_costtest_small;
+"""
+
+_create_tables = ["""
+CREATE TABLE cal_costtest(id int, dkey int, grp int, pad text) DISTRIBUTED BY (id);
+""", """
+CREATE TABLE cal_costtest_small(id int, dkey int, grp int, pad text) DISTRIBUTED BY (id);
+"""]
+
+# insert into the tables. Parameters:
+# - number of rows of the large table
+_insert_into_tables = ["""
+INSERT INTO cal_costtest
+SELECT x, (x * 7919) %% %(rows)d, x %% 1000, repeat('x', 40)
+FROM generate_series(1, %(rows)d) x;
+""", """
+INSERT INTO cal_costtest_small SELECT * FROM cal_costtest WHERE id %% 5 = 0;
+"""]
+
+_analyze_tables = """
+ANALYZE cal_costtest; ANALYZE cal_costtest_small;
+"""
+
+# The probes. Each one is run in a "small" and a "large" variant, which only
+# differ in the number of rows that reach the probed operator, so that fixed
+# costs such as hash table or scan initialization cancel out.
+#
+# - name
+# - settings that force the plan shape
+# - query of the small and of the large variant
+# - predicate on an EXPLAIN (FORMAT JSON) node, to find the probed operator
+# - parameters whose values are fitted with this probe
+PROBES = [
+    ("scan",
+     [],
+     "SELECT count(*) FROM cal_costtest_small",
+     "SELECT count(*) FROM cal_costtest",
+     lambda n: n["Node Type"] == "Seq Scan",
+     ["TableScanCostUnit"]),
+    ("hash_join",
+     ["SET optimizer_enable_hashjoin = on",
+      "SET optimizer_enable_mergejoin = off"],
+     "SELECT count(*) FROM cal_costtest t1 JOIN cal_costtest t2 ON t1.id = t2.id WHERE t1.id % 10 < 2 AND t2.id % 10 < 2",
+     "SELECT count(*) FROM cal_costtest t1 JOIN cal_costtest t2 ON t1.id = t2.id",
+     lambda n: n["Node Type"] == "Hash Join",
+     ["JoinFeedingTupColumnCostUnit", "JoinFeedingTupWidthCostUnit", "JoinOutputTupCostUnit",
+      "HJHashTableColumnCostUnit", "HJHashTableWidthCostUnit", "HJHashingTupWidthCostUnit"]),
+    ("hash_agg",
+     ["SET optimizer_enable_hashagg = on",
+      "SET optimizer_enable_groupagg = off"],
+     "SELECT count(*) FROM (SELECT id, count(*) FROM cal_costtest WHERE id % 10 < 2 GROUP BY id) s",
+     "SELECT count(*) FROM (SELECT id, count(*) FROM cal_costtest GROUP BY id) s",
+     lambda n: n["Node Type"] == "Aggregate" and n.get("Strategy") == "Hashed",
+     ["HashAggInputTupColumnCostUnit", "HashAggInputTupWidthCostUnit", "HashAggOutputTupWidthCostUnit"]),
+    ("sort",
+     ["SET optimizer_enable_sort = on"],
+     "SELECT count(*) FROM (SELECT dkey FROM cal_costtest WHERE id % 10 < 2 ORDER BY dkey LIMIT 1000000000) s",
+     "SELECT count(*) FROM (SELECT dkey FROM cal_costtest ORDER BY dkey LIMIT 1000000000) s",
+     lambda n: n["Node Type"] == "Sort",
+     ["SortTupWidthCostUnit"]),
+    ("redistribute",
+     ["SET optimizer_enable_motion_broadcast = off",
+      "SET optimizer_enable_hashjoin = on"],
+     "SELECT count(*) FROM cal_costtest t1 JOIN cal_costtest t2 ON t1.id = t2.dkey WHERE t2.id % 10 < 2",
+     "SELECT count(*) FROM cal_costtest t1 JOIN cal_costtest t2 ON t1.id = t2.dkey",
+     lambda n: n["Node Type"] == "Redistribute Motion",
+     ["RedistributeSendCostUnit", "RedistributeRecvCostUnit"]),
+    ("broadcast",
+     ["SET optimizer_enable_motion_redistribute = off",
+      "SET optimizer_enable_hashjoin = on"],
+     "SELECT count(*) FROM cal_costtest t1 JOIN cal_costtest t2 ON t1.id = t2.dkey WHERE t2.id % 100 < 1",
+     "SELECT count(*) FROM cal_costtest t1 JOIN cal_costtest t2 ON t1.id = t2.dkey WHERE t2.id % 100 < 5",
+     lambda n: n["Node Type"] == "Broadcast Motion",
+     ["BroadcastSendCostUnit", "BroadcastRecvCostUnit"]),
+    ("gather",
+     [],
+     "SELECT count(*) FROM (SELECT id FROM cal_costtest WHERE id % 10 < 2 LIMIT 1000000000) s",
+     "SELECT count(*) FROM (SELECT id FROM cal_costtest LIMIT 1000000000) s",
+     lambda n: n["Node Type"] == "Gather Motion" and "Plans" in n,
+     ["GatherSendCostUnit", "GatherRecvCostUnit"]),
+]
+
+
+# deal with command line arguments
+# -----------------------------------------------------------------------------
+
+def parseargs():
+    parser = argparse.ArgumentParser(description=_help)
+
+    parser.add_argument("--create", action="store_true",
+                        help="Create the tables to use in the calibration")
+    parser.add_argument("--drop", action="store_true",
+                        help="Drop the tables used in the calibration when finished")
+    parser.add_argument("--execute", type=int, default="3",
+                        help="Number of times to execute each query, the median time is used (default is 3)")
+    parser.add_argument("--iterations", type=int, default="5",
+                        help="Maximum number of refinements of the fit (default is 5)")
+    parser.add_argument("--tolerance", type=float, default=DEFAULT_TOLERANCE,
+                        help="Stop refining the fit when all scale factors are within this distance of 1 (default is %.2f)" % DEFAULT_TOLERANCE)
+    parser.add_argument("--output", default="",
+                        help="Write the profile to this file, in postgresql.conf syntax")
+    parser.add_argument("--verbose", action="store_true",
+                        help="Print more verbose output")
+    parser.add_argument("--logFile", default="",
+                        help="Log diagnostic output to a file")
+    parser.add_argument("--host", default="",
+                        help="Host to connect to (default is localhost or $PGHOST, if set).")
+    parser.add_argument("--port", type=int, default="0",
+                        help="Port on the host to connect to (default is 0 or $PGPORT, if set)")
+    parser.add_argument("--dbName", default="",
+                        help="Database name to connect to")
+    parser.add_argument("--numRows", type=int, default="10000000",
+                        help="Number of rows to INSERT INTO the large table (default is 10 million)")
+
+    args = parser.parse_args()
+    return args, parser
+
+
+def log_output(str):
+    if glob_verbose:
+        print(str)
+    if glob_log_file != None:
+        glob_log_file.write(str + "\n")
+
+
+# SQL related methods
+# -----------------------------------------------------------------------------
+
+def connect(host, port_num, db_name):
+    try:
+        dburl = dbconn.DbURL(hostname=host, port=port_num, dbname=db_name)
+        conn = dbconn.connect(dburl, encoding="UTF8", unsetSearchPath=False)
+
+    except Exception as e:
+        print(("Exception during connect: %s" % e))
+        quit()
+
+    return conn
+
+
+def execute_sql(conn, sqlStr):
+    log_output("")
+    log_output("Executing query: %s" % sqlStr)
+    dbconn.execSQL(conn, sqlStr)
+
+
+def execute_sql_arr(conn, sqlStrArr):
+    for sqlStr in sqlStrArr:
+        execute_sql(conn, sqlStr)
+
+
+def commit_db(conn):
+    execute_sql(conn, "commit")
+
+
+# Run EXPLAIN with the given options and return the top plan node, as a dict
+def explain_json(conn, sqlStr, analyze):
+    options = "ANALYZE, FORMAT JSON" if analyze else "FORMAT JSON"
+    log_output("")
+    log_output("Executing query: EXPLAIN (%s) %s" % (options, sqlStr))
+    curs = dbconn.query(conn, "EXPLAIN (%s) %s" % (options, sqlStr))
+    rows = curs.fetchall()
+    text = "\n".join(row[0] for row in rows)
+    log_output(text)
+    return json.loads(text)[0]["Plan"]
+
+
+# plan tree methods
+# -----------------------------------------------------------------------------
+
+def find_node(plan, predicate):
+    if predicate(plan):
+        return plan
+    for child in plan.get("Plans", []):
+        found = find_node(child, predicate)
+        if found is not None:
+            return found
+    return None
+
+
+# The children whose work is not part of the given node. A Hash node only
+# builds the hash table of its parent Hash Join, so its work is attributed to
+# the join.
+def input_nodes(node):
+    inputs = []
+    for child in node.get("Plans", []):
+        if child["Node Type"] == "Hash":
+            inputs.extend(input_nodes(child))
+        else:
+            inputs.append(child)
+    return inputs
+
+
+# The estimated cost, or the actual time, of a node excluding its inputs
+def own_value(node, key):
+    return node[key] - sum(child[key] for child in input_nodes(node))
+
+
+def own_cost(node):
+    return own_value(node, "Total Cost")
+
+
+def own_time(node):
+    return own_value(node, "Actual Total Time")
+
+
+# fitting
+# -----------------------------------------------------------------------------
+
+# The factor by which to scale the unit costs of a probe: the probe's time per
+# unit of cost, relative to that of the reference probe.
+def scale_factor(probe_time, probe_cost, ref_time, ref_cost):
+    if probe_cost <= 0 or ref_time <= 0 or probe_time <= 0:
+        return None
+    return (probe_time / probe_cost) / (ref_time / ref_cost)
+
+
+def apply_scale_factors(params, probe_params, factors):
+    new_params = dict(params)
+    for name, factor in factors.items():
+        if factor is None:
+            continue
+        for param in probe_params[name]:
+            new_params[param] = params[param] * factor
+    return new_params
+
+
+def converged(factors, tolerance):
+    return all(f is None or abs(f - 1.0) <= tolerance for f in factors.values())
+
+
+def format_profile(params):
+    return ",".join("%s=%.6g" % (name, params[name])
+                    for name in DEFAULT_PARAMS if params[name] != DEFAULT_PARAMS[name])
+
+
+# the calibration
+# -----------------------------------------------------------------------------
+
+def set_profile(conn, params):
+    execute_sql(conn, "SET optimizer_cost_model_params = '%s'" % format_profile(params))
+
+
+def run_with_settings(conn, settings, fn):
+    execute_sql_arr(conn, settings)
+    try:
+        return fn()
+    finally:
+        execute_sql(conn, "RESET ALL")
+        execute_sql(conn, "SET optimizer = on")
+
+
+def find_probe_node(conn, probe, sqlStr, analyze):
+    (name, settings, small_sql, large_sql, predicate, params) = probe
+    node = find_node(explain_json(conn, sqlStr, analyze), predicate)
+    if node is None:
+        raise Exception("probe %s: query did not produce the expected plan: %s" % (name, sqlStr))
+    return node
+
+
+# Measure the difference in the own time of the probed node between the small
+# and the large variant, taking the median of several executions
+def measure_probe_time(conn, probe, execute_n_times):
+    (name, settings, small_sql, large_sql, predicate, params) = probe
+
+    def measure():
+        diffs = []
+        for i in range(execute_n_times):
+            small = own_time(find_probe_node(conn, probe, small_sql, True))
+            large = own_time(find_probe_node(conn, probe, large_sql, True))
+            diffs.append(large - small)
+        diffs.sort()
+        return diffs[len(diffs) // 2]
+
+    return run_with_settings(conn, settings, measure)
+
+
+def estimate_probe_cost(conn, probe, params):
+    (name, settings, small_sql, large_sql, predicate, probe_params) = probe
+
+    def estimate():
+        set_profile(conn, params)
+        small = own_cost(find_probe_node(conn, probe, small_sql, False))
+        large = own_cost(find_probe_node(conn, probe, large_sql, False))
+        return large - small
+
+    return run_with_settings(conn, settings, estimate)
+
+
+# The measurements behind a profile, one line per probe, to keep along with it
+def format_report(times, costs, factors):
+    lines = ["%-12s %14s %14s %14s" % ("probe", "time (ms)", "cost", "scale factor")]
+    for probe in PROBES:
+        name = probe[0]
+        factor = factors.get(name)
+        lines.append("%-12s %14.3f %14.3f %14s" %
+                     (name, times[name], costs[name],
+                      "reference" if name == REFERENCE_PROBE else
+                      "n/a" if factor is None else "%.3f" % factor))
+    return lines
+
+
+def calibrate(conn, execute_n_times, max_iterations, tolerance):
+    probe_params = dict((probe[0], probe[5]) for probe in PROBES)
+
+    times = {}
+    for probe in PROBES:
+        times[probe[0]] = measure_probe_time(conn, probe, execute_n_times)
+        log_output("probe %s: time difference %.3f ms" % (probe[0], times[probe[0]]))
+
+    params = dict(DEFAULT_PARAMS)
+    for iteration in range(max_iterations):
+        costs = {}
+        for probe in PROBES:
+            costs[probe[0]] = estimate_probe_cost(conn, probe, params)
+
+        factors = {}
+        for probe in PROBES:
+            name = probe[0]
+            if name == REFERENCE_PROBE:
+                continue
+            factors[name] = scale_factor(times[name], costs[name],
+                                         times[REFERENCE_PROBE], costs[REFERENCE_PROBE])
+            if factors[name] is None:
+                print("WARNING: probe %s did not produce a usable measurement, keeping its parameters" % name)
+            log_output("iteration %d, probe %s: time %.3f ms, cost %.3f, scale factor %s" %
+                       (iteration, name, times[name], costs[name], factors[name]))
+
+        report = format_report(times, costs, factors)
+        if converged(factors, tolerance):
+            break
+        params = apply_scale_factors(params, probe_params, factors)
+        # a probe without a usable measurement keeps failing; don't retry it
+        for name in [n for n, f in factors.items() if f is None]:
+            probe_params[name] = []
+
+    return params, report
+
+
+# common parts: create tables, calibrate, drop objects
+# -----------------------------------------------------------------------------
+
+def createDB(conn, num_rows):
+    execute_sql(conn, _drop_tables)
+    execute_sql_arr(conn, _create_tables)
+    commit_db(conn)
+    execute_sql_arr(conn, [stmt % {"rows": num_rows} for stmt in _insert_into_tables])
+    commit_db(conn)
+    execute_sql(conn, _analyze_tables)
+    commit_db(conn)
+
+
+def dropDB(conn):
+    execute_sql(conn, _drop_tables)
+    commit_db(conn)
+
+
+def main():
+    global glob_verbose
+    global glob_log_file
+
+    args, parser = parseargs()
+    if args.logFile != "":
+        glob_log_file = open(args.logFile, "wt", 1)
+    if args.verbose:
+        glob_verbose = True
+    log_output("Connecting to host %s on port %d, database %s" % (args.host, args.port, args.dbName))
+    conn = connect(args.host, args.port, args.dbName)
+    execute_sql(conn, "SET optimizer = on")
+
+    if args.create:
+        createDB(conn, args.numRows)
+
+    params, report = calibrate(conn, max(args.execute, 1), max(args.iterations, 1),
+                               args.tolerance)
+    profile = format_profile(params)
+
+    print("\n".join(report))
+    print("optimizer_cost_model_params = '%s'" % profile)
+    if args.output != "":
+        with open(args.output, "wt") as f:
+            f.write("# generated by cal_cost_model.py, last iteration of the fit:\n")
+            for line in report:
+                f.write("#   %s\n" % line)
+            f.write("optimizer_cost_model_params = '%s'\n" % profile)
+
+    if args.drop:
+        dropDB(conn)
+
+    conn.close()
+    if glob_log_file != None:
+        glob_log_file.close()
+
+
+if __name__ == "__main__":
+    main()
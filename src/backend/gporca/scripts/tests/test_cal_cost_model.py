@@ -0,0 +1,106 @@
+import json
+import os
+import re
+import unittest
+from unittest.mock import patch
+from unittest.mock import Mock
+
+import cal_cost_model
+from cal_cost_model import explain_json
+from cal_cost_model import find_node
+from cal_cost_model import own_cost
+from cal_cost_model import own_time
+from cal_cost_model import scale_factor
+from cal_cost_model import apply_scale_factors
+from cal_cost_model import converged
+from cal_cost_model import format_profile
+from cal_cost_model import format_report
+
+_hash_join_plan = {
+    "Node Type": "Gather Motion", "Total Cost": 900.0, "Actual Total Time": 95.0,
+    "Plans": [
+        {"Node Type": "Hash Join", "Total Cost": 880.0, "Actual Total Time": 90.0,
+         "Plans": [
+             {"Node Type": "Seq Scan", "Total Cost": 431.5, "Actual Total Time": 20.0},
+             {"Node Type": "Hash", "Total Cost": 431.5, "Actual Total Time": 40.0,
+              "Plans": [
+                  {"Node Type": "Seq Scan", "Total Cost": 431.5, "Actual Total Time": 25.0}
+              ]}
+         ]}
+    ]}
+
+
+class TestCalCostModel(unittest.TestCase):
+
+    @patch('gppylib.db.dbconn.query')
+    def test_explain_json(self, mock_query):
+        text = json.dumps([{"Plan": _hash_join_plan}], indent=2)
+        mock_query.return_value = Mock()
+        mock_query.return_value.fetchall.return_value = [[line] for line in text.split("\n")]
+
+        plan = explain_json(Mock(), "mock sql query string", True)
+        self.assertEqual(plan["Node Type"], "Gather Motion")
+        self.assertEqual(mock_query.call_args[0][1],
+                         "EXPLAIN (ANALYZE, FORMAT JSON) mock sql query string")
+
+    def test_find_node(self):
+        node = find_node(_hash_join_plan, lambda n: n["Node Type"] == "Hash Join")
+        self.assertEqual(node["Total Cost"], 880.0)
+        self.assertIsNone(find_node(_hash_join_plan, lambda n: n["Node Type"] == "Sort"))
+
+    def test_own_cost_and_time_include_hash_node(self):
+        node = find_node(_hash_join_plan, lambda n: n["Node Type"] == "Hash Join")
+        # the hash table build belongs to the join, only the scans are inputs
+        self.assertAlmostEqual(own_cost(node), 880.0 - 431.5 - 431.5)
+        self.assertAlmostEqual(own_time(node), 90.0 - 20.0 - 25.0)
+
+    def test_scale_factor(self):
+        # twice as much time per unit of cost as the reference
+        self.assertAlmostEqual(scale_factor(20.0, 10.0, 5.0, 5.0), 2.0)
+        self.assertIsNone(scale_factor(20.0, 0.0, 5.0, 5.0))
+        self.assertIsNone(scale_factor(-1.0, 10.0, 5.0, 5.0))
+
+    def test_apply_scale_factors(self):
+        params = dict(cal_cost_model.DEFAULT_PARAMS)
+        probe_params = {"sort": ["SortTupWidthCostUnit"], "gather": ["GatherSendCostUnit"]}
+        new_params = apply_scale_factors(params, probe_params, {"sort": 2.0, "gather": None})
+        self.assertAlmostEqual(new_params["SortTupWidthCostUnit"], 2 * 5.67e-06)
+        self.assertEqual(new_params["GatherSendCostUnit"], params["GatherSendCostUnit"])
+        self.assertEqual(params, cal_cost_model.DEFAULT_PARAMS)
+
+    def test_converged(self):
+        self.assertTrue(converged({"sort": 1.01, "gather": None}, 0.05))
+        self.assertFalse(converged({"sort": 1.01, "gather": 0.5}, 0.05))
+        self.assertFalse(converged({"sort": 1.01}, 0.005))
+
+    def test_format_profile(self):
+        params = dict(cal_cost_model.DEFAULT_PARAMS)
+        self.assertEqual(format_profile(params), "")
+        params["SortTupWidthCostUnit"] = 1.5e-05
+        params["GatherRecvCostUnit"] = 3.0e-06
+        self.assertEqual(format_profile(params),
+                         "GatherRecvCostUnit=3e-06,SortTupWidthCostUnit=1.5e-05")
+
+    def test_format_report(self):
+        times = dict((probe[0], 10.0) for probe in cal_cost_model.PROBES)
+        costs = dict((probe[0], 20.0) for probe in cal_cost_model.PROBES)
+        report = format_report(times, costs, {"sort": 1.5, "gather": None})
+        self.assertEqual(len(report), len(cal_cost_model.PROBES) + 1)
+        lines = dict((line.split()[0], line.split()[-1]) for line in report[1:])
+        self.assertEqual(lines["scan"], "reference")
+        self.assertEqual(lines["sort"], "1.500")
+        self.assertEqual(lines["gather"], "n/a")
+
+    def test_default_params_match_cost_model(self):
+        # the defaults must be those of the cost model, not values of their own
+        src = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           "../../libgpdbcost/src/CCostModelParamsGPDB.cpp")
+        with open(src) as f:
+            values = dict((m.group(1), float(m.group(2))) for m in
+                          re.finditer(r"CCostModelParamsGPDB::D(\w+?)Val\s*=\s*([0-9.eE+-]+);",
+                                      f.read()))
+        for name, value in cal_cost_model.DEFAULT_PARAMS.items():
+            self.assertEqual(values[name], value, name)
+
+if __name__ == '__main__':
+    unittest.main()
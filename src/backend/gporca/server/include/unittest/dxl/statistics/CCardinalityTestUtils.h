@@ -11,6 +11,8 @@
 #ifndef GPNAUCRATES_CCardinalityTestUtils_H
 #define GPNAUCRATES_CCardinalityTestUtils_H
 
+#include "gpopt/base/CColRef.h"
+#include "naucrates/md/IMDRelation.h"
 #include "naucrates/statistics/CBucket.h"
 #include "naucrates/statistics/CHistogram.h"
 #include "naucrates/statistics/CPoint.h"
@@ -68,6 +70,15 @@ public:
 	// helper function to generate a point of double datatype
 	static CPoint *PpointDouble(CMemoryPool *mp, OID oid, CDouble value);
 
+	// helper function to create a column reference of a scan of a table
+	static CColRef *PcrScanColumn(CMemoryPool *mp, const IMDRelation *rel,
+								  ULONG pos, ULONG scan_id);
+
+	// helper function to create the statistics of a scan of a table
+	static CStatistics *PstatsScan(CMemoryPool *mp, CColRefArray *colrefs,
+								   CDouble ndv_per_bucket, CDouble rows,
+								   ULONG scan_id);
+
 	// helper method to print statistics object
 	static void PrintStats(CMemoryPool *mp, const IStatistics *stats);
 
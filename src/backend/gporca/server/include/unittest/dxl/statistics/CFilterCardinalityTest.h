@@ -13,6 +13,7 @@
 
 #include "gpos/base.h"
 
+#include "gpopt/base/CColRef.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/statistics/CBucket.h"
 #include "naucrates/statistics/CHistogram.h"
@@ -155,6 +156,10 @@ private:
 		CStatisticsArray *pdrgpstatBefore, CStatsPred *pred_stats,
 		const CHAR *szDXLOutput, BOOL fApplyTwice = false);
 
+	// rows of a scan after equality filters on one or two of its columns
+	static CDouble FilterRows(CMemoryPool *mp, CStatistics *stats,
+							  const CColRef *colref1, const CColRef *colref2);
+
 public:
 	// unittests
 	static GPOS_RESULT EresUnittest();
@@ -183,6 +188,9 @@ public:
 	// test for accumulating cardinality in disjunctive and conjunctive predicates
 	static GPOS_RESULT EresUnittest_CStatisticsAccumulateCard();
 
+	// test functional dependencies in conjunctive filters
+	static GPOS_RESULT EresUnittest_CStatisticsFilterDependency();
+
 };	// class CFilterCardinalityTest
 }  // namespace gpnaucrates
 
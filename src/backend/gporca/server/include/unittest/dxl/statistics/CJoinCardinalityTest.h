@@ -11,6 +11,7 @@
 #ifndef GPNAUCRATES_CJoinCardinalityTest_H
 #define GPNAUCRATES_CJoinCardinalityTest_H
 
+#include "gpopt/base/CColRef.h"
 #include "naucrates/statistics/CBucket.h"
 #include "naucrates/statistics/CHistogram.h"
 #include "naucrates/statistics/CPoint.h"
@@ -99,6 +100,12 @@ private:
 	// helper method to generate join predicate over columns that contain null values
 	static CStatsPredJoinArray *PdrgpstatspredjoinNullableCols(CMemoryPool *mp);
 
+	// helper method to estimate the rows of an equality inner join
+	static CDouble JoinRows(CMemoryPool *mp, const CStatistics *outer_stats,
+							const CStatistics *inner_stats,
+							const CColRef *outer_colref,
+							const CColRef *inner_colref);
+
 public:
 	// unittests
 	static GPOS_RESULT EresUnittest();
@@ -109,6 +116,9 @@ public:
 	// join buckets tests
 	static GPOS_RESULT EresUnittest_Join();
 
+	// test join cardinality estimation over a foreign key
+	static GPOS_RESULT EresUnittest_JoinForeignKey();
+
 };	// class CJoinCardinalityTest
 }  // namespace gpnaucrates
 
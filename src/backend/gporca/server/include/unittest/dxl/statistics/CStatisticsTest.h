@@ -11,6 +11,7 @@
 #ifndef GPNAUCRATES_CStatisticsTest_H
 #define GPNAUCRATES_CStatisticsTest_H
 
+#include "gpopt/base/CColRef.h"
 #include "naucrates/statistics/CBucket.h"
 #include "naucrates/statistics/CHistogram.h"
 #include "naucrates/statistics/CPoint.h"
@@ -90,6 +91,10 @@ private:
 		return pdrgpul;
 	}
 
+	// number of groups of a scan when grouping on the given columns
+	static CDouble GroupByRows(CMemoryPool *mp, CStatistics *stats,
+							   const CColRef *colref1, const CColRef *colref2);
+
 	// create a table descriptor with two columns having the given names
 	static CTableDescriptor *PtabdescTwoColumnSource(
 		CMemoryPool *mp, const CName &nameTable, const IMDTypeInt4 *pmdtype,
@@ -119,6 +124,9 @@ public:
 	// GbAgg test when grouping on repeated columns
 	static GPOS_RESULT EresUnittest_GbAggWithRepeatedGbCols();
 
+	// GbAgg test using multi-column ndistinct coefficients
+	static GPOS_RESULT EresUnittest_GbAggNDistinct();
+
 
 };	// class CStatisticsTest
 }  // namespace gpnaucrates
@@ -64,6 +64,10 @@
 #define GPOPT_TEST_REL_OID20 OID(10200)
 #define GPOPT_TEST_REL_OID21 OID(10311)
 #define GPOPT_TEST_REL_OID22 OID(27118)
+#define GPOPT_TEST_REL_OID23 OID(27119)
+#define GPOPT_TEST_REL_OID24 OID(27120)
+#define GPOPT_TEST_REL_OID25 OID(27121)
+#define GPOPT_TEST_REL_OID26 OID(27122)
 
 #define GPDB_INT4_LT_OP OID(97)
 #define GPDB_INT4_EQ_OP OID(96)
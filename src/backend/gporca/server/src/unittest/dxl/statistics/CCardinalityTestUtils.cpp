@@ -17,6 +17,9 @@
 
 #include "gpos/io/COstreamString.h"
 
+#include "gpopt/base/CColRefSet.h"
+#include "gpopt/base/COptCtxt.h"
+#include "gpopt/metadata/CColumnDescriptor.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/dxl/operators/CDXLDatumGeneric.h"
 #include "naucrates/dxl/operators/CDXLDatumStatsDoubleMappable.h"
@@ -209,6 +212,64 @@ CCardinalityTestUtils::PpointDouble(CMemoryPool *mp, OID oid, CDouble value)
 	return point;
 }
 
+// helper function to create a column reference of a scan of a table, the
+// scan id stands in for the id of the Get operator
+CColRef *
+CCardinalityTestUtils::PcrScanColumn(CMemoryPool *mp, const IMDRelation *rel,
+									 ULONG pos, ULONG scan_id)
+{
+	COptCtxt *poctxt = COptCtxt::PoctxtFromTLS();
+	const IMDColumn *md_col = rel->GetMdCol(pos);
+
+	// for these tests the col name doesn't matter
+	CWStringConst str(GPOS_WSZ_LIT("col"));
+	CName name(&str);
+	CColumnDescriptor *coldesc = GPOS_NEW(mp) CColumnDescriptor(
+		mp, poctxt->Pmda()->RetrieveType(md_col->MdidType()),
+		md_col->TypeModifier(), name, md_col->AttrNum(),
+		md_col->IsNullable());
+	CColRef *colref = poctxt->Pcf()->PcrCreate(
+		coldesc, name, scan_id, true /*mark_as_used*/, rel->MDId());
+	coldesc->Release();
+
+	return colref;
+}
+
+// helper function to create the statistics of a scan of a table, with int4
+// histograms of the form [0, 100), [100, 200) ... [900, 1000) on the columns,
+// as CLogicalGet::PstatsDerive would
+CStatistics *
+CCardinalityTestUtils::PstatsScan(CMemoryPool *mp, CColRefArray *colrefs,
+								  CDouble ndv_per_bucket, CDouble rows,
+								  ULONG scan_id)
+{
+	UlongToHistogramMap *col_histogram_mapping =
+		GPOS_NEW(mp) UlongToHistogramMap(mp);
+	UlongToDoubleMap *colid_width_mapping = GPOS_NEW(mp) UlongToDoubleMap(mp);
+
+	for (ULONG ul = 0; ul < colrefs->Size(); ul++)
+	{
+		ULONG colid = (*colrefs)[ul]->Id();
+		col_histogram_mapping->Insert(
+			GPOS_NEW(mp) ULONG(colid),
+			PhistInt4Remain(mp, 10 /*num_of_buckets*/, ndv_per_bucket,
+							false /*fNullFreq*/,
+							CDouble(0.0) /*num_NDV_remain*/));
+		colid_width_mapping->Insert(GPOS_NEW(mp) ULONG(colid),
+									GPOS_NEW(mp) CDouble(4.0));
+	}
+
+	CStatistics *stats = GPOS_NEW(mp)
+		CStatistics(mp, col_histogram_mapping, colid_width_mapping, rows,
+					false /*is_empty*/, 0 /*num_predicates*/);
+
+	CColRefSet *pcrs = GPOS_NEW(mp) CColRefSet(mp, colrefs);
+	stats->AddCardUpperBound(GPOS_NEW(mp) CUpperBoundNDVs(pcrs, rows));
+	stats->SetBaseScanId(scan_id);
+
+	return stats;
+}
+
 // helper function to print the bucket object
 void
 CCardinalityTestUtils::PrintBucket(CMemoryPool *mp, const char *pcPrefix,
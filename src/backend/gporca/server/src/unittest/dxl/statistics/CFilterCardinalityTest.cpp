@@ -19,8 +19,10 @@
 
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/task/CAutoTraceFlag.h"
 
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/md/CMDIdGPDB.h"
 #include "naucrates/statistics/CFilterStatsProcessor.h"
 #include "naucrates/statistics/CStatisticsUtils.h"
 
@@ -95,7 +97,9 @@ CFilterCardinalityTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(
 			CFilterCardinalityTest::EresUnittest_CStatisticsBasicsFromDXL),
 		GPOS_UNITTEST_FUNC(
-			CFilterCardinalityTest::EresUnittest_CStatisticsAccumulateCard)};
+			CFilterCardinalityTest::EresUnittest_CStatisticsAccumulateCard),
+		GPOS_UNITTEST_FUNC(
+			CFilterCardinalityTest::EresUnittest_CStatisticsFilterDependency)};
 
 	CAutoMemoryPool amp;
 	CMemoryPool *mp = amp.Pmp();
@@ -1314,4 +1318,95 @@ CFilterCardinalityTest::EresUnittest_CStatisticsAccumulateCard()
 	return GPOS_OK;
 }
 
+// rows of a scan after equality filters on one or two of its columns
+CDouble
+CFilterCardinalityTest::FilterRows(CMemoryPool *mp, CStatistics *stats,
+								   const CColRef *colref1,
+								   const CColRef *colref2)
+{
+	CStatsPredPtrArry *pdrgpstatspred = GPOS_NEW(mp) CStatsPredPtrArry(mp);
+	pdrgpstatspred->Append(GPOS_NEW(mp) CStatsPredPoint(
+		colref1->Id(), CStatsPred::EstatscmptEq, CTestUtils::PpointInt4(mp, 5)));
+	if (nullptr != colref2)
+	{
+		pdrgpstatspred->Append(GPOS_NEW(mp) CStatsPredPoint(
+			colref2->Id(), CStatsPred::EstatscmptEq,
+			CTestUtils::PpointInt4(mp, 5)));
+	}
+	CStatsPredConj *pred_stats = GPOS_NEW(mp) CStatsPredConj(pdrgpstatspred);
+
+	CStatistics *filter_stats = CFilterStatsProcessor::MakeStatsFilter(
+		mp, stats, pred_stats, true /* do_cap_NDVs */);
+	CDouble rows = filter_stats->Rows();
+
+	pred_stats->Release();
+	filter_stats->Release();
+
+	return rows;
+}
+
+// test the use of functional dependencies in equality filters: table
+// ext_stats (c1, c2, c3) has a dependency c1 => c2 of degree 1, table
+// no_ext_stats has the same columns and statistics, and no extended statistics
+GPOS_RESULT
+CFilterCardinalityTest::EresUnittest_CStatisticsFilterDependency()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+
+	OID rel_oids[] = {GPOPT_TEST_REL_OID25, GPOPT_TEST_REL_OID26};
+	for (ULONG ulRel = 0; ulRel < GPOS_ARRAY_SIZE(rel_oids); ulRel++)
+	{
+		BOOL has_ext_stats = (0 == ulRel);
+		CMDIdGPDB *rel_mdid = GPOS_NEW(mp) CMDIdGPDB(rel_oids[ulRel], 1, 0);
+		const IMDRelation *rel = md_accessor->RetrieveRel(rel_mdid);
+		rel_mdid->Release();
+
+		CColRefArray *colrefs = GPOS_NEW(mp) CColRefArray(mp);
+		for (ULONG ul = 0; ul < 3; ul++)
+		{
+			colrefs->Append(CCardinalityTestUtils::PcrScanColumn(
+				mp, rel, ul, 1 /*scan_id*/));
+		}
+		CColRef *c1 = (*colrefs)[0];
+		CColRef *c2 = (*colrefs)[1];
+		CColRef *c3 = (*colrefs)[2];
+
+		// 100 distinct values in each column
+		CStatistics *stats = CCardinalityTestUtils::PstatsScan(
+			mp, colrefs, CDouble(10.0), CDouble(10000.0), 1 /*scan_id*/);
+
+		CDouble rows_c1 = FilterRows(mp, stats, c1, nullptr);
+		CDouble rows_c1_c2 = FilterRows(mp, stats, c1, c2);
+		CDouble rows_c1_c3 = FilterRows(mp, stats, c1, c3);
+		CDouble rows_c1_c2_indep(0.0);
+		CDouble rows_c1_c3_indep(0.0);
+		{
+			CAutoTraceFlag atf(EopttraceDisableExtendedStats, true /*value*/);
+			rows_c1_c2_indep = FilterRows(mp, stats, c1, c2);
+			rows_c1_c3_indep = FilterRows(mp, stats, c1, c3);
+		}
+
+		// clean up
+		stats->Release();
+		colrefs->Release();
+
+		if (!(rows_c1_c2_indep < rows_c1) || !(rows_c1_c3 == rows_c1_c3_indep))
+		{
+			return GPOS_FAILED;
+		}
+
+		// the dependency c1 => c2 makes the filter on c2 redundant, without
+		// it the columns are filtered as independent columns
+		if ((has_ext_stats && !(rows_c1_c2 == rows_c1)) ||
+			(!has_ext_stats && !(rows_c1_c2 == rows_c1_c2_indep)))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
 // EOF
@@ -20,8 +20,10 @@
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/task/CAutoTraceFlag.h"
 
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/md/CMDIdGPDB.h"
 #include "naucrates/statistics/CStatisticsUtils.h"
 
 #include "unittest/base.h"
@@ -36,6 +38,7 @@ CJoinCardinalityTest::EresUnittest()
 	CUnittest rgutSharedOptCtxt[] = {
 		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_Join),
 		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_JoinNDVRemain),
+		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_JoinForeignKey),
 	};
 
 	// run tests with shared optimization context first
@@ -333,6 +336,121 @@ CJoinCardinalityTest::EresUnittest_Join()
 	return GPOS_OK;
 }
 
+// test join cardinality estimation over a foreign key: table fk_referencing
+// (a, b) has a foreign key on a referencing the key id of table fk_ref (id, v),
+// and one on b referencing v, which is not a key of fk_ref
+GPOS_RESULT
+CJoinCardinalityTest::EresUnittest_JoinForeignKey()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+
+	CMDIdGPDB *ref_mdid = GPOS_NEW(mp) CMDIdGPDB(GPOPT_TEST_REL_OID23, 1, 0);
+	CMDIdGPDB *fk_mdid = GPOS_NEW(mp) CMDIdGPDB(GPOPT_TEST_REL_OID24, 1, 0);
+	const IMDRelation *ref_rel = md_accessor->RetrieveRel(ref_mdid);
+	const IMDRelation *fk_rel = md_accessor->RetrieveRel(fk_mdid);
+	ref_mdid->Release();
+	fk_mdid->Release();
+
+	const ULONG fk_scan_id = 1;
+	const ULONG ref_scan_id = 2;
+	CColRefArray *fk_colrefs = GPOS_NEW(mp) CColRefArray(mp);
+	CColRefArray *ref_colrefs = GPOS_NEW(mp) CColRefArray(mp);
+	for (ULONG ul = 0; ul < 2; ul++)
+	{
+		fk_colrefs->Append(CCardinalityTestUtils::PcrScanColumn(
+			mp, fk_rel, ul, fk_scan_id));
+		ref_colrefs->Append(CCardinalityTestUtils::PcrScanColumn(
+			mp, ref_rel, ul, ref_scan_id));
+	}
+	CColRef *a = (*fk_colrefs)[0];
+	CColRef *b = (*fk_colrefs)[1];
+	CColRef *id = (*ref_colrefs)[0];
+	CColRef *v = (*ref_colrefs)[1];
+
+	// all 10000 rows of fk_referencing, referencing 50 distinct ids, joined
+	// with 100 rows of fk_ref, as if a filter kept 10% of its 1000 rows
+	CStatistics *fk_stats = CCardinalityTestUtils::PstatsScan(
+		mp, fk_colrefs, CDouble(5.0), CDouble(10000.0), fk_scan_id);
+	CStatistics *ref_stats = CCardinalityTestUtils::PstatsScan(
+		mp, ref_colrefs, CDouble(10.0), CDouble(100.0), ref_scan_id);
+
+	CDouble hist_rows(0.0);
+	CDouble hist_rows_non_key(0.0);
+	{
+		CAutoTraceFlag atf(EopttraceDisableForeignKeyStats, true /*value*/);
+		hist_rows = JoinRows(mp, fk_stats, ref_stats, a, id);
+		hist_rows_non_key = JoinRows(mp, fk_stats, ref_stats, b, v);
+	}
+
+	GPOS_RESULT eres = GPOS_OK;
+
+	// every row of fk_referencing matches one row of fk_ref, and 10% of
+	// those qualify, whichever side the referenced table is on
+	CDouble fk_rows = JoinRows(mp, fk_stats, ref_stats, a, id);
+	CDouble fk_rows_commuted = JoinRows(mp, ref_stats, fk_stats, id, a);
+	if (fabs((fk_rows - CDouble(1000.0)).Get()) > CStatistics::Epsilon ||
+		fabs((fk_rows_commuted - CDouble(1000.0)).Get()) >
+			CStatistics::Epsilon ||
+		fabs((fk_rows - hist_rows).Get()) <= CStatistics::Epsilon)
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// the referenced columns of the other foreign key do not include a key,
+	// so it can match more than one row
+	CDouble non_key_rows = JoinRows(mp, fk_stats, ref_stats, b, v);
+	if (fabs((non_key_rows - hist_rows_non_key).Get()) > CStatistics::Epsilon)
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// the referenced side is not a scan of fk_ref, e.g. an aggregate of it,
+	// or the statistics come from another scan than the join columns
+	ULONG other_scan_ids[] = {gpos::ulong_max, ref_scan_id + 1};
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(other_scan_ids); ul++)
+	{
+		ref_stats->SetBaseScanId(other_scan_ids[ul]);
+		CDouble rows = JoinRows(mp, fk_stats, ref_stats, a, id);
+		if (fabs((rows - hist_rows).Get()) > CStatistics::Epsilon)
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	// clean up
+	fk_stats->Release();
+	ref_stats->Release();
+	fk_colrefs->Release();
+	ref_colrefs->Release();
+
+	return eres;
+}
+
+// helper method to estimate the rows of an equality inner join
+CDouble
+CJoinCardinalityTest::JoinRows(CMemoryPool *mp, const CStatistics *outer_stats,
+							   const CStatistics *inner_stats,
+							   const CColRef *outer_colref,
+							   const CColRef *inner_colref)
+{
+	CStatsPredJoinArray *join_preds_stats =
+		GPOS_NEW(mp) CStatsPredJoinArray(mp);
+	join_preds_stats->Append(GPOS_NEW(mp) CStatsPredJoin(
+		outer_colref->Id(), CStatsPred::EstatscmptEq, inner_colref->Id()));
+
+	IStatistics *join_stats =
+		outer_stats->CalcInnerJoinStats(mp, inner_stats, join_preds_stats);
+	CDouble rows = join_stats->Rows();
+
+	join_stats->Release();
+	join_preds_stats->Release();
+
+	return rows;
+}
+
 //	helper method to generate a single join predicate
 CStatsPredJoinArray *
 CJoinCardinalityTest::PdrgpstatspredjoinSingleJoinPredicate(CMemoryPool *mp)
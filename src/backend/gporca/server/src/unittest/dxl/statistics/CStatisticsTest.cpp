@@ -20,6 +20,7 @@
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/task/CAutoTraceFlag.h"
 
 #include "gpopt/base/CQueryContext.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
@@ -29,6 +30,7 @@
 #include "naucrates/base/CDatumGenericGPDB.h"
 #include "naucrates/base/CDatumInt4GPDB.h"
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/md/CMDIdGPDB.h"
 #include "naucrates/md/CMDTypeGenericGPDB.h"
 #include "naucrates/md/IMDType.h"
 #include "naucrates/statistics/CBucket.h"
@@ -58,6 +60,7 @@ CStatisticsTest::EresUnittest()
 	CUnittest rgutSharedOptCtxt[] = {
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsBasic),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_UnionAll),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_GbAggNDistinct),
 		// TODO,  Mar 18 2013 temporarily disabling the test
 		// GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsSelectDerivation),
 	};
@@ -282,6 +285,93 @@ CStatisticsTest::EresUnittest_GbAggWithRepeatedGbCols()
 	return GPOS_FAILED;
 }
 
+// number of groups of a scan when grouping on the given columns
+CDouble
+CStatisticsTest::GroupByRows(CMemoryPool *mp, CStatistics *stats,
+							 const CColRef *colref1, const CColRef *colref2)
+{
+	const CStatisticsConfig *stats_config =
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetStatsConf();
+
+	ULongPtrArray *grouping_cols = GPOS_NEW(mp) ULongPtrArray(mp);
+	grouping_cols->Append(GPOS_NEW(mp) ULONG(colref1->Id()));
+	if (nullptr != colref2)
+	{
+		grouping_cols->Append(GPOS_NEW(mp) ULONG(colref2->Id()));
+	}
+
+	CDouble groups = CStatisticsUtils::Groups(mp, stats, stats_config,
+											  grouping_cols, nullptr /*keys*/);
+	grouping_cols->Release();
+
+	return groups;
+}
+
+// GbAgg test using the multi-column ndistinct coefficients of a table:
+// table ext_stats (c1, c2, c3) has 100 distinct (c1, c2) pairs, table
+// no_ext_stats has the same columns and statistics, and no extended statistics
+GPOS_RESULT
+CStatisticsTest::EresUnittest_GbAggNDistinct()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+
+	OID rel_oids[] = {GPOPT_TEST_REL_OID25, GPOPT_TEST_REL_OID26};
+	for (ULONG ulRel = 0; ulRel < GPOS_ARRAY_SIZE(rel_oids); ulRel++)
+	{
+		BOOL has_ext_stats = (0 == ulRel);
+		CMDIdGPDB *rel_mdid = GPOS_NEW(mp) CMDIdGPDB(rel_oids[ulRel], 1, 0);
+		const IMDRelation *rel = md_accessor->RetrieveRel(rel_mdid);
+		rel_mdid->Release();
+
+		CColRefArray *colrefs = GPOS_NEW(mp) CColRefArray(mp);
+		for (ULONG ul = 0; ul < 3; ul++)
+		{
+			colrefs->Append(CCardinalityTestUtils::PcrScanColumn(
+				mp, rel, ul, 1 /*scan_id*/));
+		}
+		CColRef *c1 = (*colrefs)[0];
+		CColRef *c2 = (*colrefs)[1];
+		CColRef *c3 = (*colrefs)[2];
+
+		// 100 distinct values in each column
+		CStatistics *stats = CCardinalityTestUtils::PstatsScan(
+			mp, colrefs, CDouble(10.0), CDouble(10000.0), 1 /*scan_id*/);
+
+		CDouble groups_c1 = GroupByRows(mp, stats, c1, nullptr);
+		CDouble groups_c1_c2 = GroupByRows(mp, stats, c1, c2);
+		CDouble groups_c1_c3 = GroupByRows(mp, stats, c1, c3);
+		CDouble groups_c1_c2_indep(0.0);
+		CDouble groups_c1_c3_indep(0.0);
+		{
+			CAutoTraceFlag atf(EopttraceDisableExtendedStats, true /*value*/);
+			groups_c1_c2_indep = GroupByRows(mp, stats, c1, c2);
+			groups_c1_c3_indep = GroupByRows(mp, stats, c1, c3);
+		}
+
+		// clean up
+		stats->Release();
+		colrefs->Release();
+
+		if (!(groups_c1_c2_indep > groups_c1) ||
+			!(groups_c1_c3 == groups_c1_c3_indep))
+		{
+			return GPOS_FAILED;
+		}
+
+		// the coefficient replaces the combined NDVs of c1 and c2, without
+		// it the columns are grouped as independent columns
+		if ((has_ext_stats && !(groups_c1_c2 == groups_c1)) ||
+			(!has_ext_stats && !(groups_c1_c2 == groups_c1_c2_indep)))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
 // generates example int histogram corresponding to dimension table
 CHistogram *
 CStatisticsTest::PhistExampleInt4Dim(CMemoryPool *mp)
@@ -2567,6 +2567,124 @@ llvm_compile_expr(ExprState *state)
 				LLVMBuildBr(b, opblocks[i + 1]);
 				break;
 
+			case EEOP_CDBHASH:
+			case EEOP_CDBHASH_INT4:
+			case EEOP_CDBHASH_INT8:
+				{
+					FunctionCallInfo fcinfo = op->d.cdbhash.fcinfo_data;
+					LLVMValueRef v_fcinfo;
+					LLVMValueRef v_prevhash;
+					LLVMValueRef v_hash;
+					LLVMValueRef v_argisnull;
+					LLVMValueRef v_keyhash;
+					LLVMBasicBlockRef b_notnull;
+
+					b_notnull = l_bb_before_v(opblocks[i + 1],
+											  "b.%d.notnull", i);
+
+					/*
+					 * Rotate the hash of the previous keys left by one bit,
+					 * and store it as the result, for a NULL key.
+					 */
+					if (op->d.cdbhash.first)
+						v_prevhash = l_int32_const(0);
+					else
+						v_prevhash = LLVMBuildTrunc(b,
+													LLVMBuildLoad(b, v_resvaluep, ""),
+													LLVMInt32Type(), "");
+					v_hash = LLVMBuildOr(b,
+										 LLVMBuildShl(b, v_prevhash,
+													  l_int32_const(1), ""),
+										 LLVMBuildLShr(b, v_prevhash,
+													   l_int32_const(31), ""),
+										 "v_hash");
+					LLVMBuildStore(b,
+								   LLVMBuildZExt(b, v_hash, TypeSizeT, ""),
+								   v_resvaluep);
+					LLVMBuildStore(b, l_sbool_const(0), v_resnullp);
+
+					v_fcinfo = l_ptr_const(fcinfo,
+										   l_ptr(StructFunctionCallInfoData));
+					v_argisnull = l_funcnull(b, v_fcinfo, 0);
+					LLVMBuildCondBr(b,
+									LLVMBuildICmp(b, LLVMIntEQ, v_argisnull,
+												  l_sbool_const(1), ""),
+									opblocks[i + 1],
+									b_notnull);
+
+					/* Otherwise xor in the hash of the key */
+					LLVMPositionBuilderAtEnd(b, b_notnull);
+					if (opcode == EEOP_CDBHASH)
+					{
+						/*
+						 * Hash support functions never return NULL, so don't
+						 * bother checking.  Like other function calls, this
+						 * one is a candidate for inlining.
+						 */
+						v_keyhash = BuildV1Call(context, b, mod, fcinfo, NULL);
+					}
+					else
+					{
+						LLVMValueRef v_value = l_funcvalue(b, v_fcinfo, 0);
+						LLVMValueRef v_hashfn;
+						LLVMValueRef v_uint32;
+
+						if (opcode == EEOP_CDBHASH_INT4)
+							v_uint32 = LLVMBuildTrunc(b, v_value,
+													  LLVMInt32Type(), "");
+						else
+						{
+							/* like hashint8() */
+							LLVMValueRef v_lohalf;
+							LLVMValueRef v_hihalf;
+							LLVMValueRef v_nonneg;
+
+							v_lohalf = LLVMBuildTrunc(b, v_value,
+													  LLVMInt32Type(), "");
+							v_hihalf = LLVMBuildTrunc(b,
+													  LLVMBuildLShr(b, v_value,
+																	l_sizet_const(32), ""),
+													  LLVMInt32Type(), "");
+							v_nonneg = LLVMBuildICmp(b, LLVMIntSGE, v_value,
+													 l_sizet_const(0), "");
+							v_hihalf = LLVMBuildSelect(b, v_nonneg, v_hihalf,
+													   LLVMBuildNot(b, v_hihalf, ""),
+													   "");
+							v_uint32 = LLVMBuildXor(b, v_lohalf, v_hihalf, "");
+						}
+
+						v_hashfn = LLVMGetNamedFunction(mod, "hash_uint32");
+						if (!v_hashfn)
+						{
+							LLVMTypeRef param_types[1];
+
+							param_types[0] = LLVMInt32Type();
+							v_hashfn = LLVMAddFunction(mod, "hash_uint32",
+													   LLVMFunctionType(TypeSizeT,
+																		param_types, 1,
+																		false));
+						}
+						v_keyhash = LLVMBuildCall(b, v_hashfn, &v_uint32, 1, "");
+					}
+
+					v_hash = LLVMBuildXor(b, v_hash,
+										  LLVMBuildTrunc(b, v_keyhash,
+														 LLVMInt32Type(), ""),
+										  "");
+					LLVMBuildStore(b,
+								   LLVMBuildZExt(b, v_hash, TypeSizeT, ""),
+								   v_resvaluep);
+
+					LLVMBuildBr(b, opblocks[i + 1]);
+					break;
+				}
+
+			case EEOP_CDBHASH_LEGACY:
+				build_EvalXFunc(b, mod, "ExecEvalCdbHashLegacy",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
 			case EEOP_LAST:
 				Assert(false);
 				break;
@@ -138,6 +138,9 @@ _copyPlannedStmt(const PlannedStmt *from)
 		COPY_SCALAR_FIELD(slices[i].segindex);
 		COPY_SCALAR_FIELD(slices[i].directDispatch.isDirectDispatch);
 		COPY_NODE_FIELD(slices[i].directDispatch.contentIds);
+		COPY_NODE_FIELD(slices[i].directDispatch.paramKeys);
+		COPY_NODE_FIELD(slices[i].directDispatch.paramHashFuncs);
+		COPY_SCALAR_FIELD(slices[i].directDispatch.paramNumSegments);
 	}
 
 	COPY_NODE_FIELD(intoPolicy);
@@ -248,6 +251,7 @@ CopyPlanFields(const Plan *from, Plan *newnode)
 	COPY_NODE_FIELD(flow);
 
 	COPY_SCALAR_FIELD(operatorMemKB);
+	COPY_SCALAR_FIELD(feedbackSignature);
 }
 
 /*
@@ -1137,6 +1141,33 @@ _copyMaterial(const Material *from)
 }
 
 
+/*
+ * _copyMemoize
+ */
+static Memoize *
+_copyMemoize(const Memoize *from)
+{
+	Memoize    *newnode = makeNode(Memoize);
+
+	/*
+	 * copy node superclass fields
+	 */
+	CopyPlanFields((const Plan *) from, (Plan *) newnode);
+
+	/*
+	 * copy remainder of node
+	 */
+	COPY_SCALAR_FIELD(numKeys);
+	COPY_POINTER_FIELD(hashOperators, sizeof(Oid) * from->numKeys);
+	COPY_POINTER_FIELD(collations, sizeof(Oid) * from->numKeys);
+	COPY_NODE_FIELD(param_exprs);
+	COPY_SCALAR_FIELD(singlerow);
+	COPY_SCALAR_FIELD(est_entries);
+
+	return newnode;
+}
+
+
 /*
  * _copySort
  */
@@ -1526,6 +1557,12 @@ _copyMotion(const Motion *from)
 
 	COPY_SCALAR_FIELD(segidColIdx);
 	COPY_SCALAR_FIELD(numHashSegments);
+	COPY_NODE_FIELD(skewValues);
+	COPY_SCALAR_FIELD(skewBroadcast);
+	COPY_SCALAR_FIELD(reoptRowLimit);
+	COPY_SCALAR_FIELD(hostMode);
+	COPY_SCALAR_FIELD(numHostSegments);
+	COPY_POINTER_FIELD(segmentHosts, from->numHostSegments * sizeof(int));
 
 	if (from->senderSliceInfo)
 	{
@@ -5849,6 +5886,9 @@ copyObjectImpl(const void *from)
 		case T_Material:
 			retval = _copyMaterial(from);
 			break;
+		case T_Memoize:
+			retval = _copyMemoize(from);
+			break;
 		case T_Sort:
 			retval = _copySort(from);
 			break;
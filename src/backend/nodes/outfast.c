@@ -1054,6 +1054,9 @@ _outNode(StringInfo str, void *obj)
 			case T_Material:
 				_outMaterial(str, obj);
 				break;
+			case T_Memoize:
+				_outMemoize(str, obj);
+				break;
 			case T_ShareInputScan:
 				_outShareInputScan(str, obj);
 				break;
@@ -380,6 +380,9 @@ _outPlannedStmt(StringInfo str, const PlannedStmt *node)
 		WRITE_INT_FIELD(slices[i].segindex);
 		WRITE_BOOL_FIELD(slices[i].directDispatch.isDirectDispatch);
 		WRITE_NODE_FIELD(slices[i].directDispatch.contentIds);
+		WRITE_NODE_FIELD(slices[i].directDispatch.paramKeys);
+		WRITE_NODE_FIELD(slices[i].directDispatch.paramHashFuncs);
+		WRITE_INT_FIELD(slices[i].directDispatch.paramNumSegments);
 	}
 
 	WRITE_BITMAPSET_FIELD(rewindPlanIDs);
@@ -494,6 +497,7 @@ _outPlanInfo(StringInfo str, const Plan *node)
 #endif /* COMPILING_BINARY_FUNCS */
 
 	WRITE_UINT64_FIELD(operatorMemKB);
+	WRITE_UINT_FIELD(feedbackSignature);
 }
 
 /*
@@ -1071,6 +1075,21 @@ _outMaterial(StringInfo str, const Material *node)
 	WRITE_BOOL_FIELD(cdb_shield_child_from_rescans);
 }
 
+static void
+_outMemoize(StringInfo str, const Memoize *node)
+{
+	WRITE_NODE_TYPE("MEMOIZE");
+
+	_outPlanInfo(str, (const Plan *) node);
+
+	WRITE_INT_FIELD(numKeys);
+	WRITE_OID_ARRAY(hashOperators, node->numKeys);
+	WRITE_OID_ARRAY(collations, node->numKeys);
+	WRITE_NODE_FIELD(param_exprs);
+	WRITE_BOOL_FIELD(singlerow);
+	WRITE_UINT_FIELD(est_entries);
+}
+
 static void
 _outShareInputScan(StringInfo str, const ShareInputScan *node)
 {
@@ -1272,6 +1291,12 @@ _outMotion(StringInfo str, const Motion *node)
 	WRITE_INT_FIELD(segidColIdx);
 
 	WRITE_INT_FIELD(numHashSegments);
+	WRITE_NODE_FIELD(skewValues);
+	WRITE_BOOL_FIELD(skewBroadcast);
+	WRITE_FLOAT_FIELD(reoptRowLimit, "%.0f");
+	WRITE_ENUM_FIELD(hostMode, BroadcastHostMode);
+	WRITE_INT_FIELD(numHostSegments);
+	WRITE_INT_ARRAY(segmentHosts, node->numHostSegments);
 
 	/* senderSliceInfo is intentionally omitted. It's only used during planning */
 
@@ -2343,6 +2368,21 @@ _outMaterialPath(StringInfo str, const MaterialPath *node)
 	WRITE_NODE_FIELD(subpath);
 }
 
+static void
+_outMemoizePath(StringInfo str, const MemoizePath *node)
+{
+	WRITE_NODE_TYPE("MEMOIZEPATH");
+
+	_outPathInfo(str, (const Path *) node);
+
+	WRITE_NODE_FIELD(subpath);
+	WRITE_NODE_FIELD(hash_operators);
+	WRITE_NODE_FIELD(param_exprs);
+	WRITE_BOOL_FIELD(singlerow);
+	WRITE_FLOAT_FIELD(calls, "%.0f");
+	WRITE_UINT_FIELD(est_entries);
+}
+
 static void
 _outUniquePath(StringInfo str, const UniquePath *node)
 {
@@ -2624,6 +2664,8 @@ _outCdbMotionPath(StringInfo str, const CdbMotionPath *node)
     _outPathInfo(str, &node->path);
 
     WRITE_NODE_FIELD(subpath);
+	WRITE_NODE_FIELD(skewValues);
+	WRITE_BOOL_FIELD(skewBroadcast);
 }
 
 static void
@@ -5559,6 +5601,9 @@ outNode(StringInfo str, const void *obj)
 			case T_Material:
 				_outMaterial(str, obj);
 				break;
+			case T_Memoize:
+				_outMemoize(str, obj);
+				break;
 			case T_ShareInputScan:
 				_outShareInputScan(str, obj);
 				break;
@@ -5829,6 +5874,9 @@ outNode(StringInfo str, const void *obj)
 			case T_MaterialPath:
 				_outMaterialPath(str, obj);
 				break;
+			case T_MemoizePath:
+				_outMemoizePath(str, obj);
+				break;
 			case T_UniquePath:
 				_outUniquePath(str, obj);
 				break;
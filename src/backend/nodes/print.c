@@ -557,6 +557,8 @@ plannode_type(Plan *p)
 			return "SHAREINPUTSCAN";
 		case T_Material:
 			return "MATERIAL";
+		case T_Memoize:
+			return "MEMOIZE";
 		case T_Sort:
 			return "SORT";
 		case T_Agg:
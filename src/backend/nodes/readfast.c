@@ -1038,6 +1038,12 @@ _readMotion(void)
 
 	READ_INT_FIELD(segidColIdx);
 	READ_INT_FIELD(numHashSegments);
+	READ_NODE_FIELD(skewValues);
+	READ_BOOL_FIELD(skewBroadcast);
+	READ_FLOAT_FIELD(reoptRowLimit);
+	READ_ENUM_FIELD(hostMode, BroadcastHostMode);
+	READ_INT_FIELD(numHostSegments);
+	READ_INT_ARRAY(segmentHosts, local_node->numHostSegments);
 
 	ReadCommonPlan(&local_node->plan);
 
@@ -1818,6 +1824,9 @@ readNodeBinary(void)
 			case T_Material:
 				return_value = _readMaterial();
 				break;
+			case T_Memoize:
+				return_value = _readMemoize();
+				break;
 			case T_ShareInputScan:
 				return_value = _readShareInputScan();
 				break;
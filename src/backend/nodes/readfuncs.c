@@ -2451,6 +2451,9 @@ _readPlannedStmt(void)
 		READ_INT_FIELD(slices[i].segindex);
 		READ_BOOL_FIELD(slices[i].directDispatch.isDirectDispatch);
 		READ_NODE_FIELD(slices[i].directDispatch.contentIds);
+		READ_NODE_FIELD(slices[i].directDispatch.paramKeys);
+		READ_NODE_FIELD(slices[i].directDispatch.paramHashFuncs);
+		READ_INT_FIELD(slices[i].directDispatch.paramNumSegments);
 	}
 
 	READ_BITMAPSET_FIELD(rewindPlanIDs);
@@ -2496,6 +2499,7 @@ ReadCommonPlan(Plan *local_node)
 #endif /* COMPILING_BINARY_FUNCS */
 
 	READ_UINT64_FIELD(operatorMemKB);
+	READ_UINT_FIELD(feedbackSignature);
 }
 
 /*
@@ -3125,6 +3129,26 @@ _readMaterial(void)
 	READ_DONE();
 }
 
+/*
+ * _readMemoize
+ */
+static Memoize *
+_readMemoize(void)
+{
+	READ_LOCALS(Memoize);
+
+	ReadCommonPlan(&local_node->plan);
+
+	READ_INT_FIELD(numKeys);
+	READ_OID_ARRAY(hashOperators, local_node->numKeys);
+	READ_OID_ARRAY(collations, local_node->numKeys);
+	READ_NODE_FIELD(param_exprs);
+	READ_BOOL_FIELD(singlerow);
+	READ_UINT_FIELD(est_entries);
+
+	READ_DONE();
+}
+
 /*
  * _readSort
  */
@@ -4580,6 +4604,8 @@ parseNodeString(void)
 		return_value = _readHashJoin();
 	else if (MATCH("MATERIAL", 8))
 		return_value = _readMaterial();
+	else if (MATCH("MEMOIZE", 7))
+		return_value = _readMemoize();
 	else if (MATCH("SORT", 4))
 		return_value = _readSort();
 	else if (MATCH("AGG", 3))
@@ -71,6 +71,7 @@
 
 #include "catalog/pg_proc.h"
 #include "cdb/cdbhash.h"
+#include "cdb/cdbhostbcast.h"
 #include "cdb/cdbllize.h"
 #include "cdb/cdbmutate.h"		/* apply_shareinput */
 #include "cdb/cdbpath.h"		/* cdbpath_segments */
@@ -374,7 +375,10 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 		}
 
 		if (result)
+		{
+			ApplyHostBroadcast(result);
 			return result;
+		}
 	}
 
 	/*
@@ -760,6 +764,8 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 
 	Assert(result->utilityStmt == NULL || IsA(result->utilityStmt, DeclareCursorStmt));
 
+	ApplyHostBroadcast(result);
+
 	if (gp_log_optimization_time)
 	{
 		INSTR_TIME_SET_CURRENT(endtime);
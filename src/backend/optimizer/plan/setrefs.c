@@ -893,6 +893,21 @@ set_plan_refs(PlannerInfo *root, Plan *plan, int rtoffset)
 			set_dummy_tlist_references(plan, rtoffset);
 			break;
 
+		case T_Memoize:
+			{
+				Memoize    *mplan = (Memoize *) plan;
+
+				/*
+				 * Memoize does not evaluate its targetlist.  It just uses the
+				 * same targetlist from its outer subnode.
+				 */
+				set_dummy_tlist_references(plan, rtoffset);
+
+				mplan->param_exprs = fix_scan_list(root, mplan->param_exprs,
+												   rtoffset);
+				break;
+			}
+
 		case T_PartitionSelector:
 			{
 				PartitionSelector *ps = (PartitionSelector *) plan;
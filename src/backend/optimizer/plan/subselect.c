@@ -3005,6 +3005,11 @@ finalize_plan(PlannerInfo *root, Plan *plan,
 							  &context);
 			break;
 
+		case T_Memoize:
+			finalize_primnode((Node *) ((Memoize *) plan)->param_exprs,
+							  &context);
+			break;
+
 		case T_PartitionSelector:
 			/* GPDB_12_MERGE_FIXME: need to do something with the paramid here? */
 			break;
@@ -16,8 +16,10 @@
 
 #include "access/hash.h"
 #include "catalog/pg_type.h"
+#include "cdb/cdbvars.h"
 #include "optimizer/clauses.h"
 #include "optimizer/predtest_valueset.h"
+#include "utils/array.h"
 #include "utils/lsyscache.h"
 #include "nodes/makefuncs.h"
 #include "utils/datum.h"
@@ -35,6 +37,7 @@ static bool ContainsValue(PossibleValueSet *pvs, Const *value);
 
 static bool TryProcessOpExprForPossibleValues(OpExpr *expr, Node *variable, PossibleValueSet *resultOut);
 static bool TryProcessNullTestForPossibleValues(NullTest *expr, Node *variable, PossibleValueSet *resultOut);
+static bool TryProcessScalarArrayOpExprForPossibleValues(ScalarArrayOpExpr *expr, Node *variable, PossibleValueSet *resultOut);
 
 typedef struct ConstHashValue
 {
@@ -318,6 +321,10 @@ TryProcessExprForPossibleValues(Node *expr, Node *variable, PossibleValueSet *re
 	{
 		return TryProcessNullTestForPossibleValues((NullTest *) expr, variable, resultOut);
 	}
+	else if (IsA(expr, ScalarArrayOpExpr))
+	{
+		return TryProcessScalarArrayOpExprForPossibleValues((ScalarArrayOpExpr *) expr, variable, resultOut);
+	}
 	else
 		return false;
 }
@@ -552,3 +559,86 @@ TryProcessNullTestForPossibleValues(NullTest *expr, Node *variable, PossibleValu
 		return false;
 	}
 }
+
+/**
+ * An IN-list or "= ANY(array)" reaches here only when predicate_classify()
+ * declined to expand it into an OR, which it does for constant arrays of more
+ * than MAX_SAOP_ARRAY_SIZE elements.  Expanding it is still cheap for our
+ * purposes, so treat it as the OR of one equality per array element, up to
+ * gp_direct_dispatch_max_values elements.
+ */
+static bool
+TryProcessScalarArrayOpExprForPossibleValues(ScalarArrayOpExpr *expr, Node *variable, PossibleValueSet *resultOut)
+{
+	Node	   *arraynode;
+	Const	   *arrayconst;
+	ArrayType  *arrayval;
+	int16		elmlen;
+	bool		elmbyval;
+	char		elmalign;
+	Datum	   *elem_values;
+	bool	   *elem_nulls;
+	int			num_elems;
+	Const	   *elemconst;
+	Expr	   *opexpr;
+	int			i;
+
+	InitPossibleValueSetData(resultOut);
+
+	if (!expr->useOr || list_length(expr->args) != 2)
+		return false;
+
+	arraynode = (Node *) lsecond(expr->args);
+	if (!IsA(arraynode, Const) || ((Const *) arraynode)->constisnull)
+		return false;
+	arrayconst = (Const *) arraynode;
+
+	arrayval = DatumGetArrayTypeP(arrayconst->constvalue);
+	if (ArrayGetNItems(ARR_NDIM(arrayval), ARR_DIMS(arrayval)) > gp_direct_dispatch_max_values)
+		return false;
+
+	get_typlenbyvalalign(ARR_ELEMTYPE(arrayval),
+						 &elmlen, &elmbyval, &elmalign);
+	deconstruct_array(arrayval,
+					  ARR_ELEMTYPE(arrayval),
+					  elmlen, elmbyval, elmalign,
+					  &elem_values, &elem_nulls, &num_elems);
+
+	/* reuse one Const and OpExpr, plugging in each element in turn */
+	elemconst = makeConst(ARR_ELEMTYPE(arrayval),
+						  -1,
+						  arrayconst->constcollid,
+						  elmlen,
+						  (Datum) 0,
+						  false,
+						  elmbyval);
+	opexpr = make_opclause(expr->opno, BOOLOID, false,
+						   (Expr *) linitial(expr->args),
+						   (Expr *) elemconst,
+						   InvalidOid, expr->inputcollid);
+	((OpExpr *) opexpr)->opfuncid = expr->opfuncid;
+
+	/* start from the empty set; "x = NULL" elements never match */
+	SetToNoValuesPossible(resultOut);
+
+	for (i = 0; i < num_elems; i++)
+	{
+		PossibleValueSet elemPossible;
+
+		if (elem_nulls[i])
+			continue;
+
+		elemconst->constvalue = elem_values[i];
+		if (!TryProcessOpExprForPossibleValues((OpExpr *) opexpr, variable, &elemPossible))
+		{
+			/* not an equality on our variable; learned nothing */
+			DeletePossibleValueSetData(resultOut);
+			return false;
+		}
+
+		AddUnmatchingValues(resultOut, &elemPossible);
+		DeletePossibleValueSetData(&elemPossible);
+	}
+
+	return true;
+}
@@ -357,6 +357,13 @@ plan_tree_walker(Node *node,
 				return true;
 			break;
 
+		case T_Memoize:
+			if (walk_plan_node_fields((Plan *) node, walker, context))
+				return true;
+			if (walker((Node *) ((Memoize *) node)->param_exprs, context))
+				return true;
+			break;
+
 		case T_Sort:
 			if (walk_plan_node_fields((Plan *) node, walker, context))
 				return true;
@@ -51,9 +51,12 @@
 #include "optimizer/pathnode.h"
 #include "parser/parsetree.h"
 #include "partitioning/partbounds.h"
+#include "partitioning/partdesc.h"
 #include "partitioning/partprune.h"
 #include "rewrite/rewriteManip.h"
 #include "utils/lsyscache.h"
+#include "utils/partcache.h"
+#include "utils/rel.h"
 
 
 /*
@@ -844,6 +847,149 @@ get_matching_partitions(PartitionPruneContext *context, List *pruning_steps)
 	return result;
 }
 
+/*
+ * prune_partitions_for_quals
+ *		GPDB: Determine the partitions of 'relation' that can contain rows
+ *		satisfying the implicitly-ANDed list of 'quals', without building any
+ *		planner data structures.
+ *
+ * This is used by ORCA to avoid fetching metadata for partitions that are
+ * excluded by simple restrictions on the partition key.  Only "partkey op
+ * Const" clauses (in either order) on a single-column RANGE or LIST partition
+ * key are used; anything else is ignored, which merely results in less
+ * pruning.  The matching partitions are found by binary searching the
+ * relation's PartitionBoundInfo, so the cost does not depend on the number of
+ * partitions.  'varno' is the range table index by which the quals refer to
+ * the relation.
+ *
+ * Returns a Bitmapset of indexes into the relation's PartitionDesc.
+ */
+Bitmapset *
+prune_partitions_for_quals(Relation relation, Index varno, List *quals)
+{
+	PartitionKey partkey = RelationGetPartitionKey(relation);
+	PartitionDesc partdesc = RelationGetPartitionDesc(relation);
+	PartitionPruneContext context;
+	List	   *pruning_steps = NIL;
+	List	   *source_stepids = NIL;
+	ListCell   *lc;
+
+	Assert(partkey != NULL && partdesc != NULL);
+
+	if (partdesc->nparts == 0)
+		return NULL;
+
+	if (partkey->partnatts != 1 || partkey->partattrs[0] == 0 ||
+		(partkey->strategy != PARTITION_STRATEGY_RANGE &&
+		 partkey->strategy != PARTITION_STRATEGY_LIST))
+		return bms_add_range(NULL, 0, partdesc->nparts - 1);
+
+	foreach(lc, quals)
+	{
+		OpExpr	   *opexpr = (OpExpr *) lfirst(lc);
+		Expr	   *leftop;
+		Expr	   *rightop;
+		Var		   *var;
+		Oid			opno;
+		int			op_strategy;
+		Oid			op_lefttype;
+		Oid			op_righttype;
+		Oid			cmpfn;
+		PartitionPruneStepOp *step;
+
+		if (!IsA(opexpr, OpExpr) || list_length(opexpr->args) != 2)
+			continue;
+
+		leftop = (Expr *) linitial(opexpr->args);
+		rightop = (Expr *) lsecond(opexpr->args);
+		if (IsA(leftop, RelabelType))
+			leftop = ((RelabelType *) leftop)->arg;
+		if (IsA(rightop, RelabelType))
+			rightop = ((RelabelType *) rightop)->arg;
+
+		opno = opexpr->opno;
+		if (IsA(leftop, Const) && IsA(rightop, Var))
+		{
+			Expr	   *tmp = leftop;
+
+			leftop = rightop;
+			rightop = tmp;
+			opno = get_commutator(opno);
+			if (!OidIsValid(opno))
+				continue;
+		}
+
+		if (!IsA(leftop, Var) || !IsA(rightop, Const) ||
+			((Const *) rightop)->constisnull)
+			continue;
+
+		var = (Var *) leftop;
+		if (var->varno != varno || var->varlevelsup != 0 ||
+			var->varattno != partkey->partattrs[0])
+			continue;
+
+		if (OidIsValid(partkey->partcollation[0]) &&
+			partkey->partcollation[0] != opexpr->inputcollid)
+			continue;
+
+		if (!op_in_opfamily(opno, partkey->partopfamily[0]))
+			continue;
+		get_op_opfamily_properties(opno, partkey->partopfamily[0], false,
+								   &op_strategy, &op_lefttype, &op_righttype);
+		if (op_lefttype != partkey->partopcintype[0])
+			continue;
+
+		if (op_righttype == partkey->partopcintype[0])
+			cmpfn = partkey->partsupfunc[0].fn_oid;
+		else
+			cmpfn = get_opfamily_proc(partkey->partopfamily[0],
+									  partkey->partopcintype[0],
+									  op_righttype, BTORDER_PROC);
+		if (!OidIsValid(cmpfn))
+			continue;
+
+		step = makeNode(PartitionPruneStepOp);
+		step->step.step_id = list_length(pruning_steps);
+		step->opstrategy = op_strategy;
+		step->exprs = list_make1(rightop);
+		step->cmpfns = list_make1_oid(cmpfn);
+		step->nullkeys = NULL;
+
+		source_stepids = lappend_int(source_stepids, step->step.step_id);
+		pruning_steps = lappend(pruning_steps, step);
+	}
+
+	if (pruning_steps == NIL)
+		return bms_add_range(NULL, 0, partdesc->nparts - 1);
+
+	/* get_matching_partitions() uses the result of the last step */
+	if (list_length(pruning_steps) > 1)
+	{
+		PartitionPruneStepCombine *combine;
+
+		combine = makeNode(PartitionPruneStepCombine);
+		combine->step.step_id = list_length(pruning_steps);
+		combine->combineOp = PARTPRUNE_COMBINE_INTERSECT;
+		combine->source_stepids = source_stepids;
+		pruning_steps = lappend(pruning_steps, combine);
+	}
+
+	context.strategy = partkey->strategy;
+	context.partnatts = partkey->partnatts;
+	context.nparts = partdesc->nparts;
+	context.boundinfo = partdesc->boundinfo;
+	context.partcollation = partkey->partcollation;
+	context.partsupfunc = partkey->partsupfunc;
+	context.stepcmpfuncs = (FmgrInfo *) palloc0(sizeof(FmgrInfo) *
+												context.partnatts *
+												list_length(pruning_steps));
+	context.ppccontext = CurrentMemoryContext;
+	context.planstate = NULL;
+	context.exprstates = NULL;
+
+	return get_matching_partitions(&context, pruning_steps);
+}
+
 /*
  * gen_partprune_steps_internal
  *		Processes 'clauses' to generate partition pruning steps.
@@ -0,0 +1,265 @@
+/*-------------------------------------------------------------------------
+ *
+ * ash_sampler.c
+ *	  Active session history sampler.
+ *
+ * pg_stat_activity only shows what a backend is doing right now, and
+ * EXPLAIN ANALYZE needs the query to be re-run.  To answer "where did this
+ * query spend its time" after the fact, the sampler process wakes up every
+ * gp_ash_sample_interval milliseconds and records, for every backend that
+ * is running a query, its wait event, the query's session id and command
+ * count, and the slice and plan node it is executing.  The samples go into
+ * a fixed-size ring buffer in shared memory of gp_ash_buffer_size entries,
+ * overwriting the oldest ones.
+ *
+ * One sampler runs on the coordinator and on each segment.  The
+ * gp_internal_tools extension reads the buffers of all of them, and since
+ * the (session id, command count) pair identifies the same query on the QD
+ * and its QEs, the samples can be aggregated per query cluster-wide.
+ *
+ * The sampler only reads other backends' state.  The slice and plan node
+ * are published by the backends themselves in their PGPROC, see
+ * ExecProcNodeGPDB(), and are read without locking, as pg_stat_activity
+ * does for wait events.  A sample may therefore be slightly inconsistent,
+ * which is fine for statistical purposes.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/postmaster/ash_sampler.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <signal.h>
+
+#include "libpq/pqsignal.h"
+#include "miscadmin.h"
+#include "pgstat.h"
+#include "postmaster/ash_sampler.h"
+#include "postmaster/bgworker.h"
+#include "storage/ipc.h"
+#include "storage/latch.h"
+#include "storage/lwlock.h"
+#include "storage/proc.h"
+#include "storage/procarray.h"
+#include "storage/shmem.h"
+#include "utils/guc.h"
+#include "utils/timestamp.h"
+
+/* GUCs */
+int			gp_ash_buffer_size = 0;
+int			gp_ash_sample_interval = 1000;
+
+typedef struct AshSharedState
+{
+	int			nsamples;		/* number of valid samples, up to size */
+	int			next;			/* where the next sample goes */
+	AshSample	samples[FLEXIBLE_ARRAY_MEMBER];
+} AshSharedState;
+
+static AshSharedState *ashShared = NULL;
+
+static volatile sig_atomic_t got_SIGHUP = false;
+
+static void AshSamplerLoop(void);
+static void AshTakeSamples(void);
+
+Size
+AshShmemSize(void)
+{
+	if (gp_ash_buffer_size <= 0)
+		return 0;
+
+	return add_size(offsetof(AshSharedState, samples),
+					mul_size(gp_ash_buffer_size, sizeof(AshSample)));
+}
+
+void
+AshShmemInit(void)
+{
+	bool		found;
+
+	if (gp_ash_buffer_size <= 0)
+		return;
+
+	ashShared = (AshSharedState *)
+		ShmemInitStruct("Active Session History", AshShmemSize(), &found);
+
+	if (!found)
+	{
+		ashShared->nsamples = 0;
+		ashShared->next = 0;
+	}
+}
+
+/*
+ * Copy all samples currently in the ring buffer into a palloc'd array,
+ * oldest first.  Returns the number of samples.
+ */
+int
+AshCopySamples(AshSample **samples)
+{
+	AshSample  *result;
+	int			nsamples;
+	int			first;
+	int			ntail;
+
+	*samples = NULL;
+	if (ashShared == NULL)
+		return 0;
+
+	/* Allocate for the worst case, so we don't palloc while holding the lock */
+	result = palloc(gp_ash_buffer_size * sizeof(AshSample));
+
+	LWLockAcquire(AshSamplerLock, LW_SHARED);
+
+	nsamples = ashShared->nsamples;
+	first = (nsamples < gp_ash_buffer_size) ? 0 : ashShared->next;
+	ntail = Min(nsamples, gp_ash_buffer_size - first);
+
+	memcpy(result, &ashShared->samples[first], ntail * sizeof(AshSample));
+	memcpy(result + ntail, &ashShared->samples[0],
+		   (nsamples - ntail) * sizeof(AshSample));
+
+	LWLockRelease(AshSamplerLock);
+
+	*samples = result;
+	return nsamples;
+}
+
+/* SIGHUP: set flag to reload config file */
+static void
+sigHupHandler(SIGNAL_ARGS)
+{
+	int			save_errno = errno;
+
+	got_SIGHUP = true;
+
+	if (MyProc)
+		SetLatch(&MyProc->procLatch);
+
+	errno = save_errno;
+}
+
+bool
+AshSamplerStartRule(Datum main_arg)
+{
+	return gp_ash_buffer_size > 0;
+}
+
+/*
+ * Entry point of the sampler process.
+ */
+void
+AshSamplerMain(Datum main_arg)
+{
+	pqsignal(SIGHUP, sigHupHandler);
+
+	/* We're now ready to receive signals */
+	BackgroundWorkerUnblockSignals();
+
+	AshSamplerLoop();
+
+	proc_exit(0);
+}
+
+static void
+AshSamplerLoop(void)
+{
+	for (;;)
+	{
+		int			rc;
+
+		if (got_SIGHUP)
+		{
+			got_SIGHUP = false;
+			ProcessConfigFile(PGC_SIGHUP);
+		}
+
+		AshTakeSamples();
+
+		rc = WaitLatch(&MyProc->procLatch,
+					   WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+					   gp_ash_sample_interval,
+					   WAIT_EVENT_ASH_SAMPLER_MAIN);
+		ResetLatch(&MyProc->procLatch);
+
+		/* emergency bailout if postmaster has died */
+		if (rc & WL_POSTMASTER_DEATH)
+			proc_exit(1);
+	}
+}
+
+/*
+ * Take one sample of every backend that is currently running a query.
+ */
+static void
+AshTakeSamples(void)
+{
+	AshSample  *batch;
+	TimestampTz now;
+	int			numbackends;
+	int			nbatch = 0;
+	int			i;
+
+	/* Make sure we look at a fresh snapshot of the backend status array */
+	pgstat_clear_snapshot();
+	numbackends = pgstat_fetch_stat_numbackends();
+	if (numbackends == 0)
+		return;
+
+	batch = palloc(numbackends * sizeof(AshSample));
+	now = GetCurrentTimestamp();
+
+	for (i = 1; i <= numbackends; i++)
+	{
+		LocalPgBackendStatus *local_beentry;
+		PgBackendStatus *beentry;
+		PGPROC	   *proc;
+		AshSample  *sample;
+
+		local_beentry = pgstat_fetch_stat_local_beentry(i);
+		if (local_beentry == NULL)
+			continue;
+		beentry = &local_beentry->backendStatus;
+
+		if (beentry->st_procpid == MyProcPid ||
+			beentry->st_backendType != B_BACKEND)
+			continue;
+		if (beentry->st_state != STATE_RUNNING &&
+			beentry->st_state != STATE_FASTPATH)
+			continue;
+
+		proc = BackendPidGetProc(beentry->st_procpid);
+		if (proc == NULL)
+			continue;
+
+		sample = &batch[nbatch++];
+		sample->sample_time = now;
+		sample->pid = beentry->st_procpid;
+		sample->sess_id = beentry->st_session_id;
+		sample->command_cnt = proc->queryCommandId;
+		sample->slice_id = proc->sliceId;
+		sample->plan_node_id = proc->planNodeId;
+		sample->wait_event_info = proc->wait_event_info;
+		sample->databaseid = beentry->st_databaseid;
+	}
+
+	if (nbatch > 0)
+	{
+		LWLockAcquire(AshSamplerLock, LW_EXCLUSIVE);
+		for (i = 0; i < nbatch; i++)
+		{
+			ashShared->samples[ashShared->next] = batch[i];
+			ashShared->next = (ashShared->next + 1) % gp_ash_buffer_size;
+		}
+		ashShared->nsamples = Min(ashShared->nsamples + nbatch,
+								  gp_ash_buffer_size);
+		LWLockRelease(AshSamplerLock);
+	}
+
+	pfree(batch);
+}
@@ -38,6 +38,7 @@
 #include "utils/ps_status.h"
 #include "utils/timeout.h"
 
+#include "postmaster/ash_sampler.h"
 #include "postmaster/backoff.h"
 #include "postmaster/fts.h"
 #include "utils/gdd.h"
@@ -152,6 +153,9 @@ static const struct
 	{
 		"BackoffSweeperMain", BackoffSweeperMain
 	},
+	{
+		"AshSamplerMain", AshSamplerMain
+	},
 #ifdef ENABLE_IC_PROXY
 	{
 		"ICProxyMain", ICProxyMain
@@ -3801,6 +3801,9 @@ pgstat_get_wait_activity(WaitEventActivity w)
 		case WAIT_EVENT_GLOBAL_DEADLOCK_DETECTOR_MAIN:
 			event_name = "GlobalDeadLockDetectorMain";
 			break;
+		case WAIT_EVENT_ASH_SAMPLER_MAIN:
+			event_name = "AshSamplerMain";
+			break;
 			/* no default case, so that compiler will warn */
 	}
 
@@ -117,6 +117,7 @@
 #include "pg_getopt.h"
 #include "pgstat.h"
 #include "port/pg_bswap.h"
+#include "postmaster/ash_sampler.h"
 #include "postmaster/autovacuum.h"
 #include "postmaster/bgworker_internals.h"
 #include "postmaster/bgwriter.h"
@@ -151,6 +152,7 @@
 #include "cdb/cdbtm.h"
 #include "cdb/cdbvars.h"
 #include "cdb/ic_proxy_bgworker.h"
+#include "cdb/ml_ipc.h"
 #include "utils/metrics_utils.h"
 
 /*
@@ -412,6 +414,13 @@ static BackgroundWorker PMAuxProcList[MaxPMAuxProc] =
 	 "postgres", "BackoffSweeperMain", 0, {0}, 0,
 	 BackoffSweeperStartRule},
 
+	{"ash sampler process", "ash sampler process",
+	 BGWORKER_SHMEM_ACCESS,
+	 BgWorkerStart_RecoveryFinished,
+	 0, /* restart immediately if ash sampler process exits with non-zero code */
+	 "postgres", "AshSamplerMain", 0, {0}, 0,
+	 AshSamplerStartRule},
+
 #ifdef ENABLE_IC_PROXY
 	{"ic proxy process", "ic proxy process",
 	 0,
@@ -3045,6 +3054,9 @@ reset_shared(int port)
 	 * objects if the postmaster crashes and is restarted.
 	 */
 	CreateSharedMemoryAndSemaphores(port);
+
+	/* GPDB: and the interconnect rings left behind by crashed backends */
+	ic_shmring_remove_orphans();
 }
 
 
@@ -30,6 +30,7 @@
 #include "executor/nodeShareInputScan.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "postmaster/ash_sampler.h"
 #include "postmaster/autovacuum.h"
 #include "postmaster/bgworker_internals.h"
 #include "postmaster/bgwriter.h"
@@ -61,6 +62,8 @@
 #include "libpq-fe.h"
 #include "libpq-int.h"
 #include "cdb/cdbfts.h"
+#include "cdb/cdbinitplancache.h"
+#include "cdb/cdbqueryfeedback.h"
 #include "cdb/cdbtm.h"
 #include "postmaster/backoff.h"
 #include "cdb/memquota.h"
@@ -195,6 +198,9 @@ CreateSharedMemoryAndSemaphores(int port)
 		size = add_size(size, CancelBackendMsgShmemSize());
 		size = add_size(size, WorkFileShmemSize());
 		size = add_size(size, ShareInputShmemSize());
+		size = add_size(size, InitPlanCacheShmemSize());
+		size = add_size(size, QueryFeedbackShmemSize());
+		size = add_size(size, AshShmemSize());
 
 #ifdef FAULT_INJECTOR
 		size = add_size(size, FaultInjector_ShmemSize());
@@ -358,6 +364,9 @@ CreateSharedMemoryAndSemaphores(int port)
 	BackendCancelShmemInit();
 	WorkFileShmemInit();
 	ShareInputShmemInit();
+	InitPlanCacheShmemInit();
+	QueryFeedbackShmemInit();
+	AshShmemInit();
 
 	/*
 	 * Set up Instrumentation free list
@@ -386,6 +386,8 @@ ProcArrayRemove(PGPROC *proc, TransactionId latestXid)
 		if (InvalidDistributedTransactionId != gxid &&
 			ShmemVariableCache->latestCompletedGxid < gxid)
 			ShmemVariableCache->latestCompletedGxid = gxid;
+		if (InvalidDistributedTransactionId != gxid)
+			ShmemVariableCache->gxactCompletionCount++;
 	}
 
 	for (index = 0; index < arrayP->numProcs; index++)
@@ -428,6 +430,10 @@ ProcArrayEndGxact(TMGXACT *tmGxact)
 	if (InvalidDistributedTransactionId != gxid &&
 		ShmemVariableCache->latestCompletedGxid < gxid)
 		ShmemVariableCache->latestCompletedGxid = gxid;
+
+	/* invalidates the distributed snapshots cached by CreateDistributedSnapshot */
+	if (InvalidDistributedTransactionId != gxid)
+		ShmemVariableCache->gxactCompletionCount++;
 }
 
 /*
@@ -1960,6 +1966,21 @@ DistributedSnapshotMappedEntry_Compare(const void *p1, const void *p2)
 		return -1;
 }
 
+/*
+ * The last distributed snapshot created by this backend.
+ *
+ * The set of distributed transactions a snapshot sees as in progress only
+ * changes when a distributed transaction ends, or a new gxid is handed out.
+ * As long as neither has happened, a new snapshot would have the same
+ * contents as the last one, so CreateDistributedSnapshot() returns a copy of
+ * it instead of scanning the proc array again.  That's the common case with
+ * read-mostly workloads, where most statements run without a gxid.
+ */
+static DistributedSnapshot cachedDistributedSnapshot = DistributedSnapshot_StaticInit;
+static bool cachedDistributedSnapshotValid = false;
+static uint64 cachedGxactCompletionCount;
+static DistributedTransactionId cachedNextGxid;
+
 /*
  * create distributed snapshot based on current visible distributed transaction
  */
@@ -1972,12 +1993,37 @@ CreateDistributedSnapshot(DistributedSnapshot *ds)
 	DistributedTransactionId xmax;
 	DistributedSnapshotId distribSnapshotId;
 	DistributedTransactionId globalXminDistributedSnapshots;
+	DistributedTransactionId nextGxid;
 	ProcArrayStruct *arrayP = procArray;
 
 	Assert(LWLockHeldByMe(ProcArrayLock));
 	if (*shmNumCommittedGxacts != 0)
 		elog(ERROR, "Create distributed snapshot before DTM recovery finish");
 
+	/*
+	 * nextGxid is protected by shmGxidGenLock rather than ProcArrayLock.
+	 * Reading it without the spinlock is good enough here, a gxid that is
+	 * being handed out concurrently would be missed by the scan below too.
+	 */
+	nextGxid = ShmemVariableCache->nextGxid;
+
+	if (cachedDistributedSnapshotValid &&
+		cachedGxactCompletionCount == ShmemVariableCache->gxactCompletionCount &&
+		cachedNextGxid == nextGxid)
+	{
+		DistributedSnapshot_Copy(ds, &cachedDistributedSnapshot);
+
+		if (MyTmGxact->xminDistributedSnapshot == InvalidDistributedTransactionId)
+			MyTmGxact->xminDistributedSnapshot = ds->xmin;
+
+		elog((Debug_print_snapshot_dtm ? LOG : DEBUG5),
+			 "[Distributed Snapshot #%u] *Reuse* (gxid = "UINT64_FORMAT"')",
+			 ds->distribSnapshotId,
+			 MyTmGxact->gxid);
+
+		return true;
+	}
+
 	xmin = xmax = ShmemVariableCache->latestCompletedGxid + 1;
 
 	/*
@@ -2064,6 +2110,11 @@ CreateDistributedSnapshot(DistributedSnapshot *ds)
 		 distribSnapshotId,
 		 MyTmGxact->gxid);
 
+	DistributedSnapshot_Copy(&cachedDistributedSnapshot, ds);
+	cachedGxactCompletionCount = ShmemVariableCache->gxactCompletionCount;
+	cachedNextGxid = nextGxid;
+	cachedDistributedSnapshotValid = true;
+
 	return true;
 }
 
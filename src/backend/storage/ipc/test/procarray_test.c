@@ -79,6 +79,8 @@ test__CreateDistributedSnapshot(void **state)
 	 * get adjusted correctly based on in-progress.
 	 */
 	allTmGxact[procArray->pgprocnos[0]].xminDistributedSnapshot = InvalidDistributedTransactionId;
+	/* don't let the previous snapshot be reused */
+	ShmemVariableCache->gxactCompletionCount++;
 
 	allTmGxact[procArray->pgprocnos[1]].gxid = 10;
 	allTmGxact[procArray->pgprocnos[1]].xminDistributedSnapshot = 5;
@@ -105,6 +107,7 @@ test__CreateDistributedSnapshot(void **state)
 	 * ascending sorted order with distributed transactions.
 	 */
 	allTmGxact[procArray->pgprocnos[0]].xminDistributedSnapshot = InvalidDistributedTransactionId;
+	ShmemVariableCache->gxactCompletionCount++;
 
 	allTmGxact[procArray->pgprocnos[3]].gxid = 15;
 	allTmGxact[procArray->pgprocnos[3]].xminDistributedSnapshot = 12;
@@ -136,6 +139,83 @@ test__CreateDistributedSnapshot(void **state)
 	free(procArray);
 }
 
+static void
+test__CreateDistributedSnapshot_Reuse(void **state)
+{
+	DistributedSnapshot ds;
+	DistributedSnapshotId firstId;
+
+	ds.inProgressXidArray =
+		(DistributedTransactionId*)malloc(SIZE_OF_IN_PROGRESS_ARRAY);
+
+	setup();
+
+#ifdef USE_ASSERT_CHECKING
+	expect_value_count(LWLockHeldByMe, l, ProcArrayLock, -1);
+	will_return_count(LWLockHeldByMe, true, -1);
+#endif
+
+	ShmemVariableCache->latestCompletedGxid = 24;
+	ShmemVariableCache->nextGxid = 31;
+	ShmemVariableCache->gxactCompletionCount = 100;
+
+	/* we don't have a gxid, another backend does */
+	allTmGxact[procArray->pgprocnos[0]].gxid = InvalidDistributedTransactionId;
+	allTmGxact[procArray->pgprocnos[0]].xminDistributedSnapshot = InvalidDistributedTransactionId;
+	allTmGxact[procArray->pgprocnos[1]].gxid = 30;
+	allTmGxact[procArray->pgprocnos[1]].xminDistributedSnapshot = 25;
+	procArray->numProcs = 2;
+
+	MyTmGxact = &allTmGxact[procArray->pgprocnos[0]];
+
+	CreateDistributedSnapshot(&ds);
+	firstId = ds.distribSnapshotId;
+	assert_true(ds.xmin == 25);
+	assert_true(ds.xmax == 30);
+	assert_true(ds.count == 1);
+	assert_true(ds.inProgressXidArray[0] == 30);
+
+	/*
+	 * Nothing has changed, so the same snapshot is handed out again, even
+	 * though the proc array isn't looked at.
+	 */
+	memset(ds.inProgressXidArray, 0, SIZE_OF_IN_PROGRESS_ARRAY);
+	allTmGxact[procArray->pgprocnos[0]].xminDistributedSnapshot = InvalidDistributedTransactionId;
+	procArray->numProcs = 0;
+	CreateDistributedSnapshot(&ds);
+	assert_true(ds.distribSnapshotId == firstId);
+	assert_true(ds.xmin == 25);
+	assert_true(ds.xmax == 30);
+	assert_true(ds.count == 1);
+	assert_true(ds.inProgressXidArray[0] == 30);
+	assert_true(MyTmGxact->xminDistributedSnapshot == 25);
+
+	/* The other transaction ends, which makes for a new snapshot */
+	allTmGxact[procArray->pgprocnos[1]].gxid = InvalidDistributedTransactionId;
+	allTmGxact[procArray->pgprocnos[1]].xminDistributedSnapshot = InvalidDistributedTransactionId;
+	procArray->numProcs = 2;
+	ShmemVariableCache->latestCompletedGxid = 30;
+	ShmemVariableCache->gxactCompletionCount++;
+	CreateDistributedSnapshot(&ds);
+	assert_true(ds.distribSnapshotId != firstId);
+	assert_true(ds.xmin == 31);
+	assert_true(ds.xmax == 31);
+	assert_true(ds.count == 0);
+	firstId = ds.distribSnapshotId;
+
+	/* So does handing out a new gxid */
+	allTmGxact[procArray->pgprocnos[1]].gxid = 31;
+	ShmemVariableCache->nextGxid = 32;
+	CreateDistributedSnapshot(&ds);
+	assert_true(ds.distribSnapshotId != firstId);
+	assert_true(ds.count == 1);
+	assert_true(ds.inProgressXidArray[0] == 31);
+
+	free(ds.inProgressXidArray);
+	free(allTmGxact);
+	free(procArray);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -143,7 +223,8 @@ main(int argc, char* argv[])
 
 	const UnitTest tests[] =
 	{
-		unit_test(test__CreateDistributedSnapshot)
+		unit_test(test__CreateDistributedSnapshot),
+		unit_test(test__CreateDistributedSnapshot_Reuse)
 	};
 
 	MemoryContextInit();
@@ -583,6 +583,8 @@ InitProcess(void)
 	MyProc->waitPortalId = INVALID_PORTALID;
 
 	MyProc->queryCommandId = -1;
+	MyProc->sliceId = -1;
+	MyProc->planNodeId = -1;
 
 	/* Init gxact */
 	MyTmGxact->gxid = InvalidDistributedTransactionId;
@@ -755,6 +757,8 @@ InitAuxiliaryProcess(void)
 	PGSemaphoreReset(MyProc->sem);
 
 	MyProc->queryCommandId = -1;
+	MyProc->sliceId = -1;
+	MyProc->planNodeId = -1;
 
 	/*
 	 * Arrange to clean up at process exit.
@@ -1389,12 +1389,22 @@ aosyncfiletag(const FileTag *ftag, char *path)
 	strlcpy(path, p, MAXPGPATH);
 	pfree(p);
 
-	File fd = PathNameOpenFile(path, O_RDWR);
-	if (fd <= 0)
-		elog(ERROR, "could not open file %s: %m", path);
+	/*
+	 * The file may have been dropped since the request was made; let
+	 * ProcessSyncRequests() check for a cancelling forget request on ENOENT.
+	 */
+	File fd = PathNameOpenFile(path, O_RDWR | PG_BINARY);
+	if (fd < 0)
+		return -1;
 
 	/* Try to fsync the file. */
-	return FileSync(fd, WAIT_EVENT_DATA_FILE_SYNC);
+	int			result = FileSync(fd, WAIT_EVENT_DATA_FILE_SYNC);
+	int			save_errno = errno;
+
+	FileClose(fd);
+	errno = save_errno;
+
+	return result;
 }
 
 /*
@@ -96,6 +96,7 @@
 #include "cdb/cdbdispatchresult.h"
 #include "cdb/cdbgang.h"
 #include "cdb/ml_ipc.h"
+#include "cdb/cdbreopt.h"
 #include "utils/guc.h"
 #include "access/twophase.h"
 #include "postmaster/backoff.h"
@@ -1728,7 +1729,8 @@ exec_simple_query(const char *query_string)
 		const char *commandTag;
 		char		completionTag[COMPLETION_TAG_BUFSIZE];
 		List	   *querytree_list,
-				   *plantree_list;
+				   *plantree_list,
+				   *reopt_querytree_list = NIL;
 		Portal		portal;
 		DestReceiver *receiver;
 		int16		format;
@@ -1819,6 +1821,14 @@ exec_simple_query(const char *query_string)
 		querytree_list = pg_analyze_and_rewrite(parsetree, query_string,
 												NULL, 0, NULL);
 
+		/*
+		 * GPDB: a SELECT may have to be planned again if one of its Broadcast
+		 * Motions turns out to be badly misestimated, see cdbreopt.c.  The
+		 * planner scribbles on its input, so keep a copy for that.
+		 */
+		if (AdaptiveReoptCandidate(querytree_list))
+			reopt_querytree_list = copyObject(querytree_list);
+
 		plantree_list = pg_plan_queries(querytree_list,
 										CURSOR_OPT_PARALLEL_OK, NULL);
 
@@ -1829,6 +1839,21 @@ exec_simple_query(const char *query_string)
 		/* If we got a cancel signal in analysis or planning, quit */
 		CHECK_FOR_INTERRUPTS();
 
+		if (reopt_querytree_list != NIL &&
+			AdaptiveReoptSetLimits(plantree_list))
+		{
+			MemoryContextSwitchTo(oldcontext);
+
+			AdaptiveReoptRunSelect(query_string,
+								   nodeTag(parsetree->stmt),
+								   commandTag,
+								   reopt_querytree_list,
+								   plantree_list,
+								   dest,
+								   completionTag);
+			goto portal_done;
+		}
+
 		/*
 		 * Create unnamed portal to run the query or queries in. If there
 		 * already is one, silently drop it.
@@ -1904,6 +1929,7 @@ exec_simple_query(const char *query_string)
 
 		PortalDrop(portal, false);
 
+portal_done:
 		if (lnext(parsetree_item) == NULL)
 		{
 			/*
@@ -5297,6 +5323,9 @@ PostgresMain(int argc, char *argv[],
 
 					/* get the client command serial# */
 					gp_command_count = pq_getmsgint(&input_message, 4);
+					MyProc->queryCommandId = gp_command_count;
+					MyProc->sliceId = -1;
+					MyProc->planNodeId = -1;
 
 					elog(DEBUG1, "Message type %c received by from libpq, len = %d", firstchar, input_message.len); /* TODO: Remove this */
 
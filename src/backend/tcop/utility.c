@@ -461,7 +461,8 @@ standard_ProcessUtility(PlannedStmt *pstmt,
 												  /* gp_dispatch */ false);
 							}
 
-							sendDtxExplicitBegin();
+							if (!deferDtxExplicitBegin())
+								sendDtxExplicitBegin();
 						}
 						break;
 
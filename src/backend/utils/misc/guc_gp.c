@@ -16,7 +16,9 @@
  */
 #include "postgres.h"
 
+#include <ctype.h>
 #include <float.h>
+#include <math.h>
 #include <sys/stat.h>
 #include <sys/unistd.h>
 
@@ -39,6 +41,8 @@
 #include "pgstat.h"
 #include "parser/scansup.h"
 #include "postmaster/syslogger.h"
+#include "postmaster/ash_sampler.h"
+#include "postmaster/bgworker_internals.h"
 #include "postmaster/fts.h"
 #include "replication/walsender.h"
 #include "storage/proc.h"
@@ -80,6 +84,11 @@ static bool check_verify_gpfdists_cert(bool *newval, void **extra, GucSource sou
 static bool check_dispatch_log_stats(bool *newval, void **extra, GucSource source);
 static bool check_gp_hashagg_default_nbatches(int *newval, void **extra, GucSource source);
 static bool check_gp_workfile_compression(bool *newval, void **extra, GucSource source);
+static bool check_optimizer_cost_model_params(char **newval, void **extra, GucSource source);
+
+#ifdef USE_ORCA
+extern bool GPOPTIsCostModelParam(const char *name);
+#endif
 
 /* Helper function for guc setter */
 bool gpvars_check_gp_resqueue_priority_default_value(char **newval,
@@ -141,6 +150,7 @@ bool		gp_appendonly_verify_block_checksums = true;
 bool		gp_appendonly_verify_write_block = false;
 bool		gp_appendonly_compaction = true;
 int			gp_appendonly_compaction_threshold = 0;
+int			gp_appendonly_vacuum_parallel_workers = 0;
 bool		gp_heap_require_relhasoids_match = true;
 bool		gp_local_distributed_cache_stats = false;
 bool		debug_xlog_record_read = false;
@@ -249,6 +259,7 @@ bool		dml_ignore_target_partition_check = false;
 /* Planner gucs */
 bool		gp_enable_hashjoin_size_heuristic = false;
 bool		gp_enable_predicate_propagation = false;
+bool		gp_enable_skew_join = false;
 bool		gp_enable_minmax_optimization = true;
 bool		gp_enable_multiphase_agg = true;
 bool		gp_enable_preunique = true;
@@ -257,10 +268,23 @@ bool		gp_enable_dqa_pruning = true;
 bool		gp_dynamic_partition_pruning = true;
 bool		gp_log_dynamic_partition_pruning = false;
 bool		gp_cte_sharing = false;
+bool		gp_enable_initplan_cache = false;
+bool		gp_enable_dispatch_plan_cache = true;
 bool		gp_enable_relsize_collection = false;
 bool		gp_recursive_cte = true;
 bool		gp_eager_two_phase_agg = false;
 
+/* Adaptive re-optimization of misestimated Broadcast Motions */
+double		gp_adaptive_reopt_ratio = 0;
+int			gp_adaptive_reopt_min_rows = 100000;
+int			gp_adaptive_reopt_max_result_size = 16384;
+
+/* Cardinality feedback for GPORCA, see cdbqueryfeedback.c */
+bool		gp_enable_query_feedback = false;
+
+/* Host-aware Broadcast Motions, see cdbhostbcast.c */
+bool		gp_enable_host_broadcast = false;
+
 /* Optimizer related gucs */
 bool		optimizer;
 bool		optimizer_log;
@@ -270,6 +294,7 @@ bool		optimizer_trace_fallback;
 bool		optimizer_partition_selection_log;
 int			optimizer_minidump;
 int			optimizer_cost_model;
+char	   *optimizer_cost_model_params;
 bool		optimizer_metadata_caching;
 int			optimizer_mdcache_size;
 bool		optimizer_use_gpdb_allocators;
@@ -286,6 +311,7 @@ bool		optimizer_print_expression_properties;
 bool		optimizer_print_group_properties;
 bool		optimizer_print_optimization_context;
 bool		optimizer_print_optimization_stats;
+bool		optimizer_print_wrapper_calls;
 bool		optimizer_print_xform_results;
 
 /* array of xforms disable flags */
@@ -303,6 +329,7 @@ bool		optimizer_enable_sort;
 bool		optimizer_enable_materialize;
 bool		optimizer_enable_partition_propagation;
 bool		optimizer_enable_partition_selection;
+bool		optimizer_enable_static_partition_prefilter;
 bool		optimizer_enable_outerjoin_rewrite;
 bool		optimizer_enable_multiple_distinct_aggs;
 bool		optimizer_enable_direct_dispatch;
@@ -378,6 +405,9 @@ bool		optimizer_cte_inlining;
 bool		optimizer_enable_space_pruning;
 bool		optimizer_enable_associativity;
 bool		optimizer_enable_eageragg;
+bool		optimizer_enable_foreign_key_stats;
+bool		optimizer_enable_foreign_key_join_elimination;
+bool		optimizer_enable_extended_stats;
 bool		optimizer_enable_range_predicate_dpe;
 
 /* Analyze related GUCs for Optimizer */
@@ -403,6 +433,9 @@ bool		gp_reject_internal_tcp_conn = true;
 
 /* copy */
 bool		gp_enable_segment_copy_checking = true;
+
+/* CREATE INDEX */
+bool		gp_enable_parallel_index_build = false;
 /*
  * Default storage options GUC.  Value is comma-separated name=value
  * pairs.  E.g. "appendonly=true,orientation=column"
@@ -630,6 +663,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"gp_enable_skew_join", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables skew-resilient redistribution of join inputs."),
+			gettext_noop("When both inputs of a join are redistributed and the "
+						 "larger one has very frequent join key values, spread "
+						 "those rows evenly and broadcast the matching rows "
+						 "of the smaller input.")
+		},
+		&gp_enable_skew_join,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"debug_print_prelim_plan", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Prints the preliminary execution plan to server log."),
@@ -1010,6 +1055,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_bypass_loopback", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Send Motion data between processes on the same host through shared memory rather than the loopback interface."),
+			gettext_noop("Only used by the UDP interconnect."),
+		},
+		&gp_interconnect_bypass_loopback,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"resource_scheduler", PGC_POSTMASTER, RESOURCES_MGM,
 			gettext_noop("Enable resource scheduling."),
@@ -1670,6 +1725,62 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_enable_initplan_cache", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Reuse results of deterministic InitPlans across queries."),
+			gettext_noop("A result is reused only while none of the relations "
+						 "the query reads have been modified since.")
+		},
+		&gp_enable_initplan_cache,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_enable_query_feedback", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Correct GPORCA cardinality estimates with row counts observed by EXPLAIN ANALYZE."),
+			gettext_noop("Row counts are recorded by EXPLAIN ANALYZE and auto_explain.log_analyze, "
+						 "and used when GPORCA plans a query with the same predicates again.")
+		},
+		&gp_enable_query_feedback,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_enable_host_broadcast", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Send one copy of a broadcast to each segment host, and copy it to the other segments of the host locally."),
+			gettext_noop("Each such Broadcast Motion needs an extra slice.")
+		},
+		&gp_enable_host_broadcast,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_enable_dispatch_plan_cache", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Reuse the serialized plan of repeatedly executed single-segment statements."),
+			gettext_noop("Applies to cached plans, such as prepared statements, that are "
+						 "directly dispatched to one segment.")
+		},
+		&gp_enable_dispatch_plan_cache,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_enable_read_only_dtx_deferral", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Don't start a distributed transaction for read-only transaction blocks until it is needed."),
+			gettext_noop("Applies to READ COMMITTED transaction blocks. Their queries run "
+						 "on the segments like auto-commit queries do, until a cursor, "
+						 "a savepoint, a write or a utility statement needs the "
+						 "distributed transaction.")
+		},
+		&gp_enable_read_only_dtx_deferral,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_cte_sharing", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("This guc enables sharing of plan fragments for common table expressions."),
@@ -1955,6 +2066,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_print_wrapper_calls", PGC_USERSET, LOGGING_WHAT,
+			gettext_noop("Print the number of calls from the optimizer into the catalog and other backend functions."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_print_wrapper_calls,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_extract_dxl_stats", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Extract plan stats in dxl."),
@@ -2085,6 +2207,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"optimizer_enable_static_partition_prefilter", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Prune partitions by simple WHERE clause restrictions before retrieving their metadata for the optimizer."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_static_partition_prefilter,
+		true,
+		NULL, NULL, NULL
+	},
 	{
 		{"optimizer_enable_outerjoin_rewrite", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Enable outer join to inner join rewrite in the optimizer."),
@@ -2667,6 +2799,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_enable_parallel_index_build", PGC_USERSET, RESOURCES_ASYNCHRONOUS,
+			gettext_noop("Allow each segment to build btree indexes with parallel workers."),
+			gettext_noop("The number of workers per segment is limited by max_parallel_maintenance_workers.")
+		},
+		&gp_enable_parallel_index_build,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_ignore_error_table", PGC_USERSET, COMPAT_OPTIONS_PREVIOUS,
 			gettext_noop("Ignore INTO error-table in external table and COPY (Deprecated)."),
@@ -2773,6 +2915,41 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_enable_foreign_key_stats", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Use foreign keys to estimate the cardinality of joins."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_foreign_key_stats,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_enable_foreign_key_join_elimination", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Eliminate inner joins to a table referenced by a foreign key when none of its columns are used."),
+			gettext_noop("Foreign keys are not enforced, so this can change query results if the "
+						 "constraint does not hold."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_foreign_key_join_elimination,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_enable_extended_stats", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Use extended statistics to estimate the cardinality of filters and group by."),
+			gettext_noop("Functional dependencies and multi-column ndistinct coefficients "
+						 "built for CREATE STATISTICS objects are used for correlated columns."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_extended_stats,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_prune_unused_columns", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Prune unused table columns during query optimization."),
@@ -2857,6 +3034,18 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_direct_dispatch_max_values", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the maximum number of distribution key values considered for direct dispatch."),
+			gettext_noop("IN-lists, ANY(array) conditions and multi-row VALUES inserts with more "
+						 "distribution key values than this are dispatched to all segments."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_direct_dispatch_max_values,
+		1000, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"debug_dtm_action_segment", PGC_SUSET, DEVELOPER_OPTIONS,
 			gettext_noop("Sets the debug DTM action segment."),
@@ -2983,6 +3172,17 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_appendonly_vacuum_parallel_workers", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Sets the maximum number of parallel workers each segment uses to vacuum the indexes of an append-optimized table."),
+			gettext_noop("The number is also limited by max_parallel_maintenance_workers. "
+						 "Zero disables parallel index vacuuming.")
+		},
+		&gp_appendonly_vacuum_parallel_workers,
+		0, 0, MAX_PARALLEL_WORKER_LIMIT,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_workfile_max_entries", PGC_POSTMASTER, RESOURCES,
 			gettext_noop("Sets the maximum number of entries that can be stored in the workfile directory"),
@@ -3782,6 +3982,25 @@ struct config_int ConfigureNamesInt_gp[] =
 		120, 5, INT_MAX, NULL, NULL
 	},
 
+	{
+		{"gp_ash_buffer_size", PGC_POSTMASTER, STATS_MONITORING,
+			gettext_noop("Sets the number of active session history samples kept in shared memory."),
+			gettext_noop("Zero disables the active session history sampler.")
+		},
+		&gp_ash_buffer_size,
+		0, 0, INT_MAX / 1024, NULL, NULL
+	},
+
+	{
+		{"gp_ash_sample_interval", PGC_SIGHUP, STATS_MONITORING,
+			gettext_noop("Sets the interval between active session history samples."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&gp_ash_sample_interval,
+		1000, 10, INT_MAX, NULL, NULL
+	},
+
 	{
 		{"optimizer_plan_id", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Choose a plan alternative"),
@@ -3983,6 +4202,37 @@ struct config_int ConfigureNamesInt_gp[] =
 		0, 0, INT_MAX, NULL, NULL
 	},
 
+	{
+		{"gp_motion_skew_min_rows", PGC_USERSET, LOGGING_WHAT,
+			gettext_noop("Minimum number of rows a Redistribute Motion must send before skew is reported."),
+			NULL
+		},
+		&gp_motion_skew_min_rows,
+		10000, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_adaptive_reopt_min_rows", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Minimum number of rows a Broadcast Motion must receive before the query is planned again."),
+			NULL
+		},
+		&gp_adaptive_reopt_min_rows,
+		100000, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_adaptive_reopt_max_result_size", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the maximum size of the result held back by a SELECT that may be planned again."),
+			gettext_noop("A larger result is sent as it is produced, and the query cannot be planned again."),
+			GUC_UNIT_KB
+		},
+		&gp_adaptive_reopt_max_result_size,
+		16384, 64, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0, 0, 0, NULL, NULL
@@ -4025,6 +4275,27 @@ struct config_real ConfigureNamesReal_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_motion_skew_warning_ratio", PGC_USERSET, LOGGING_WHAT,
+			gettext_noop("Warns when a Redistribute Motion sends this many times the average row count to one segment."),
+			gettext_noop("0 disables the check.")
+		},
+		&gp_motion_skew_warning_ratio,
+		0, 0, DBL_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_adaptive_reopt_ratio", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Plans a SELECT again when a Broadcast Motion receives this many times its estimated row count."),
+			gettext_noop("Only applies to read-only SELECT statements planned by GPORCA "
+						 "that have not returned any rows yet. 0 disables it.")
+		},
+		&gp_adaptive_reopt_ratio,
+		0, 0, DBL_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_resqueue_priority_cpucores_per_segment", PGC_POSTMASTER, RESOURCES_MGM,
 			gettext_noop("Number of processing units associated with a segment."),
@@ -4261,6 +4532,20 @@ struct config_string ConfigureNamesString_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_cost_model_params", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Overrides parameters of the optimizer cost model."),
+			gettext_noop("A comma-separated list of name=value pairs, using the "
+						 "parameter names of the GPDB cost model, e.g. "
+						 "\"TableScanCostUnit=5.5e-07,SortTupWidthCostUnit=5.67e-06\". "
+						 "Typically generated by the cost model calibration tool."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_cost_model_params,
+		"",
+		check_optimizer_cost_model_params, NULL, NULL
+	},
+
 	{
 		{"gp_default_storage_options", PGC_USERSET, APPENDONLY_TABLES,
 			gettext_noop("default options for appendonly storage."),
@@ -4680,6 +4965,76 @@ check_optimizer(bool *newval, void **extra, GucSource source)
 	return true;
 }
 
+/*
+ * Check the syntax of optimizer_cost_model_params, and that the names are
+ * parameters of the GPDB cost model.
+ */
+static bool
+check_optimizer_cost_model_params(char **newval, void **extra, GucSource source)
+{
+	const char *p = *newval;
+
+	while (*p)
+	{
+		const char *name;
+		char	   *end;
+		double		value;
+
+		while (isspace((unsigned char) *p))
+			p++;
+		name = p;
+		while (isalnum((unsigned char) *p))
+			p++;
+		if (p == name || p - name >= NAMEDATALEN)
+		{
+			GUC_check_errdetail("Expected a cost model parameter name at \"%s\".", name);
+			return false;
+		}
+#ifdef USE_ORCA
+		{
+			char		namebuf[NAMEDATALEN];
+
+			strlcpy(namebuf, name, p - name + 1);
+			if (!GPOPTIsCostModelParam(namebuf))
+			{
+				GUC_check_errdetail("Unrecognized cost model parameter \"%s\".", namebuf);
+				return false;
+			}
+		}
+#endif
+		while (isspace((unsigned char) *p))
+			p++;
+		if (*p != '=')
+		{
+			GUC_check_errdetail("Expected \"=\" after the cost model parameter name.");
+			return false;
+		}
+		p++;
+
+		errno = 0;
+		value = strtod(p, &end);
+		if (end == p || errno != 0 || value < 0 || isinf(value) || isnan(value))
+		{
+			GUC_check_errdetail("Invalid value for cost model parameter \"%.*s\".",
+								(int) (strcspn(name, " =")), name);
+			return false;
+		}
+		p = end;
+
+		while (isspace((unsigned char) *p))
+			p++;
+		if (*p == ',')
+			p++;
+		else if (*p != '\0')
+		{
+			GUC_check_errdetail("Expected \",\" between cost model parameters.");
+			return false;
+		}
+	}
+
+	return true;
+}
+
 static bool
 check_verify_gpfdists_cert(bool *newval, void **extra, GucSource source)
 {
@@ -294,6 +294,7 @@ IsMemoryIntensiveOperator(Node *node, PlannedStmt *stmt)
 	switch(nodeTag(node))
 	{
 		case T_Material:
+		case T_Memoize:
 		case T_Sort:
 		case T_ShareInputScan:
 		case T_Hash:
@@ -154,6 +154,9 @@ typedef struct VariableCacheData
 										 * aborted */
 	TransactionId latestCompletedGxid;	/* newest distributed XID that has
 										   committed or aborted */
+	uint64		gxactCompletionCount;	/* # of distributed transactions that
+										 * have ended, protected by
+										 * ProcArrayLock */
 
 	/*
 	 * The two variables are protected by shmGxidGenLock.  Note nextGxid won't
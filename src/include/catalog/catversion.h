@@ -56,6 +56,6 @@
  */
 
 /*							3yyymmddN */
-#define CATALOG_VERSION_NO	302104021
+#define CATALOG_VERSION_NO	302104024
 
 #endif
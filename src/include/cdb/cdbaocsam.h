@@ -296,6 +296,8 @@ extern AOCSScanDesc aocs_beginrangescan(Relation relation, Snapshot snapshot,
 										Snapshot appendOnlyMetaDataSnapshot,
 										int *segfile_no_arr, int segfile_count);
 
+extern BlockNumber aocs_segfiles_nblocks(AOCSFileSegInfo **seginfo, int nseg);
+
 extern void aocs_rescan(AOCSScanDesc scan);
 extern void aocs_endscan(AOCSScanDesc scan);
 
@@ -241,6 +241,25 @@ typedef struct AppendOnlyScanDescData
 
 typedef AppendOnlyScanDescData *AppendOnlyScanDesc;
 
+/*
+ * Shared state for parallel scans of append-optimized tables, both row and
+ * column oriented.
+ *
+ * The unit of work handed out to the participants is a whole segment file:
+ * every participant reads the same list of segfiles from pg_aoseg, sorted
+ * by segno, and claims the next index into that list when it is done with
+ * its current one.
+ */
+typedef struct ParallelAOScanDescData
+{
+	ParallelTableScanDescData base;
+
+	pg_atomic_uint32 pas_next_segfile;	/* index of the next segfile to
+										 * hand out */
+} ParallelAOScanDescData;
+
+typedef ParallelAOScanDescData *ParallelAOScanDesc;
+
 /*
  * Statistics on the latest fetch.
  */
@@ -371,6 +390,15 @@ extern TableScanDesc appendonly_beginscan(Relation relation,
 										  int nkeys, struct ScanKeyData *key,
 										  ParallelTableScanDesc pscan,
 										  uint32 flags);
+extern Size appendonly_parallelscan_estimate(Relation rel);
+extern Size appendonly_parallelscan_initialize(Relation rel,
+											   ParallelTableScanDesc pscan);
+extern void appendonly_parallelscan_reinitialize(Relation rel,
+												 ParallelTableScanDesc pscan);
+extern int appendonly_parallelscan_nextsegfile(ParallelTableScanDesc pscan,
+											   int total_segfiles);
+extern BlockNumber appendonly_segfiles_nblocks(FileSegInfo **segfile_arr,
+											   int nsegfiles);
 extern void appendonly_rescan(TableScanDesc scan, ScanKey key,
 								bool set_params, bool allow_strat,
 								bool allow_sync, bool allow_pagemode);
@@ -0,0 +1,22 @@
+/*-------------------------------------------------------------------------
+ *
+ * cdbhostbcast.h
+ *	  Host-aware Broadcast Motions.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/cdb/cdbhostbcast.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef CDBHOSTBCAST_H
+#define CDBHOSTBCAST_H
+
+#include "nodes/plannodes.h"
+
+extern void ApplyHostBroadcast(PlannedStmt *stmt);
+extern int	GetSegmentHostCount(void);
+
+#endif   /* CDBHOSTBCAST_H */
@@ -0,0 +1,30 @@
+/*-------------------------------------------------------------------------
+ *
+ * cdbinitplancache.h
+ *	  Session-local cache of dispatched InitPlan results on the QD.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/cdb/cdbinitplancache.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef CDBINITPLANCACHE_H
+#define CDBINITPLANCACHE_H
+
+#include "executor/execdesc.h"
+#include "nodes/execnodes.h"
+#include "nodes/plannodes.h"
+
+extern Size InitPlanCacheShmemSize(void);
+extern void InitPlanCacheShmemInit(void);
+
+extern void InitPlanCacheNoteWrites(PlannedStmt *stmt);
+extern void InitPlanCacheNoteRelationWrite(Oid relid);
+
+extern bool InitPlanCacheLookup(QueryDesc *queryDesc, SubPlanState *sps);
+extern void InitPlanCacheStore(QueryDesc *queryDesc, SubPlanState *sps);
+
+#endif   /* CDBINITPLANCACHE_H */
@@ -110,6 +110,19 @@ typedef enum MotionConnState
 	mcsEosSent
 } MotionConnState;
 
+/*
+ * Whether a UDP interconnect connection within a host carries its data
+ * packets through a shared memory ring, see ic_shmring.c.
+ */
+typedef enum MotionConnShmState
+{
+	mcsShmUnused,				/* not on the same host, or disabled */
+	mcsShmEligible,				/* receiver: may offer a ring to the sender */
+	mcsShmOffered,				/* sender: the receiver has created a ring */
+	mcsShmActive,				/* data packets go through the ring */
+	mcsShmFailed				/* could not set up the ring, stay on UDP */
+} MotionConnShmState;
+
 typedef struct ICBuffer ICBuffer;
 typedef struct ICBufferLink ICBufferLink;
 
@@ -283,6 +296,10 @@ struct MotionConn
 	int			pkt_q_tail;
 	uint8		**pkt_q;
 
+	/* shared memory ring of a connection within a host */
+	MotionConnShmState shmState;
+	struct ICShmRing *shmRing;
+
 	uint64 stat_total_ack_time;
 	uint64 stat_count_acks;
 	uint64 stat_max_ack_time;
@@ -344,6 +361,13 @@ typedef struct ChunkTransportStateEntry
 
 	bool		sendingEos;
 
+	/*
+	 * For a host-aware Broadcast sender, the connections that broadcast
+	 * tuples go to (see cdbhostbcast.c).  NULL means all of them.
+	 * End-of-stream messages always go to all of them.
+	 */
+	bool	   *broadcastTargets;
+
 	/* Statistics info for this motion on the interconnect level */
 	uint64 stat_total_ack_time;
 	uint64 stat_count_acks;
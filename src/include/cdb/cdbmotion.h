@@ -122,6 +122,9 @@ extern void SendStopMessage(MotionLayerState *mlStates,
 							ChunkTransportState *transportStates,
 							int16 motNodeID);
 
+/* bytes sent and received so far by a motion node, for progress reporting */
+extern uint64 GetMotionNodeBytes(MotionLayerState *mlStates, int16 motNodeID);
+
 /* used by ml_ipc to set the number of receivers that the motion node is expecting.
  * This is used by cdbmotion to keep track of when its seen enough EndOfStream
  * messages.
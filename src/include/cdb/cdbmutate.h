@@ -50,6 +50,7 @@ extern Node *makeSegmentFilterExpr(int segid);
 
 extern Node *exec_make_plan_constant(struct PlannedStmt *stmt, EState *estate,
 						bool is_SRI, List **cursorPositions);
+extern bool exec_plan_needs_constant_folding(struct PlannedStmt *stmt);
 extern void remove_subquery_in_RTEs(Node *node);
 
 extern Plan *cdbpathtoplan_create_sri_plan(RangeTblEntry *rte, PlannerInfo *subroot, Path *subpath, int createplan_flags);
@@ -0,0 +1,39 @@
+/*-------------------------------------------------------------------------
+ *
+ * cdbqueryfeedback.h
+ *	  Row counts observed by EXPLAIN ANALYZE, to correct GPORCA estimates.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/cdb/cdbqueryfeedback.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef CDBQUERYFEEDBACK_H
+#define CDBQUERYFEEDBACK_H
+
+#include "datatype/timestamp.h"
+
+/* Maximum number of base tables below a recorded plan node */
+#define QUERY_FEEDBACK_MAX_RELS		8
+
+typedef struct QueryFeedbackEntry
+{
+	uint32		signature;		/* hash key, must be first */
+	double		rows;			/* rows produced by the last execution */
+	TimestampTz recorded;		/* when 'rows' was recorded */
+	int			nrels;			/* number of valid entries in relids */
+	Oid			relids[QUERY_FEEDBACK_MAX_RELS];	/* tables it was read from */
+} QueryFeedbackEntry;
+
+extern Size QueryFeedbackShmemSize(void);
+extern void QueryFeedbackShmemInit(void);
+
+extern void QueryFeedbackRecord(uint32 signature, double rows,
+								int nrels, const Oid *relids);
+extern void QueryFeedbackForgetRelation(Oid relid);
+extern QueryFeedbackEntry *QueryFeedbackSnapshot(int *nentries);
+
+#endif   /* CDBQUERYFEEDBACK_H */
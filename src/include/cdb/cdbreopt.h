@@ -0,0 +1,30 @@
+/*-------------------------------------------------------------------------
+ *
+ * cdbreopt.h
+ *	  Adaptive re-optimization of SELECTs with misestimated Broadcast Motions.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/cdb/cdbreopt.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef CDBREOPT_H
+#define CDBREOPT_H
+
+#include "nodes/pg_list.h"
+#include "tcop/dest.h"
+
+extern bool AdaptiveReoptCandidate(List *querytree_list);
+extern bool AdaptiveReoptSetLimits(List *plantree_list);
+extern void AdaptiveReoptRunSelect(const char *query_string,
+								   NodeTag sourceTag,
+								   const char *commandTag,
+								   List *querytree_list,
+								   List *plantree_list,
+								   CommandDest dest,
+								   char *completionTag);
+
+#endif   /* CDBREOPT_H */
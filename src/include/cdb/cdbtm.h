@@ -227,6 +227,9 @@ typedef struct TMGXACTLOCAL
 	
 	bool						explicitBeginRemembered;
 
+	/* Explicit BEGIN of a read-only transaction block, not activated yet */
+	bool						explicitBeginDeferred;
+
 	/* Used on QE, indicates the transaction applies one-phase commit protocol */
 	bool						isOnePhaseCommit;
 
@@ -264,6 +267,7 @@ typedef enum
 
 extern int max_tm_gxacts;
 extern int gp_gxid_prefetch_num;
+extern bool gp_enable_read_only_dtx_deferral;
 
 extern DtxContext DistributedTransactionContext;
 
@@ -309,6 +313,8 @@ extern void bumpGxid(void);
 extern bool isCurrentDtxActivated(void);
 
 extern void sendDtxExplicitBegin(void);
+extern bool deferDtxExplicitBegin(void);
+extern void activateDeferredDtxExplicitBegin(void);
 extern bool isDtxExplicitBegin(void);
 
 extern bool dispatchDtxCommand(const char *cmd);
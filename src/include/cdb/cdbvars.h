@@ -355,6 +355,15 @@ extern bool gp_interconnect_log_stats;
 
 extern bool gp_interconnect_cache_future_packets;
 
+/*
+ * Parameter gp_interconnect_bypass_loopback
+ *
+ * With the UDP interconnect, send the data packets between a sender and a
+ * receiver on the same host through shared memory, rather than the loopback
+ * interface.
+ */
+extern bool gp_interconnect_bypass_loopback;
+
 #define UNDEF_SEGMENT -2
 
 /*
@@ -407,6 +416,9 @@ extern bool gp_enable_fast_sri;
 /* Enable single-mirror pair dispatch. */
 extern bool gp_enable_direct_dispatch;
 
+/* Max number of distribution key values to hash for multi-segment direct dispatch. */
+extern int	gp_direct_dispatch_max_values;
+
 /* Name of pseudo-function to access any table as if it was randomly distributed. */
 #define GP_DIST_RANDOM_NAME "GP_DIST_RANDOM"
 
@@ -452,6 +464,17 @@ extern int gp_log_fts;
  */
 extern int gp_log_interconnect;
 
+/*
+ * gp_motion_skew_warning_ratio, gp_motion_skew_min_rows
+ *
+ * A Redistribute Motion sender that has sent at least gp_motion_skew_min_rows
+ * rows, and has sent gp_motion_skew_warning_ratio times the per-segment
+ * average or more to a single segment, emits a WARNING naming that segment
+ * and the most frequent distribution key values it saw.  0 disables it.
+ */
+extern double gp_motion_skew_warning_ratio;
+extern int	gp_motion_skew_min_rows;
+
 /* --------------------------------------------------------------------------------------------------
  * Greenplum Optimizer GUCs
  */
@@ -599,6 +622,51 @@ extern bool gp_dynamic_partition_pruning;
 
 /* Sharing of plan fragments for common table expressions */
 extern bool gp_cte_sharing;
+
+/* Reuse results of InitPlans across queries, see cdbinitplancache.c */
+extern bool gp_enable_initplan_cache;
+
+/*
+ * gp_adaptive_reopt_ratio, gp_adaptive_reopt_min_rows
+ *
+ * A SELECT planned by GPORCA is planned again, with broadcasts penalized,
+ * when one of its Broadcast Motions receives more than
+ * gp_adaptive_reopt_ratio times its estimated row count, and at least
+ * gp_adaptive_reopt_min_rows rows.  0 disables it.  See cdbreopt.c.
+ */
+extern double gp_adaptive_reopt_ratio;
+extern int	gp_adaptive_reopt_min_rows;
+
+/*
+ * gp_adaptive_reopt_max_result_size
+ *
+ * Maximum size in kB of the result a SELECT that may be planned again holds
+ * back until it has run to completion.  Past it, the query runs again
+ * without row limits, and sends its result as it is produced.
+ */
+extern int	gp_adaptive_reopt_max_result_size;
+
+/*
+ * gp_enable_query_feedback
+ *
+ * Record the actual row counts of GPORCA plans run by EXPLAIN ANALYZE, and
+ * use them to correct the estimates of later queries with the same tables
+ * and predicates.  See cdbqueryfeedback.c.
+ */
+extern bool gp_enable_query_feedback;
+
+/*
+ * gp_enable_host_broadcast
+ *
+ * Send only one copy of each broadcast row to a segment host with several
+ * segments, and let that host pass it on to its other segments.  Also makes
+ * GPORCA cost Broadcast Motions accordingly.  See cdbhostbcast.c.
+ */
+extern bool gp_enable_host_broadcast;
+
+/* Reuse serialized plans of single-segment statements, see cdbdisp_query.c */
+extern bool gp_enable_dispatch_plan_cache;
+
 /* Enable RECURSIVE clauses in common table expressions */
 extern bool gp_recursive_cte;
 
@@ -329,6 +329,8 @@ typedef struct GpDistributionData
 {
 	GpPolicy   *policy;		/* partitioning policy for this table */
 	CdbHash	   *cdbHash;	/* corresponding CdbHash object */
+	ExprState  *hashExprState;	/* computes the hash of a row's keys */
+	ExprContext *econtext;		/* for evaluating hashExprState */
 } GpDistributionData;
 
 #endif							/* COPY_H */
@@ -20,7 +20,9 @@
 #include "catalog/pg_type.h"
 #include "nodes/parsenodes.h"
 #include "storage/buf.h"
+#include "storage/dsm.h"
 #include "storage/lock.h"
+#include "storage/shm_toc.h"
 #include "utils/relcache.h"
 #include "utils/snapshot.h"
 
@@ -327,6 +329,7 @@ extern void ao_vacuum_rel_compact(Relation onerel, int options, VacuumParams *pa
 								  BufferAccessStrategy bstrategy);
 extern void ao_vacuum_rel_post_cleanup(Relation onerel, int options, VacuumParams *params,
 									   BufferAccessStrategy bstrategy);
+extern void appendonly_parallel_vacuum_main(dsm_segment *seg, shm_toc *toc);
 
 extern bool std_typanalyze(VacAttrStats *stats);
 
@@ -239,6 +239,16 @@ typedef enum ExprEvalOp
 	EEOP_AGG_ORDERED_TRANS_DATUM,
 	EEOP_AGG_ORDERED_TRANS_TUPLE,
 
+	/*
+	 * Add a distribution key to the distribution hash, see
+	 * ExecBuildCdbHash().  The _INT4 and _INT8 variants inline the default
+	 * hash functions of those types.
+	 */
+	EEOP_CDBHASH,
+	EEOP_CDBHASH_INT4,
+	EEOP_CDBHASH_INT8,
+	EEOP_CDBHASH_LEGACY,
+
 	/* non-existent operation, used e.g. to check array lengths */
 	EEOP_LAST
 } ExprEvalOp;
@@ -713,6 +723,16 @@ typedef struct ExprEvalStep
 			int			transno;
 			int			setoff;
 		}			agg_trans;
+
+		/* for EEOP_CDBHASH* */
+		struct
+		{
+			FmgrInfo   *finfo;	/* hash function's lookup data */
+			FunctionCallInfo fcinfo_data;	/* key is evaluated into args[0] */
+			/* faster to access without additional indirection: */
+			PGFunction	fn_addr;	/* actual call address */
+			bool		first;	/* first key, no hash to combine with yet? */
+		}			cdbhash;
 	}			d;
 } ExprEvalStep;
 
@@ -804,6 +824,7 @@ extern void ExecEvalConvertRowtype(ExprState *state, ExprEvalStep *op,
 extern void ExecEvalScalarArrayOp(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalScalarArrayOpFastInt(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalScalarArrayOpFastStr(ExprState *state, ExprEvalStep *op);
+extern void ExecEvalCdbHashLegacy(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalConstraintNotNull(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalConstraintCheck(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalXmlExpr(ExprState *state, ExprEvalStep *op);
@@ -24,6 +24,7 @@
 #include "cdb/cdbdef.h"                 /* CdbVisitOpt */
 
 struct ChunkTransportState;             /* #include "cdb/cdbinterconnect.h" */
+struct CdbHash;                         /* #include "cdb/cdbhash.h" */
 
 /*
  * The "eflags" argument to ExecutorStart and the various ExecInitNode
@@ -301,6 +302,12 @@ extern ExprState *ExecBuildGroupingEqual(TupleDesc ldesc, TupleDesc rdesc,
 										 const Oid *eqfunctions,
 										 const Oid *collations,
 										 PlanState *parent);
+extern ExprState *ExecBuildCdbHash(struct CdbHash *h, List *hashExprs,
+								   PlanState *parent);
+extern ExprState *ExecBuildCdbHashForSlot(struct CdbHash *h, TupleDesc desc,
+										  const TupleTableSlotOps *ops,
+										  const AttrNumber *keyColIdx,
+										  PlanState *parent);
 extern ProjectionInfo *ExecBuildProjectionInfo(List *targetList,
 											   ExprContext *econtext,
 											   TupleTableSlot *slot,
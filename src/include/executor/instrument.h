@@ -15,6 +15,7 @@
 #ifndef INSTRUMENT_H
 #define INSTRUMENT_H
 
+#include "datatype/timestamp.h"
 #include "nodes/plannodes.h"
 #include "portability/instr_time.h"
 #include "utils/resowner.h"
@@ -125,6 +126,11 @@ typedef struct InstrumentationSlot
 	int32		ccnt;			/* command count */
 	int16		segid;			/* segment id */
 	int16		nid;			/* node id */
+	int16		sliceid;		/* slice id of the process */
+	TimestampTz	starttime;		/* time the node was initialized */
+	uint64		motionbytes;	/* bytes sent and received by a Motion node */
+	uint64		maxtargetrows;	/* most rows a Redistribute Motion sent to
+								 * any one segment */
 } InstrumentationSlot;
 
 /*
@@ -143,6 +149,8 @@ extern Size InstrShmemNumSlots(void);
 extern Size InstrShmemSize(void);
 extern void InstrShmemInit(void);
 extern Instrumentation *GpInstrAlloc(const Plan *node, int instrument_options);
+extern void GpInstrSetMotionProgress(Instrumentation *instr, uint64 nbytes,
+									 uint64 maxtargetrows);
 
 /*
  * For each free slot in shmem, fill it with specific pattern
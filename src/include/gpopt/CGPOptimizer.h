@@ -36,6 +36,9 @@ public:
 	// serialize planned statement into DXL
 	static char *SerializeDXLPlan(Query *query);
 
+	// is the given name a cost model parameter
+	static bool IsCostModelParam(const char *name);
+
 	// gpopt initialize and terminate
 	static void InitGPOPT();
 
@@ -47,6 +50,7 @@ extern "C" {
 extern PlannedStmt *GPOPTOptimizedPlan(Query *query,
 									   bool *had_unexpected_failure);
 extern char *SerializeDXLPlan(Query *query);
+extern bool GPOPTIsCostModelParam(const char *name);
 extern void InitGPOPT();
 extern void TerminateGPOPT();
 }
@@ -56,6 +56,9 @@ struct Motion;
 struct Var;
 struct Const;
 struct ArrayExpr;
+struct MVDependencies;
+struct MVNDistinct;
+struct QueryFeedbackEntry;
 
 #include "gpopt/utils/RelationWrapper.h"
 
@@ -205,6 +208,19 @@ void FreeAttrStatsSlot(AttStatsSlot *sslot);
 // attribute statistics
 HeapTuple GetAttStats(Oid relid, AttrNumber attnum);
 
+// attribute statistics, with its MCV and histogram slots, in one call; the
+// slots are empty if there are no statistics
+HeapTuple GetAttStatsWithSlots(Oid relid, AttrNumber attnum,
+							   AttStatsSlot *mcv_slot, AttStatsSlot *hist_slot);
+
+// free what GetAttStatsWithSlots returned
+void FreeAttStatsWithSlots(HeapTuple statstuple, AttStatsSlot *mcv_slot,
+						   AttStatsSlot *hist_slot);
+
+// average width of each of the first natts attributes of a relation, from
+// pg_statistic, or -1 if there are no statistics
+void GetAttStatsWidths(Oid relid, int natts, int32 *widths);
+
 // does a function exist with the given oid
 bool FunctionExists(Oid oid);
 
@@ -262,6 +278,9 @@ List *GetCheckConstraintOids(Oid rel_oid);
 // part constraint expression tree
 Node *GetRelationPartConstraints(Relation rel);
 
+// oids of the partitions of rel that may satisfy the ANDed list of quals
+List *GetPartitionsMatchingQuals(Relation rel, Index varno, Node *quals);
+
 // get the cast function for the specified source and destination types
 bool GetCastFunc(Oid src_oid, Oid dest_oid, bool *is_binary_coercible,
 				 Oid *cast_fn_oid, CoercionPathType *pathtype);
@@ -332,6 +351,21 @@ char *GetOpName(Oid opno);
 // keys of the relation with the given oid
 List *GetRelationKeys(Oid relid);
 
+// foreign keys of the given relation, as a list of ForeignKeyCacheInfo owned
+// by the relcache
+List *GetRelationForeignKeys(Relation rel);
+
+// oids of the extended statistics objects defined on the given relation
+List *GetRelationExtStatistics(Relation rel);
+
+// functional dependencies of the given extended statistics object, NULL if
+// they have not been built by ANALYZE
+MVDependencies *GetMVDependencies(Oid stat_oid);
+
+// multi-column ndistinct coefficients of the given extended statistics
+// object, NULL if they have not been built by ANALYZE
+MVNDistinct *GetMVNDistinct(Oid stat_oid);
+
 // relid of a composite type
 Oid GetTypeRelid(Oid typid);
 
@@ -341,6 +375,12 @@ char *GetTypeName(Oid typid);
 // number of GP segments
 int GetGPSegmentCount(void);
 
+// number of hosts running GP segments
+int GetGPSegmentHostCount(void);
+
+// row counts observed by EXPLAIN ANALYZE, see cdbqueryfeedback.c
+QueryFeedbackEntry *GetQueryFeedback(int *nentries);
+
 // heap attribute is null
 bool HeapAttIsNull(HeapTuple tup, int attnum);
 
@@ -486,6 +526,10 @@ Node *StringToNode(char *string);
 // return the default value of the type
 Node *GetTypeDefault(Oid typid);
 
+// default value expression of each attribute of a relation, or of its type,
+// in one call; NULL for dropped attributes and those without a default
+void GetColumnDefaults(TupleDesc tupdesc, Node **defaults);
+
 // convert numeric to double; if out of range, return +/- HUGE_VAL
 double NumericToDoubleNoOverflow(Numeric num);
 
@@ -584,6 +628,25 @@ void CloseRelation(Relation rel);
 // return a list of index oids for a given relation
 List *GetRelationIndexes(Relation relation);
 
+// the properties of an index that decide whether the optimizer supports it
+struct IndexProps
+{
+	Oid oid;
+	bool found;	 // false if the index could not be opened
+	Oid relam;
+	bool is_valid;
+	bool has_include_cols;
+	bool has_exprs;
+	bool has_pred;
+};
+
+// properties of an index
+void GetIndexProps(Relation index_rel, IndexProps *props);
+
+// properties of all indexes of a relation, in one call; returns the number
+// of indexes and a palloc'd array in *props
+int GetRelationIndexProps(Relation relation, IndexProps **props);
+
 // build an array of triggers for this relation
 void BuildRelationTriggers(Relation rel);
 
@@ -746,6 +809,13 @@ List *GetRelChildIndexes(Oid reloid);
 
 void GPDBLockRelationOid(Oid reloid, int lockmode);
 
+// reset the counts of calls through these wrappers, see
+// optimizer_print_wrapper_calls
+void ResetWrapperCalls();
+
+// log the counts of calls through these wrappers since the last reset
+void ReportWrapperCalls();
+
 }  //namespace gpdb
 
 #define ForEach(cell, l) \
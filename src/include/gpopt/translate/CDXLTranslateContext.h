@@ -65,7 +65,8 @@ private:
 	// mappings ColId->TargetEntry used for intermediate DXL nodes
 	ULongToTargetEntryMap *m_colid_to_target_entry_map;
 
-	// mappings ColId->ParamId used for outer refs in subplans
+	// mappings ColId->ParamId used for outer refs in subplans; shared with
+	// the parent context until this context adds a mapping
 	ULongToColParamMap *m_colid_to_paramid_map;
 
 	// is the node for which this context is built a child of an aggregate node
@@ -75,7 +76,7 @@ private:
 	// to use OUTER instead of 0 for Var::varno in Agg target lists (MPP-12034)
 	BOOL m_is_child_agg_node;
 
-	// copy the params hashmap
+	// replace the params hashmap with a private copy of the given one
 	void CopyParamHashmap(ULongToColParamMap *original);
 
 public:
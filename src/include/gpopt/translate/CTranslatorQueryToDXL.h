@@ -296,6 +296,11 @@ private:
 										  ULONG	 //current_query_level
 	);
 
+	// partitions that can satisfy the WHERE clause, NULL if none were pruned
+	IMdIdArray *GetStaticallyPrunedPartitions(const RangeTblEntry *rte,
+											  ULONG rt_index,
+											  IMdIdArray *partition_mdids);
+
 	void NoteDistributionPolicyOpclasses(const RangeTblEntry *rte);
 
 	// generate a DXL node from column values, where each column value is
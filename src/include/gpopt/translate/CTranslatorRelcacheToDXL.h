@@ -187,6 +187,9 @@ private:
 	// retrieve relstats object from the relcache
 	static IMDCacheObject *RetrieveRelStats(CMemoryPool *mp, IMDId *mdid);
 
+	// retrieve extended stats object from the relcache
+	static IMDCacheObject *RetrieveExtStats(CMemoryPool *mp, IMDId *mdid);
+
 	// retrieve column stats object from the relcache
 	static IMDCacheObject *RetrieveColStats(CMemoryPool *mp,
 											CMDAccessor *md_accessor,
@@ -229,6 +232,13 @@ private:
 											   BOOL is_partitioned,
 											   ULONG *attno_mapping);
 
+	// get foreign keys for relation
+	static void RetrieveRelForeignKeys(CMemoryPool *mp, Relation rel,
+									   ULONG *attno_mapping,
+									   IMdIdArray **fk_rel_mdids,
+									   ULongPtr2dArray **fk_cols,
+									   ULongPtr2dArray **fk_ref_cols);
+
 	// storage type for a relation
 	static IMDRelation::Erelstoragetype RetrieveRelStorageType(Relation rel);
 
@@ -244,7 +254,7 @@ private:
 	// return the dxl representation of the column's default value
 	static CDXLNode *GetDefaultColumnValue(CMemoryPool *mp,
 										   CMDAccessor *md_accessor,
-										   TupleDesc rd_att, AttrNumber attrno);
+										   Node *default_expr);
 
 
 	// get the distribution columns
@@ -260,6 +270,9 @@ private:
 	// check if index is supported
 	static BOOL IsIndexSupported(Relation index_rel);
 
+	// check if index is supported, given its properties
+	static BOOL IsIndexSupported(const gpdb::IndexProps *index_props);
+
 	// compute the array of included columns
 	static ULongPtrArray *ComputeIncludedCols(CMemoryPool *mp,
 											  const IMDRelation *md_rel);
@@ -20,6 +20,7 @@
 #include "gpopt/base/CColRef.h"
 #include "gpopt/search/CSearchStage.h"
 #include "gpopt/translate/CTranslatorUtils.h"
+#include "naucrates/statistics/IStatistics.h"
 
 
 
@@ -127,6 +128,9 @@ private:
 	static COptimizerConfig *CreateOptimizerConfig(CMemoryPool *mp,
 												   ICostModel *cost_model);
 
+	// row counts observed in earlier executions, by feedback signature
+	static gpnaucrates::UlongToDoubleMap *GetFeedbackRows(CMemoryPool *mp);
+
 	// optimize a query to a physical DXL
 	static void *OptimizeTask(void *ptr);
 
@@ -145,8 +149,13 @@ private:
 	// set cost model parameters
 	static void SetCostModelParams(ICostModel *cost_model);
 
+	// set cost model params from a "Name=Value,..." profile
+	static void SetCostModelParamsFromProfile(ICostModel *cost_model,
+											  const CHAR *profile);
+
 	// generate an instance of optimizer cost model
-	static ICostModel *GetCostModel(CMemoryPool *mp, ULONG num_segments);
+	static ICostModel *GetCostModel(CMemoryPool *mp, ULONG num_segments,
+									ULONG num_broadcast_hosts);
 
 	// print warning messages for columns with missing statistics
 	static void PrintMissingStatsWarning(CMemoryPool *mp,
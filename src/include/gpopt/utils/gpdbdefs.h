@@ -42,7 +42,9 @@ extern "C" {
 #include "catalog/pg_operator.h"
 #include "catalog/pg_proc.h"
 #include "cdb/cdbhash.h"
+#include "cdb/cdbhostbcast.h"
 #include "cdb/cdbmutate.h"
+#include "cdb/cdbqueryfeedback.h"
 #include "cdb/cdbutil.h"
 #include "commands/defrem.h"
 #include "commands/trigger.h"
@@ -18,6 +18,7 @@
 
 #include "access/tupconvert.h"
 #include "executor/instrument.h"
+#include "lib/ilist.h"
 #include "lib/pairingheap.h"
 #include "nodes/params.h"
 #include "nodes/parsenodes.h"
@@ -1234,6 +1235,7 @@ typedef struct ResultState
 	bool		rs_checkqual;	/* do we need to check the qual? */
 
 	struct CdbHash *hashFilter;
+	ExprState  *hashFilterExpr;	/* computes the hash for hashFilter */
 } ResultState;
 
 /* ----------------
@@ -2183,6 +2185,63 @@ typedef struct MaterialState
 								 * when this node has outputted its last row? */
 } MaterialState;
 
+struct MemoizeEntry;
+struct MemoizeTuple;
+struct MemoizeKey;
+
+typedef struct MemoizeInstrumentation
+{
+	uint64		cache_hits;		/* number of rescans where we've found the
+								 * scan parameter values to be cached */
+	uint64		cache_misses;	/* number of rescans where we've not found the
+								 * scan parameter values to be cached. */
+	uint64		cache_evictions;	/* number of cache entries removed due to
+									 * the need to free memory */
+	uint64		cache_overflows;	/* number of times we've had to bypass the
+									 * cache when filling it due to not being
+									 * able to free enough space to store the
+									 * current scan's tuples. */
+	uint64		mem_peak;		/* peak memory usage in bytes */
+} MemoizeInstrumentation;
+
+/* ----------------
+ *	 MemoizeState information
+ *
+ *		memoize nodes are used to cache recent and commonly seen results from
+ *		a parameterized scan.
+ * ----------------
+ */
+typedef struct MemoizeState
+{
+	ScanState	ss;				/* its first field is NodeTag */
+	int			mstatus;		/* value of ExecMemoize state machine */
+	int			nkeys;			/* number of cache keys */
+	struct memoize_hash *hashtable; /* hash table for cache entries */
+	TupleDesc	hashkeydesc;	/* tuple descriptor for cache keys */
+	TupleTableSlot *tableslot;	/* min tuple slot for existing cache entries */
+	TupleTableSlot *probeslot;	/* virtual slot used for hash lookups */
+	ExprState  *cache_eq_expr;	/* Compare exec params to hash key */
+	ExprState **param_exprs;	/* exprs containing the parameters to this
+								 * node */
+	FmgrInfo   *hashfunctions;	/* lookup data for hash funcs nkeys in size */
+	Oid		   *collations;		/* collation for comparisons nkeys in size */
+	uint64		mem_used;		/* bytes of memory used by cache */
+	uint64		mem_limit;		/* memory limit in bytes for the cache */
+	MemoryContext tableContext; /* memory context to store cache data */
+	dlist_head	lru_list;		/* least recently used entry list */
+	struct MemoizeTuple *last_tuple;	/* Used to point to the last tuple
+										 * returned during a cache hit and the
+										 * tuple we last stored when
+										 * populating the cache. */
+	struct MemoizeEntry *entry; /* the entry that 'last_tuple' belongs to or
+								 * NULL if 'last_tuple' is NULL. */
+	bool		singlerow;		/* true if the cache entry is to be marked as
+								 * complete after caching the first tuple. */
+	Bitmapset  *keyparamids;	/* Param->paramids of expressions belonging to
+								 * param_exprs */
+	MemoizeInstrumentation stats;	/* execution statistics */
+} MemoizeState;
+
 /* ----------------
  *	  ShareInputScanState information
  *
@@ -2695,6 +2754,7 @@ typedef struct SplitUpdateState
 	AttrNumber	output_segid_attno;		/* attribute number of "gp_segment_id" in output target list */
 
 	struct CdbHash *cdbhash;	/* hash api object */
+	ExprState  *hashExprState;	/* computes the hash of the new row */
 
 } SplitUpdateState;
 
@@ -2730,9 +2790,26 @@ typedef struct MotionState
 	/* For motion send */
 	bool		sentEndOfStream;	/* set when end-of-stream has successfully been sent */
 	List	   *hashExprs;		/* state struct used for evaluating the hash expressions */
+	ExprState  *hashExprState;	/* computes the hash of all of them */
 	struct CdbHash *cdbhash;	/* hash api object */
 	int			numHashSegments;	/* number of segments to use when calculating hash */
 
+	/* For skew detection on a Redistribute Motion sender */
+	int64	   *numTuplesPerTarget;	/* rows sent to each target segment */
+	int64		maxTuplesPerTarget;	/* largest entry in numTuplesPerTarget */
+	int			maxTarget;		/* target segment with maxTuplesPerTarget */
+	struct MotionSkewSample *skewSamples;	/* heavy-hitter hash keys */
+	int			numSkewSamples;	/* number of valid entries in skewSamples */
+	Oid		   *hashKeyOutFuncs;	/* output function of each hash key */
+
+	/* For skew-resilient Redistribute Motion sender */
+	uint32	   *skewHashes;		/* hashes of Motion.skewValues */
+	int			numSkewHashes;
+	int			skewNextTarget;	/* next target when spreading */
+
+	/* For host-aware Broadcast Motion sender */
+	bool		hostTargetsSet;	/* broadcast targets have been chosen */
+
 	/* For Motion recv */
 	int			routeIdNext;	/* for a sorted motion node, the routeId to get next (same as
 								 * the routeId last returned ) */
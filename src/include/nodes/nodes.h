@@ -89,6 +89,7 @@ typedef enum NodeTag
 	T_MergeJoin,
 	T_HashJoin,
 	T_Material,
+	T_Memoize,
 	T_Sort,
 	T_Agg,
 	T_TupleSplit,
@@ -157,6 +158,7 @@ typedef enum NodeTag
 	T_MergeJoinState,
 	T_HashJoinState,
 	T_MaterialState,
+	T_MemoizeState,
 	T_SortState,
 	T_AggState,
 	T_TupleSplitState,
@@ -296,6 +298,7 @@ typedef enum NodeTag
 	T_MergeAppendPath,
 	T_GroupResultPath,
 	T_MaterialPath,
+	T_MemoizePath,
 	T_UniquePath,
 	T_GatherPath,
 	T_GatherMergePath,
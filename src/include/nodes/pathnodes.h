@@ -1608,6 +1608,16 @@ typedef struct CdbMotionPath
 	bool		is_explicit_motion;
 
 	GpPolicy   *policy;
+
+	/*
+	 * Skew-resilient redistribution, see cdbpath_motion_for_join().  The
+	 * locus describes where the rows with other key values go; rows with
+	 * one of skewValues are broadcast if skewBroadcast, else spread evenly.
+	 * skewFraction is the estimated fraction of rows that are broadcast.
+	 */
+	List	   *skewValues;
+	bool		skewBroadcast;
+	double		skewFraction;
 } CdbMotionPath;
 
 /*
@@ -1774,6 +1784,25 @@ typedef struct MaterialPath
 	bool		cdb_shield_child_from_rescans;
 } MaterialPath;
 
+/*
+ * MemoizePath represents a Memoize plan node, i.e., a cache that caches
+ * tuples from parameterized paths to save the underlying node from having to
+ * be rescanned for parameter values which are already cached.
+ */
+typedef struct MemoizePath
+{
+	Path		path;
+	Path	   *subpath;		/* outerpath to cache tuples from */
+	List	   *hash_operators; /* hash operators for each key */
+	List	   *param_exprs;	/* cache keys */
+	bool		singlerow;		/* true if the cache entry is to be marked as
+								 * complete after caching the first record. */
+	double		calls;			/* expected number of rescans */
+	uint32		est_entries;	/* The maximum number of entries that the
+								 * planner expects will fit in the cache, or 0
+								 * if unknown */
+} MemoizePath;
+
 /*
  * UniquePath represents elimination of distinct rows from the output of
  * its subpath.
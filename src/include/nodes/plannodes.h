@@ -36,6 +36,17 @@ typedef struct DirectDispatchInfo
 	bool		isDirectDispatch;
 	List	   *contentIds;
 
+	/*
+	 * If 'paramKeys' is set, 'contentIds' is empty and the target segment is
+	 * computed at executor startup instead, by hashing the distribution key
+	 * values in 'paramKeys' (Consts or PARAM_EXTERN Params) with the hash
+	 * functions in 'paramHashFuncs' over 'paramNumSegments' segments.  This
+	 * lets generic plans of prepared statements use direct dispatch.
+	 */
+	List	   *paramKeys;
+	List	   *paramHashFuncs;
+	int			paramNumSegments;
+
 	/* only used while planning, in createplan.c */
 	bool		haveProcessedAnyCalculations;
 } DirectDispatchInfo;
@@ -156,6 +167,13 @@ typedef struct PlannedStmt
  	 * GPDB: whether a query is a SPI inner query for extension usage 
  	 */
 	int8		metricsQueryType;
+
+	/*
+	 * GPDB: the dispatcher's serialized copy of this plan, for repeated
+	 * executions of a cached plan.  Owned by cdbdisp_query.c; it is not
+	 * copied or serialized with the node.
+	 */
+	struct DispatchPlanCache *dispatchCache;
 } PlannedStmt;
 
 /*
@@ -316,6 +334,12 @@ typedef struct Plan
 	 * How much memory (in KB) should be used to execute this plan node?
 	 */
 	uint64 operatorMemKB;
+
+	/*
+	 * Signature of the tables and predicates GPORCA estimated the output of
+	 * this node from, or 0.  See cdbqueryfeedback.c.
+	 */
+	uint32		feedbackSignature;
 } Plan;
 
 /* ----------------
@@ -1045,6 +1069,32 @@ typedef struct Material
 	bool		cdb_shield_child_from_rescans;
 } Material;
 
+/* ----------------
+ *		memoize node
+ *
+ * Caches the result of its (parameterized) subplan for each distinct set
+ * of parameter values, so that a Nested Loop rescanning its inner side with
+ * parameter values it has seen before doesn't have to rerun the subplan.
+ * ----------------
+ */
+typedef struct Memoize
+{
+	Plan		plan;
+
+	int			numKeys;		/* size of the two arrays below */
+
+	Oid		   *hashOperators;	/* hash operators for each key */
+	Oid		   *collations;		/* collations for each key */
+	List	   *param_exprs;	/* cache keys in the form of exprs containing
+								 * parameters */
+	bool		singlerow;		/* true if the cache entry should be marked as
+								 * complete after we store the first tuple in
+								 * it. */
+	uint32		est_entries;	/* The maximum number of entries that the
+								 * planner expects will fit in the cache, or 0
+								 * if unknown */
+} Memoize;
+
 /* ----------------
  *		sort node
  * ----------------
@@ -1318,6 +1368,19 @@ typedef enum MotionType
 	MOTIONTYPE_OUTER_QUERY	/* Gather or Broadcast to outer query's slice, don't know which one yet */
 } MotionType;
 
+/*
+ * Host-aware Broadcast (see cdbhostbcast.c).  A Broadcast is split into two
+ * Motions: the lower one sends each row to one segment of every host, and
+ * the upper one sends the rows a segment received to the other segments of
+ * its own host.
+ */
+typedef enum BroadcastHostMode
+{
+	BROADCAST_HOST_NONE,	/* send to every receiver */
+	BROADCAST_HOST_RELAY,	/* send to one receiver on each host */
+	BROADCAST_HOST_LOCAL	/* send to the receivers on the sender's host */
+} BroadcastHostMode;
+
 /*
  * Motion Node
  *
@@ -1335,6 +1398,30 @@ typedef struct Motion
 	Oid			*hashFuncs;			/* corresponding hash functions */
 	int         numHashSegments;	/* the module number of the hash function */
 
+	/*
+	 * For skew-resilient Hash (see cdbpath_motion_for_join): rows whose
+	 * single hash key equals one of these Consts are not hashed, but sent
+	 * to all segments if skewBroadcast is set, else spread round-robin.
+	 */
+	List	   *skewValues;
+	bool		skewBroadcast;
+
+	/*
+	 * For Broadcast under adaptive re-optimization (see cdbreopt.c): a
+	 * sender that gets more than this many rows from its subplan raises
+	 * ERRCODE_GP_CARDINALITY_MISESTIMATE, so that the QD can plan the query
+	 * again.  0 disables the check.
+	 */
+	double		reoptRowLimit;
+
+	/*
+	 * For host-aware Broadcast: the host of each receiving segment, as a
+	 * small integer.  Unused with BROADCAST_HOST_NONE.
+	 */
+	BroadcastHostMode hostMode;
+	int			numHostSegments;	/* # of entries in segmentHosts */
+	int		   *segmentHosts;
+
 	/* For Explicit */
 	AttrNumber segidColIdx;			/* index of the segid column in the target list */
 
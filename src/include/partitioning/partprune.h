@@ -80,5 +80,7 @@ extern PartitionPruneInfo *make_partition_pruneinfo_ext(struct PlannerInfo *root
 extern Bitmapset *prune_append_rel_partitions(struct RelOptInfo *rel);
 extern Bitmapset *get_matching_partitions(PartitionPruneContext *context,
 										  List *pruning_steps);
+extern Bitmapset *prune_partitions_for_quals(Relation relation, Index varno,
+											 List *quals);
 
 #endif							/* PARTPRUNE_H */
@@ -857,7 +857,8 @@ typedef enum
 	,
 	WAIT_EVENT_BACKOFF_MAIN,
 	WAIT_EVENT_FTS_PROBE_MAIN,
-	WAIT_EVENT_GLOBAL_DEADLOCK_DETECTOR_MAIN
+	WAIT_EVENT_GLOBAL_DEADLOCK_DETECTOR_MAIN,
+	WAIT_EVENT_ASH_SAMPLER_MAIN
 
 } WaitEventActivity;
 
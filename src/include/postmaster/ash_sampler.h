@@ -0,0 +1,47 @@
+/*-------------------------------------------------------------------------
+ *
+ * ash_sampler.h
+ *	  Active session history sampler.
+ *
+ * Portions Copyright (c) 2012-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/postmaster/ash_sampler.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef ASH_SAMPLER_H
+#define ASH_SAMPLER_H
+
+#include "datatype/timestamp.h"
+
+/* GUCs */
+extern int	gp_ash_buffer_size;
+extern int	gp_ash_sample_interval;
+
+/*
+ * One sample of one active backend.  Identifies the query by the
+ * (sess_id, command_cnt) pair, which is the same on the QD and all QEs.
+ */
+typedef struct AshSample
+{
+	TimestampTz sample_time;
+	int32		pid;
+	int32		sess_id;
+	int32		command_cnt;
+	int16		slice_id;
+	int16		plan_node_id;
+	uint32		wait_event_info;
+	Oid			databaseid;
+} AshSample;
+
+extern Size AshShmemSize(void);
+extern void AshShmemInit(void);
+
+extern int	AshCopySamples(AshSample **samples);
+
+extern bool AshSamplerStartRule(Datum main_arg);
+extern void AshSamplerMain(Datum main_arg);
+
+#endif							/* ASH_SAMPLER_H */
@@ -205,6 +205,14 @@ struct PGPROC
 	 */
 	int			queryCommandId;
 
+	/*
+	 * Slice and plan node this backend is currently executing, or -1.
+	 * Published for the active session history sampler (see ash_sampler.c);
+	 * written only by the owning backend and read without locking.
+	 */
+	int			sliceId;
+	int			planNodeId;
+
 	/*
 	 * Information for resource group
 	 */
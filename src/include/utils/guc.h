@@ -306,6 +306,7 @@ extern bool gp_appendonly_compaction;
  * 10% of the tuples are hidden.
  */
 extern int  gp_appendonly_compaction_threshold;
+extern int  gp_appendonly_vacuum_parallel_workers;
 extern bool gp_heap_require_relhasoids_match;
 extern bool	debug_xlog_record_read;
 extern bool Debug_cancel_print;
@@ -455,6 +456,7 @@ extern int  optimizer_log_failure;
 extern bool	optimizer_trace_fallback;
 extern int optimizer_minidump;
 extern int  optimizer_cost_model;
+extern char *optimizer_cost_model_params;
 extern bool optimizer_metadata_caching;
 extern int	optimizer_mdcache_size;
 
@@ -470,6 +472,7 @@ extern bool	optimizer_print_expression_properties;
 extern bool	optimizer_print_group_properties;
 extern bool	optimizer_print_optimization_context;
 extern bool optimizer_print_optimization_stats;
+extern bool optimizer_print_wrapper_calls;
 extern bool optimizer_print_xform_results;
 
 /* array of xforms disable flags */
@@ -487,6 +490,7 @@ extern bool optimizer_enable_sort;
 extern bool optimizer_enable_materialize;
 extern bool optimizer_enable_partition_propagation;
 extern bool optimizer_enable_partition_selection;
+extern bool optimizer_enable_static_partition_prefilter;
 extern bool optimizer_enable_outerjoin_rewrite;
 extern bool optimizer_enable_multiple_distinct_aggs;
 extern bool optimizer_enable_hashjoin_redistribute_broadcast_children;
@@ -509,6 +513,9 @@ extern bool optimizer_enable_indexscan;
 extern bool optimizer_enable_indexonlyscan;
 extern bool optimizer_enable_tablescan;
 extern bool optimizer_enable_eageragg;
+extern bool optimizer_enable_foreign_key_stats;
+extern bool optimizer_enable_foreign_key_join_elimination;
+extern bool optimizer_enable_extended_stats;
 extern bool optimizer_expand_fulljoin;
 extern bool optimizer_enable_hashagg;
 extern bool optimizer_enable_groupagg;
@@ -595,6 +602,8 @@ extern char  *gp_default_storage_options;
 /* copy GUC */
 extern bool gp_enable_segment_copy_checking;
 
+extern bool gp_enable_parallel_index_build;
+
 extern int writable_external_table_bufsize;
 
 /* Enable passing of query constraints to external table providers */
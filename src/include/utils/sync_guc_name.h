@@ -11,11 +11,13 @@
 		"force_parallel_mode",
 		"gin_fuzzy_search_limit",
 		"gin_pending_list_limit",
+		"gp_appendonly_vacuum_parallel_workers",
 		"gp_blockdirectory_entry_min_range",
 		"gp_blockdirectory_minipage_size",
 		"gp_debug_linger",
 		"gp_default_storage_options",
 		"gp_disable_tuple_hints",
+		"gp_enable_parallel_index_build",
 		"gp_enable_segment_copy_checking",
 		"gp_external_enable_filter_pushdown",
 		"gp_hashagg_default_nbatches",
@@ -24,6 +26,7 @@
 		"gp_ignore_error_table",
 		"gp_indexcheck_insert",
 		"gp_initial_bad_row_limit",
+		"gp_interconnect_bypass_loopback",
 		"gp_interconnect_debug_retry_interval",
 		"gp_interconnect_default_rtt",
 		"gp_interconnect_fc_method",
@@ -46,6 +49,8 @@
 		"gp_log_stack_trace_lines",
 		"gp_max_packet_size",
 		"gp_max_slices",
+		"gp_motion_skew_min_rows",
+		"gp_motion_skew_warning_ratio",
 		"gp_motion_slice_noop",
 		"gp_resgroup_memory_policy_auto_fixed_mem",
 		"gp_resgroup_print_operator_memory_limits",
@@ -88,12 +93,15 @@
 		"log_min_messages",
 		"log_statement_stats",
 		"maintenance_work_mem",
+		"max_parallel_maintenance_workers",
 		"max_parallel_workers_per_gather",
 		"max_statement_mem",
 		"memory_profiler_dataset_id",
 		"memory_profiler_dataset_size",
 		"memory_profiler_query_id",
 		"memory_profiler_run_id",
+		"min_parallel_index_scan_size",
+		"min_parallel_table_scan_size",
 		"optimize_bounded_sort",
 		"optimizer_cte_inlining_bound",
 		"optimizer_mdcache_size",
@@ -122,6 +122,7 @@
 		"enable_indexonlyscan",
 		"enable_indexscan",
 		"enable_material",
+		"enable_memoize",
 		"enable_mergejoin",
 		"enable_nestloop",
 		"enable_parallel_append",
@@ -147,6 +148,9 @@
 		"geqo_seed",
 		"geqo_selection_bias",
 		"geqo_threshold",
+		"gp_adaptive_reopt_max_result_size",
+		"gp_adaptive_reopt_min_rows",
+		"gp_adaptive_reopt_ratio",
 		"gp_adjust_selectivity_for_outerjoins",
 		"gp_allow_non_uniform_partitioning_ddl",
 		"gp_allow_rename_relation_without_lock",
@@ -154,6 +158,8 @@
 		"gp_appendonly_compaction_threshold",
 		"gp_appendonly_verify_block_checksums",
 		"gp_appendonly_verify_write_block",
+		"gp_ash_buffer_size",
+		"gp_ash_sample_interval",
 		"gp_auth_time_override",
 		"gp_autostats_mode",
 		"gp_autostats_mode_in_functions",
@@ -168,6 +174,7 @@
 		"gp_dbid",
 		"gp_debug_pgproc",
 		"gp_debug_resqueue_priority",
+		"gp_direct_dispatch_max_values",
 		"gp_distinct_grouping_sets_threshold",
 		"gp_dtx_recovery_interval",
 		"gp_dtx_recovery_prepared_period",
@@ -176,20 +183,26 @@
 		"gp_enable_agg_distinct",
 		"gp_enable_agg_distinct_pruning",
 		"gp_enable_direct_dispatch",
+		"gp_enable_dispatch_plan_cache",
 		"gp_enable_explain_allstat",
 		"gp_enable_fast_sri",
 		"gp_enable_global_deadlock_detector",
 		"gp_enable_groupext_distinct_gather",
 		"gp_enable_groupext_distinct_pruning",
 		"gp_enable_hashjoin_size_heuristic",
+		"gp_enable_host_broadcast",
+		"gp_enable_initplan_cache",
 		"gp_enable_interconnect_aggressive_retry",
 		"gp_enable_minmax_optimization",
 		"gp_enable_motion_deadlock_sanity",
 		"gp_enable_multiphase_agg",
 		"gp_enable_predicate_propagation",
 		"gp_enable_preunique",
+		"gp_enable_query_feedback",
 		"gp_enable_query_metrics",
+		"gp_enable_read_only_dtx_deferral",
 		"gp_enable_relsize_collection",
+		"gp_enable_skew_join",
 		"gp_enable_slow_writer_testmode",
 		"gp_enable_sort_distinct",
 		"gp_enable_sort_limit",
@@ -321,7 +334,6 @@
 		"max_index_keys",
 		"max_locks_per_transaction",
 		"max_logical_replication_workers",
-		"max_parallel_maintenance_workers",
 		"max_parallel_workers",
 		"max_pred_locks_per_page",
 		"max_pred_locks_per_relation",
@@ -338,8 +350,6 @@
 		"max_wal_size",
 		"max_worker_processes",
 		"memory_spill_ratio",
-		"min_parallel_index_scan_size",
-		"min_parallel_table_scan_size",
 		"min_wal_size",
 		"old_snapshot_threshold",
 		"operator_precedence_warning",
@@ -351,6 +361,7 @@
 		"optimizer_array_expansion_threshold",
 		"optimizer_control",
 		"optimizer_cost_model",
+		"optimizer_cost_model_params",
 		"optimizer_cost_threshold",
 		"optimizer_cte_inlining",
 		"optimizer_damping_factor_filter",
@@ -369,6 +380,9 @@
 		"optimizer_enable_dml_constraints",
 		"optimizer_enable_dynamictablescan",
 		"optimizer_enable_eageragg",
+		"optimizer_enable_extended_stats",
+		"optimizer_enable_foreign_key_join_elimination",
+		"optimizer_enable_foreign_key_stats",
 		"optimizer_enable_gather_on_segment_for_dml",
 		"optimizer_enable_groupagg",
 		"optimizer_enable_hashagg",
@@ -394,6 +408,7 @@
 		"optimizer_enable_range_predicate_dpe",
 		"optimizer_enable_sort",
 		"optimizer_enable_space_pruning",
+		"optimizer_enable_static_partition_prefilter",
 		"optimizer_enable_streaming_material",
 		"optimizer_enable_tablescan",
 		"optimizer_enforce_subplans",
@@ -428,6 +443,7 @@
 		"optimizer_print_optimization_stats",
 		"optimizer_print_plan",
 		"optimizer_print_query",
+		"optimizer_print_wrapper_calls",
 		"optimizer_print_xform",
 		"optimizer_print_xform_results",
 		"optimizer_prune_computed_columns",
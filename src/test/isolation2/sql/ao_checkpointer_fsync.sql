@@ -0,0 +1,61 @@
+-- WAL-logged AO and AOCS segment files are not fsync'd when they are
+-- closed, but by the checkpointer at the next checkpoint.  Validate that
+-- rows inserted after the last checkpoint survive a crash, and that a
+-- checkpoint copes with segment files that go away while their sync
+-- requests are pending.
+
+-- Set fsync on since we need to test the fsync code logic.
+!\retcode gpconfig -c fsync -v on --skipvalidation;
+!\retcode gpstop -u;
+
+1: CREATE TABLE ao_crash_row (a int, b int) WITH (appendoptimized = true) DISTRIBUTED BY (a);
+1: CREATE TABLE ao_crash_column (a int, b int) WITH (appendoptimized = true, orientation = column) DISTRIBUTED BY (a);
+1: CHECKPOINT;
+1: INSERT INTO ao_crash_row SELECT i, i FROM generate_series(1, 100) i;
+1: INSERT INTO ao_crash_column SELECT i, i FROM generate_series(1, 100) i;
+
+-- Crash seg 0 when the next checkpoint starts, so that the inserts are only
+-- recovered by replaying their WAL records.
+1: SELECT gp_inject_fault('checkpoint', 'panic', dbid) FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+-- start_ignore
+1: CHECKPOINT;
+-- end_ignore
+1q:
+
+-- wait for segment to complete recovering
+0U: SELECT 1;
+0Uq:
+
+-- reset the fault as protection in case the panic didn't happen
+2: SELECT gp_inject_fault('checkpoint', 'reset', dbid) FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+
+2: SELECT count(*), sum(b) FROM ao_crash_row;
+2: SELECT count(*), sum(b) FROM ao_crash_column;
+2: DROP TABLE ao_crash_row;
+2: DROP TABLE ao_crash_column;
+
+-- Drop and truncate tables while the checkpointer of seg 0 is about to fsync
+-- their segment files.  It fails to open the files, finds the forget requests
+-- the drop queued, and completes the checkpoint.
+2: CREATE TABLE ao_sync_drop (a int, b int) WITH (appendoptimized = true, orientation = column) DISTRIBUTED BY (a);
+2: CREATE TABLE ao_sync_truncate (a int, b int) WITH (appendoptimized = true) DISTRIBUTED BY (a);
+2: CHECKPOINT;
+2: INSERT INTO ao_sync_drop SELECT i, i FROM generate_series(1, 100) i;
+2: INSERT INTO ao_sync_truncate SELECT i, i FROM generate_series(1, 100) i;
+
+2: SELECT gp_inject_fault('ao_fsync_counter', 'suspend', dbid) FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+3&: CHECKPOINT;
+2: SELECT gp_wait_until_triggered_fault('ao_fsync_counter', 1, dbid) FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+2: DROP TABLE ao_sync_drop;
+2: TRUNCATE ao_sync_truncate;
+2: SELECT gp_inject_fault('ao_fsync_counter', 'reset', dbid) FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+3<:
+
+-- the segment is still up, and the truncated table is usable
+2: INSERT INTO ao_sync_truncate SELECT i, i FROM generate_series(1, 10) i;
+2: SELECT count(*) FROM ao_sync_truncate;
+2: CHECKPOINT;
+2: DROP TABLE ao_sync_truncate;
+
+!\retcode gpconfig -r fsync --skipvalidation;
+!\retcode gpstop -u;
@@ -0,0 +1,28 @@
+-- A read-only transaction block defers its distributed transaction
+-- (gp_enable_read_only_dtx_deferral), but with GDD enabled SELECT FOR
+-- UPDATE/SHARE locks the rows on the segments, so it must start the
+-- distributed transaction to hold those locks until the end of the block.
+DROP TABLE IF EXISTS t_ro_locks;
+CREATE TABLE t_ro_locks (id int, val int) DISTRIBUTED BY (id);
+INSERT INTO t_ro_locks SELECT i, i FROM generate_series(1, 10) i;
+
+10: BEGIN READ ONLY;
+10: SELECT * FROM t_ro_locks WHERE id = 1 FOR UPDATE;
+-- the row is still locked after the statement
+20: SELECT * FROM t_ro_locks WHERE id = 1 FOR UPDATE NOWAIT;
+10: COMMIT;
+20: SELECT * FROM t_ro_locks WHERE id = 1 FOR UPDATE NOWAIT;
+
+10: BEGIN READ ONLY;
+10: SELECT * FROM t_ro_locks WHERE id = 1 FOR SHARE;
+20: SELECT * FROM t_ro_locks WHERE id = 1 FOR UPDATE NOWAIT;
+-- a blocked update goes ahead when the block ends
+20&: UPDATE t_ro_locks SET val = 0 WHERE id = 1;
+10: COMMIT;
+20<:
+20: SELECT * FROM t_ro_locks WHERE id = 1;
+
+10q:
+20q:
+
+DROP TABLE t_ro_locks;
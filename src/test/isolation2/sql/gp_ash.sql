@@ -0,0 +1,47 @@
+-- Test the active session history sampler: a query held inside a plan
+-- node on a segment must be sampled with that node's id.
+
+-- start_ignore
+! gpconfig -c gp_ash_buffer_size -v 10000;
+! gpconfig -c gp_ash_sample_interval -v 10;
+! gpstop -rai;
+-- end_ignore
+
+1: CREATE EXTENSION IF NOT EXISTS gp_internal_tools;
+1: CREATE TABLE ash_t (a int, b int) DISTRIBUTED BY (a);
+1: INSERT INTO ash_t SELECT i, i FROM generate_series(1, 100) i;
+
+-- hold the Sort on content 0 right before it sorts
+SELECT gp_inject_fault_infinite('execsort_before_sorting', 'suspend', dbid)
+FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+2&: SELECT * FROM ash_t ORDER BY b;
+SELECT gp_wait_until_triggered_fault('execsort_before_sorting', 1, dbid)
+FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+
+-- let the sampler take a few samples of the held query
+SELECT pg_sleep(0.5);
+
+-- the samples taken on content 0 point into the plan, not at -1 or the
+-- Gather Motion on top of it
+SELECT count(*) > 0 AS sampled_in_plan_node
+FROM session_state.active_session_history h
+JOIN pg_stat_activity a ON h.sess_id = a.sess_id
+WHERE a.query LIKE 'SELECT * FROM ash_t ORDER BY b%'
+  AND h.segid = 0 AND h.slice_id > 0 AND h.plan_node_id > 0;
+
+SELECT gp_inject_fault('execsort_before_sorting', 'reset', dbid)
+FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+-- start_ignore
+2<:
+-- end_ignore
+2q:
+
+1: DROP TABLE ash_t;
+1: DROP EXTENSION gp_internal_tools;
+1q:
+
+-- start_ignore
+! gpconfig -r gp_ash_buffer_size;
+! gpconfig -r gp_ash_sample_interval;
+! gpstop -rai;
+-- end_ignore
@@ -0,0 +1,45 @@
+-- Test session_state.query_progress: while a query is held inside a plan
+-- node on a segment, another session sees its per-node progress there.
+-- Plan nodes only get shared memory instrumentation slots when the query
+-- is instrumented, hence EXPLAIN ANALYZE; instr_in_shmem_setup turned on
+-- gp_enable_query_metrics.
+
+1: CREATE EXTENSION IF NOT EXISTS gp_internal_tools;
+1: CREATE TABLE qp_t (a int, b int) DISTRIBUTED BY (a);
+1: INSERT INTO qp_t SELECT i, i FROM generate_series(1, 100) i;
+
+-- hold the Sort on content 0 after it has read all of its input
+SELECT gp_inject_fault_infinite('execsort_before_sorting', 'suspend', dbid)
+FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+2&: EXPLAIN ANALYZE SELECT * FROM qp_t ORDER BY b;
+SELECT gp_wait_until_triggered_fault('execsort_before_sorting', 1, dbid)
+FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+
+-- On content 0 the Seq Scan has produced every row stored there, and the
+-- Sort above it nothing yet. All nodes are in the segments' slice.
+1: SELECT max(rows_out) = (SELECT count(*) FROM qp_t WHERE gp_segment_id = 0) AS scan_rows_out,
+          min(rows_out) = 0 AS sort_rows_out,
+          bool_and(slice_id > 0) AS in_segment_slice,
+          bool_and(elapsed_seconds >= 0) AS elapsed
+   FROM session_state.query_progress
+   WHERE query LIKE 'EXPLAIN ANALYZE SELECT * FROM qp_t%' AND segid = 0;
+
+-- and the QD has the Gather Motion that receives the rows
+1: SELECT count(*) > 0 AS gather_on_qd
+   FROM session_state.query_progress
+   WHERE query LIKE 'EXPLAIN ANALYZE SELECT * FROM qp_t%' AND segid = -1;
+
+SELECT gp_inject_fault('execsort_before_sorting', 'reset', dbid)
+FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+-- start_ignore
+2<:
+-- end_ignore
+
+-- the slots are released once the query is done
+1: SELECT count(*) FROM session_state.query_progress
+   WHERE query LIKE 'EXPLAIN ANALYZE SELECT * FROM qp_t%';
+2q:
+
+1: DROP TABLE qp_t;
+1: DROP EXTENSION gp_internal_tools;
+1q:
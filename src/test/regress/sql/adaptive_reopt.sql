@@ -0,0 +1,69 @@
+--
+-- Adaptive re-optimization of SELECTs with misestimated Broadcast Motions.
+--
+-- Only GPORCA plans are re-optimized, with the Postgres planner the queries
+-- below run once, and no LOG line is expected.
+--
+-- start_matchsubs
+-- m/^DETAIL:  Broadcast Motion \d+ received more than \d+ rows, estimated \d+/
+-- s/Broadcast Motion \d+ received more than \d+ rows, estimated \d+.*/Broadcast Motion ### received more than ### rows, estimated ###/
+-- end_matchsubs
+set gp_autostats_mode = none;
+create table reopt_fact (a int, b int) distributed by (a);
+create table reopt_dim (a int, b int) distributed by (a);
+
+-- The statistics claim that reopt_dim is empty, so a join on a column that
+-- is not its distribution key broadcasts it.
+analyze reopt_dim;
+insert into reopt_fact select i, i % 100 from generate_series(1, 1000) i;
+analyze reopt_fact;
+insert into reopt_dim select i, i % 100 from generate_series(1, 5000) i;
+
+set client_min_messages = log;
+
+-- Disabled by default.
+select count(*) from reopt_fact f join reopt_dim d on f.b = d.b;
+
+set gp_adaptive_reopt_ratio = 10;
+set gp_adaptive_reopt_min_rows = 100;
+select count(*) from reopt_fact f join reopt_dim d on f.b = d.b;
+select f.b, count(*) from reopt_fact f join reopt_dim d on f.b = d.b
+group by f.b order by f.b limit 3;
+
+-- Also inside a transaction block, which is left usable.
+begin;
+select count(*) from reopt_fact f join reopt_dim d on f.b = d.b;
+select count(*) from reopt_dim;
+commit;
+
+-- A result that outgrows gp_adaptive_reopt_max_result_size is not held back
+-- any longer: the query runs again without row limits.
+set gp_adaptive_reopt_min_rows = 1000000;
+set gp_adaptive_reopt_max_result_size = 64;
+\o /dev/null
+select f.a, d.a, repeat('x', 100) from reopt_fact f join reopt_dim d on f.b = d.b;
+\o
+reset gp_adaptive_reopt_max_result_size;
+set gp_adaptive_reopt_min_rows = 100;
+
+-- Volatile functions are not run twice: one NOTICE, and no re-plan.
+create function reopt_notice() returns int as $$
+begin
+  raise notice 'reopt_notice called';
+  return 1;
+end;
+$$ language plpgsql volatile;
+select reopt_notice(), count(*) from reopt_fact f join reopt_dim d on f.b = d.b;
+
+-- Once the statistics of reopt_dim are current, no Broadcast Motion can
+-- receive more rows than its limit, and the query runs as usual.
+analyze reopt_dim;
+select count(*) from reopt_fact f join reopt_dim d on f.b = d.b;
+
+reset client_min_messages;
+reset gp_adaptive_reopt_ratio;
+reset gp_adaptive_reopt_min_rows;
+reset gp_autostats_mode;
+drop function reopt_notice();
+drop table reopt_fact;
+drop table reopt_dim;
@@ -0,0 +1,42 @@
+--
+-- Direct dispatch of multi-row VALUES inserts and long IN-lists.  The
+-- Postgres planner does these, ORCA decides direct dispatch on its own.
+--
+set optimizer = off;
+-- turn off autostats so we don't have to worry about the logging of the autostat queries
+set gp_autostats_mode = None;
+
+create table direct_test_multi
+(
+  key int NULL,
+  value varchar(50) NULL
+)
+distributed by (key);
+
+set test_print_direct_dispatch_info=on;
+
+-- Multi-row constant insert, all rows hash to the same segment
+-- DO direct dispatch
+insert into direct_test_multi values (1, 'cow'), (1, 'horse'), (1, 'pig');
+
+-- Multi-row constant insert, rows hash to two of the segments
+-- DO direct dispatch, to those two
+insert into direct_test_multi values (2, 'b'), (1, 'a'), (2, 'd'), (1, 'c');
+
+-- IN-list too long for the planner to expand into an OR, but all the same key
+-- DO direct dispatch
+select count(*) from direct_test_multi where key = any(array_fill(1, array[200]));
+
+-- The same, with more values than gp_direct_dispatch_max_values
+-- Do NOT direct dispatch
+set gp_direct_dispatch_max_values = 100;
+select count(*) from direct_test_multi where key = any(array_fill(1, array[200]));
+reset gp_direct_dispatch_max_values;
+
+set test_print_direct_dispatch_info=off;
+
+-- Each row landed on the segment it hashes to, exactly once
+select gp_segment_id, key, value from direct_test_multi order by key, value;
+select key, value, count(*) from direct_test_multi group by key, value having count(*) <> 1;
+
+drop table direct_test_multi;
@@ -0,0 +1,84 @@
+--
+-- Reuse of the serialized plan of prepared single-segment statements
+-- (gp_enable_dispatch_plan_cache).  Check that repeated executions keep
+-- giving the right answers, and with gp_dispatch_plan_cache_stats(), which
+-- counts the cacheable plans this session dispatched and how many of them
+-- reused their serialized form, that the cache is used.
+--
+set optimizer = off;
+set gp_enable_dispatch_plan_cache = on;
+
+create table dispatch_plan_cache_t (id int, val int) distributed by (id);
+insert into dispatch_plan_cache_t select i, i * 10 from generate_series(1, 100) i;
+
+prepare dpc_select(int) as select val from dispatch_plan_cache_t where id = $1;
+prepare dpc_update(int, int) as update dispatch_plan_cache_t set val = $2 where id = $1;
+
+-- force a generic plan, which is what gets cached
+set plan_cache_mode = force_generic_plan;
+
+execute dpc_select(1);
+execute dpc_select(2);
+execute dpc_select(3);
+-- the plan is kept at the second execution, and reused at the third
+select * from gp_dispatch_plan_cache_stats();
+execute dpc_update(3, 33);
+execute dpc_update(3, 333);
+execute dpc_update(3, 3333);
+execute dpc_select(3);
+
+-- the generic plan is still directly dispatched, to the segment that the
+-- parameter value hashes to
+set test_print_direct_dispatch_info = on;
+execute dpc_select(10);
+execute dpc_select(11);
+set test_print_direct_dispatch_info = off;
+
+-- a different statement_mem changes the plan's operator memory, so the
+-- serialized plan is only reused by the execution in between
+select dispatches as dispatches_before, hits as hits_before from gp_dispatch_plan_cache_stats() \gset
+set statement_mem = '50MB';
+execute dpc_select(4);
+execute dpc_select(5);
+reset statement_mem;
+execute dpc_select(6);
+select dispatches - :dispatches_before as dispatches, hits - :hits_before as hits from gp_dispatch_plan_cache_stats();
+
+-- ALTER TABLE invalidates the cached plan, and the serialized plan with it
+alter table dispatch_plan_cache_t alter column val set default 0;
+select dispatches as dispatches_before, hits as hits_before from gp_dispatch_plan_cache_stats() \gset
+execute dpc_select(12);
+execute dpc_select(13);
+execute dpc_select(14);
+select dispatches - :dispatches_before as dispatches, hits - :hits_before as hits from gp_dispatch_plan_cache_stats();
+
+-- custom plans are made for every execution, and never reused
+set plan_cache_mode = force_custom_plan;
+select dispatches as dispatches_before, hits as hits_before from gp_dispatch_plan_cache_stats() \gset
+execute dpc_select(15);
+execute dpc_select(16);
+execute dpc_select(17);
+select dispatches - :dispatches_before as dispatches, hits - :hits_before as hits from gp_dispatch_plan_cache_stats();
+set plan_cache_mode = force_generic_plan;
+
+-- a stable function has to be evaluated at every execution, so this one
+-- is not cached
+prepare dpc_stable(int) as select val, now() = now() from dispatch_plan_cache_t where id = $1;
+select dispatches as dispatches_before, hits as hits_before from gp_dispatch_plan_cache_stats() \gset
+execute dpc_stable(7);
+execute dpc_stable(7);
+execute dpc_stable(7);
+select dispatches - :dispatches_before as dispatches, hits - :hits_before as hits from gp_dispatch_plan_cache_stats();
+
+set gp_enable_dispatch_plan_cache = off;
+select dispatches as dispatches_before, hits as hits_before from gp_dispatch_plan_cache_stats() \gset
+execute dpc_select(8);
+execute dpc_select(9);
+select dispatches - :dispatches_before as dispatches, hits - :hits_before as hits from gp_dispatch_plan_cache_stats();
+
+reset plan_cache_mode;
+reset gp_enable_dispatch_plan_cache;
+deallocate dpc_select;
+deallocate dpc_update;
+deallocate dpc_stable;
+drop table dispatch_plan_cache_t;
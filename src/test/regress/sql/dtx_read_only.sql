@@ -0,0 +1,76 @@
+--
+-- Read-only transaction blocks don't start a distributed transaction until
+-- they need one (gp_enable_read_only_dtx_deferral).
+--
+set optimizer = off;
+set gp_autostats_mode = none;
+
+create table dtx_read_only_t (key int, value int) distributed by (key);
+insert into dtx_read_only_t select i, i from generate_series(1, 10) i;
+create temp table dtx_read_only_temp (key int, value int) distributed by (key);
+
+set test_print_direct_dispatch_info = on;
+
+-- no distributed commit at the end
+begin read only;
+select * from dtx_read_only_t where key = 1;
+select * from dtx_read_only_t where key = 2;
+commit;
+
+-- the same with default_transaction_read_only
+set default_transaction_read_only = on;
+begin;
+select * from dtx_read_only_t where key = 1;
+rollback;
+reset default_transaction_read_only;
+
+-- a savepoint starts the distributed transaction
+begin read only;
+select * from dtx_read_only_t where key = 1;
+savepoint sp1;
+select * from dtx_read_only_t where key = 2;
+release sp1;
+commit;
+
+-- not for other isolation levels
+begin isolation level repeatable read read only;
+select * from dtx_read_only_t where key = 1;
+commit;
+
+-- nor with the GUC turned off
+set gp_enable_read_only_dtx_deferral = off;
+begin read only;
+select * from dtx_read_only_t where key = 1;
+commit;
+reset gp_enable_read_only_dtx_deferral;
+
+-- SELECT FOR UPDATE/SHARE starts the distributed transaction, its row locks
+-- on the segments are held until the end of the transaction block (see
+-- isolation2 gdd/dtx_read_only_row_locks)
+begin read only;
+select * from dtx_read_only_t where key = 1 for update;
+commit;
+begin read only;
+select * from dtx_read_only_t where key = 1 for share;
+commit;
+
+-- so does a write to a temporary table, which is rolled back with the
+-- transaction block
+begin read only;
+insert into dtx_read_only_temp values (1, 1);
+rollback;
+
+set test_print_direct_dispatch_info = off;
+
+select count(*) from dtx_read_only_temp;
+
+-- a cursor works across fetches
+begin read only;
+declare c cursor for select * from dtx_read_only_t order by key;
+fetch 2 from c;
+fetch 2 from c;
+close c;
+commit;
+
+drop table dtx_read_only_t;
+drop table dtx_read_only_temp;
@@ -0,0 +1,55 @@
+--
+-- Host-aware Broadcast Motions, see gp_enable_host_broadcast.  All the
+-- segments of the test cluster are on one host, so every Broadcast that
+-- the Postgres planner makes is split in two.
+--
+set optimizer = off;
+set gp_autostats_mode = none;
+
+create table hb_fact (a int, b int) distributed by (a);
+create table hb_dim (a int, b int) distributed by (a);
+create table hb_dst (a int, b int) distributed by (a);
+create table hb_rep (a int, b int) distributed replicated;
+insert into hb_fact select i, i % 10 from generate_series(1, 10000) i;
+insert into hb_dim select i, i % 10 from generate_series(1, 10) i;
+analyze hb_fact;
+analyze hb_dim;
+
+-- Broadcast join
+explain (costs off) select f.a, d.a from hb_fact f join hb_dim d on f.b = d.b;
+set gp_enable_host_broadcast = on;
+explain (costs off) select f.a, d.a from hb_fact f join hb_dim d on f.b = d.b;
+select count(*), sum(f.a), sum(d.a) from hb_fact f join hb_dim d on f.b = d.b;
+reset gp_enable_host_broadcast;
+select count(*), sum(f.a), sum(d.a) from hb_fact f join hb_dim d on f.b = d.b;
+
+-- Broadcast below a Redistribute
+explain (costs off) insert into hb_dst select d.a, f.a from hb_fact f join hb_dim d on f.b = d.b;
+set gp_enable_host_broadcast = on;
+explain (costs off) insert into hb_dst select d.a, f.a from hb_fact f join hb_dim d on f.b = d.b;
+insert into hb_dst select d.a, f.a from hb_fact f join hb_dim d on f.b = d.b;
+select count(*), sum(a), sum(b) from hb_dst;
+reset gp_enable_host_broadcast;
+insert into hb_dst select d.a, f.a from hb_fact f join hb_dim d on f.b = d.b;
+select count(*), sum(a), sum(b) from hb_dst;
+
+-- LIMIT, which stops reading before the Motions are done
+explain (costs off) select f.a, d.a from hb_fact f join hb_dim d on f.b = d.b limit 5;
+set gp_enable_host_broadcast = on;
+explain (costs off) select f.a, d.a from hb_fact f join hb_dim d on f.b = d.b limit 5;
+select count(*) from (select f.a, d.a from hb_fact f join hb_dim d on f.b = d.b limit 5) s;
+reset gp_enable_host_broadcast;
+select count(*) from (select f.a, d.a from hb_fact f join hb_dim d on f.b = d.b limit 5) s;
+
+-- Every segment of a replicated table gets all the rows
+explain (costs off) insert into hb_rep select * from hb_fact;
+set gp_enable_host_broadcast = on;
+explain (costs off) insert into hb_rep select * from hb_fact;
+insert into hb_rep select * from hb_fact;
+reset gp_enable_host_broadcast;
+select gp_segment_id, count(*), sum(a) from gp_dist_random('hb_rep')
+ group by gp_segment_id order by gp_segment_id;
+
+reset gp_autostats_mode;
+reset optimizer;
+drop table hb_fact, hb_dim, hb_dst, hb_rep;
@@ -0,0 +1,62 @@
+--
+-- Parallel vacuum of the indexes of append-optimized tables, see
+-- gp_appendonly_vacuum_parallel_workers
+--
+set gp_appendonly_vacuum_parallel_workers = 2;
+set max_parallel_maintenance_workers = 2;
+set min_parallel_index_scan_size = 0;
+
+create table pav_ao (a int, b int, c text) with (appendonly=true) distributed by (a);
+create table pav_aoco (a int, b int, c text) with (appendonly=true, orientation=column) distributed by (a);
+create index pav_ao_a on pav_ao (a);
+create index pav_ao_b on pav_ao (b);
+create index pav_ao_c on pav_ao (c);
+create index pav_ao_bitmap on pav_ao using bitmap (b);
+create index pav_aoco_a on pav_aoco (a);
+create index pav_aoco_b on pav_aoco (b);
+create index pav_aoco_c on pav_aoco (c);
+
+insert into pav_ao select i, i % 100, 'row ' || i from generate_series(1, 20000) i;
+insert into pav_aoco select i, i % 100, 'row ' || i from generate_series(1, 20000) i;
+delete from pav_ao where a % 4 = 0;
+delete from pav_aoco where a % 4 = 0;
+
+-- Count the parallel workers that join in: two on each segment, per table
+select gp_inject_fault_infinite('appendonly_parallel_vacuum_worker', 'skip', dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+
+vacuum pav_ao;
+select gp_wait_until_triggered_fault('appendonly_parallel_vacuum_worker', 2, dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+vacuum pav_aoco;
+select gp_wait_until_triggered_fault('appendonly_parallel_vacuum_worker', 4, dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+
+select gp_inject_fault('appendonly_parallel_vacuum_worker', 'reset', dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+
+-- The dead entries are gone from every btree index, whichever process
+-- vacuumed it
+select c.relname, sum(c.reltuples) from gp_dist_random('pg_class') c
+ where c.relname in ('pav_ao_a', 'pav_ao_b', 'pav_ao_c',
+                     'pav_aoco_a', 'pav_aoco_b', 'pav_aoco_c')
+ group by c.relname order by c.relname;
+
+set enable_seqscan = off;
+set enable_bitmapscan = off;
+select count(*), sum(a) from pav_ao where a between 1000 and 2000;
+select count(*), sum(a) from pav_ao where b = 42;
+select count(*) from pav_ao where c = 'row 42';
+select count(*), sum(a) from pav_aoco where a between 1000 and 2000;
+select count(*), sum(a) from pav_aoco where b = 42;
+select count(*) from pav_aoco where c = 'row 42';
+reset enable_seqscan;
+reset enable_bitmapscan;
+
+vacuum full pav_ao;
+select count(*) from pav_ao;
+
+reset gp_appendonly_vacuum_parallel_workers;
+reset max_parallel_maintenance_workers;
+reset min_parallel_index_scan_size;
+drop table pav_ao, pav_aoco;
@@ -0,0 +1,68 @@
+--
+-- Segment-local parallel index builds, see gp_enable_parallel_index_build
+--
+set gp_enable_parallel_index_build = on;
+set max_parallel_maintenance_workers = 2;
+set min_parallel_table_scan_size = 0;
+-- Leave each of the three participants 32MB to sort with
+set maintenance_work_mem = '128MB';
+
+create table pib_heap (a int, b int) distributed by (a);
+create table pib_ao (a int, b int) with (appendonly=true) distributed by (a);
+create table pib_aoco (a int, b int) with (appendonly=true, orientation=column) distributed by (a);
+
+-- Load in several transactions.  The parallel workers share out whatever
+-- segfiles the append-optimized tables end up with.
+begin;
+insert into pib_heap select i, i % 100 from generate_series(1, 30000) i;
+insert into pib_ao select i, i % 100 from generate_series(1, 10000) i;
+insert into pib_aoco select i, i % 100 from generate_series(1, 10000) i;
+commit;
+begin;
+insert into pib_ao select i, i % 100 from generate_series(10001, 20000) i;
+insert into pib_aoco select i, i % 100 from generate_series(10001, 20000) i;
+commit;
+begin;
+insert into pib_ao select i, i % 100 from generate_series(20001, 30000) i;
+insert into pib_aoco select i, i % 100 from generate_series(20001, 30000) i;
+commit;
+
+-- The first index of an append-optimized table also builds its block
+-- directory, which has to be done serially.  The second one can use
+-- parallel workers.  Count the workers that join in: two on each segment,
+-- per parallel build.
+select gp_inject_fault_infinite('btree_parallel_build_worker', 'skip', dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+create index pib_heap_a on pib_heap (a);
+select gp_wait_until_triggered_fault('btree_parallel_build_worker', 2, dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+create index pib_ao_a on pib_ao (a);
+create index pib_aoco_a on pib_aoco (a);
+create index pib_ao_b on pib_ao (b);
+select gp_wait_until_triggered_fault('btree_parallel_build_worker', 4, dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+create index pib_aoco_b on pib_aoco (b);
+select gp_wait_until_triggered_fault('btree_parallel_build_worker', 6, dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+select gp_inject_fault('btree_parallel_build_worker', 'reset', dbid)
+  from gp_segment_configuration where role = 'p' and content > -1;
+
+set enable_seqscan = off;
+set enable_bitmapscan = off;
+select count(*), sum(a) from pib_heap where a between 1000 and 2000;
+select count(*), sum(a) from pib_ao where a between 1000 and 2000;
+select count(*), sum(a) from pib_aoco where a between 1000 and 2000;
+select count(*), sum(a) from pib_ao where b = 42;
+select count(*), sum(a) from pib_aoco where b = 42;
+reset enable_seqscan;
+reset enable_bitmapscan;
+
+-- The index must agree with the table
+select count(*) from pib_ao a1 join pib_ao a2 using (a);
+select count(*) from pib_aoco a1 join pib_aoco a2 using (a);
+
+reset gp_enable_parallel_index_build;
+reset max_parallel_maintenance_workers;
+reset min_parallel_table_scan_size;
+reset maintenance_work_mem;
+drop table pib_heap, pib_ao, pib_aoco;
@@ -0,0 +1,57 @@
+--
+-- Row counts recorded by EXPLAIN ANALYZE for GPORCA, see
+-- gp_enable_query_feedback.  Plans of the Postgres planner are not
+-- recorded, so with it the gp_query_feedback view stays empty.
+--
+set gp_enable_query_feedback = on;
+select gp_query_feedback_reset();
+
+create table qf_t (a int, b int, c int) distributed by (a);
+create table qf_rep (a int, b int, c int) distributed replicated;
+insert into qf_t select i, i % 10, i % 10 from generate_series(1, 1000) i;
+insert into qf_rep select * from qf_t;
+analyze qf_t;
+analyze qf_rep;
+
+create function qf_explain_analyze(query text) returns void as $$
+begin
+  execute 'explain analyze ' || query;
+end;
+$$ language plpgsql;
+create view qf_entries as
+  select (select string_agg(r::regclass::text, ',' order by r::regclass::text)
+            from unnest(relids) r) as tables, rows
+    from gp_query_feedback;
+
+-- b and c are correlated, which the estimates do not know about
+select qf_explain_analyze('select count(*) from qf_t where b = 1 and c = 1');
+select * from qf_entries order by tables, rows;
+
+-- Each segment scans all of a replicated table, its rows are not counted
+-- once per segment
+select qf_explain_analyze('select count(*) from qf_t join qf_rep on qf_t.a = qf_rep.a where qf_rep.b = 1 and qf_rep.c = 1');
+select * from qf_entries order by tables, rows;
+
+-- ANALYZE and TRUNCATE forget what was learned about a table
+analyze qf_rep;
+select * from qf_entries order by tables, rows;
+truncate qf_t;
+select * from qf_entries order by tables, rows;
+
+-- So does an explicit reset
+insert into qf_t select i, i % 10, i % 10 from generate_series(1, 1000) i;
+select qf_explain_analyze('select count(*) from qf_t where b = 1 and c = 1');
+select gp_query_feedback_reset();
+select count(*) from qf_entries;
+
+-- Only superusers can reset
+create role qf_user;
+set role qf_user;
+select gp_query_feedback_reset();
+reset role;
+drop role qf_user;
+
+reset gp_enable_query_feedback;
+drop view qf_entries;
+drop function qf_explain_analyze(text);
+drop table qf_t, qf_rep;
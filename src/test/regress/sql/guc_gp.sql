@@ -230,3 +230,13 @@ FETCH c2;
 END;
 
 DROP TABLE guc_gp_t1;
+
+-- optimizer_cost_model_params takes name=value pairs of the GPDB cost model
+SET optimizer_cost_model_params = 'TableScanCostUnit=5.5e-07, SortTupWidthCostUnit=5.67e-06';
+SHOW optimizer_cost_model_params;
+SET optimizer_cost_model_params = 'NoSuchCostUnit=1';
+SET optimizer_cost_model_params = 'TableScanCostUnit';
+SET optimizer_cost_model_params = 'TableScanCostUnit=1 SortTupWidthCostUnit=2';
+SET optimizer_cost_model_params = 'TableScanCostUnit=-1';
+SHOW optimizer_cost_model_params;
+RESET optimizer_cost_model_params;
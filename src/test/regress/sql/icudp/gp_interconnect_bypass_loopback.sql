@@ -0,0 +1,59 @@
+--
+-- Motions between processes on the same host, through shared memory rings
+-- rather than the loopback interface, see gp_interconnect_bypass_loopback.
+-- All the segments of the test cluster are on one host.
+--
+
+--start_ignore
+create extension if not exists gp_inject_fault;
+--end_ignore
+
+set gp_interconnect_bypass_loopback = on;
+
+create table icshm_a (a int, b int, t text) distributed by (a);
+create table icshm_rep (a int, b int, t text) distributed replicated;
+insert into icshm_a select i, i % 1000, repeat('x', 100) from generate_series(1, 100000) i;
+
+-- Redistribute
+select count(*), sum(length(y.t)) from icshm_a x join icshm_a y on x.a = y.b;
+-- Broadcast
+insert into icshm_rep select * from icshm_a;
+select count(*), sum(a) from icshm_rep;
+-- Gather
+select a from icshm_a order by a offset 99995;
+
+-- Cancel the sender partway, after it has put a few packets into a ring
+select gp_inject_fault('interconnect_shmring_send', 'interrupt', '', '', '', 10, 10, 0, 2);
+select count(*), sum(length(y.t)) from icshm_a x join icshm_a y on x.a = y.b;
+select gp_inject_fault('interconnect_shmring_send', 'reset', 2);
+
+select gp_inject_fault('interconnect_shmring_send', 'interrupt', '', '', '', 10, 10, 0, 2);
+insert into icshm_rep select * from icshm_a;
+select gp_inject_fault('interconnect_shmring_send', 'reset', 2);
+
+select gp_inject_fault('interconnect_shmring_send', 'interrupt', '', '', '', 10, 10, 0, 2);
+select a from icshm_a order by a offset 99995;
+select gp_inject_fault('interconnect_shmring_send', 'reset', 2);
+
+-- Cancel the receiver partway, after it has read a few packets from a ring
+select gp_inject_fault('interconnect_shmring_recv', 'interrupt', '', '', '', 10, 10, 0, 2);
+select count(*), sum(length(y.t)) from icshm_a x join icshm_a y on x.a = y.b;
+select gp_inject_fault('interconnect_shmring_recv', 'reset', 2);
+
+select gp_inject_fault('interconnect_shmring_recv', 'interrupt', '', '', '', 10, 10, 0, 2);
+insert into icshm_rep select * from icshm_a;
+select gp_inject_fault('interconnect_shmring_recv', 'reset', 2);
+
+-- Error out partway, in the middle of the stream
+select count(*), sum(length(y.t)) from icshm_a x join icshm_a y on x.a = y.b
+ where 1 / (y.a - 50000) > -2;
+insert into icshm_rep select * from icshm_a where 1 / (a - 50000) > -2;
+select a from icshm_a where 1 / (a - 50000) > -2 order by a offset 99995;
+
+-- The aborted statements left nothing behind, and the rings work as before
+select count(*), sum(a) from icshm_rep;
+select count(*), sum(length(y.t)) from icshm_a x join icshm_a y on x.a = y.b;
+select a from icshm_a order by a offset 99995;
+
+reset gp_interconnect_bypass_loopback;
+drop table icshm_a, icshm_rep;
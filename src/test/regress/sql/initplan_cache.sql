@@ -0,0 +1,65 @@
+--
+-- Tests for reusing InitPlan results across queries (gp_enable_initplan_cache).
+-- A cached result must never be returned once one of the relations the
+-- InitPlan reads has been modified.  gp_initplan_cache_stats() counts the
+-- lookups and hits of this session.
+--
+-- Use the Postgres planner, whose plans for these queries have InitPlans.
+set optimizer = off;
+create table initplan_cache_dim (id int, name text) distributed by (id);
+create table initplan_cache_fact (id int, dim_id int) distributed by (id);
+insert into initplan_cache_dim values (1, 'one'), (2, 'two');
+insert into initplan_cache_fact select i, d from generate_series(1, 4) d, generate_series(1, d) i;
+
+set gp_enable_initplan_cache = on;
+
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+-- served from the cache
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+select * from gp_initplan_cache_stats();
+
+-- Modifying the InitPlan's relation must be noticed
+insert into initplan_cache_dim values (3, 'three');
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+select * from gp_initplan_cache_stats();
+-- and the new result is cached again
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+select * from gp_initplan_cache_stats();
+update initplan_cache_dim set id = 4 where id = 3;
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+delete from initplan_cache_dim where id = 4;
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+
+-- So must COPY and TRUNCATE
+copy initplan_cache_dim from stdin;
+3	three
+\.
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+truncate initplan_cache_dim;
+insert into initplan_cache_dim values (1, 'one');
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+
+-- Our own uncommitted changes must be visible to us
+begin;
+insert into initplan_cache_dim values (4, 'four');
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+rollback;
+select count(*) from initplan_cache_fact where dim_id = (select max(id) from initplan_cache_dim);
+
+-- Parameters of prepared statements are part of the cache key
+prepare initplan_cache_stmt(int) as
+  select count(*) from initplan_cache_fact where dim_id = (select max(id) + $1 from initplan_cache_dim);
+execute initplan_cache_stmt(0);
+execute initplan_cache_stmt(1);
+execute initplan_cache_stmt(0);
+deallocate initplan_cache_stmt;
+
+-- Volatile InitPlans are never cached, nor looked up
+select count(*) from initplan_cache_fact where dim_id = (select max(id) + (random() * 0)::int from initplan_cache_dim);
+-- only the third execution of the prepared statement was a hit since
+select * from gp_initplan_cache_stats();
+
+reset gp_enable_initplan_cache;
+reset optimizer;
+drop table initplan_cache_dim;
+drop table initplan_cache_fact;
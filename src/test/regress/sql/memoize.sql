@@ -0,0 +1,109 @@
+--
+-- Tests for the Memoize node, which caches the results of the
+-- parameterized inner side of a nested loop join.  Memoize is only used in
+-- plans of the Postgres planner.
+--
+set optimizer = off;
+
+-- Helper function which can be used for masking out portions of EXPLAIN
+-- ANALYZE which could contain information that's not consistent on all
+-- platforms.
+create function explain_memoize(query text, hide_hitmiss bool) returns setof text
+language plpgsql as
+$$
+declare
+    ln text;
+begin
+    for ln in
+        execute format('explain (analyze, costs off, summary off, timing off) %s',
+            query)
+    loop
+        if hide_hitmiss = true then
+                ln := regexp_replace(ln, 'Hits: 0', 'Hits: Zero');
+                ln := regexp_replace(ln, 'Hits: \d+', 'Hits: N');
+                ln := regexp_replace(ln, 'Misses: 0', 'Misses: Zero');
+                ln := regexp_replace(ln, 'Misses: \d+', 'Misses: N');
+        end if;
+        ln := regexp_replace(ln, 'Evictions: 0', 'Evictions: Zero');
+        ln := regexp_replace(ln, 'Evictions: \d+', 'Evictions: N');
+        ln := regexp_replace(ln, 'Memory Usage: \d+', 'Memory Usage: N');
+        ln := regexp_replace(ln, 'loops=\d+', 'loops=N');
+        return next ln;
+    end loop;
+end;
+$$;
+
+create table memoize_outer (a int, b int) distributed by (a);
+create table memoize_inner (a int, b int) distributed by (a);
+create index memoize_inner_b on memoize_inner (b);
+insert into memoize_outer select i, i % 10 from generate_series(1, 1000) i;
+insert into memoize_inner select i, i % 100 from generate_series(1, 1000) i;
+analyze memoize_outer;
+analyze memoize_inner;
+
+set enable_memoize = on;
+set enable_nestloop = on;
+set enable_hashjoin = off;
+set enable_mergejoin = off;
+set enable_bitmapscan = off;
+
+-- All rows of memoize_seg1 are on segment 1, and the replicated inner side
+-- is joined where they are, so the cache sees every outer row.  10 distinct
+-- keys: 10 misses, the other 990 lookups are hits.
+create table memoize_seg1 (a int, b int) distributed by (a);
+create table memoize_rep (a int, b int) distributed replicated;
+create index memoize_rep_b on memoize_rep (b);
+insert into memoize_seg1 select 1, i % 10 from generate_series(1, 1000) i;
+insert into memoize_rep select i, i % 100 from generate_series(1, 1000) i;
+analyze memoize_seg1;
+analyze memoize_rep;
+select explain_memoize('select count(*), sum(i.a) from memoize_seg1 o join memoize_rep i on i.b = o.b', false);
+select count(*), sum(i.a) from memoize_seg1 o join memoize_rep i on i.b = o.b;
+
+-- Few distinct keys: most inner scans are cache hits
+select count(*), sum(i.a) from memoize_outer o join memoize_inner i on i.b = o.b;
+
+-- Many distinct keys with a tiny cache forces evictions
+set work_mem = '64kB';
+select count(*), sum(i.a) from memoize_outer o join memoize_inner i on i.b = o.a % 100;
+reset work_mem;
+
+-- A parameter that is not part of the cache key must flush the cache
+select o2.a, (select count(*) from memoize_outer o join memoize_inner i
+              on i.b = o.b where i.a < o2.a)
+from memoize_outer o2 where o2.a <= 3 order by 1;
+
+-- Unique inner side: entries are complete after the first row
+create table memoize_uniq (a int primary key, c text) distributed by (a);
+insert into memoize_uniq select i, 'row ' || i from generate_series(0, 99) i;
+analyze memoize_uniq;
+select count(*), count(distinct u.c) from memoize_outer o join memoize_uniq u on u.a = o.b;
+
+-- Only the Postgres planner adds Memoize nodes.  ORCA plans a plain
+-- parameterized nested loop here, see memoize_optimizer.out.
+reset optimizer;
+set optimizer_enable_hashjoin = off;
+set optimizer_enable_bitmapscan = off;
+explain (costs off) select i.a from memoize_seg1 o join memoize_rep i on i.b = o.b;
+reset optimizer_enable_hashjoin;
+reset optimizer_enable_bitmapscan;
+set optimizer = off;
+
+-- Should give the same results with the cache disabled
+set enable_memoize = off;
+select count(*), sum(i.a) from memoize_outer o join memoize_inner i on i.b = o.b;
+select count(*), count(distinct u.c) from memoize_outer o join memoize_uniq u on u.a = o.b;
+
+reset enable_memoize;
+reset enable_nestloop;
+reset enable_hashjoin;
+reset enable_mergejoin;
+reset enable_bitmapscan;
+reset optimizer;
+
+drop table memoize_outer;
+drop table memoize_inner;
+drop table memoize_uniq;
+drop table memoize_seg1;
+drop table memoize_rep;
+drop function explain_memoize(text, bool);
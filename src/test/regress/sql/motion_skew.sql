@@ -0,0 +1,30 @@
+--
+-- Runtime skew detection on Redistribute Motion senders.
+--
+create table motion_skew_src (a int, b int) distributed by (a);
+create table motion_skew_dst (b int) distributed by (b);
+
+-- All rows live on one segment, and all of them hash to the same target.
+insert into motion_skew_src select 2, 1 from generate_series(1, 20000);
+analyze motion_skew_src;
+
+-- Disabled by default.
+insert into motion_skew_dst select b from motion_skew_src;
+
+set gp_motion_skew_warning_ratio = 2;
+set gp_motion_skew_min_rows = 1000;
+insert into motion_skew_dst select b from motion_skew_src;
+
+-- Not enough rows to be worth a warning.
+set gp_motion_skew_min_rows = 100000;
+insert into motion_skew_dst select b from motion_skew_src;
+
+-- Below the ratio.
+set gp_motion_skew_min_rows = 1000;
+set gp_motion_skew_warning_ratio = 5;
+insert into motion_skew_dst select b from motion_skew_src;
+
+reset gp_motion_skew_warning_ratio;
+reset gp_motion_skew_min_rows;
+drop table motion_skew_src;
+drop table motion_skew_dst;
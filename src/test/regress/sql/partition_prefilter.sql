@@ -0,0 +1,40 @@
+--
+-- Static pruning of partitions by simple WHERE clause restrictions before
+-- the optimizer retrieves partition metadata. The results must be the same
+-- with and without the prefilter.
+--
+create schema partition_prefilter;
+set search_path to partition_prefilter;
+
+create table pp_range (id int, d date)
+  distributed by (id)
+  partition by range (d) (start (date '2020-01-01') end (date '2020-01-11') every (interval '1 day'), default partition other);
+insert into pp_range select i, date '2019-12-30' + (i % 15) from generate_series(1, 150) i;
+
+create table pp_list (id int, region text)
+  distributed by (id)
+  partition by list (region) (values ('north'), values ('south'), values ('east'), values ('west'));
+insert into pp_list select i, (array['north', 'south', 'east', 'west'])[i % 4 + 1] from generate_series(1, 100) i;
+
+set optimizer_enable_static_partition_prefilter = on;
+
+select count(*) from pp_range where d = date '2020-01-05';
+select count(*) from pp_range where d >= date '2020-01-03' and d < date '2020-01-06';
+select count(*) from pp_range where date '2020-01-09' < d;
+select count(*) from pp_range where d < date '2020-01-01';
+select count(*) from pp_range where d = date '2019-06-01';
+select count(*) from pp_range where d > date '2020-01-08' and d < date '2020-01-02';
+select count(*) from pp_range where d = date '2020-01-05' or id = 1;
+select count(*) from pp_list where region = 'south';
+select count(*) from pp_list where region > 'north';
+select count(*) from pp_list l, pp_range r where l.id = r.id and r.d = date '2020-01-02' and l.region = 'east';
+select count(*) from pp_list l left join pp_range r on l.id = r.id and r.d = date '2020-01-02';
+
+set optimizer_enable_static_partition_prefilter = off;
+
+select count(*) from pp_range where d = date '2020-01-05';
+select count(*) from pp_range where d >= date '2020-01-03' and d < date '2020-01-06';
+select count(*) from pp_list where region = 'south';
+
+reset optimizer_enable_static_partition_prefilter;
+drop schema partition_prefilter cascade;
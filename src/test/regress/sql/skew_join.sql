@@ -0,0 +1,32 @@
+--
+-- Skew-resilient redistribution of join inputs (gp_enable_skew_join).
+--
+set optimizer = off;
+
+create table skew_join_big (id int, k int) distributed by (id);
+create table skew_join_small (k int, v int) distributed by (v);
+
+-- Half of the big table has k = 1.
+insert into skew_join_big
+  select i, case when i % 2 = 0 then 1 else i % 1000 end
+  from generate_series(1, 30000) i;
+insert into skew_join_small select i % 8000, i from generate_series(1, 16000) i;
+analyze skew_join_big;
+analyze skew_join_small;
+
+explain (costs off) select * from skew_join_big b join skew_join_small s on b.k = s.k;
+select count(*) from skew_join_big b join skew_join_small s on b.k = s.k;
+
+set gp_enable_skew_join = on;
+explain (costs off) select * from skew_join_big b join skew_join_small s on b.k = s.k;
+select count(*) from skew_join_big b join skew_join_small s on b.k = s.k;
+select count(*) from skew_join_big b left join skew_join_small s on b.k = s.k;
+
+-- The small side is preserved here, so its rows must not be broadcast.
+explain (costs off) select * from skew_join_small s left join skew_join_big b on b.k = s.k;
+select count(*) from skew_join_small s left join skew_join_big b on b.k = s.k;
+
+reset gp_enable_skew_join;
+drop table skew_join_big;
+drop table skew_join_small;
+reset optimizer;
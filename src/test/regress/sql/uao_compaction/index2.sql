@@ -22,3 +22,16 @@ VACUUM table_index2;
 SELECT COUNT(*) FROM table_index2;
 SET enable_seqscan=OFF;
 SELECT COUNT(*) FROM table_index2 WHERE a > 0;
+
+-- Deleting a few rows doesn't compact the segment files, and VACUUM leaves
+-- the index entries of the deleted rows alone until it does. Index scans
+-- must not return the deleted rows either way.
+CREATE TABLE table_index3 (a INT, b INT) WITH (appendonly=true) DISTRIBUTED BY (a);
+CREATE INDEX table_index3_index_b ON table_index3(b);
+INSERT INTO table_index3 SELECT i, i % 100 FROM generate_series(1, 10000) i;
+DELETE FROM table_index3 WHERE a <= 50;
+VACUUM table_index3;
+SELECT COUNT(*) FROM table_index3 WHERE b = 10;
+VACUUM FULL table_index3;
+SELECT COUNT(*) FROM table_index3 WHERE b = 10;
+SELECT COUNT(*) FROM table_index3 WHERE b < 50;